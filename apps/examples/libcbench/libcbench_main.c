@@ -0,0 +1,569 @@
+/****************************************************************************
+ * examples/libcbench/libcbench_main.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <time.h>
+#include <crc32.h>
+#include <crc16.h>
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_EXAMPLES_LIBCBENCH_NBYTES
+#  define CONFIG_EXAMPLES_LIBCBENCH_NBYTES (1024*1024)
+#endif
+
+#ifndef CONFIG_EXAMPLES_LIBCBENCH_CPUMHZ
+#  define CONFIG_EXAMPLES_LIBCBENCH_CPUMHZ 0
+#endif
+
+#define MAX_SIZE  4096
+#define MAX_ALIGN 8
+
+#define NSIZES    (sizeof(g_sizes) / sizeof(g_sizes[0]))
+#define NALIGNS   (sizeof(g_aligns) / sizeof(g_aligns[0]))
+#define NTESTS    (sizeof(g_tests) / sizeof(g_tests[0]))
+#define NFORMATS  (sizeof(g_formats) / sizeof(g_formats[0]))
+
+/* printf() is much slower per byte than the memory functions so each
+ * printf measurement produces fewer bytes.
+ */
+
+#define PRINTF_NBYTES (CONFIG_EXAMPLES_LIBCBENCH_NBYTES / 8)
+
+/* The printf output destinations */
+
+#define PRINTF_MEMORY 0  /* snprintf() into a buffer */
+#define PRINTF_RAW    1  /* dprintf() to /dev/null */
+#define PRINTF_FILE   2  /* fprintf() to a FILE opened on /dev/null */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* Describes one function under test.  The function is called with the
+ * destination and source buffers and the size.  For string functions, the
+ * source holds a NUL-terminated string of that size.
+ */
+
+struct libcbench_s
+{
+  FAR const char *name;
+  CODE int (*func)(FAR uint8_t *dest, FAR const uint8_t *src, size_t size);
+};
+
+/* Describes one printf format under test.  Every format is passed the
+ * same arguments:  An int, an unsigned int, a string, and an unsigned int.
+ */
+
+struct printfbench_s
+{
+  FAR const char *name;
+  FAR const char *fmt;
+};
+
+/* The source and destination offsets from a word boundary */
+
+struct align_s
+{
+  uint8_t dest;
+  uint8_t src;
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int bench_memcpy(FAR uint8_t *dest, FAR const uint8_t *src, size_t size);
+static int bench_memmove(FAR uint8_t *dest, FAR const uint8_t *src, size_t size);
+static int bench_memset(FAR uint8_t *dest, FAR const uint8_t *src, size_t size);
+static int bench_memcmp(FAR uint8_t *dest, FAR const uint8_t *src, size_t size);
+static int bench_strlen(FAR uint8_t *dest, FAR const uint8_t *src, size_t size);
+static int bench_strcmp(FAR uint8_t *dest, FAR const uint8_t *src, size_t size);
+static int bench_crc32(FAR uint8_t *dest, FAR const uint8_t *src, size_t size);
+static int bench_crc16(FAR uint8_t *dest, FAR const uint8_t *src, size_t size);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct libcbench_s g_tests[] =
+{
+  { "memcpy",  bench_memcpy  },
+  { "memmove", bench_memmove },
+  { "memset",  bench_memset  },
+  { "memcmp",  bench_memcmp  },
+  { "strlen",  bench_strlen  },
+  { "strcmp",  bench_strcmp  },
+  { "crc32",   bench_crc32   },
+  { "crc16",   bench_crc16   },
+};
+
+static const struct printfbench_s g_formats[] =
+{
+  { "text",   "The quick brown fox jumps over the lazy dog\n" },
+  { "mixed",  "pid=%d pri=%u state=%s stack=%08x\n" },
+  { "number", "%d %u %s %x\n" },
+};
+
+static const uint16_t g_sizes[] = { 8, 64, 512, 4096 };
+
+static const struct align_s g_aligns[] =
+{
+  { 0, 0 },   /* Both aligned */
+  { 1, 1 },   /* Both misaligned by the same amount */
+  { 0, 2 },   /* Half-word aligned relative to each other */
+  { 0, 1 },   /* Byte aligned relative to each other */
+};
+
+/* Room for the largest size, the alignment offsets and the terminator */
+
+static uint32_t g_srcbuffer[(MAX_SIZE + MAX_ALIGN) / 4 + 1];
+static uint32_t g_destbuffer[(MAX_SIZE + MAX_ALIGN) / 4 + 1];
+
+/* The results are accumulated here so that the calls are not optimized
+ * away.
+ */
+
+static volatile int g_sink;
+
+/* Destinations for the printf output */
+
+static char g_printfbuffer[128];
+#if CONFIG_NFILE_DESCRIPTORS > 0
+static int g_nullfd = -1;
+#if CONFIG_NFILE_STREAMS > 0
+static FAR FILE *g_nullstream;
+#endif
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int bench_memcpy(FAR uint8_t *dest, FAR const uint8_t *src, size_t size)
+{
+  return memcpy(dest, src, size) != NULL;
+}
+
+static int bench_memmove(FAR uint8_t *dest, FAR const uint8_t *src, size_t size)
+{
+  return memmove(dest, src, size) != NULL;
+}
+
+static int bench_memset(FAR uint8_t *dest, FAR const uint8_t *src, size_t size)
+{
+  return memset(dest, 0x5a, size) != NULL;
+}
+
+static int bench_memcmp(FAR uint8_t *dest, FAR const uint8_t *src, size_t size)
+{
+  return memcmp(dest, src, size);
+}
+
+static int bench_strlen(FAR uint8_t *dest, FAR const uint8_t *src, size_t size)
+{
+  return (int)strlen((FAR const char *)src);
+}
+
+static int bench_strcmp(FAR uint8_t *dest, FAR const uint8_t *src, size_t size)
+{
+  return strcmp((FAR const char *)dest, (FAR const char *)src);
+}
+
+static int bench_crc32(FAR uint8_t *dest, FAR const uint8_t *src, size_t size)
+{
+  return (int)crc32part(src, size, 0xffffffff);
+}
+
+static int bench_crc16(FAR uint8_t *dest, FAR const uint8_t *src, size_t size)
+{
+  return (int)crc16part(src, size, 0);
+}
+
+/****************************************************************************
+ * Name: libcbench_crccheck
+ *
+ * Description:
+ *   Verify the CRC functions against known answers before timing them.
+ *   The check string is "123456789" passed in two pieces to exercise the
+ *   incremental interfaces.  The long check compares a buffer processed
+ *   all at once with the same buffer processed a byte at a time.
+ *
+ ****************************************************************************/
+
+static int libcbench_crccheck(void)
+{
+  FAR const uint8_t *check = (FAR const uint8_t *)"123456789";
+  FAR const uint8_t *src = (FAR const uint8_t *)g_srcbuffer;
+  struct crc32_s ctx32;
+  struct crc16_s ctx16;
+  uint32_t crc32val;
+  uint16_t crc16val;
+  int errors = 0;
+  int i;
+
+  /* IEEE 802.3 CRC-32 of "123456789" is 0xcbf43926 */
+
+  crc32_init(&ctx32, 0xffffffff, 0xffffffff);
+  crc32_update(&ctx32, check, 4);
+  crc32_update(&ctx32, &check[4], 5);
+  crc32val = crc32_final(&ctx32);
+  if (crc32val != 0xcbf43926)
+    {
+      printf("crc32: ERROR got %08lx expected cbf43926\n",
+             (unsigned long)crc32val);
+      errors++;
+    }
+
+  /* XMODEM CRC-16 of "123456789" is 0x31c3 */
+
+  crc16_init(&ctx16, 0, 0);
+  crc16_update(&ctx16, check, 5);
+  crc16_update(&ctx16, &check[5], 4);
+  crc16val = crc16_final(&ctx16);
+  if (crc16val != 0x31c3)
+    {
+      printf("crc16: ERROR got %04x expected 31c3\n", crc16val);
+      errors++;
+    }
+
+  /* A longer, unaligned buffer exercises the multi-byte steps */
+
+  for (i = 0; i < 1000; i++)
+    {
+      ((FAR uint8_t *)g_srcbuffer)[i] = (uint8_t)(i * 7 + (i >> 3));
+    }
+
+  crc32val = 0xffffffff;
+  crc16val = 0;
+  for (i = 1; i < 1000; i++)
+    {
+      crc32val = crc32part(&src[i], 1, crc32val);
+      crc16val = crc16part(&src[i], 1, crc16val);
+    }
+
+  if (crc32part(&src[1], 999, 0xffffffff) != crc32val)
+    {
+      printf("crc32: ERROR long buffer mismatch\n");
+      errors++;
+    }
+
+  if (crc16part(&src[1], 999, 0) != crc16val)
+    {
+      printf("crc16: ERROR long buffer mismatch\n");
+      errors++;
+    }
+
+  return errors;
+}
+
+/****************************************************************************
+ * Name: libcbench_elapsed
+ *
+ * Description:
+ *   Return the time between start and end in microseconds
+ *
+ ****************************************************************************/
+
+static uint32_t libcbench_elapsed(FAR const struct timespec *start,
+                                  FAR const struct timespec *end)
+{
+  return (uint32_t)(end->tv_sec - start->tv_sec) * 1000000 +
+         (end->tv_nsec / 1000) - (start->tv_nsec / 1000);
+}
+
+/****************************************************************************
+ * Name: libcbench_run
+ *
+ * Description:
+ *   Time one function for one size and alignment and report the result
+ *
+ ****************************************************************************/
+
+static void libcbench_run(FAR const struct libcbench_s *test, size_t size,
+                          FAR const struct align_s *align)
+{
+  FAR uint8_t *dest = (FAR uint8_t *)g_destbuffer + align->dest;
+  FAR uint8_t *src  = (FAR uint8_t *)g_srcbuffer + align->src;
+  struct timespec start;
+  struct timespec end;
+  uint32_t nloops;
+  uint32_t nbytes;
+  uint32_t elapsed;
+  uint32_t kbps;
+  uint32_t i;
+  int result = 0;
+
+  /* Both buffers hold the same NUL-terminated string of 'size' bytes so
+   * that memcmp() and strcmp() must examine every byte.
+   */
+
+  memset(src, 'A', size);
+  src[size] = '\0';
+  memset(dest, 'A', size);
+  dest[size] = '\0';
+
+  nloops = CONFIG_EXAMPLES_LIBCBENCH_NBYTES / size;
+
+  (void)clock_gettime(CLOCK_REALTIME, &start);
+  for (i = 0; i < nloops; i++)
+    {
+      result += test->func(dest, src, size);
+    }
+  (void)clock_gettime(CLOCK_REALTIME, &end);
+
+  g_sink += result;
+
+  elapsed = libcbench_elapsed(&start, &end);
+  if (elapsed == 0)
+    {
+      elapsed = 1;
+    }
+
+  /* Bytes per microsecond is the same as MB (10^6 bytes) per second.
+   * Report KB (10^3) per second to keep three more digits.
+   */
+
+  nbytes = nloops * size;
+  if (nbytes < 4000000)
+    {
+      kbps = (nbytes * 1000) / elapsed;
+    }
+  else
+    {
+      kbps = (nbytes / elapsed) * 1000;
+    }
+
+  printf("%-8s %5lu  %d/%d  %8lu usec %8lu KB/s",
+         test->name, (unsigned long)size, align->dest, align->src,
+         (unsigned long)elapsed, (unsigned long)kbps);
+
+#if CONFIG_EXAMPLES_LIBCBENCH_CPUMHZ > 0
+  /* Bytes per cycle is (bytes/usec) / (cycles/usec).  Show it with three
+   * decimal places.
+   */
+
+  {
+    uint32_t bpc = kbps / CONFIG_EXAMPLES_LIBCBENCH_CPUMHZ;
+    printf("  %lu.%03lu bytes/cycle",
+           (unsigned long)(bpc / 1000), (unsigned long)(bpc % 1000));
+  }
+#endif
+
+  printf("\n");
+}
+
+/****************************************************************************
+ * Name: libcbench_printf
+ *
+ * Description:
+ *   Time one printf format to one destination and report the result
+ *
+ ****************************************************************************/
+
+static void libcbench_printf(FAR const struct printfbench_s *test, int dest)
+{
+  static FAR const char *names[3] = { "snprintf", "dprintf", "fprintf" };
+  struct timespec start;
+  struct timespec end;
+  uint32_t nbytes = 0;
+  uint32_t elapsed;
+  uint32_t kbps;
+  int i = 0;
+  int ret;
+
+  (void)clock_gettime(CLOCK_REALTIME, &start);
+  while (nbytes < PRINTF_NBYTES)
+    {
+      switch (dest)
+        {
+          default:
+          case PRINTF_MEMORY:
+            ret = snprintf(g_printfbuffer, sizeof(g_printfbuffer), test->fmt,
+                           i, i, "ready", i);
+            break;
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+          case PRINTF_RAW:
+            ret = dprintf(g_nullfd, test->fmt, i, i, "ready", i);
+            break;
+
+#if CONFIG_NFILE_STREAMS > 0
+          case PRINTF_FILE:
+            ret = fprintf(g_nullstream, test->fmt, i, i, "ready", i);
+            break;
+#endif
+#endif
+        }
+
+      if (ret <= 0)
+        {
+          printf("%-8s %-6s  failed: %d\n", names[dest], test->name, ret);
+          return;
+        }
+
+      nbytes += ret;
+      i++;
+    }
+  (void)clock_gettime(CLOCK_REALTIME, &end);
+
+  elapsed = libcbench_elapsed(&start, &end);
+  if (elapsed == 0)
+    {
+      elapsed = 1;
+    }
+
+  if (nbytes < 4000000)
+    {
+      kbps = (nbytes * 1000) / elapsed;
+    }
+  else
+    {
+      kbps = (nbytes / elapsed) * 1000;
+    }
+
+  printf("%-8s %-6s  %8lu calls %8lu usec %8lu KB/s\n",
+         names[dest], test->name, (unsigned long)i,
+         (unsigned long)elapsed, (unsigned long)kbps);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * libcbench_main
+ ****************************************************************************/
+
+int libcbench_main(int argc, char *argv[])
+{
+  int i;
+  int j;
+  int k;
+  int errors;
+
+  errors = libcbench_crccheck();
+  if (errors != 0)
+    {
+      printf("libcbench: CRC known-answer tests FAILED\n");
+    }
+  else
+    {
+      printf("libcbench: CRC known-answer tests passed\n");
+    }
+
+  printf("libcbench: %d bytes per measurement\n",
+         CONFIG_EXAMPLES_LIBCBENCH_NBYTES);
+  printf("FUNCTION  SIZE  D/S      TIME        SPEED\n");
+
+  for (i = 0; i < NTESTS; i++)
+    {
+      for (j = 0; j < NSIZES; j++)
+        {
+          for (k = 0; k < NALIGNS; k++)
+            {
+              libcbench_run(&g_tests[i], g_sizes[j], &g_aligns[k]);
+            }
+        }
+    }
+
+  /* Now measure the formatted output throughput */
+
+  printf("\nprintf: %d bytes per measurement\n", PRINTF_NBYTES);
+  printf("FUNCTION FORMAT     CALLS           TIME        SPEED\n");
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+  g_nullfd = open("/dev/null", O_WRONLY);
+  if (g_nullfd < 0)
+    {
+      printf("libcbench: Failed to open /dev/null\n");
+    }
+
+#if CONFIG_NFILE_STREAMS > 0
+  g_nullstream = fopen("/dev/null", "w");
+  if (!g_nullstream)
+    {
+      printf("libcbench: Failed to fopen /dev/null\n");
+    }
+#endif
+#endif
+
+  for (i = 0; i < NFORMATS; i++)
+    {
+      libcbench_printf(&g_formats[i], PRINTF_MEMORY);
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+      if (g_nullfd >= 0)
+        {
+          libcbench_printf(&g_formats[i], PRINTF_RAW);
+        }
+
+#if CONFIG_NFILE_STREAMS > 0
+      if (g_nullstream)
+        {
+          libcbench_printf(&g_formats[i], PRINTF_FILE);
+        }
+#endif
+#endif
+    }
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+#if CONFIG_NFILE_STREAMS > 0
+  if (g_nullstream)
+    {
+      fclose(g_nullstream);
+    }
+#endif
+
+  if (g_nullfd >= 0)
+    {
+      close(g_nullfd);
+    }
+#endif
+
+  return errors != 0 ? 1 : 0;
+}
@@ -53,7 +53,9 @@
 
 int main(int argc, char **argv, char **envp)
 {
-#ifdef CONFIG_EXAMPLES_NETTEST_SERVER
+#if defined(CONFIG_EXAMPLES_NETTEST_CONNRATE)
+  connrate_client();
+#elif defined(CONFIG_EXAMPLES_NETTEST_SERVER)
   send_client();
 #else
   recv_server();
@@ -99,7 +99,9 @@ int nettest_main(int argc, char *argv[])
   addr.s_addr = HTONL(CONFIG_EXAMPLES_NETTEST_NETMASK);
   uip_setnetmask("eth0", &addr);
 
-#ifdef CONFIG_EXAMPLES_NETTEST_SERVER
+#if defined(CONFIG_EXAMPLES_NETTEST_CONNRATE)
+  connrate_server();
+#elif defined(CONFIG_EXAMPLES_NETTEST_SERVER)
   recv_server();
 #else
   send_client();
@@ -92,4 +92,9 @@
 extern void send_client(void);
 extern void recv_server(void);
 
+#ifdef CONFIG_EXAMPLES_NETTEST_CONNRATE
+extern void connrate_client(void);
+extern void connrate_server(void);
+#endif
+
 #endif /* __EXAMPLES_NETTEST_H */
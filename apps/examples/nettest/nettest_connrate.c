@@ -0,0 +1,216 @@
+/****************************************************************************
+ * examples/nettest/nettest_connrate.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+
+#ifdef NETTEST_HOST
+#  include <sys/time.h>
+#endif
+
+#include "nettest.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_EXAMPLES_NETTEST_BACKLOG
+#  define CONFIG_EXAMPLES_NETTEST_BACKLOG 8
+#endif
+
+#ifndef CONFIG_EXAMPLES_NETTEST_NCONNECT
+#  define CONFIG_EXAMPLES_NETTEST_NCONNECT 1000
+#endif
+
+#define CONNRATE_REPORT 100
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef NETTEST_HOST
+/****************************************************************************
+ * Name: connrate_client
+ *
+ * Description:
+ *   Host side of the connection rate test:  Open and close
+ *   CONFIG_EXAMPLES_NETTEST_NCONNECT connections to the target as quickly
+ *   as possible and report the rate.
+ *
+ ****************************************************************************/
+
+void connrate_client(void)
+{
+  struct sockaddr_in myaddr;
+  struct timeval start;
+  struct timeval end;
+  unsigned long elapsed;
+  int nfailed = 0;
+  int sockfd;
+  int i;
+
+  myaddr.sin_family      = AF_INET;
+  myaddr.sin_port        = HTONS(PORTNO);
+  myaddr.sin_addr.s_addr = HTONL(CONFIG_EXAMPLES_NETTEST_CLIENTIP);
+
+  message("client: Opening %d connections\n", CONFIG_EXAMPLES_NETTEST_NCONNECT);
+  gettimeofday(&start, NULL);
+
+  for (i = 0; i < CONFIG_EXAMPLES_NETTEST_NCONNECT; i++)
+    {
+      sockfd = socket(PF_INET, SOCK_STREAM, 0);
+      if (sockfd < 0)
+        {
+          message("client: socket failure %d\n", errno);
+          exit(1);
+        }
+
+      if (connect(sockfd, (struct sockaddr*)&myaddr, sizeof(struct sockaddr_in)) < 0)
+        {
+          nfailed++;
+        }
+
+      close(sockfd);
+    }
+
+  gettimeofday(&end, NULL);
+  elapsed = (end.tv_sec - start.tv_sec) * 1000 +
+            (end.tv_usec - start.tv_usec) / 1000;
+  if (elapsed == 0)
+    {
+      elapsed = 1;
+    }
+
+  message("client: %d connections, %d failed, %lu ms, %lu connections/sec\n",
+          CONFIG_EXAMPLES_NETTEST_NCONNECT, nfailed, elapsed,
+          (unsigned long)(CONFIG_EXAMPLES_NETTEST_NCONNECT - nfailed) * 1000 /
+          elapsed);
+}
+
+#else
+/****************************************************************************
+ * Name: connrate_server
+ *
+ * Description:
+ *   Target side of the connection rate test:  Listen with a backlog of
+ *   CONFIG_EXAMPLES_NETTEST_BACKLOG and accept and close connections
+ *   forever.
+ *
+ ****************************************************************************/
+
+void connrate_server(void)
+{
+  struct sockaddr_in myaddr;
+  socklen_t addrlen;
+  unsigned long naccepted = 0;
+  int listensd;
+  int acceptsd;
+  int optval;
+
+  /* Create a new TCP socket */
+
+  listensd = socket(PF_INET, SOCK_STREAM, 0);
+  if (listensd < 0)
+    {
+      message("server: socket failure: %d\n", errno);
+      return;
+    }
+
+  /* Set socket to reuse address */
+
+  optval = 1;
+  if (setsockopt(listensd, SOL_SOCKET, SO_REUSEADDR, (void*)&optval, sizeof(int)) < 0)
+    {
+      message("server: setsockopt SO_REUSEADDR failure: %d\n", errno);
+      goto errout_with_listensd;
+    }
+
+  /* Bind the socket to a local address */
+
+  myaddr.sin_family      = AF_INET;
+  myaddr.sin_port        = HTONS(PORTNO);
+  myaddr.sin_addr.s_addr = INADDR_ANY;
+
+  if (bind(listensd, (struct sockaddr*)&myaddr, sizeof(struct sockaddr_in)) < 0)
+    {
+      message("server: bind failure: %d\n", errno);
+      goto errout_with_listensd;
+    }
+
+  /* Listen for connections on the bound TCP socket */
+
+  if (listen(listensd, CONFIG_EXAMPLES_NETTEST_BACKLOG) < 0)
+    {
+      message("server: listen failure %d\n", errno);
+      goto errout_with_listensd;
+    }
+
+  /* Accept and close connections forever */
+
+  message("server: Accepting connections on port %d, backlog %d\n",
+          PORTNO, CONFIG_EXAMPLES_NETTEST_BACKLOG);
+
+  for (;;)
+    {
+      addrlen  = sizeof(struct sockaddr_in);
+      acceptsd = accept(listensd, (struct sockaddr*)&myaddr, &addrlen);
+      if (acceptsd < 0)
+        {
+          message("server: accept failure: %d\n", errno);
+          goto errout_with_listensd;
+        }
+
+      close(acceptsd);
+
+      if ((++naccepted % CONNRATE_REPORT) == 0)
+        {
+          message("server: %lu connections accepted\n", naccepted);
+        }
+    }
+
+errout_with_listensd:
+  close(listensd);
+}
+#endif
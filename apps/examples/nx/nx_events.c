@@ -172,6 +172,21 @@ static inline void nxeg_filltoolbar(NXTKWINDOW htb,
 }
 #endif
 
+/****************************************************************************
+ * Name: nxeg_countredraw
+ ****************************************************************************/
+
+#ifdef CONFIG_EXAMPLES_NX_DAMAGEBENCH
+static inline void nxeg_countredraw(FAR const struct nxgl_rect_s *rect)
+{
+  g_nredraws++;
+  g_redrawpixels += (uint32_t)(rect->pt2.x - rect->pt1.x + 1) *
+                    (uint32_t)(rect->pt2.y - rect->pt1.y + 1);
+}
+#else
+#  define nxeg_countredraw(rect)
+#endif
+
 /****************************************************************************
  * Name: nxeg_redraw
  ****************************************************************************/
@@ -185,6 +200,7 @@ static void nxeg_redraw(NXEGWINDOW hwnd, FAR const struct nxgl_rect_s *rect,
            rect->pt1.x, rect->pt1.y, rect->pt2.x, rect->pt2.y,
            more ? "true" : "false");
 
+  nxeg_countredraw(rect);
   nxeg_fillwindow(hwnd, rect, st);
 }
 
@@ -247,6 +263,8 @@ static void nxeg_tbredraw(NXEGWINDOW hwnd, FAR const struct nxgl_rect_s *rect,
            st->wnum, hwnd,
            rect->pt1.x, rect->pt1.y, rect->pt2.x, rect->pt2.y,
            more ? "true" : "false");
+
+  nxeg_countredraw(rect);
   nxeg_filltoolbar(hwnd, rect, g_tbcolor);
 }
 #endif
@@ -156,6 +156,15 @@
 #  endif
 #endif
 
+#ifdef CONFIG_EXAMPLES_NX_DAMAGEBENCH
+#  ifndef CONFIG_EXAMPLES_NX_BENCHFRAMES
+#    define CONFIG_EXAMPLES_NX_BENCHFRAMES 32
+#  endif
+#  ifndef CONFIG_EXAMPLES_NX_BENCHSTEPS
+#    define CONFIG_EXAMPLES_NX_BENCHSTEPS 4
+#  endif
+#endif
+
 #ifdef CONFIG_EXAMPLES_NX_RAWWINDOWS
 #  define NXEGWINDOW NXWINDOW
 #else
@@ -292,6 +301,13 @@ extern nxgl_mxpixel_t g_color2[CONFIG_NX_NPLANES];
 extern nxgl_mxpixel_t g_tbcolor[CONFIG_NX_NPLANES];
 #endif
 
+/* Redraw statistics collected for the redraw benchmark */
+
+#ifdef CONFIG_EXAMPLES_NX_DAMAGEBENCH
+extern volatile uint32_t g_nredraws;
+extern volatile uint32_t g_redrawpixels;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -81,6 +81,17 @@
 #  define CONFIG_EXAMPLES_NX_DEVNO 0
 #endif
 
+/* The frame period used by the redraw benchmark.  This must be longer than
+ * the NX server frame period so that all of the damage from one frame of
+ * the benchmark is flushed before the next.
+ */
+
+#ifdef CONFIG_NX_FRAMEMS
+#  define NXEG_BENCH_FRAMEUSEC (2 * 1000 * CONFIG_NX_FRAMEMS)
+#else
+#  define NXEG_BENCH_FRAMEUSEC (40 * 1000)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -133,6 +144,13 @@ nxgl_mxpixel_t g_color2[CONFIG_NX_NPLANES];
 nxgl_mxpixel_t g_tbcolor[CONFIG_NX_NPLANES];
 #endif
 
+/* Redraw statistics collected for the redraw benchmark */
+
+#ifdef CONFIG_EXAMPLES_NX_DAMAGEBENCH
+volatile uint32_t g_nredraws;
+volatile uint32_t g_redrawpixels;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -413,6 +431,82 @@ static inline int nxeg_raise(NXEGWINDOW hwnd)
 }
 #endif
 
+/****************************************************************************
+ * Name: nxeg_damagebench
+ *
+ * Description:
+ *   Move the window in small steps, CONFIG_EXAMPLES_NX_BENCHSTEPS times per
+ *   frame, and report the number of redraw callbacks and the number of
+ *   pixels redrawn by the window clients per frame.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_EXAMPLES_NX_DAMAGEBENCH
+static int nxeg_damagebench(NXEGWINDOW hwnd, FAR struct nxgl_point_s *pos)
+{
+  struct nxgl_point_s pt;
+  uint32_t nredraws;
+  uint32_t npixels;
+  int frame;
+  int step;
+  int ret;
+
+  message("nxeg_damagebench: %d frames, %d moves per frame\n",
+          CONFIG_EXAMPLES_NX_BENCHFRAMES, CONFIG_EXAMPLES_NX_BENCHSTEPS);
+
+  /* Let any pending redraws complete before starting the count */
+
+  usleep(NXEG_BENCH_FRAMEUSEC);
+  g_nredraws     = 0;
+  g_redrawpixels = 0;
+
+  pt.x = pos->x;
+  pt.y = pos->y;
+
+  for (frame = 0; frame < CONFIG_EXAMPLES_NX_BENCHFRAMES; frame++)
+    {
+      /* Move back and forth so that the window stays on the display */
+
+      for (step = 0; step < CONFIG_EXAMPLES_NX_BENCHSTEPS; step++)
+        {
+          if (frame & 1)
+            {
+              pt.x += 2;
+              pt.y += 1;
+            }
+          else
+            {
+              pt.x -= 2;
+              pt.y -= 1;
+            }
+
+          ret = nxeg_setposition(hwnd, &pt);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+
+      /* Then wait for the end of the frame */
+
+      usleep(NXEG_BENCH_FRAMEUSEC);
+    }
+
+  /* Wait for the final redraws */
+
+  usleep(NXEG_BENCH_FRAMEUSEC);
+  nredraws = g_nredraws;
+  npixels  = g_redrawpixels;
+
+  message("nxeg_damagebench: %lu redraws, %lu pixels\n",
+          (unsigned long)nredraws, (unsigned long)npixels);
+  message("nxeg_damagebench: per frame: %lu redraws, %lu pixels\n",
+          (unsigned long)(nredraws / CONFIG_EXAMPLES_NX_BENCHFRAMES),
+          (unsigned long)(npixels / CONFIG_EXAMPLES_NX_BENCHFRAMES));
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: nxeg_suinitialize
  ****************************************************************************/
@@ -866,6 +960,16 @@ int nx_main(int argc, char *argv[])
   nxeg_drivemouse();
 #endif
 
+  /* Run the redraw benchmark, moving window 2 over window 1 */
+
+#ifdef CONFIG_EXAMPLES_NX_DAMAGEBENCH
+  ret = nxeg_damagebench(hwnd2, &pt);
+  if (ret < 0)
+    {
+      goto errout_with_hwnd2;
+    }
+#endif
+
   /* Sleep a bit */
 
   message("nx_main: Sleeping\n\n");
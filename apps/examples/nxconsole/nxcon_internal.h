@@ -235,6 +235,12 @@
 #  define CONFIG_EXAMPLES_NXCONSOLE_STACKSIZE 2048
 #endif
 
+/* Text output benchmark */
+
+#ifndef CONFIG_EXAMPLES_NXCON_BENCHLINES
+#  define CONFIG_EXAMPLES_NXCON_BENCHLINES 200
+#endif
+
 /* Debug ********************************************************************/
 
 #ifdef CONFIG_CPP_HAVE_VARARGS
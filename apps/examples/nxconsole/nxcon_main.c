@@ -48,6 +48,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <string.h>
+#include <time.h>
 #include <errno.h>
 #include <debug.h>
 
@@ -202,6 +203,64 @@ static int nxcon_task(int argc, char **argv)
   return EXIT_SUCCESS;
 }
 
+/****************************************************************************
+ * Name: nxcon_bench
+ *
+ * Description:
+ *   Write lines of text to the NX console and report the rate.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_EXAMPLES_NXCON_BENCH
+static void nxcon_bench(int fd)
+{
+  static const char line[] =
+    "The quick brown fox jumps over the lazy dog 0123456789\n";
+#ifdef CONFIG_NXFONTS_CACHE
+  struct nxf_cachestats_s stats;
+#endif
+  struct timespec start;
+  struct timespec end;
+  uint32_t nchars;
+  uint32_t msecs;
+  int i;
+
+  (void)clock_gettime(CLOCK_REALTIME, &start);
+  for (i = 0; i < CONFIG_EXAMPLES_NXCON_BENCHLINES; i++)
+    {
+      if (write(fd, line, sizeof(line) - 1) < 0)
+        {
+          message("nxcon_bench: write failed: %d\n", errno);
+          return;
+        }
+    }
+
+  (void)clock_gettime(CLOCK_REALTIME, &end);
+
+  msecs = (end.tv_sec - start.tv_sec) * 1000 +
+          (end.tv_nsec - start.tv_nsec) / 1000000;
+  if (msecs < 1)
+    {
+      msecs = 1;
+    }
+
+  nchars = CONFIG_EXAMPLES_NXCON_BENCHLINES * (sizeof(line) - 1);
+  message("nxcon_bench: %lu chars in %lu msec: %lu chars/sec %lu lines/sec\n",
+          (unsigned long)nchars, (unsigned long)msecs,
+          (unsigned long)nchars * 1000 / msecs,
+          (unsigned long)CONFIG_EXAMPLES_NXCON_BENCHLINES * 1000 / msecs);
+
+#ifdef CONFIG_NXFONTS_CACHE
+  nxf_cache_getstats(&stats);
+  message("nxcon_bench: glyph cache: %lu hits %lu misses %lu evictions, "
+          "%lu glyphs in %lu bytes\n",
+          (unsigned long)stats.hits, (unsigned long)stats.misses,
+          (unsigned long)stats.evictions, (unsigned long)stats.nglyphs,
+          (unsigned long)stats.nbytes);
+#endif
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -364,6 +423,12 @@ int nxcon_main(int argc, char **argv)
       goto errout_with_driver;
     }
 
+#ifdef CONFIG_EXAMPLES_NXCON_BENCH
+  /* Measure the text output rate before handing the console over */
+
+  nxcon_bench(fd);
+
+#endif
   /* Start Console Task *****************************************************/
   /* Now re-direct stdout and stderr so that they use the NX console driver.
    * Note that stdin is retained (file descriptor 0, probably the the serial console).
@@ -116,6 +116,31 @@
 #  endif
 #endif
 
+#ifdef CONFIG_NX_MULTIUSER
+#  ifdef CONFIG_DISABLE_SIGNALS
+#    error "This example requires signal support (CONFIG_DISABLE_SIGNALS=n)"
+#  endif
+#  ifdef CONFIG_DISABLE_PTHREAD
+#    error "This example requires pthread support (CONFIG_DISABLE_PTHREAD=n)"
+#  endif
+#  ifndef CONFIG_EXAMPLES_NXLINES_STACKSIZE
+#    define CONFIG_EXAMPLES_NXLINES_STACKSIZE 2048
+#  endif
+#  ifndef CONFIG_EXAMPLES_NXLINES_LISTENERPRIO
+#    define CONFIG_EXAMPLES_NXLINES_LISTENERPRIO 80
+#  endif
+#  ifndef CONFIG_EXAMPLES_NXLINES_CLIENTPRIO
+#    define CONFIG_EXAMPLES_NXLINES_CLIENTPRIO 100
+#  endif
+#  ifndef CONFIG_EXAMPLES_NXLINES_SERVERPRIO
+#    define CONFIG_EXAMPLES_NXLINES_SERVERPRIO 120
+#  endif
+#endif
+
+#ifndef CONFIG_EXAMPLES_NXLINES_BENCHLINES
+#  define CONFIG_EXAMPLES_NXLINES_BENCHLINES 1000
+#endif
+
 /* Debug ********************************************************************/
 
 #ifdef CONFIG_CPP_HAVE_VARARGS
@@ -150,7 +175,12 @@ enum exitcode_e
   NXEXIT_LCDGETDEV,
   NXEXIT_NXOPEN,
   NXEXIT_NXREQUESTBKGD,
-  NXEXIT_NXSETBGCOLOR
+  NXEXIT_NXSETBGCOLOR,
+  NXEXIT_SCHEDSETPARAM,
+  NXEXIT_TASKCREATE,
+  NXEXIT_PTHREADCREATE,
+  NXEXIT_NXCONNECT,
+  NXEXIT_LOSTSERVERCONN
 };
 
 struct nxlines_data_s
@@ -168,6 +198,10 @@ struct nxlines_data_s
   volatile bool havepos;
   sem_t sem;
   volatile int code;
+
+#ifdef CONFIG_NX_MULTIUSER
+  volatile bool connected;
+#endif
 };
 
 /****************************************************************************
@@ -193,5 +227,8 @@ extern FAR NX_DRIVERTYPE *up_nxdrvinit(unsigned int devno);
 /* Background window interfaces */
 
 extern void nxlines_test(NXWINDOW hwnd);
+#ifdef CONFIG_EXAMPLES_NXLINES_BENCH
+extern void nxlines_bench(NXWINDOW hwnd);
+#endif
 
 #endif /* __APPS_EXAMPLES_NXLINES_NXLINES_H */
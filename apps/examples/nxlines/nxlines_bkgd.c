@@ -44,6 +44,8 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <string.h>
+#include <time.h>
+#include <errno.h>
 #include <debug.h>
 #include <fixedmath.h>
 
@@ -185,6 +187,89 @@ static void nxlines_kbdin(NXWINDOW hwnd, uint8_t nch, FAR const uint8_t *ch,
 
    message("nxlines_kbdin: Unexpected keyboard callback\n");
 }
+#endif
+
+/****************************************************************************
+ * Name: nxlines_benchpass
+ *
+ * Description:
+ *   Draw CONFIG_EXAMPLES_NXLINES_BENCHLINES one pixel wide lines through
+ *   the center of the display and report the rate.  The lines are drawn
+ *   with nx_drawline() just as in the animated test.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_EXAMPLES_NXLINES_BENCH
+static void nxlines_benchpass(NXWINDOW hwnd, FAR const char *label)
+{
+  struct nxgl_vector_s vector;
+  struct nxgl_rect_s rect;
+  struct timespec start;
+  struct timespec end;
+  nxgl_mxpixel_t color[CONFIG_NX_NPLANES];
+  nxgl_coord_t radius;
+  nxgl_coord_t halfx;
+  nxgl_coord_t halfy;
+  uint32_t fence;
+  uint32_t msecs;
+  b16_t angle;
+  int ret;
+  int i;
+
+  radius = (MIN(g_nxlines.yres, g_nxlines.xres) >> 1) - 1;
+
+  (void)clock_gettime(CLOCK_REALTIME, &start);
+  for (i = 0, angle = 0; i < CONFIG_EXAMPLES_NXLINES_BENCHLINES; i++)
+    {
+      halfx = b16toi(b16muli(b16sin(angle), radius));
+      halfy = b16toi(b16muli(b16cos(angle), radius));
+
+      vector.pt1.x = (g_nxlines.xres >> 1) + halfx;
+      vector.pt1.y = (g_nxlines.yres >> 1) + halfy;
+      vector.pt2.x = (g_nxlines.xres >> 1) - halfx;
+      vector.pt2.y = (g_nxlines.yres >> 1) - halfy;
+
+      color[0] = (i & 1) ? CONFIG_EXAMPLES_NXLINES_LINECOLOR :
+                           CONFIG_EXAMPLES_NXLINES_CIRCLECOLOR;
+
+      ret = nx_drawline(hwnd, &vector, 1, color);
+      if (ret < 0)
+        {
+          message("nxlines_benchpass: nx_drawline failed: %d\n", ret);
+        }
+
+      angle += b16PI / 64;
+    }
+
+  /* Reading back a pixel does not complete until the server has drawn
+   * every line that was sent before it.
+   */
+
+  rect.pt1.x = 0;
+  rect.pt1.y = 0;
+  rect.pt2.x = 0;
+  rect.pt2.y = 0;
+
+  ret = nx_getrectangle(hwnd, &rect, 0, (FAR uint8_t *)&fence,
+                        sizeof(uint32_t));
+  if (ret < 0)
+    {
+      message("nxlines_benchpass: nx_getrectangle failed: %d\n", ret);
+    }
+
+  (void)clock_gettime(CLOCK_REALTIME, &end);
+
+  msecs = (end.tv_sec - start.tv_sec) * 1000 +
+          (end.tv_nsec - start.tv_nsec) / 1000000;
+  if (msecs < 1)
+    {
+      msecs = 1;
+    }
+
+  message("nxlines_bench: %s: %d lines in %lu msec (%lu lines/sec)\n",
+          label, CONFIG_EXAMPLES_NXLINES_BENCHLINES, (unsigned long)msecs,
+          (unsigned long)CONFIG_EXAMPLES_NXLINES_BENCHLINES * 1000 / msecs);
+}
 #endif
 
  /****************************************************************************
@@ -333,3 +418,30 @@ void nxlines_test(NXWINDOW hwnd)
       usleep(500*1000);
     }
 }
+
+/****************************************************************************
+ * Name: nxlines_bench
+ *
+ * Description:
+ *   Measure the line drawing rate.  With CONFIG_NX_BATCH, the measurement is
+ *   repeated with drawing command batching enabled on the connection.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_EXAMPLES_NXLINES_BENCH
+void nxlines_bench(NXWINDOW hwnd)
+{
+  nxlines_benchpass(hwnd, "unbatched");
+
+#ifdef CONFIG_NX_BATCH
+  if (nx_batch(g_nxlines.hnx, true) < 0)
+    {
+      message("nxlines_bench: nx_batch failed: %d\n", errno);
+      return;
+    }
+
+  nxlines_benchpass(hwnd, "batched");
+  (void)nx_batch(g_nxlines.hnx, false);
+#endif
+}
+#endif
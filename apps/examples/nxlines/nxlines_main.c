@@ -43,10 +43,12 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <unistd.h>
 #include <time.h>
 #include <string.h>
 #include <sched.h>
+#include <pthread.h>
 #include <errno.h>
 #include <debug.h>
 
@@ -104,6 +106,9 @@ struct nxlines_data_s g_nxlines =
   false,         /* havpos */
   { 0 },         /* sem */
   NXEXIT_SUCCESS /* exit code */
+#ifdef CONFIG_NX_MULTIUSER
+  , false        /* connected */
+#endif
 };
 
 /****************************************************************************
@@ -111,24 +116,24 @@ struct nxlines_data_s g_nxlines =
  ****************************************************************************/
 
 /****************************************************************************
- * Name: nxlines_initialize
+ * Name: nxlines_devinit
  ****************************************************************************/
 
-static inline int nxlines_initialize(void)
+static FAR NX_DRIVERTYPE *nxlines_devinit(void)
 {
   FAR NX_DRIVERTYPE *dev;
 
 #if defined(CONFIG_EXAMPLES_NXLINES_EXTERNINIT)
   /* Use external graphics driver initialization */
 
-  message("nxlines_initialize: Initializing external graphics device\n");
+  message("nxlines_devinit: Initializing external graphics device\n");
   dev = up_nxdrvinit(CONFIG_EXAMPLES_NXLINES_DEVNO);
   if (!dev)
     {
-      message("nxlines_initialize: up_nxdrvinit failed, devno=%d\n",
+      message("nxlines_devinit: up_nxdrvinit failed, devno=%d\n",
               CONFIG_EXAMPLES_NXLINES_DEVNO);
       g_nxlines.code = NXEXIT_EXTINITIALIZE;
-      return ERROR;
+      return NULL;
     }
 
 #elif defined(CONFIG_NX_LCDDRIVER)
@@ -136,13 +141,13 @@ static inline int nxlines_initialize(void)
 
   /* Initialize the LCD device */
 
-  message("nxlines_initialize: Initializing LCD\n");
+  message("nxlines_devinit: Initializing LCD\n");
   ret = up_lcdinitialize();
   if (ret < 0)
     {
-      message("nxlines_initialize: up_lcdinitialize failed: %d\n", -ret);
+      message("nxlines_devinit: up_lcdinitialize failed: %d\n", -ret);
       g_nxlines.code = NXEXIT_LCDINITIALIZE;
-      return ERROR;
+      return NULL;
     }
 
   /* Get the device instance */
@@ -150,9 +155,9 @@ static inline int nxlines_initialize(void)
   dev = up_lcdgetdev(CONFIG_EXAMPLES_NXLINES_DEVNO);
   if (!dev)
     {
-      message("nxlines_initialize: up_lcdgetdev failed, devno=%d\n", CONFIG_EXAMPLES_NXLINES_DEVNO);
+      message("nxlines_devinit: up_lcdgetdev failed, devno=%d\n", CONFIG_EXAMPLES_NXLINES_DEVNO);
       g_nxlines.code = NXEXIT_LCDGETDEV;
-      return ERROR;
+      return NULL;
     }
 
   /* Turn the LCD on at 75% power */
@@ -163,24 +168,185 @@ static inline int nxlines_initialize(void)
 
   /* Initialize the frame buffer device */
 
-  message("nxlines_initialize: Initializing framebuffer\n");
+  message("nxlines_devinit: Initializing framebuffer\n");
   ret = up_fbinitialize();
   if (ret < 0)
     {
-      message("nxlines_initialize: up_fbinitialize failed: %d\n", -ret);
+      message("nxlines_devinit: up_fbinitialize failed: %d\n", -ret);
       g_nxlines.code = NXEXIT_FBINITIALIZE;
-      return ERROR;
+      return NULL;
     }
 
   dev = up_fbgetvplane(CONFIG_EXAMPLES_NXLINES_VPLANE);
   if (!dev)
     {
-      message("nxlines_initialize: up_fbgetvplane failed, vplane=%d\n", CONFIG_EXAMPLES_NXLINES_VPLANE);
+      message("nxlines_devinit: up_fbgetvplane failed, vplane=%d\n", CONFIG_EXAMPLES_NXLINES_VPLANE);
       g_nxlines.code = NXEXIT_FBGETVPLANE;
-      return ERROR;
+      return NULL;
     }
 #endif
 
+  return dev;
+}
+
+/****************************************************************************
+ * Name: nxlines_server
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_MULTIUSER
+static int nxlines_server(int argc, char *argv[])
+{
+  FAR NX_DRIVERTYPE *dev;
+
+  /* Initialize the graphics device */
+
+  dev = nxlines_devinit();
+  if (!dev)
+    {
+      return 1;
+    }
+
+  /* Then start the server (this should not return) */
+
+  (void)nx_run(dev);
+  message("nxlines_server: nx_run returned: %d\n", errno);
+  return 2;
+}
+#endif
+
+/****************************************************************************
+ * Name: nxlines_listener
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_MULTIUSER
+static FAR void *nxlines_listener(FAR void *arg)
+{
+  int ret;
+
+  /* Process events forever */
+
+  for (;;)
+    {
+      /* Handle the next event.  If we were configured blocking, then
+       * we will stay right here until the next event is received.
+       */
+
+      ret = nx_eventhandler(g_nxlines.hnx);
+      if (ret < 0)
+        {
+          /* An error occurred... assume that we have lost connection with
+           * the server.
+           */
+
+          message("nxlines_listener: Lost server connection: %d\n", errno);
+          exit(NXEXIT_LOSTSERVERCONN);
+        }
+
+      /* If we received a message, we must be connected */
+
+      if (!g_nxlines.connected)
+        {
+          g_nxlines.connected = true;
+          sem_post(&g_nxlines.sem);
+          message("nxlines_listener: Connected\n");
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: nxlines_initialize
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_MULTIUSER
+static inline int nxlines_initialize(void)
+{
+  struct sched_param param;
+  pthread_attr_t attr;
+  pthread_t thread;
+  pid_t servrid;
+  int ret;
+
+  /* Set the client task priority */
+
+  param.sched_priority = CONFIG_EXAMPLES_NXLINES_CLIENTPRIO;
+  ret = sched_setparam(0, &param);
+  if (ret < 0)
+    {
+      message("nxlines_initialize: sched_setparam failed: %d\n" , ret);
+      g_nxlines.code = NXEXIT_SCHEDSETPARAM;
+      return ERROR;
+    }
+
+  /* Start the server task */
+
+  message("nxlines_initialize: Starting nxlines_server task\n");
+  servrid = task_create("NX Server", CONFIG_EXAMPLES_NXLINES_SERVERPRIO,
+                        CONFIG_EXAMPLES_NXLINES_STACKSIZE, nxlines_server,
+                        NULL);
+  if (servrid < 0)
+    {
+      message("nxlines_initialize: Failed to create nxlines_server task: %d\n",
+              errno);
+      g_nxlines.code = NXEXIT_TASKCREATE;
+      return ERROR;
+    }
+
+  /* Wait a bit to let the server get started */
+
+  sleep(1);
+
+  /* Connect to the server */
+
+  g_nxlines.hnx = nx_connect();
+  if (!g_nxlines.hnx)
+    {
+      message("nxlines_initialize: nx_connect failed: %d\n", errno);
+      g_nxlines.code = NXEXIT_NXCONNECT;
+      return ERROR;
+    }
+
+  /* Start a separate thread to listen for server events */
+
+  (void)pthread_attr_init(&attr);
+  param.sched_priority = CONFIG_EXAMPLES_NXLINES_LISTENERPRIO;
+  (void)pthread_attr_setschedparam(&attr, &param);
+  (void)pthread_attr_setstacksize(&attr, CONFIG_EXAMPLES_NXLINES_STACKSIZE);
+
+  ret = pthread_create(&thread, &attr, nxlines_listener, NULL);
+  if (ret != 0)
+    {
+      message("nxlines_initialize: pthread_create failed: %d\n", ret);
+      g_nxlines.code = NXEXIT_PTHREADCREATE;
+      return ERROR;
+    }
+
+  /* Don't return until we are connected to the server */
+
+  while (!g_nxlines.connected)
+    {
+      /* Wait for the listener thread to wake us up when we really
+       * are connected.
+       */
+
+      (void)sem_wait(&g_nxlines.sem);
+    }
+
+  return OK;
+}
+#else
+static inline int nxlines_initialize(void)
+{
+  FAR NX_DRIVERTYPE *dev;
+
+  /* Initialize the graphics device */
+
+  dev = nxlines_devinit();
+  if (!dev)
+    {
+      return ERROR;
+    }
+
   /* Then open NX */
 
   message("nxlines_initialize: Open NX\n");
@@ -194,6 +360,7 @@ static inline int nxlines_initialize(void)
 
   return OK;
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -257,6 +424,9 @@ int nxlines_main(int argc, char *argv[])
    * logic is cosmetic). 
    */
 
+#ifdef CONFIG_EXAMPLES_NXLINES_BENCH
+  nxlines_bench(g_nxlines.hbkgd);
+#endif
   nxlines_test(g_nxlines.hbkgd);
 
   /* Release background */
@@ -266,8 +436,13 @@ int nxlines_main(int argc, char *argv[])
   /* Close NX */
 
 errout_with_nx:
+#ifdef CONFIG_NX_MULTIUSER
+  message("nxlines_main: Disconnect from the server\n");
+  nx_disconnect(g_nxlines.hnx);
+#else
   message("nxlines_main: Close NX\n");
   nx_close(g_nxlines.hnx);
+#endif
 errout:
   return g_nxlines.code;
 }
@@ -87,7 +87,9 @@ static void nxbg_kbdin(NXWINDOW hwnd, uint8_t nch, FAR const uint8_t *ch,
 
 static struct nxtext_state_s  g_bgstate;
 static struct nxtext_bitmap_s g_bgbm[CONFIG_EXAMPLES_NXTEXT_BMCACHE];
+#ifndef CONFIG_NXFONTS_CACHE
 static struct nxtext_glyph_s  g_bgglyph[CONFIG_EXAMPLES_NXTEXT_GLCACHE];
+#endif
 
 /****************************************************************************
  * Public Data
@@ -377,9 +379,11 @@ FAR struct nxtext_state_s *nxbg_getstate(void)
   /* Set up the text caches */
 
   g_bgstate.maxchars  = CONFIG_EXAMPLES_NXTEXT_BMCACHE;
-  g_bgstate.maxglyphs = CONFIG_EXAMPLES_NXTEXT_GLCACHE;
   g_bgstate.bm        = g_bgbm;
+#ifndef CONFIG_NXFONTS_CACHE
+  g_bgstate.maxglyphs = CONFIG_EXAMPLES_NXTEXT_GLCACHE;
   g_bgstate.glyph     = g_bgglyph;
+#endif
 
   /* Set the first display position */
 
@@ -106,8 +106,10 @@ static const struct nx_callback_s g_pucb =
 static struct nxtext_state_s g_pustate;
 #ifdef CONFIG_NX_KBD
 static struct nxtext_bitmap_s  g_pubm[NBM_CACHE];
+#ifndef CONFIG_NXFONTS_CACHE
 static struct nxtext_glyph_s g_puglyph[NGLYPH_CACHE];
 #endif
+#endif
 
 /* Some random numbers */
 
@@ -312,9 +314,11 @@ static inline void nxpu_initstate(void)
   /* Set up the text caches */
 
   g_pustate.maxchars  = NBM_CACHE;
-  g_pustate.maxglyphs = NGLYPH_CACHE;
   g_pustate.bm        = g_pubm;
+#ifndef CONFIG_NXFONTS_CACHE
+  g_pustate.maxglyphs = NGLYPH_CACHE;
   g_pustate.glyph     = g_puglyph;
+#endif
 
   /* Set the first display position */
 
@@ -79,6 +79,16 @@
 #  error "Unsupported CONFIG_EXAMPLES_NXTEXT_BPP"
 #endif
 
+/* Glyphs come from the shared glyph cache or from the window's own cache */
+
+#ifdef CONFIG_NXFONTS_CACHE
+#  define NXTEXT_GLYPH_T const struct nxf_glyph_s
+#  define nxtext_releaseglyph(g) nxf_cache_release(g)
+#else
+#  define NXTEXT_GLYPH_T struct nxtext_glyph_s
+#  define nxtext_releaseglyph(g)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -99,6 +109,7 @@
  * Private Functions
  ****************************************************************************/
 
+#ifndef CONFIG_NXFONTS_CACHE
 /****************************************************************************
  * Name: nxtext_freeglyph
  ****************************************************************************/
@@ -321,6 +332,7 @@ nxtext_renderglyph(FAR struct nxtext_state_s *st,
 
   return glyph;
 }
+#endif
 
 /****************************************************************************
  * Name: nxtext_fontsize
@@ -349,6 +361,18 @@ static int nxtext_fontsize(NXHANDLE hfont, uint8_t ch, FAR struct nxgl_size_s *s
  * Name: nxtext_getglyph
  ****************************************************************************/
 
+#ifdef CONFIG_NXFONTS_CACHE
+static inline FAR const struct nxf_glyph_s *
+nxtext_getglyph(NXHANDLE hfont, FAR struct nxtext_state_s *st, uint8_t ch)
+{
+  /* Get the glyph from the shared glyph cache.  It must be released with
+   * nxtext_releaseglyph().
+   */
+
+  return nxf_cache_getglyph(hfont, ch, CONFIG_EXAMPLES_NXTEXT_BPP,
+                            st->fcolor[0], st->wcolor[0]);
+}
+#else
 static FAR struct nxtext_glyph_s *
 nxtext_getglyph(NXHANDLE hfont, FAR struct nxtext_state_s *st, uint8_t ch)
 {
@@ -373,6 +397,7 @@ nxtext_getglyph(NXHANDLE hfont, FAR struct nxtext_state_s *st, uint8_t ch)
 
   return glyph;
 }
+#endif
 
 /****************************************************************************
  * Name: nxtext_addchar
@@ -387,7 +412,7 @@ static FAR const struct nxtext_bitmap_s *
 nxtext_addchar(NXHANDLE hfont, FAR struct nxtext_state_s *st, uint8_t ch)
 {
   FAR struct nxtext_bitmap_s *bm = NULL;
-  FAR struct nxtext_glyph_s *glyph;
+  FAR NXTEXT_GLYPH_T *glyph;
 
   /* Is there space for another character on the display? */
 
@@ -419,6 +444,7 @@ nxtext_addchar(NXHANDLE hfont, FAR struct nxtext_state_s *st, uint8_t ch)
             /* Set up the next character position */
 
             st->fpos.x += glyph->width;
+            nxtext_releaseglyph(glyph);
          }
 
        /* Success.. increment nchars to retain this character */
@@ -519,7 +545,7 @@ void nxtext_fillchar(NXWINDOW hwnd, FAR const struct nxgl_rect_s *rect,
                      FAR struct nxtext_state_s *st,
                      NXHANDLE hfont, FAR const struct nxtext_bitmap_s *bm)
 {
-  FAR struct nxtext_glyph_s *glyph;
+  FAR NXTEXT_GLYPH_T *glyph;
   struct nxgl_rect_s bounds;
   struct nxgl_rect_s intersection;
   struct nxgl_size_s fsize;
@@ -593,6 +619,8 @@ void nxtext_fillchar(NXWINDOW hwnd, FAR const struct nxgl_rect_s *rect,
         {
           message("nxtext_fillchar: nx_bitmapwindow failed: %d\n", errno);
         }
+
+      nxtext_releaseglyph(glyph);
     }
 }
 
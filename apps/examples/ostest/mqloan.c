@@ -0,0 +1,148 @@
+/****************************************************************************
+ * examples/ostest/mqloan.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <mqueue.h>
+
+#include <nuttx/mqueue.h>
+
+#include "ostest.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define LOAN_MAXMSG  4
+#define LOAN_MSGSIZE 200  /* Larger than the default CONFIG_MQ_MAXMSGSIZE */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void mqloan_test(void)
+{
+  static const int prios[LOAN_MAXMSG] = { 1, 5, 1, 5 };
+  struct mq_attr attr;
+  FAR char *buffer;
+  mqd_t mqdes;
+  ssize_t nbytes;
+  int prio;
+  int i;
+
+  attr.mq_maxmsg  = LOAN_MAXMSG;
+  attr.mq_msgsize = LOAN_MSGSIZE;
+  attr.mq_flags   = 0;
+
+  mqdes = mq_open("mqloan", O_RDWR|O_CREAT|O_NONBLOCK, 0666, &attr);
+  if (mqdes == (mqd_t)-1)
+    {
+      printf("mqloan_test: ERROR mq_open failed, errno=%d\n", errno);
+      return;
+    }
+
+  /* Fill the queue with loaned messages built in place */
+
+  for (i = 0; i < LOAN_MAXMSG; i++)
+    {
+      buffer = (FAR char *)mq_loan(mqdes);
+      if (!buffer)
+        {
+          printf("mqloan_test: ERROR mq_loan %d failed, errno=%d\n",
+                 i, errno);
+          goto errout;
+        }
+
+      memset(buffer, 'a' + i, LOAN_MSGSIZE);
+      if (mq_sendloan(mqdes, buffer, LOAN_MSGSIZE, prios[i]) < 0)
+        {
+          printf("mqloan_test: ERROR mq_sendloan %d failed, errno=%d\n",
+                 i, errno);
+          goto errout;
+        }
+    }
+
+  /* The queue is full */
+
+  if (mq_loan(mqdes) != NULL || errno != EAGAIN)
+    {
+      printf("mqloan_test: ERROR mq_loan did not fail with EAGAIN\n");
+      goto errout;
+    }
+
+  /* Messages must be received highest priority first, and in FIFO order
+   * within each priority:  1 ('b'), 3 ('d'), 0 ('a'), 2 ('c').
+   */
+
+  for (i = 0; i < LOAN_MAXMSG; i++)
+    {
+      static const char expected[LOAN_MAXMSG] = { 'b', 'd', 'a', 'c' };
+
+      nbytes = mq_receiveloan(mqdes, (FAR void **)&buffer, &prio);
+      if (nbytes != LOAN_MSGSIZE)
+        {
+          printf("mqloan_test: ERROR mq_receiveloan returned %d, errno=%d\n",
+                 (int)nbytes, errno);
+          goto errout;
+        }
+
+      if (buffer[0] != expected[i] || buffer[LOAN_MSGSIZE-1] != expected[i])
+        {
+          printf("mqloan_test: ERROR message %d is '%c', expected '%c'\n",
+                 i, buffer[0], expected[i]);
+        }
+
+      mq_returnloan(mqdes, buffer);
+    }
+
+  /* The queue is empty */
+
+  if (mq_receiveloan(mqdes, (FAR void **)&buffer, &prio) >= 0 ||
+      errno != EAGAIN)
+    {
+      printf("mqloan_test: ERROR mq_receiveloan did not fail with EAGAIN\n");
+    }
+
+errout:
+  mq_close(mqdes);
+  mq_unlink("mqloan");
+  printf("mqloan_test: Done\n");
+}
@@ -0,0 +1,137 @@
+/****************************************************************************
+ * examples/ostest/mutexperf.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "ostest.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define NLOOPS 100000
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static pthread_mutex_t g_perfmutex;
+static sem_t g_perfsem;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint32_t elapsed_usec(FAR const struct timespec *start,
+                             FAR const struct timespec *end)
+{
+  return (uint32_t)(end->tv_sec - start->tv_sec) * 1000000 +
+         (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+static void show_result(FAR const char *what, uint32_t elapsed)
+{
+  printf("mutexperf_test: %-24s %d loops in %lu usec (%lu nsec/loop)\n",
+         what, NLOOPS, (unsigned long)elapsed,
+         (unsigned long)elapsed * 1000 / NLOOPS);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void mutexperf_test(void)
+{
+  struct timespec start;
+  struct timespec end;
+  int i;
+
+  printf("mutexperf_test: Measuring uncontended lock/unlock\n");
+
+  pthread_mutex_init(&g_perfmutex, NULL);
+  sem_init(&g_perfsem, 0, 1);
+
+  /* pthread_mutex_lock() followed by pthread_mutex_unlock() */
+
+  clock_gettime(CLOCK_REALTIME, &start);
+  for (i = 0; i < NLOOPS; i++)
+    {
+      pthread_mutex_lock(&g_perfmutex);
+      pthread_mutex_unlock(&g_perfmutex);
+    }
+
+  clock_gettime(CLOCK_REALTIME, &end);
+  show_result("mutex lock/unlock:", elapsed_usec(&start, &end));
+
+  /* pthread_mutex_trylock() followed by pthread_mutex_unlock() */
+
+  clock_gettime(CLOCK_REALTIME, &start);
+  for (i = 0; i < NLOOPS; i++)
+    {
+      if (pthread_mutex_trylock(&g_perfmutex) != 0)
+        {
+          printf("mutexperf_test: ERROR: pthread_mutex_trylock failed\n");
+          break;
+        }
+
+      pthread_mutex_unlock(&g_perfmutex);
+    }
+
+  clock_gettime(CLOCK_REALTIME, &end);
+  show_result("mutex trylock/unlock:", elapsed_usec(&start, &end));
+
+  /* sem_wait() followed by sem_post() */
+
+  clock_gettime(CLOCK_REALTIME, &start);
+  for (i = 0; i < NLOOPS; i++)
+    {
+      sem_wait(&g_perfsem);
+      sem_post(&g_perfsem);
+    }
+
+  clock_gettime(CLOCK_REALTIME, &end);
+  show_result("semaphore wait/post:", elapsed_usec(&start, &end));
+
+  pthread_mutex_destroy(&g_perfmutex);
+  sem_destroy(&g_perfsem);
+}
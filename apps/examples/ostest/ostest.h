@@ -71,6 +71,26 @@
 #  define CONFIG_EXAMPLES_OSTEST_NBARRIER_THREADS 8
 #endif
 
+/* This is the number of unrelated threads that are blocked on other
+ * semaphores in the semaphore post latency test.
+ */
+
+#ifndef CONFIG_EXAMPLES_OSTEST_SEMLATENCY_NBLOCKED
+#  define CONFIG_EXAMPLES_OSTEST_SEMLATENCY_NBLOCKED 16
+#endif
+
+#ifndef CONFIG_EXAMPLES_OSTEST_PISTRESS_NMUTEX
+#  define CONFIG_EXAMPLES_OSTEST_PISTRESS_NMUTEX 8
+#endif
+
+#ifndef CONFIG_EXAMPLES_OSTEST_SPAWNPERF_NTHREADS
+#  define CONFIG_EXAMPLES_OSTEST_SPAWNPERF_NTHREADS 500
+#endif
+
+#ifndef CONFIG_EXAMPLES_OSTEST_WQUEUE_NITEMS
+#  define CONFIG_EXAMPLES_OSTEST_WQUEUE_NITEMS 2000
+#endif
+
 /* Priority inheritance */
 
 #if defined(CONFIG_DEBUG) && defined(CONFIG_PRIORITY_INHERITANCE) && defined(CONFIG_SEM_PHDEBUG)
@@ -125,6 +145,18 @@ int waitpid_test(void);
 
 void mutex_test(void);
 
+/* mutexperf.c **************************************************************/
+
+void mutexperf_test(void);
+
+/* spawnperf.c **************************************************************/
+
+void spawnperf_test(void);
+
+/* ringbuf.c ****************************************************************/
+
+void ringbuf_test(void);
+
 /* rmutex.c ******************************************************************/
 
 void recursive_mutex_test(void);
@@ -133,6 +165,10 @@ void recursive_mutex_test(void);
 
 void sem_test(void);
 
+/* semlatency.c *************************************************************/
+
+void semlatency_test(void);
+
 /* cond.c *******************************************************************/
 
 void cond_test(void);
@@ -145,6 +181,14 @@ void mqueue_test(void);
 
 void timedmqueue_test(void);
 
+/* wqueue.c *****************************************************************/
+
+void wqueue_test(void);
+
+/* mqloan.c *****************************************************************/
+
+void mqloan_test(void);
+
 /* cancel.c *****************************************************************/
 
 void cancel_test(void);
@@ -173,6 +217,10 @@ void barrier_test(void);
 
 void priority_inheritance(void);
 
+/* pistress.c ***************************************************************/
+
+void pistress_test(void);
+
 /* vfork.c ******************************************************************/
 
 #if defined(CONFIG_ARCH_HAVE_VFORK) && defined(CONFIG_SCHED_WAITPID) && \
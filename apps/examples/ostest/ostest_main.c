@@ -359,6 +359,30 @@ static int user_main(int argc, char *argv[])
       check_test_memory_usage();
 #endif
 
+#if !defined(CONFIG_DISABLE_PTHREAD) && !defined(CONFIG_DISABLE_CLOCK)
+      /* Measure the cost of uncontended mutex and semaphore operations */
+
+      printf("\nuser_main: mutex performance test\n");
+      mutexperf_test();
+      check_test_memory_usage();
+#endif
+
+#if !defined(CONFIG_DISABLE_PTHREAD) && !defined(CONFIG_DISABLE_CLOCK)
+      /* Measure the cost of creating short-lived threads */
+
+      printf("\nuser_main: thread creation performance test\n");
+      spawnperf_test();
+      check_test_memory_usage();
+#endif
+
+#ifndef CONFIG_DISABLE_PTHREAD
+      /* Verify the ring buffer used by pipes and drivers */
+
+      printf("\nuser_main: ring buffer test\n");
+      ringbuf_test();
+      check_test_memory_usage();
+#endif
+
 #ifndef CONFIG_DISABLE_PTHREAD
       /* Verify pthread cancellation */
 
@@ -375,6 +399,14 @@ static int user_main(int argc, char *argv[])
       check_test_memory_usage();
 #endif
 
+#if !defined(CONFIG_DISABLE_PTHREAD) && !defined(CONFIG_DISABLE_CLOCK)
+      /* Measure semaphore post latency with many blocked tasks */
+
+      printf("\nuser_main: semaphore latency test\n");
+      semlatency_test();
+      check_test_memory_usage();
+#endif
+
 #ifndef CONFIG_DISABLE_PTHREAD
     /* Verify pthreads and condition variables */
 
@@ -411,6 +443,23 @@ static int user_main(int argc, char *argv[])
       check_test_memory_usage();
 #endif
 
+#if !defined(CONFIG_DISABLE_MQUEUE) && defined(CONFIG_MQ_LOAN)
+      /* Verify zero-copy message queue interfaces */
+
+      printf("\nuser_main: message queue loan test\n");
+      mqloan_test();
+      check_test_memory_usage();
+#endif
+
+#if defined(CONFIG_SCHED_WORKQUEUE) && !defined(CONFIG_NUTTX_KERNEL) && \
+   !defined(CONFIG_DISABLE_CLOCK)
+      /* Measure work queue throughput and latency */
+
+      printf("\nuser_main: work queue test\n");
+      wqueue_test();
+      check_test_memory_usage();
+#endif
+
 #ifndef CONFIG_DISABLE_SIGNALS
       /* Verify signal handlers */
 
@@ -449,6 +498,14 @@ static int user_main(int argc, char *argv[])
       printf("\nuser_main: priority inheritance test\n");
       priority_inheritance();
       check_test_memory_usage();
+
+#ifndef CONFIG_DISABLE_CLOCK
+      /* Measure the cost of releasing boosted mutexes */
+
+      printf("\nuser_main: priority inheritance stress test\n");
+      pistress_test();
+      check_test_memory_usage();
+#endif
 #endif /* CONFIG_PRIORITY_INHERITANCE && !CONFIG_DISABLE_SIGNALS && !CONFIG_DISABLE_PTHREAD */
 
 #if defined(CONFIG_ARCH_HAVE_VFORK) && defined(CONFIG_SCHED_WAITPID) && \
@@ -0,0 +1,255 @@
+/****************************************************************************
+ * examples/ostest/pistress.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "ostest.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define NMUTEX  CONFIG_EXAMPLES_OSTEST_PISTRESS_NMUTEX
+#define NROUNDS 100
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static pthread_mutex_t g_pimutex[NMUTEX];
+static sem_t g_pistart[NMUTEX];
+static volatile bool g_pidone;
+static int g_holderpri;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint32_t elapsed_usec(FAR const struct timespec *start,
+                             FAR const struct timespec *end)
+{
+  return (uint32_t)(end->tv_sec - start->tv_sec) * 1000000 +
+         (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+/* Each waiter runs at a higher priority than the holder.  When started, it
+ * immediately blocks on its mutex and boosts the priority of the holder.
+ */
+
+static FAR void *pistress_waiter(FAR void *parameter)
+{
+  int ndx = (int)((intptr_t)parameter);
+
+  for (;;)
+    {
+      while (sem_wait(&g_pistart[ndx]) != 0);
+      if (g_pidone)
+        {
+          break;
+        }
+
+      pthread_mutex_lock(&g_pimutex[ndx]);
+      pthread_mutex_unlock(&g_pimutex[ndx]);
+    }
+
+  return NULL;
+}
+
+/* The holder takes all of the mutexes, lets every waiter block on one of
+ * them, then measures the time to release all of the mutexes.  Each release
+ * must find the holder record and restore the holder's priority.
+ */
+
+static FAR void *pistress_holder(FAR void *parameter)
+{
+  struct sched_param sparam;
+  struct timespec start;
+  struct timespec end;
+  uint32_t elapsed;
+  uint32_t total = 0;
+  uint32_t worst = 0;
+  int policy;
+  int round;
+  int i;
+
+  for (round = 0; round < NROUNDS; round++)
+    {
+      for (i = 0; i < NMUTEX; i++)
+        {
+          pthread_mutex_lock(&g_pimutex[i]);
+        }
+
+      /* Each waiter preempts us and blocks on its mutex */
+
+      for (i = 0; i < NMUTEX; i++)
+        {
+          sem_post(&g_pistart[i]);
+        }
+
+      clock_gettime(CLOCK_REALTIME, &start);
+      for (i = NMUTEX - 1; i >= 0; i--)
+        {
+          pthread_mutex_unlock(&g_pimutex[i]);
+        }
+
+      clock_gettime(CLOCK_REALTIME, &end);
+
+      elapsed = elapsed_usec(&start, &end);
+      total  += elapsed;
+      if (elapsed > worst)
+        {
+          worst = elapsed;
+        }
+
+      /* All boosts should have been undone */
+
+      pthread_getschedparam(pthread_self(), &policy, &sparam);
+      if (sparam.sched_priority != g_holderpri)
+        {
+          printf("pistress_holder: ERROR: priority is %d, expected %d\n",
+                 sparam.sched_priority, g_holderpri);
+        }
+    }
+
+  printf("pistress_holder: %d mutexes, %d rounds: "
+         "%lu usec/unlock average, worst round %lu usec\n",
+         NMUTEX, NROUNDS,
+         (unsigned long)total / (NROUNDS * NMUTEX), (unsigned long)worst);
+
+  /* Release the waiters */
+
+  g_pidone = true;
+  for (i = 0; i < NMUTEX; i++)
+    {
+      sem_post(&g_pistart[i]);
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void pistress_test(void)
+{
+  struct sched_param sparam;
+  pthread_attr_t attr;
+  pthread_t holder;
+  pthread_t waiter[NMUTEX];
+  pthread_addr_t result;
+  int status;
+  int i;
+
+  printf("pistress_test: Releasing %d boosted mutexes\n", NMUTEX);
+
+  g_pidone    = false;
+  g_holderpri = sched_get_priority_min(SCHED_FIFO) + 1;
+
+  for (i = 0; i < NMUTEX; i++)
+    {
+      pthread_mutex_init(&g_pimutex[i], NULL);
+      sem_init(&g_pistart[i], 0, 0);
+    }
+
+  /* Start the waiters at increasing priorities above the holder */
+
+  for (i = 0; i < NMUTEX; i++)
+    {
+      pthread_attr_init(&attr);
+      sparam.sched_priority = g_holderpri + 1 + i;
+      pthread_attr_setschedparam(&attr, &sparam);
+
+      status = pthread_create(&waiter[i], &attr, pistress_waiter,
+                              (pthread_addr_t)((intptr_t)i));
+      if (status != 0)
+        {
+          printf("pistress_test: ERROR: pthread_create failed, status=%d\n",
+                 status);
+          g_pidone = true;
+          while (--i >= 0)
+            {
+              sem_post(&g_pistart[i]);
+              pthread_join(waiter[i], &result);
+            }
+
+          goto errout;
+        }
+    }
+
+  /* Then the holder at the lowest priority */
+
+  pthread_attr_init(&attr);
+  sparam.sched_priority = g_holderpri;
+  pthread_attr_setschedparam(&attr, &sparam);
+
+  status = pthread_create(&holder, &attr, pistress_holder, NULL);
+  if (status != 0)
+    {
+      printf("pistress_test: ERROR: pthread_create failed, status=%d\n",
+             status);
+      g_pidone = true;
+      for (i = 0; i < NMUTEX; i++)
+        {
+          sem_post(&g_pistart[i]);
+        }
+    }
+  else
+    {
+      pthread_join(holder, &result);
+    }
+
+  for (i = 0; i < NMUTEX; i++)
+    {
+      pthread_join(waiter[i], &result);
+    }
+
+errout:
+  for (i = 0; i < NMUTEX; i++)
+    {
+      pthread_mutex_destroy(&g_pimutex[i]);
+      sem_destroy(&g_pistart[i]);
+    }
+}
@@ -0,0 +1,299 @@
+/****************************************************************************
+ * examples/ostest/ringbuf.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sched.h>
+#include <pthread.h>
+#include <semaphore.h>
+
+#include <nuttx/ringbuf.h>
+
+#include "ostest.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define RB_SIZE   13     /* Deliberately not a power of two */
+#define RB_NBYTES 20000  /* Bytes passed from the producer to the consumer */
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static uint8_t g_rbbuffer[RB_SIZE];
+static struct ringbuf_s g_rb;
+static sem_t g_rbdatasem;
+static sem_t g_rbspacesem;
+static int g_rberrors;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void ringbuf_basic(void)
+{
+  uint8_t wrbuf[RB_SIZE + 3];
+  uint8_t rdbuf[RB_SIZE + 3];
+  FAR uint8_t *ptr;
+  uint8_t value = 0;
+  size_t span;
+  size_t n;
+  int pass;
+  int i;
+
+  ringbuf_init(&g_rb, g_rbbuffer, RB_SIZE);
+
+  if (!ringbuf_isempty(&g_rb) || ringbuf_getc(&g_rb) != EOF)
+    {
+      printf("ringbuf_test: ERROR new ring buffer is not empty\n");
+      g_rberrors++;
+    }
+
+  /* The full capacity of the buffer must be usable */
+
+  memset(wrbuf, 0x5a, sizeof(wrbuf));
+  n = ringbuf_put(&g_rb, wrbuf, sizeof(wrbuf));
+  if (n != RB_SIZE || !ringbuf_isfull(&g_rb) || ringbuf_putc(&g_rb, 0))
+    {
+      printf("ringbuf_test: ERROR put %lu bytes into a %d byte buffer\n",
+             (unsigned long)n, RB_SIZE);
+      g_rberrors++;
+    }
+
+  ringbuf_reset(&g_rb);
+
+  /* Move data of varying lengths through the buffer so that both indices
+   * wrap many times.
+   */
+
+  for (pass = 0; pass < 4 * RB_SIZE; pass++)
+    {
+      size_t len = (pass % RB_SIZE) + 1;
+
+      for (i = 0; i < len; i++)
+        {
+          wrbuf[i] = value + i;
+        }
+
+      n = ringbuf_put(&g_rb, wrbuf, len);
+      if (n != len || ringbuf_used(&g_rb) != len)
+        {
+          printf("ringbuf_test: ERROR pass %d: put %lu of %lu bytes\n",
+                 pass, (unsigned long)n, (unsigned long)len);
+          g_rberrors++;
+        }
+
+      memset(rdbuf, 0, sizeof(rdbuf));
+      n = ringbuf_get(&g_rb, rdbuf, sizeof(rdbuf));
+      if (n != len || memcmp(wrbuf, rdbuf, len) != 0)
+        {
+          printf("ringbuf_test: ERROR pass %d: got %lu of %lu bytes\n",
+                 pass, (unsigned long)n, (unsigned long)len);
+          g_rberrors++;
+        }
+
+      value += len;
+    }
+
+  /* Fill the buffer in place through the contiguous spans.  Two spans are
+   * needed whenever the free space wraps around the end of the buffer.
+   */
+
+  ringbuf_reset(&g_rb);
+  (void)ringbuf_put(&g_rb, wrbuf, 5);
+  (void)ringbuf_get(&g_rb, rdbuf, 5);
+
+  for (value = 0, n = 0; (span = ringbuf_wrspan(&g_rb, &ptr)) > 0; )
+    {
+      for (i = 0; i < span; i++)
+        {
+          ptr[i] = value++;
+        }
+
+      ringbuf_wrcommit(&g_rb, span);
+      n += span;
+    }
+
+  for (value = 0; (span = ringbuf_rdspan(&g_rb, &ptr)) > 0; )
+    {
+      for (i = 0; i < span; i++, value++)
+        {
+          if (ptr[i] != value)
+            {
+              printf("ringbuf_test: ERROR span byte %d: %d, expected %d\n",
+                     value, ptr[i], value);
+              g_rberrors++;
+            }
+        }
+
+      ringbuf_rdcommit(&g_rb, span);
+    }
+
+  if (n != RB_SIZE || value != RB_SIZE || !ringbuf_isempty(&g_rb))
+    {
+      printf("ringbuf_test: ERROR spans moved %lu/%d bytes\n",
+             (unsigned long)n, value);
+      g_rberrors++;
+    }
+}
+
+static FAR void *ringbuf_producer(FAR void *arg)
+{
+  uint8_t buffer[7];
+  uint8_t value = 0;
+  int nbytes = 0;
+  size_t n;
+  int i;
+
+  while (nbytes < RB_NBYTES)
+    {
+      for (i = 0; i < sizeof(buffer); i++)
+        {
+          buffer[i] = value + i;
+        }
+
+      /* The scheduler is locked so that the consumer cannot empty the
+       * buffer and miss the notification between the check and the wait.
+       */
+
+      sched_lock();
+      while ((n = ringbuf_put(&g_rb, buffer, sizeof(buffer))) == 0)
+        {
+          sem_wait(&g_rbspacesem);
+        }
+      sched_unlock();
+
+      ringbuf_notify(&g_rbdatasem);
+      value  += n;
+      nbytes += n;
+    }
+
+  return NULL;
+}
+
+static FAR void *ringbuf_consumer(FAR void *arg)
+{
+  uint8_t value = 0;
+  int nbytes = 0;
+  int ch;
+
+  while (nbytes < RB_NBYTES)
+    {
+      sched_lock();
+      while ((ch = ringbuf_getc(&g_rb)) == EOF)
+        {
+          sem_wait(&g_rbdatasem);
+        }
+      sched_unlock();
+
+      ringbuf_notify(&g_rbspacesem);
+      if (ch != value)
+        {
+          /* Keep draining the buffer so that the producer can finish */
+
+          printf("ringbuf_consumer: ERROR byte %d: %d, expected %d\n",
+                 nbytes, ch, value);
+          g_rberrors++;
+          value = ch;
+        }
+
+      value++;
+      nbytes++;
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void ringbuf_test(void)
+{
+  pthread_t producer;
+  pthread_t consumer;
+  int status;
+
+  g_rberrors = 0;
+
+  /* Single threaded checks of wrap-around and spans */
+
+  ringbuf_basic();
+
+  /* Then pass a byte sequence from one thread to another */
+
+  ringbuf_init(&g_rb, g_rbbuffer, RB_SIZE);
+  sem_init(&g_rbdatasem, 0, 0);
+  sem_init(&g_rbspacesem, 0, 0);
+
+  status = pthread_create(&consumer, NULL, ringbuf_consumer, NULL);
+  if (status != 0)
+    {
+      printf("ringbuf_test: ERROR pthread_create failed, status=%d\n",
+             status);
+      g_rberrors++;
+      goto errout;
+    }
+
+  status = pthread_create(&producer, NULL, ringbuf_producer, NULL);
+  if (status != 0)
+    {
+      printf("ringbuf_test: ERROR pthread_create failed, status=%d\n",
+             status);
+      g_rberrors++;
+      pthread_cancel(consumer);
+      pthread_join(consumer, NULL);
+      goto errout;
+    }
+
+  pthread_join(producer, NULL);
+  pthread_join(consumer, NULL);
+
+errout:
+  sem_destroy(&g_rbdatasem);
+  sem_destroy(&g_rbspacesem);
+
+  printf("ringbuf_test: %s, %d errors\n",
+         g_rberrors ? "FAILED" : "PASSED", g_rberrors);
+}
@@ -0,0 +1,250 @@
+/****************************************************************************
+ * examples/ostest/semlatency.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <sched.h>
+
+#include "ostest.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define NBLOCKED CONFIG_EXAMPLES_OSTEST_SEMLATENCY_NBLOCKED
+#define NSTEPS   4
+#define NLOOPS   10000
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static sem_t g_pingsem;
+static sem_t g_blockedsem[NBLOCKED];
+static int g_prioblocked;
+static int g_result;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void *blocked_func(void *parameter)
+{
+  FAR sem_t *sem = (FAR sem_t *)parameter;
+
+  /* Wait on our private semaphore until the test is complete */
+
+  while (sem_wait(sem) != 0);
+  return NULL;
+}
+
+static void *responder_func(void *parameter)
+{
+  int i;
+
+  /* Take the ping semaphore NLOOPS times for each measurement step.  This
+   * thread has higher priority than the poster so each post wakes it
+   * immediately.
+   */
+
+  for (i = 0; i < (NSTEPS + 1) * NLOOPS; i++)
+    {
+      while (sem_wait(&g_pingsem) != 0);
+    }
+
+  return NULL;
+}
+
+static int start_thread(pthread_t *thread, int priority,
+                        void *(*entry)(void *), pthread_addr_t arg)
+{
+  struct sched_param sparam;
+  pthread_attr_t attr;
+  int status;
+
+  status = pthread_attr_init(&attr);
+  if (status != OK)
+    {
+      printf("semlatency_test: ERROR: pthread_attr_init failed, status=%d\n", status);
+      return status;
+    }
+
+  sparam.sched_priority = priority;
+  status = pthread_attr_setschedparam(&attr, &sparam);
+  if (status != OK)
+    {
+      printf("semlatency_test: ERROR: pthread_attr_setschedparam failed, status=%d\n", status);
+      return status;
+    }
+
+  status = pthread_create(thread, &attr, entry, arg);
+  if (status != OK)
+    {
+      printf("semlatency_test: ERROR: pthread_create failed, status=%d\n", status);
+    }
+
+  return status;
+}
+
+static void *poster_func(void *parameter)
+{
+  pthread_t blocked[NBLOCKED];
+  struct timespec start;
+  struct timespec end;
+  uint32_t elapsed;
+  int nblocked = 0;
+  int step;
+  int i;
+
+  for (step = 0; step <= NSTEPS; step++)
+    {
+      /* Block more unrelated threads on their own semaphores.  They have
+       * higher priority than the ping responder.
+       */
+
+      while (nblocked < (step * NBLOCKED) / NSTEPS)
+        {
+          if (start_thread(&blocked[nblocked], g_prioblocked, blocked_func,
+                           (pthread_addr_t)&g_blockedsem[nblocked]) != OK)
+            {
+              goto errout;
+            }
+
+          nblocked++;
+        }
+
+      /* Measure the time to post the ping semaphore NLOOPS times */
+
+      clock_gettime(CLOCK_REALTIME, &start);
+      for (i = 0; i < NLOOPS; i++)
+        {
+          sem_post(&g_pingsem);
+        }
+
+      clock_gettime(CLOCK_REALTIME, &end);
+
+      elapsed = (uint32_t)(end.tv_sec - start.tv_sec) * 1000000 +
+                (end.tv_nsec - start.tv_nsec) / 1000;
+
+      printf("semlatency_test: %2d blocked tasks: %d posts in %lu usec (%lu nsec/post)\n",
+             nblocked, NLOOPS, (unsigned long)elapsed,
+             (unsigned long)elapsed * 1000 / NLOOPS);
+    }
+
+  g_result = OK;
+
+errout:
+  /* Release the blocked threads */
+
+  for (i = 0; i < nblocked; i++)
+    {
+      sem_post(&g_blockedsem[i]);
+      pthread_join(blocked[i], NULL);
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void semlatency_test(void)
+{
+  pthread_t responder;
+  pthread_t poster;
+  int prio_min;
+  int prio_max;
+  int prio_mid;
+  int i;
+
+  printf("semlatency_test: Measuring sem_post() latency with up to %d blocked tasks\n",
+         NBLOCKED);
+
+  sem_init(&g_pingsem, 0, 0);
+  for (i = 0; i < NBLOCKED; i++)
+    {
+      sem_init(&g_blockedsem[i], 0, 0);
+    }
+
+  prio_min = sched_get_priority_min(SCHED_FIFO);
+  prio_max = sched_get_priority_max(SCHED_FIFO);
+  prio_mid = (prio_min + prio_max) / 2;
+
+  /* The poster runs at the mid priority, the responder just above it, and
+   * the unrelated blocked threads above both.
+   */
+
+  if (start_thread(&responder, prio_mid + 1, responder_func, NULL) != OK)
+    {
+      return;
+    }
+
+  g_prioblocked = (prio_mid + prio_max) / 2;
+  g_result      = ERROR;
+
+  if (start_thread(&poster, prio_mid, poster_func, NULL) != OK)
+    {
+      pthread_cancel(responder);
+      pthread_join(responder, NULL);
+      return;
+    }
+
+  pthread_join(poster, NULL);
+
+  /* The responder has taken every post unless the poster stopped early */
+
+  if (g_result != OK)
+    {
+      pthread_cancel(responder);
+    }
+
+  pthread_join(responder, NULL);
+
+  sem_destroy(&g_pingsem);
+  for (i = 0; i < NBLOCKED; i++)
+    {
+      sem_destroy(&g_blockedsem[i]);
+    }
+
+  printf("semlatency_test: Done\n");
+}
@@ -0,0 +1,154 @@
+/****************************************************************************
+ * examples/ostest/spawnperf.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "ostest.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define NTHREADS CONFIG_EXAMPLES_OSTEST_SPAWNPERF_NTHREADS
+#define NKEEP    4    /* Number of allocations kept alive between threads */
+#define KEEPSIZE 64   /* Size of each of those allocations */
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR void *g_keep[NKEEP];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint32_t elapsed_usec(FAR const struct timespec *start,
+                             FAR const struct timespec *end)
+{
+  return (uint32_t)(end->tv_sec - start->tv_sec) * 1000000 +
+         (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+static void show_heap(FAR const char *when)
+{
+  struct mallinfo mm;
+
+#ifdef CONFIG_CAN_PASS_STRUCTS
+  mm = mallinfo();
+#else
+  (void)mallinfo(&mm);
+#endif
+
+  printf("spawnperf_test: %-6s free %d bytes in %d chunks, largest %d\n",
+         when, mm.fordblks, mm.ordblks, mm.mxordblk);
+}
+
+static FAR void *spawnperf_thread(FAR void *parameter)
+{
+  return NULL;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void spawnperf_test(void)
+{
+  struct timespec start;
+  struct timespec end;
+  pthread_t thread;
+  FAR void *result;
+  int status;
+  int i;
+
+#ifdef CONFIG_SCHED_TCBPOOL
+  printf("spawnperf_test: Creating %d threads (TCB pool enabled)\n", NTHREADS);
+#else
+  printf("spawnperf_test: Creating %d threads (TCB pool disabled)\n", NTHREADS);
+#endif
+
+  memset(g_keep, 0, sizeof(g_keep));
+  show_heap("before");
+
+  /* Create and join short-lived threads one at a time.  A few small
+   * allocations made between threads stay alive for a while (as the state
+   * of a request would) so that a heap allocation of each stack fragments
+   * the heap.
+   */
+
+  clock_gettime(CLOCK_REALTIME, &start);
+  for (i = 0; i < NTHREADS; i++)
+    {
+      free(g_keep[i % NKEEP]);
+      g_keep[i % NKEEP] = malloc(KEEPSIZE);
+
+      status = pthread_create(&thread, NULL, spawnperf_thread, NULL);
+      if (status != 0)
+        {
+          printf("spawnperf_test: ERROR pthread_create %d failed: %d\n",
+                 i, status);
+          break;
+        }
+
+      (void)pthread_join(thread, &result);
+    }
+
+  clock_gettime(CLOCK_REALTIME, &end);
+
+  printf("spawnperf_test: %d threads created and joined in %lu usec "
+         "(%lu usec/thread)\n", i,
+         (unsigned long)elapsed_usec(&start, &end),
+         i > 0 ? (unsigned long)elapsed_usec(&start, &end) / i : 0);
+
+  show_heap("during");
+
+  for (i = 0; i < NKEEP; i++)
+    {
+      free(g_keep[i]);
+      g_keep[i] = NULL;
+    }
+
+  show_heap("after");
+}
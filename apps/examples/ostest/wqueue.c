@@ -0,0 +1,317 @@
+/****************************************************************************
+ * examples/ostest/wqueue.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <time.h>
+#include <sched.h>
+#include <semaphore.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
+
+#include "ostest.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define NITEMS    CONFIG_EXAMPLES_OSTEST_WQUEUE_NITEMS
+#define MAXDELAY  20     /* Maximum delay in clock ticks */
+
+/* The low priority work queue may be served by a pool of threads */
+
+#if defined(CONFIG_SCHED_LPWORK) && CONFIG_SCHED_LPNTHREADS > 1
+#  define HAVE_LPPOOL 1
+#  define NSHORT    8    /* Number of short work items */
+#  define LONGMSEC  500  /* Duration of the long-running work (msec) */
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct wqitem_s
+{
+  struct work_s work;
+  uint32_t      expiry;  /* Time when the work was due */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR struct wqitem_s *g_wqitems;
+static sem_t g_wqdone;
+static volatile int g_wqndone;
+static uint32_t g_wqlast;
+static uint32_t g_wqmaxlate;
+static uint32_t g_wqtotallate;
+static int g_wqnbad;
+
+#ifdef HAVE_LPPOOL
+static struct work_s g_wqlong;
+static sem_t g_wqlongdone;
+static volatile bool g_wqlongbusy;
+static volatile int g_wqnlate;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint32_t elapsed_usec(FAR const struct timespec *start,
+                             FAR const struct timespec *end)
+{
+  return (uint32_t)(end->tv_sec - start->tv_sec) * 1000000 +
+         (end->tv_nsec - start->tv_nsec) / 1000;
+}
+
+static void wqueue_counted(void)
+{
+  if (++g_wqndone >= NITEMS)
+    {
+      sem_post(&g_wqdone);
+    }
+}
+
+/* Work with no delay:  Just count it */
+
+static void wqueue_fastworker(FAR void *arg)
+{
+  wqueue_counted();
+}
+
+/* Delayed work:  Check that it runs in order of expiration and measure
+ * how late it runs.
+ */
+
+static void wqueue_delayworker(FAR void *arg)
+{
+  FAR struct wqitem_s *item = (FAR struct wqitem_s *)arg;
+  uint32_t late = clock_systimer() - item->expiry;
+
+  if (g_wqndone > 0 && (int32_t)(item->expiry - g_wqlast) < 0)
+    {
+      g_wqnbad++;
+    }
+
+  g_wqlast       = item->expiry;
+  g_wqtotallate += late;
+  if (late > g_wqmaxlate)
+    {
+      g_wqmaxlate = late;
+    }
+
+  wqueue_counted();
+}
+
+/* Pool test:  Long-running work that sleeps (like a FLASH erase) and short
+ * work that should not have to wait for it.
+ */
+
+#ifdef HAVE_LPPOOL
+static void wqueue_longworker(FAR void *arg)
+{
+  usleep(LONGMSEC * 1000);
+  g_wqlongbusy = false;
+  sem_post(&g_wqlongdone);
+}
+
+static void wqueue_shortworker(FAR void *arg)
+{
+  if (!g_wqlongbusy)
+    {
+      g_wqnlate++;
+    }
+
+  if (++g_wqndone >= NSHORT)
+    {
+      sem_post(&g_wqdone);
+    }
+}
+
+static void wqueue_pooltest(void)
+{
+  struct work_s shortwork[NSHORT];
+  struct timespec start;
+  struct timespec end;
+  int i;
+
+  printf("wqueue_test: Queuing long-running work and %d short work items "
+         "on %d low priority worker threads\n",
+         NSHORT, CONFIG_SCHED_LPNTHREADS);
+
+  memset(shortwork, 0, NSHORT * sizeof(struct work_s));
+  memset(&g_wqlong, 0, sizeof(struct work_s));
+  sem_init(&g_wqlongdone, 0, 0);
+  g_wqndone    = 0;
+  g_wqnlate    = 0;
+  g_wqlongbusy = true;
+
+  /* The long-running work is queued first so that it is performed first.
+   * The short work is performed by the other threads in the pool while
+   * the long-running work is still in progress.
+   */
+
+  clock_gettime(CLOCK_REALTIME, &start);
+  work_queue(LPWORK, &g_wqlong, wqueue_longworker, NULL, 0);
+  for (i = 0; i < NSHORT; i++)
+    {
+      work_queue(LPWORK, &shortwork[i], wqueue_shortworker, NULL, 0);
+    }
+
+  while (sem_wait(&g_wqdone) != 0);
+  clock_gettime(CLOCK_REALTIME, &end);
+
+  printf("wqueue_test: short work performed in %lu usec "
+         "(long-running work takes %d msec)\n",
+         (unsigned long)elapsed_usec(&start, &end), LONGMSEC);
+
+  if (g_wqnlate > 0)
+    {
+      printf("wqueue_test: ERROR %d short work items were not performed "
+             "while the long-running work was in progress\n", g_wqnlate);
+    }
+
+  while (sem_wait(&g_wqlongdone) != 0);
+  sem_destroy(&g_wqlongdone);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void wqueue_test(void)
+{
+  struct timespec start;
+  struct timespec queued;
+  struct timespec end;
+  uint32_t seed = 1;
+  int i;
+
+  g_wqitems = (FAR struct wqitem_s *)zalloc(NITEMS * sizeof(struct wqitem_s));
+  if (!g_wqitems)
+    {
+      printf("wqueue_test: ERROR failed to allocate %d work items\n", NITEMS);
+      return;
+    }
+
+  sem_init(&g_wqdone, 0, 0);
+
+  /* Throughput:  Queue work with no delay while the scheduler is locked so
+   * that all of it is pending at once, then let the worker drain it.
+   */
+
+  printf("wqueue_test: Queuing %d work items with no delay\n", NITEMS);
+
+  g_wqndone = 0;
+  sched_lock();
+  clock_gettime(CLOCK_REALTIME, &start);
+  for (i = 0; i < NITEMS; i++)
+    {
+      work_queue(USRWORK, &g_wqitems[i].work, wqueue_fastworker,
+                 &g_wqitems[i], 0);
+    }
+
+  clock_gettime(CLOCK_REALTIME, &queued);
+  sched_unlock();
+
+  while (sem_wait(&g_wqdone) != 0);
+  clock_gettime(CLOCK_REALTIME, &end);
+
+  printf("wqueue_test: queued in %lu usec, all performed in %lu usec\n",
+         (unsigned long)elapsed_usec(&start, &queued),
+         (unsigned long)elapsed_usec(&start, &end));
+
+  /* Latency:  Queue work with pseudo-random delays, then check that the
+   * work is performed in order of expiration and how late it is.
+   */
+
+  printf("wqueue_test: Queuing %d work items with delays of 1-%d ticks\n",
+         NITEMS, MAXDELAY);
+
+  g_wqndone     = 0;
+  g_wqmaxlate   = 0;
+  g_wqtotallate = 0;
+  g_wqnbad      = 0;
+
+  sched_lock();
+  clock_gettime(CLOCK_REALTIME, &start);
+  for (i = 0; i < NITEMS; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      work_queue(USRWORK, &g_wqitems[i].work, wqueue_delayworker,
+                 &g_wqitems[i], 1 + (seed >> 16) % MAXDELAY);
+
+      g_wqitems[i].expiry = g_wqitems[i].work.qtime +
+                            g_wqitems[i].work.delay;
+    }
+
+  clock_gettime(CLOCK_REALTIME, &queued);
+  sched_unlock();
+
+  while (sem_wait(&g_wqdone) != 0);
+
+  printf("wqueue_test: queued in %lu usec, "
+         "late by %lu ticks average, %lu ticks worst\n",
+         (unsigned long)elapsed_usec(&start, &queued),
+         (unsigned long)(g_wqtotallate / NITEMS),
+         (unsigned long)g_wqmaxlate);
+
+  if (g_wqnbad > 0)
+    {
+      printf("wqueue_test: ERROR %d work items performed out of order\n",
+             g_wqnbad);
+    }
+
+#ifdef HAVE_LPPOOL
+  /* Pool:  Check that long-running work does not delay other work */
+
+  wqueue_pooltest();
+#endif
+
+  sem_destroy(&g_wqdone);
+  free(g_wqitems);
+}
@@ -70,5 +70,8 @@
 extern int transfer_test(int fdin, int fdout);
 extern int interlock_test(void);
 extern int redirection_test(void);
+#ifndef CONFIG_DISABLE_CLOCK
+extern int throughput_test(void);
+#endif
 
 #endif /* __EXAMPLES_PIPE_PIPE_H */
@@ -184,6 +184,19 @@ int pipe_main(int argc, char *argv[])
     }
   printf("pipe_main: PIPE redirection test PASSED\n");
 
+#ifndef CONFIG_DISABLE_CLOCK
+  /* Measure the pipe throughput for several transfer sizes */
+
+  printf("\npipe_main: Performing throughput test\n");
+  ret = throughput_test();
+  if (ret != 0)
+    {
+      fprintf(stderr, "pipe_main: PIPE throughput test FAILED (%d)\n", ret);
+      return 8;
+    }
+  printf("pipe_main: PIPE throughput test PASSED\n");
+#endif
+
   fflush(stdout);
   return 0;
 }
@@ -0,0 +1,205 @@
+/****************************************************************************
+ * examples/pipe/throughput_test.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+#include <errno.h>
+
+#include "pipe.h"
+
+#ifndef CONFIG_DISABLE_CLOCK
+
+/****************************************************************************
+ * Pre-proecessor Definitions
+ ****************************************************************************/
+
+#define MAX_XFRSIZE  4096
+#define TOTAL_BYTES  (64 * 1024)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const size_t g_xfrsizes[] = { 64, 256, 1024, 4096 };
+
+static uint8_t g_wrbuffer[MAX_XFRSIZE];
+static uint8_t g_rdbuffer[MAX_XFRSIZE];
+static size_t g_xfrsize;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: throughput_reader
+ ****************************************************************************/
+
+static void *throughput_reader(pthread_addr_t pvarg)
+{
+  int fd = (int)pvarg;
+  int nbytes;
+  int ret;
+
+  for (nbytes = 0; nbytes < TOTAL_BYTES; nbytes += ret)
+    {
+      ret = read(fd, g_rdbuffer, g_xfrsize);
+      if (ret <= 0)
+        {
+          fprintf(stderr, "throughput_reader: read failed, errno=%d\n", errno);
+          return (void*)1;
+        }
+    }
+
+  return (void*)0;
+}
+
+/****************************************************************************
+ * Name: throughput_xfr
+ ****************************************************************************/
+
+static int throughput_xfr(int fdin, int fdout)
+{
+  struct timespec start;
+  struct timespec end;
+  pthread_t readerid;
+  uint32_t elapsed;
+  void *value;
+  int nbytes;
+  int ret;
+
+  (void)clock_gettime(CLOCK_REALTIME, &start);
+
+  ret = pthread_create(&readerid, NULL, throughput_reader, (pthread_addr_t)fdin);
+  if (ret != 0)
+    {
+      fprintf(stderr, "throughput_test: Failed to create reader thread, error=%d\n", ret);
+      return 1;
+    }
+
+  for (nbytes = 0; nbytes < TOTAL_BYTES; nbytes += g_xfrsize)
+    {
+      ret = write(fdout, g_wrbuffer, g_xfrsize);
+      if (ret != g_xfrsize)
+        {
+          fprintf(stderr, "throughput_test: write failed, ret=%d errno=%d\n", ret, errno);
+          pthread_cancel(readerid);
+          pthread_join(readerid, &value);
+          return 2;
+        }
+    }
+
+  ret = pthread_join(readerid, &value);
+  if (ret != 0 || (int)value != 0)
+    {
+      fprintf(stderr, "throughput_test: reader failed, error=%d\n", ret);
+      return 3;
+    }
+
+  (void)clock_gettime(CLOCK_REALTIME, &end);
+
+  elapsed = (uint32_t)(end.tv_sec - start.tv_sec) * 1000 +
+            (end.tv_nsec / 1000000) - (start.tv_nsec / 1000000);
+  printf("throughput_test: %4lu byte transfers: %d bytes in %lu msec",
+         (unsigned long)g_xfrsize, TOTAL_BYTES, (unsigned long)elapsed);
+  if (elapsed > 0)
+    {
+      printf(" (%lu bytes/sec)", (unsigned long)TOTAL_BYTES * 1000 / elapsed);
+    }
+  printf("\n");
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: throughput_test
+ ****************************************************************************/
+
+int throughput_test(void)
+{
+  int filedes[2];
+  int ret = 0;
+  int i;
+
+  ret = pipe(filedes);
+  if (ret < 0)
+    {
+      fprintf(stderr, "throughput_test: pipe failed with errno=%d\n", errno);
+      return 1;
+    }
+
+  for (i = 0; i < MAX_XFRSIZE; i++)
+    {
+      g_wrbuffer[i] = (uint8_t)i;
+    }
+
+  /* Move the same amount of data through the pipe using each of the
+   * transfer sizes.
+   */
+
+  for (i = 0; i < sizeof(g_xfrsizes) / sizeof(g_xfrsizes[0]); i++)
+    {
+      g_xfrsize = g_xfrsizes[i];
+      ret = throughput_xfr(filedes[0], filedes[1]);
+      if (ret != 0)
+        {
+          break;
+        }
+    }
+
+  if (close(filedes[0]) != 0)
+    {
+      fprintf(stderr, "throughput_test: close failed: %d\n", errno);
+    }
+  if (close(filedes[1]) != 0)
+    {
+      fprintf(stderr, "throughput_test: close failed: %d\n", errno);
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_DISABLE_CLOCK */
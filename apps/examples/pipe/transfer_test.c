@@ -39,8 +39,10 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <time.h>
 #include <errno.h>
 
 #include "pipe.h"
@@ -175,9 +177,20 @@ int transfer_test(int fdin, int fdout)
   pthread_t readerid;
   pthread_t writerid;
   void *value;
+#ifndef CONFIG_DISABLE_CLOCK
+  struct timespec start;
+  struct timespec end;
+  uint32_t elapsed;
+#endif
   int tmp;
   int ret;
 
+#ifndef CONFIG_DISABLE_CLOCK
+  /* Time the whole transfer so that the pipe throughput can be compared */
+
+  (void)clock_gettime(CLOCK_REALTIME, &start);
+#endif
+
   /* Start transfer_reader thread */
 
   printf("transfer_test: Starting transfer_reader thread\n");
@@ -236,6 +249,22 @@ int transfer_test(int fdin, int fdout)
     {
       ret = tmp;
     }
+
+#ifndef CONFIG_DISABLE_CLOCK
+  (void)clock_gettime(CLOCK_REALTIME, &end);
+
+  elapsed = (uint32_t)(end.tv_sec - start.tv_sec) * 1000 +
+            (end.tv_nsec / 1000000) - (start.tv_nsec / 1000000);
+  printf("transfer_test: %d bytes in %lu msec", NWRITE_BYTES,
+         (unsigned long)elapsed);
+  if (elapsed > 0)
+    {
+      printf(" (%lu bytes/sec)",
+             (unsigned long)NWRITE_BYTES * 1000 / elapsed);
+    }
+  printf("\n");
+#endif
+
   printf("transfer_test: returning %d\n", ret);
   return ret;
 }
@@ -0,0 +1,199 @@
+/****************************************************************************
+ * examples/poll/epoll_listener.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/epoll.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <string.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <debug.h>
+
+#include "poll_internal.h"
+
+#ifdef CONFIG_FS_EPOLL
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define EPOLL_NEVENTS 2
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_listener
+ *
+ * Description:
+ *   Like poll_listener(), but the FIFO is added to an epoll interest set
+ *   once and then epoll_wait() is called in the loop.
+ *
+ ****************************************************************************/
+
+void *epoll_listener(pthread_addr_t pvarg)
+{
+  struct epoll_event ev;
+  struct epoll_event evs[EPOLL_NEVENTS];
+  char buffer[64];
+  ssize_t nbytes;
+  int epfd;
+  int ret;
+  int fd;
+  int i;
+
+  /* Open the FIFO for non-blocking read */
+
+  message("epoll_listener: Opening %s for non-blocking read\n", FIFO_PATH3);
+  fd = open(FIFO_PATH3, O_RDONLY|O_NONBLOCK);
+  if (fd < 0)
+    {
+      message("epoll_listener: ERROR Failed to open FIFO %s: %d\n",
+              FIFO_PATH3, errno);
+      return (void*)-1;
+    }
+
+  /* Create the interest set and add the FIFO to it */
+
+  epfd = epoll_create(EPOLL_NEVENTS);
+  if (epfd < 0)
+    {
+      message("epoll_listener: ERROR epoll_create failed: %d\n", errno);
+      (void)close(fd);
+      return (void*)-1;
+    }
+
+  ev.events  = EPOLLIN;
+  ev.data.fd = fd;
+
+  ret = epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+  if (ret < 0)
+    {
+      message("epoll_listener: ERROR epoll_ctl failed: %d\n", errno);
+      epoll_close(epfd);
+      (void)close(fd);
+      return (void*)-1;
+    }
+
+  /* Loop forever */
+
+  for (;;)
+    {
+      message("epoll_listener: Calling epoll_wait()\n");
+
+      ret = epoll_wait(epfd, evs, EPOLL_NEVENTS, POLL_LISTENER_DELAY);
+
+      message("\nepoll_listener: epoll_wait returned: %d\n", ret);
+      if (ret < 0)
+        {
+          message("epoll_listener: ERROR epoll_wait failed: %d\n", errno);
+        }
+      else if (ret == 0)
+        {
+          message("epoll_listener: Timeout\n");
+        }
+      else if (ret > EPOLL_NEVENTS)
+        {
+          message("epoll_listener: ERROR epoll_wait reported: %d\n", ret);
+        }
+
+      /* Read until each ready FIFO is empty */
+
+      for (i = 0; i < ret; i++)
+        {
+          if (evs[i].events != EPOLLIN || evs[i].data.fd != fd)
+            {
+              message("epoll_listener: ERROR unexpected event[%d]: %02x fd=%d\n",
+                      i, evs[i].events, evs[i].data.fd);
+              continue;
+            }
+
+          do
+            {
+              nbytes = read(evs[i].data.fd, buffer, 63);
+              if (nbytes < 0)
+                {
+                  if (errno != EAGAIN && errno != EINTR)
+                    {
+                      message("epoll_listener: read failed: %d\n", errno);
+                    }
+
+                  nbytes = 0;
+                }
+              else if (nbytes > 0)
+                {
+                  buffer[nbytes] = '\0';
+                  message("epoll_listener: Read '%s' (%d bytes)\n",
+                          buffer, nbytes);
+                }
+            }
+          while (nbytes > 0);
+        }
+
+      /* Make sure that everything is displayed */
+
+      msgflush();
+    }
+
+  /* Won't get here */
+
+  epoll_close(epfd);
+  (void)close(fd);
+  return NULL;
+}
+
+#endif /* CONFIG_FS_EPOLL */
@@ -98,6 +98,7 @@
 
 #define FIFO_PATH1 "/dev/fifo0"
 #define FIFO_PATH2 "/dev/fifo1"
+#define FIFO_PATH3 "/dev/fifo2"
 
 #define POLL_LISTENER_DELAY   2000   /* 2 seconds */
 #define SELECT_LISTENER_DELAY 4      /* 4 seconds */
@@ -121,6 +122,10 @@
 extern void *poll_listener(pthread_addr_t pvarg);
 extern void *select_listener(pthread_addr_t pvarg);
 
+#ifdef CONFIG_FS_EPOLL
+extern void *epoll_listener(pthread_addr_t pvarg);
+#endif
+
 #ifdef HAVE_NETPOLL
 extern void *net_listener(pthread_addr_t pvarg);
 extern void *net_reader(pthread_addr_t pvarg);
@@ -85,6 +85,10 @@ int poll_main(int argc, char *argv[])
   pthread_t tid2;
 #ifdef HAVE_NETPOLL
   pthread_t tid3;
+#endif
+#ifdef CONFIG_FS_EPOLL
+  pthread_t tid4;
+  int fd3 = -1;
 #endif
   int count;
   int fd1 = -1;
@@ -112,6 +116,17 @@ int poll_main(int argc, char *argv[])
       goto errout;
     }
 
+#ifdef CONFIG_FS_EPOLL
+  message("\npoll_main: Creating FIFO %s\n", FIFO_PATH3);
+  ret = mkfifo(FIFO_PATH3, 0666);
+  if (ret < 0)
+    {
+      message("poll_main: mkfifo failed: %d\n", errno);
+      exitcode = 9;
+      goto errout;
+    }
+#endif
+
   /* Open the FIFOs for blocking, write */
 
   fd1 = open(FIFO_PATH1, O_WRONLY);
@@ -132,6 +147,17 @@ int poll_main(int argc, char *argv[])
       goto errout;
     }
 
+#ifdef CONFIG_FS_EPOLL
+  fd3 = open(FIFO_PATH3, O_WRONLY);
+  if (fd3 < 0)
+    {
+      message("poll_main: Failed to open FIFO %s for writing, errno=%d\n",
+              FIFO_PATH3, errno);
+      exitcode = 10;
+      goto errout;
+    }
+#endif
+
   /* Start the listeners */
 
   message("poll_main: Starting poll_listener thread\n");
@@ -154,6 +180,18 @@ int poll_main(int argc, char *argv[])
       goto errout;
     }
 
+#ifdef CONFIG_FS_EPOLL
+  message("poll_main: Starting epoll_listener thread\n");
+
+  ret = pthread_create(&tid4, NULL, epoll_listener, NULL);
+  if (ret != 0)
+    {
+      message("poll_main: Failed to create epoll_listener thread: %d\n", ret);
+      exitcode = 11;
+      goto errout;
+    }
+#endif
+
 #ifdef HAVE_NETPOLL
 #ifdef CONFIG_NET_TCPBACKLOG
   message("poll_main: Starting net_listener thread\n");
@@ -195,6 +233,16 @@ int poll_main(int argc, char *argv[])
           goto errout;
         }
 
+#ifdef CONFIG_FS_EPOLL
+      nbytes = write(fd3, buffer, strlen(buffer));
+      if (nbytes < 0)
+        {
+          message("poll_main: Write fd3 failed: %d\n", errno);
+          exitcode = 12;
+          goto errout;
+        }
+#endif
+
       message("\npoll_main: Sent '%s' (%d bytes)\n", buffer, nbytes);
       msgflush();
 
@@ -216,6 +264,13 @@ errout:
       close(fd2);
     }
 
+#ifdef CONFIG_FS_EPOLL
+  if (fd3 >= 0)
+    {
+      close(fd3);
+    }
+#endif
+
   fflush(stdout);
   return exitcode;
 }
@@ -43,14 +43,163 @@
 #include <stdio.h>
 #include <unistd.h>
 
+#ifdef CONFIG_EXAMPLES_SERLOOP_THROUGHPUT
+#  include <stdlib.h>
+#  include <fcntl.h>
+#  include <pthread.h>
+#  include <time.h>
+#  include <errno.h>
+#endif
+
 /****************************************************************************
  * Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_EXAMPLES_SERLOOP_THROUGHPUT
+#  ifndef CONFIG_EXAMPLES_SERLOOP_DEVPATH
+#    define CONFIG_EXAMPLES_SERLOOP_DEVPATH "/dev/ttyS0"
+#  endif
+#  ifndef CONFIG_EXAMPLES_SERLOOP_NBYTES
+#    define CONFIG_EXAMPLES_SERLOOP_NBYTES 65536
+#  endif
+#  ifndef CONFIG_EXAMPLES_SERLOOP_BLOCKSIZE
+#    define CONFIG_EXAMPLES_SERLOOP_BLOCKSIZE 512
+#  endif
+#endif
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
+#ifdef CONFIG_EXAMPLES_SERLOOP_THROUGHPUT
+static uint8_t g_txbuffer[CONFIG_EXAMPLES_SERLOOP_BLOCKSIZE];
+static uint8_t g_rxbuffer[CONFIG_EXAMPLES_SERLOOP_BLOCKSIZE];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * serloop_reader
+ ****************************************************************************/
+
+#ifdef CONFIG_EXAMPLES_SERLOOP_THROUGHPUT
+static void *serloop_reader(void *arg)
+{
+  int fd = (int)((intptr_t)arg);
+  unsigned long nerrors = 0;
+  unsigned long nread = 0;
+  uint8_t expected = 0;
+  ssize_t nbytes;
+  int i;
+
+  /* Read back the looped-back data and verify the pattern */
+
+  while (nread < CONFIG_EXAMPLES_SERLOOP_NBYTES)
+    {
+      nbytes = read(fd, g_rxbuffer, CONFIG_EXAMPLES_SERLOOP_BLOCKSIZE);
+      if (nbytes < 0)
+        {
+          printf("serloop_reader: ERROR read failed: %d\n", errno);
+          nerrors++;
+          break;
+        }
+
+      for (i = 0; i < nbytes; i++)
+        {
+          if (g_rxbuffer[i] != expected)
+            {
+              nerrors++;
+            }
+
+          expected++;
+        }
+
+      nread += nbytes;
+    }
+
+  return (void *)((intptr_t)nerrors);
+}
+
+/****************************************************************************
+ * serloop_throughput
+ ****************************************************************************/
+
+static int serloop_throughput(void)
+{
+  struct timespec start;
+  struct timespec end;
+  unsigned long nwritten;
+  unsigned long msec;
+  pthread_t reader;
+  void *value;
+  ssize_t nbytes;
+  int ret;
+  int fd;
+  int i;
+
+  fd = open(CONFIG_EXAMPLES_SERLOOP_DEVPATH, O_RDWR);
+  if (fd < 0)
+    {
+      printf("serloop: ERROR failed to open %s: %d\n",
+             CONFIG_EXAMPLES_SERLOOP_DEVPATH, errno);
+      return EXIT_FAILURE;
+    }
+
+  for (i = 0; i < CONFIG_EXAMPLES_SERLOOP_BLOCKSIZE; i++)
+    {
+      g_txbuffer[i] = (uint8_t)i;
+    }
+
+  (void)clock_gettime(CLOCK_REALTIME, &start);
+
+  ret = pthread_create(&reader, NULL, serloop_reader, (void *)((intptr_t)fd));
+  if (ret != 0)
+    {
+      printf("serloop: ERROR pthread_create failed: %d\n", ret);
+      close(fd);
+      return EXIT_FAILURE;
+    }
+
+  /* Write the pattern in blocks.  The block size must be a multiple of 256
+   * for the pattern to be continuous across blocks.
+   */
+
+  for (nwritten = 0; nwritten < CONFIG_EXAMPLES_SERLOOP_NBYTES; )
+    {
+      size_t offset = nwritten % CONFIG_EXAMPLES_SERLOOP_BLOCKSIZE;
+
+      nbytes = write(fd, &g_txbuffer[offset],
+                     CONFIG_EXAMPLES_SERLOOP_BLOCKSIZE - offset);
+      if (nbytes < 0)
+        {
+          printf("serloop: ERROR write failed: %d\n", errno);
+          break;
+        }
+
+      nwritten += nbytes;
+    }
+
+  (void)pthread_join(reader, &value);
+  (void)clock_gettime(CLOCK_REALTIME, &end);
+  close(fd);
+
+  msec = (end.tv_sec - start.tv_sec) * 1000 +
+         (end.tv_nsec - start.tv_nsec) / 1000000;
+
+  printf("serloop: %lu bytes in %lu msec, %lu errors\n",
+         nwritten, msec, (unsigned long)((intptr_t)value));
+
+  if (msec > 0)
+    {
+      printf("serloop: %lu bytes/sec\n", (nwritten * 1000) / msec);
+    }
+
+  return value == NULL ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -61,7 +210,9 @@
 
 int serloop_main(int argc, char *argv[])
 {
-#ifdef CONFIG_EXAMPLES_SERLOOP_BUFIO
+#if defined(CONFIG_EXAMPLES_SERLOOP_THROUGHPUT)
+  return serloop_throughput();
+#elif defined(CONFIG_EXAMPLES_SERLOOP_BUFIO)
   int ch;
 
   for (;;)
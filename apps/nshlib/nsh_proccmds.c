@@ -45,6 +45,10 @@
 #include <sched.h>
 #include <errno.h>
 
+#ifdef CONFIG_SCHED_CPULOAD
+#  include <nuttx/clock.h>
+#endif
+
 #include "nsh.h"
 #include "nsh_console.h"
 
@@ -113,6 +117,12 @@ static const char *g_ttypenames[4] =
 static void ps_task(FAR struct tcb_s *tcb, FAR void *arg)
 {
   struct nsh_vtbl_s *vtbl = (struct nsh_vtbl_s*)arg;
+#ifdef CONFIG_SCHED_CPULOAD
+  struct cpuload_s cpuload;
+  uint32_t runtime;
+  int intpart;
+  int fracpart;
+#endif
 #if CONFIG_MAX_TASK_ARGS > 2
   int i;
 #endif
@@ -127,6 +137,43 @@ static void ps_task(FAR struct tcb_s *tcb, FAR void *arg)
              tcb->flags & TCB_FLAG_CANCEL_PENDING ? 'P' : ' ',
              g_statenames[tcb->task_state]);
 
+#ifdef CONFIG_SCHED_CPULOAD
+  /* Show the CPU load over the recent load window (in tenths of a percent)
+   * and the cumulative run time (in milliseconds).
+   */
+
+  intpart  = 0;
+  fracpart = 0;
+  runtime  = 0;
+
+  if (clock_cpuload(tcb->pid, &cpuload) == OK)
+    {
+      /* Scale the counts down so that active * 1000 cannot overflow */
+
+      while (cpuload.total > 0x003fffff)
+        {
+          cpuload.total  >>= 1;
+          cpuload.active >>= 1;
+        }
+
+      if (cpuload.total > 0)
+        {
+          int tmp  = (int)((1000 * cpuload.active) / cpuload.total);
+          intpart  = tmp / 10;
+          fracpart = tmp - 10 * intpart;
+        }
+
+#if CPULOAD_CLOCKS_PER_SEC >= 1000
+      runtime = cpuload.runtime / (CPULOAD_CLOCKS_PER_SEC / 1000);
+#else
+      runtime = cpuload.runtime * (1000 / CPULOAD_CLOCKS_PER_SEC);
+#endif
+    }
+
+  nsh_output(vtbl, "%3d.%01d%% %8lu ", intpart, fracpart,
+             (unsigned long)runtime);
+#endif
+
   /* Show task name and arguments */
 
 #if CONFIG_TASK_NAME_SIZE > 0
@@ -202,7 +249,11 @@ int cmd_exec(FAR struct nsh_vtbl_s *vtbl, int argc, char **argv)
 #ifndef CONFIG_NSH_DISABLE_PS
 int cmd_ps(FAR struct nsh_vtbl_s *vtbl, int argc, char **argv)
 {
+#ifdef CONFIG_SCHED_CPULOAD
+  nsh_output(vtbl, "PID   PRI SCHD TYPE   NP STATE    CPU    TIME(ms) NAME\n");
+#else
   nsh_output(vtbl, "PID   PRI SCHD TYPE   NP STATE    NAME\n");
+#endif
   sched_foreach(ps_task, vtbl);
   return OK;
 }
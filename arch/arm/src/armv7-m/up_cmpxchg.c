@@ -0,0 +1,96 @@
+/****************************************************************************
+ * arch/arm/src/armv7-m/up_cmpxchg.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <nuttx/arch.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_cmpxchg16
+ *
+ * Description:
+ *   Atomically compare the 16-bit value at addr with oldval and, if they
+ *   are equal, replace it with newval.  The exclusive monitor is cleared on
+ *   exception entry and return so the store fails (and is retried) if an
+ *   interrupt handler runs between the load and the store.
+ *
+ ****************************************************************************/
+
+bool up_cmpxchg16(FAR volatile int16_t *addr, int16_t oldval,
+                  int16_t newval)
+{
+  uint32_t curval;
+  uint32_t status;
+
+  do
+    {
+      __asm__ __volatile__
+      (
+        "\tldrexh %0, [%1]\n"
+        : "=&r" (curval)
+        : "r" (addr)
+        : "memory"
+      );
+
+      if ((int16_t)curval != oldval)
+        {
+          __asm__ __volatile__ ("\tclrex\n" : : : "memory");
+          return false;
+        }
+
+      __asm__ __volatile__
+      (
+        "\tstrexh %0, %2, [%1]\n"
+        : "=&r" (status)
+        : "r" (addr), "r" ((uint32_t)(uint16_t)newval)
+        : "memory"
+      );
+    }
+  while (status != 0);
+
+  __asm__ __volatile__ ("\tdmb\n" : : : "memory");
+  return true;
+}
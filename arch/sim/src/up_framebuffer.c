@@ -42,8 +42,10 @@
 #include <stdint.h>
 #include <string.h>
 #include <errno.h>
+#include <syslog.h>
 #include <debug.h>
 
+#include <nuttx/clock.h>
 #include <nuttx/fb.h>
 #include "up_internal.h"
 
@@ -111,6 +113,12 @@ static int up_putcmap(FAR struct fb_vtable_s *vtable, FAR const struct fb_cmap_s
 #ifdef CONFIG_FB_HWCURSOR
 static int up_getcursor(FAR struct fb_vtable_s *vtable, FAR struct fb_cursorattrib_s *attrib);
 static int up_setcursor(FAR struct fb_vtable_s *vtable, FAR struct fb_setcursor_s *setttings);
+#endif
+
+  /* The following is provided only if the display must be told about updates */
+
+#ifdef CONFIG_FB_UPDATE
+static int up_updatearea(FAR struct fb_vtable_s *vtable, FAR const struct fb_area_s *area);
 #endif
 
 /****************************************************************************
@@ -177,12 +185,32 @@ struct fb_vtable_s g_fbobject =
   .getcursor     = up_getcursor,
   .setcursor     = up_setcursor,
 #endif
+#ifdef CONFIG_FB_UPDATE
+  .updatearea    = up_updatearea,
+#endif
 };
 
+#ifdef CONFIG_SIM_FBSTATS
+/* Update statistics for the current one second interval */
+
+static uint32_t g_fbstart;  /* Time of the start of the interval */
+static uint32_t g_fbtick;   /* Time of the last update */
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
+#ifdef CONFIG_SIM_FBSTATS
+/* Update statistics for the last complete one second interval.  Updates
+ * reported within the same system timer tick are counted as one frame.
+ */
+
+uint32_t g_fbframes;        /* Number of frames */
+uint32_t g_fbareas;         /* Number of updated areas */
+uint32_t g_fbbytes;         /* Number of bytes flushed to the display */
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -340,6 +368,65 @@ static int up_setcursor(FAR struct fb_vtable_s *vtable,
 }
 #endif
 
+/****************************************************************************
+ * Name: up_updatearea
+ ****************************************************************************/
+
+#ifdef CONFIG_FB_UPDATE
+static int up_updatearea(FAR struct fb_vtable_s *vtable,
+                         FAR const struct fb_area_s *area)
+{
+#ifdef CONFIG_SIM_FBSTATS
+  static uint32_t nframes;
+  static uint32_t nareas;
+  static uint32_t nbytes;
+  uint32_t now;
+#endif
+
+  if (!vtable || !area)
+    {
+      dbg("Returning EINVAL\n");
+      return -EINVAL;
+    }
+
+#ifdef CONFIG_SIM_FBSTATS
+  /* Updates reported within the same tick belong to the same frame */
+
+  now = clock_systimer();
+  if (nareas == 0 || now != g_fbtick)
+    {
+      nframes++;
+      g_fbtick = now;
+    }
+
+  nareas++;
+  nbytes += (((uint32_t)area->w * CONFIG_SIM_FBBPP + 7) >> 3) * area->h;
+
+  /* Publish and report the statistics once per second */
+
+  if (now - g_fbstart >= TICK_PER_SEC)
+    {
+      g_fbframes = nframes;
+      g_fbareas  = nareas;
+      g_fbbytes  = nbytes;
+
+      lowsyslog("fb: %u frames/s %u areas/s %u bytes/s\n",
+                nframes, nareas, nbytes);
+
+      g_fbstart  = now;
+      nframes    = 0;
+      nareas     = 0;
+      nbytes     = 0;
+    }
+#endif
+
+#ifdef CONFIG_SIM_X11FB
+  up_x11updatearea(area->x, area->y, area->w, area->h);
+#endif
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
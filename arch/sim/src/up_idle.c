@@ -64,9 +64,6 @@ static int g_x11refresh = 0;
 
 #if defined(CONFIG_SIM_WALLTIME) || defined(CONFIG_SIM_X11FB)
 extern int up_hostusleep(unsigned int usec);
-#ifdef CONFIG_SIM_X11FB
-extern void up_x11update(void);
-#endif
 #endif
 
 /****************************************************************************
@@ -106,6 +103,12 @@ void up_idle(void)
   uipdriver_loop();
 #endif
 
+  /* Run the loopback serial device if enabled */
+
+#ifdef CONFIG_SIM_LOOPSERIAL
+  up_loopserial_loop();
+#endif
+
   /* Fake some power management stuff for testing purposes */
 
 #ifdef CONFIG_PM
@@ -145,12 +148,15 @@ void up_idle(void)
         }
 #endif
 
-      /* Update the display periodically */
+      /* Update the display periodically.  Only the areas reported through
+       * the framebuffer updatearea() method are redrawn if the graphics
+       * system reports them.
+       */
 
       g_x11refresh += 1000000 / CLK_TCK;
       if (g_x11refresh > 500000)
         {
-          up_x11update();
+          up_x11present();
         }
     }
 #endif
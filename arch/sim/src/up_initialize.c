@@ -127,6 +127,10 @@ void up_initialize(void)
   up_registerblockdevice(); /* Our FAT ramdisk at /dev/ram0 */
 #endif
 
+#ifdef CONFIG_SIM_LOOPSERIAL
+  up_loopserial_register(); /* Loopback serial device at /dev/ttyS0 */
+#endif
+
 #ifdef CONFIG_NET
   uipdriver_init();         /* Our "real" network driver */
 #endif
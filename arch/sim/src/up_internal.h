@@ -158,6 +158,13 @@ extern void up_longjmp(int *jb, int val) noreturn_function;
 extern void up_devconsole(void);
 extern void up_registerblockdevice(void);
 
+/* up_loopserial.c ********************************************************/
+
+#ifdef CONFIG_SIM_LOOPSERIAL
+extern void up_loopserial_register(void);
+extern void up_loopserial_loop(void);
+#endif
+
 /* up_deviceimage.c *******************************************************/
 
 extern char *up_deviceimage(void);
@@ -184,6 +191,10 @@ extern int up_x11cmap(unsigned short first, unsigned short len,
                       unsigned char *red, unsigned char *green,
                       unsigned char *blue, unsigned char  *transp);
 #endif
+extern void up_x11update(void);
+extern void up_x11updatearea(unsigned short x, unsigned short y,
+                             unsigned short w, unsigned short h);
+extern void up_x11present(void);
 #endif
 
 /* up_eventloop.c ***********************************************************/
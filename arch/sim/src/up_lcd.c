@@ -43,10 +43,12 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
+#include <syslog.h>
 #include <errno.h>
 #include <debug.h>
 
 #include <nuttx/arch.h>
+#include <nuttx/clock.h>
 #include <nuttx/lcd/lcd.h>
 
 /****************************************************************************
@@ -147,6 +149,15 @@ static int sim_putrun(fb_coord_t row, fb_coord_t col, FAR const uint8_t *buffer,
                       size_t npixels);
 static int sim_getrun(fb_coord_t row, fb_coord_t col, FAR uint8_t *buffer,
                       size_t npixels);
+#ifndef CONFIG_SIM_LCDNOAREA
+static int sim_putarea(fb_coord_t row, fb_coord_t col, fb_coord_t nrows,
+                       size_t npixels, FAR const uint8_t *buffer, size_t stride);
+static int sim_getarea(fb_coord_t row, fb_coord_t col, fb_coord_t nrows,
+                       size_t npixels, FAR uint8_t *buffer, size_t stride);
+#endif
+#ifdef CONFIG_SIM_LCDSTATS
+static void sim_transaction(size_t npixels);
+#endif
 
 /* LCD Configuration */
 
@@ -207,6 +218,10 @@ static const struct lcd_planeinfo_s g_planeinfo =
 {
   .putrun = sim_putrun,            /* Put a run into LCD memory */
   .getrun = sim_getrun,            /* Get a run from LCD memory */
+#ifndef CONFIG_SIM_LCDNOAREA
+  .putarea = sim_putarea,          /* Put an area into LCD memory */
+  .getarea = sim_getarea,          /* Get an area from LCD memory */
+#endif
   .buffer = (uint8_t*)g_runbuffer, /* Run scratch buffer */
   .bpp    = CONFIG_SIM_FBBPP,      /* Bits-per-pixel */
 };
@@ -234,10 +249,65 @@ static struct sim_dev_s g_lcddev =
   },
 };
 
+#ifdef CONFIG_SIM_LCDSTATS
+static uint32_t g_lcdstart;        /* Start of the current one second interval */
+#endif
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_LCDSTATS
+/* Transfer statistics for the last complete one second interval.  Each
+ * call to putrun, getrun, putarea, or getarea is one transaction:  One
+ * window set-up on real LCD hardware.
+ */
+
+uint32_t g_lcdtransactions;        /* Number of transactions */
+uint32_t g_lcdpixels;              /* Number of pixels transferred */
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name:  sim_transaction
+ *
+ * Description:
+ *   Count one LCD transaction and report the transaction and pixel rates
+ *   once per second.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SIM_LCDSTATS
+static void sim_transaction(size_t npixels)
+{
+  static uint32_t ntransactions;
+  static uint32_t npixtotal;
+  uint32_t now;
+
+  ntransactions++;
+  npixtotal += npixels;
+
+  now = clock_systimer();
+  if (now - g_lcdstart >= TICK_PER_SEC)
+    {
+      g_lcdtransactions = ntransactions;
+      g_lcdpixels       = npixtotal;
+
+      lowsyslog("lcd: %u transactions/s %u pixels/s\n",
+                ntransactions, npixtotal);
+
+      g_lcdstart        = now;
+      ntransactions     = 0;
+      npixtotal         = 0;
+    }
+}
+#else
+#  define sim_transaction(n)
+#endif
+
 /****************************************************************************
  * Name:  sim_putrun
  *
@@ -256,6 +326,7 @@ static int sim_putrun(fb_coord_t row, fb_coord_t col, FAR const uint8_t *buffer,
                        size_t npixels)
 {
   lcddbg("row: %d col: %d npixels: %d\n", row, col, npixels);
+  sim_transaction(npixels);
   return OK;
 }
 
@@ -277,8 +348,61 @@ static int sim_getrun(fb_coord_t row, fb_coord_t col, FAR uint8_t *buffer,
                        size_t npixels)
 {
   lcddbg("row: %d col: %d npixels: %d\n", row, col, npixels);
+  sim_transaction(npixels);
+  return -ENOSYS;
+}
+
+/****************************************************************************
+ * Name:  sim_putarea
+ *
+ * Description:
+ *   This method can be used to write a rectangular area to the LCD:
+ *
+ *   row     - Starting row to write to (range: 0 <= row <= yres-nrows)
+ *   col     - Starting column to write to (range: 0 <= col <= xres-npixels)
+ *   nrows   - The number of rows to write (range: 0 < nrows <= yres-row)
+ *   npixels - The number of pixels to write in each row
+ *             (range: 0 < npixels <= xres-col)
+ *   buffer  - The buffer containing the first row of the area
+ *   stride  - Distance in bytes between rows in the buffer (0: repeat the run)
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_SIM_LCDNOAREA
+static int sim_putarea(fb_coord_t row, fb_coord_t col, fb_coord_t nrows,
+                       size_t npixels, FAR const uint8_t *buffer, size_t stride)
+{
+  lcddbg("row: %d col: %d nrows: %d npixels: %d\n", row, col, nrows, npixels);
+  sim_transaction(nrows * npixels);
+  return OK;
+}
+#endif
+
+/****************************************************************************
+ * Name:  sim_getarea
+ *
+ * Description:
+ *   This method can be used to read a rectangular area from the LCD:
+ *
+ *   row     - Starting row to read from (range: 0 <= row <= yres-nrows)
+ *   col     - Starting column to read from (range: 0 <= col <= xres-npixels)
+ *   nrows   - The number of rows to read (range: 0 < nrows <= yres-row)
+ *   npixels - The number of pixels to read in each row
+ *             (range: 0 < npixels <= xres-col)
+ *   buffer  - The buffer in which to return the area read from the LCD
+ *   stride  - Distance in bytes between rows in the buffer
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_SIM_LCDNOAREA
+static int sim_getarea(fb_coord_t row, fb_coord_t col, fb_coord_t nrows,
+                       size_t npixels, FAR uint8_t *buffer, size_t stride)
+{
+  lcddbg("row: %d col: %d nrows: %d npixels: %d\n", row, col, nrows, npixels);
+  sim_transaction(nrows * npixels);
   return -ENOSYS;
 }
+#endif
 
 /****************************************************************************
  * Name:  sim_getvideoinfo
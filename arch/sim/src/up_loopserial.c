@@ -0,0 +1,497 @@
+/****************************************************************************
+ * arch/sim/src/up_loopserial.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/serial/serial.h>
+
+#include "up_internal.h"
+
+#ifdef CONFIG_SIM_LOOPSERIAL
+
+/****************************************************************************
+ * Private Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_SIM_LOOPSERIAL_RXBUFSIZE
+#  define CONFIG_SIM_LOOPSERIAL_RXBUFSIZE 256
+#endif
+
+#ifndef CONFIG_SIM_LOOPSERIAL_TXBUFSIZE
+#  define CONFIG_SIM_LOOPSERIAL_TXBUFSIZE 256
+#endif
+
+/* Size of the simulated hardware FIFO used when DMA is not enabled */
+
+#define LOOPSERIAL_FIFOSIZE 16
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct loopserial_s
+{
+  bool     txint;       /* TX "interrupt" enabled */
+  bool     rxint;       /* RX "interrupt" enabled */
+  bool     rxactive;    /* Data received since the line was last idle */
+#ifdef CONFIG_SIM_LOOPSERIAL_DMA
+  bool     txdma;       /* TX DMA transfer in progress */
+  bool     rxdma;       /* RX DMA transfer in progress */
+#else
+  uint8_t  head;        /* FIFO head index */
+  uint8_t  tail;        /* FIFO tail index */
+  uint8_t  count;       /* Number of bytes in the FIFO */
+  char     fifo[LOOPSERIAL_FIFOSIZE];
+#endif
+  uint32_t nxfers;      /* Number of simulated interrupts/DMA completions */
+  uint32_t nbytes;      /* Number of bytes looped back */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int  loopserial_setup(FAR struct uart_dev_s *dev);
+static void loopserial_shutdown(FAR struct uart_dev_s *dev);
+static int  loopserial_attach(FAR struct uart_dev_s *dev);
+static void loopserial_detach(FAR struct uart_dev_s *dev);
+static int  loopserial_ioctl(FAR struct file *filep, int cmd,
+                             unsigned long arg);
+static int  loopserial_receive(FAR struct uart_dev_s *dev,
+                               FAR unsigned int *status);
+static void loopserial_rxint(FAR struct uart_dev_s *dev, bool enable);
+static bool loopserial_rxavailable(FAR struct uart_dev_s *dev);
+static void loopserial_send(FAR struct uart_dev_s *dev, int ch);
+static void loopserial_txint(FAR struct uart_dev_s *dev, bool enable);
+static bool loopserial_txready(FAR struct uart_dev_s *dev);
+static bool loopserial_txempty(FAR struct uart_dev_s *dev);
+#ifdef CONFIG_SIM_LOOPSERIAL_DMA
+static void loopserial_dmasend(FAR struct uart_dev_s *dev);
+static void loopserial_dmareceive(FAR struct uart_dev_s *dev);
+static void loopserial_dmarxfree(FAR struct uart_dev_s *dev);
+static void loopserial_dmatxavail(FAR struct uart_dev_s *dev);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct uart_ops_s g_loopserial_ops =
+{
+  .setup          = loopserial_setup,
+  .shutdown       = loopserial_shutdown,
+  .attach         = loopserial_attach,
+  .detach         = loopserial_detach,
+  .ioctl          = loopserial_ioctl,
+  .receive        = loopserial_receive,
+  .rxint          = loopserial_rxint,
+  .rxavailable    = loopserial_rxavailable,
+  .send           = loopserial_send,
+  .txint          = loopserial_txint,
+  .txready        = loopserial_txready,
+  .txempty        = loopserial_txempty,
+#ifdef CONFIG_SIM_LOOPSERIAL_DMA
+  .dmasend        = loopserial_dmasend,
+  .dmareceive     = loopserial_dmareceive,
+  .dmarxfree      = loopserial_dmarxfree,
+  .dmatxavail     = loopserial_dmatxavail,
+#endif
+};
+
+static char g_loopserial_rxbuffer[CONFIG_SIM_LOOPSERIAL_RXBUFSIZE];
+static char g_loopserial_txbuffer[CONFIG_SIM_LOOPSERIAL_TXBUFSIZE];
+
+static struct loopserial_s g_loopserial_priv;
+
+static uart_dev_t g_loopserial_dev =
+{
+  .recv     =
+  {
+    .size   = CONFIG_SIM_LOOPSERIAL_RXBUFSIZE,
+    .buffer = g_loopserial_rxbuffer,
+  },
+  .xmit     =
+  {
+    .size   = CONFIG_SIM_LOOPSERIAL_TXBUFSIZE,
+    .buffer = g_loopserial_txbuffer,
+  },
+  .ops      = &g_loopserial_ops,
+  .priv     = &g_loopserial_priv,
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int loopserial_setup(FAR struct uart_dev_s *dev)
+{
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+
+  memset(priv, 0, sizeof(struct loopserial_s));
+  return OK;
+}
+
+static void loopserial_shutdown(FAR struct uart_dev_s *dev)
+{
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+
+  dbg("transfers: %lu bytes: %lu\n",
+      (unsigned long)priv->nxfers, (unsigned long)priv->nbytes);
+}
+
+static int loopserial_attach(FAR struct uart_dev_s *dev)
+{
+  return OK;
+}
+
+static void loopserial_detach(FAR struct uart_dev_s *dev)
+{
+}
+
+static int loopserial_ioctl(FAR struct file *filep, int cmd,
+                            unsigned long arg)
+{
+  return -ENOTTY;
+}
+
+static void loopserial_rxint(FAR struct uart_dev_s *dev, bool enable)
+{
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+  priv->rxint = enable;
+}
+
+static void loopserial_txint(FAR struct uart_dev_s *dev, bool enable)
+{
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+  priv->txint = enable;
+}
+
+#ifndef CONFIG_SIM_LOOPSERIAL_DMA
+static int loopserial_receive(FAR struct uart_dev_s *dev,
+                              FAR unsigned int *status)
+{
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+  int ch;
+
+  *status = 0;
+  if (priv->count == 0)
+    {
+      return 0;
+    }
+
+  ch = priv->fifo[priv->tail];
+  if (++priv->tail >= LOOPSERIAL_FIFOSIZE)
+    {
+      priv->tail = 0;
+    }
+
+  priv->count--;
+  return ch;
+}
+
+static bool loopserial_rxavailable(FAR struct uart_dev_s *dev)
+{
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+  int16_t nexthead;
+
+  /* Emulate hardware flow control:  Only report data available if there is
+   * space to accept it in the RX buffer.  Otherwise, data would be lost.
+   */
+
+  nexthead = dev->recv.head + 1;
+  if (nexthead >= dev->recv.size)
+    {
+      nexthead = 0;
+    }
+
+  return priv->count > 0 && nexthead != dev->recv.tail;
+}
+
+static void loopserial_send(FAR struct uart_dev_s *dev, int ch)
+{
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+
+  priv->fifo[priv->head] = ch;
+  if (++priv->head >= LOOPSERIAL_FIFOSIZE)
+    {
+      priv->head = 0;
+    }
+
+  priv->count++;
+  priv->nbytes++;
+}
+
+static bool loopserial_txready(FAR struct uart_dev_s *dev)
+{
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+  return priv->count < LOOPSERIAL_FIFOSIZE;
+}
+
+static bool loopserial_txempty(FAR struct uart_dev_s *dev)
+{
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+  return priv->count == 0;
+}
+
+#else /* CONFIG_SIM_LOOPSERIAL_DMA */
+
+/* The byte-at-a-time methods are not used when DMA is enabled */
+
+static int loopserial_receive(FAR struct uart_dev_s *dev,
+                              FAR unsigned int *status)
+{
+  *status = 0;
+  return 0;
+}
+
+static bool loopserial_rxavailable(FAR struct uart_dev_s *dev)
+{
+  return false;
+}
+
+static void loopserial_send(FAR struct uart_dev_s *dev, int ch)
+{
+}
+
+static bool loopserial_txready(FAR struct uart_dev_s *dev)
+{
+  return false;
+}
+
+static bool loopserial_txempty(FAR struct uart_dev_s *dev)
+{
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+  return !priv->txdma;
+}
+
+static void loopserial_dmasend(FAR struct uart_dev_s *dev)
+{
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+  priv->txdma = true;
+}
+
+static void loopserial_dmareceive(FAR struct uart_dev_s *dev)
+{
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+  priv->rxdma = true;
+}
+
+static void loopserial_dmarxfree(FAR struct uart_dev_s *dev)
+{
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+
+  if (!priv->rxdma)
+    {
+      uart_recvchars_dma(dev);
+    }
+}
+
+static void loopserial_dmatxavail(FAR struct uart_dev_s *dev)
+{
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+
+  if (!priv->txdma)
+    {
+      uart_xmitchars_dma(dev);
+    }
+}
+
+/****************************************************************************
+ * Name: loopserial_copy
+ *
+ * Description:
+ *   Copy as much as possible from the regions described by the TX DMA
+ *   transfer to the regions described by the RX DMA transfer.  Returns the
+ *   number of bytes copied.
+ *
+ ****************************************************************************/
+
+static size_t loopserial_copy(FAR struct uart_dmaxfer_s *tx,
+                              FAR struct uart_dmaxfer_s *rx)
+{
+  size_t txlen = tx->length + tx->nlength;
+  size_t rxlen = rx->length + rx->nlength;
+  size_t total = txlen < rxlen ? txlen : rxlen;
+  size_t ncopied = 0;
+
+  while (ncopied < total)
+    {
+      FAR const char *src;
+      FAR char *dest;
+      size_t srclen;
+      size_t destlen;
+      size_t nbytes;
+
+      /* Get the source span */
+
+      if (ncopied < tx->length)
+        {
+          src    = tx->buffer + ncopied;
+          srclen = tx->length - ncopied;
+        }
+      else
+        {
+          src    = tx->nbuffer + (ncopied - tx->length);
+          srclen = txlen - ncopied;
+        }
+
+      /* Get the destination span */
+
+      if (ncopied < rx->length)
+        {
+          dest    = rx->buffer + ncopied;
+          destlen = rx->length - ncopied;
+        }
+      else
+        {
+          dest    = rx->nbuffer + (ncopied - rx->length);
+          destlen = rxlen - ncopied;
+        }
+
+      nbytes = srclen < destlen ? srclen : destlen;
+      memcpy(dest, src, nbytes);
+      ncopied += nbytes;
+    }
+
+  return ncopied;
+}
+#endif /* CONFIG_SIM_LOOPSERIAL_DMA */
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_loopserial_register
+ *
+ * Description:
+ *   Register the simulated loopback serial device.
+ *
+ ****************************************************************************/
+
+void up_loopserial_register(void)
+{
+  (void)uart_register("/dev/ttyS0", &g_loopserial_dev);
+}
+
+/****************************************************************************
+ * Name: up_loopserial_loop
+ *
+ * Description:
+ *   Called from the IDLE loop to simulate the UART interrupt.  Data sent on
+ *   the device is looped back and received on the same device.
+ *
+ ****************************************************************************/
+
+void up_loopserial_loop(void)
+{
+  FAR uart_dev_t *dev = &g_loopserial_dev;
+  FAR struct loopserial_s *priv = (FAR struct loopserial_s *)dev->priv;
+
+#ifdef CONFIG_SIM_LOOPSERIAL_DMA
+  /* Complete both DMA transfers when they are both in progress.  This
+   * simulates one TX and one RX DMA completion interrupt.
+   */
+
+  if (priv->txdma && priv->rxdma)
+    {
+      size_t nbytes = loopserial_copy(&dev->dmatx, &dev->dmarx);
+
+      priv->nxfers++;
+      priv->nbytes += nbytes;
+
+      dev->dmatx.nbytes = nbytes;
+      priv->txdma = false;
+      uart_xmitchars_done(dev);
+
+      dev->dmarx.nbytes = nbytes;
+      priv->rxdma = false;
+      uart_recvchars_done(dev);
+
+      /* Restart the transfers if there is more to do */
+
+      uart_recvchars_dma(dev);
+      uart_xmitchars_dma(dev);
+      priv->rxactive = true;
+    }
+#else
+  /* Simulate the TX interrupt:  Move data from the TX buffer to the FIFO */
+
+  if (priv->txint && priv->count < LOOPSERIAL_FIFOSIZE &&
+      dev->xmit.head != dev->xmit.tail)
+    {
+      priv->nxfers++;
+      uart_xmitchars(dev);
+    }
+
+  /* Simulate the RX interrupt:  Move data from the FIFO to the RX buffer */
+
+  if (priv->rxint && loopserial_rxavailable(dev))
+    {
+      priv->nxfers++;
+      uart_recvchars(dev);
+      priv->rxactive = true;
+    }
+#endif
+
+#ifdef CONFIG_SERIAL_TERMIOS
+  /* Simulate the idle line interrupt:  Nothing more is in flight after some
+   * data was received.
+   */
+
+#ifdef CONFIG_SIM_LOOPSERIAL_DMA
+  if (priv->rxactive && !priv->txdma)
+#else
+  if (priv->rxactive && priv->count == 0 && dev->xmit.head == dev->xmit.tail)
+#endif
+    {
+      priv->rxactive = false;
+      uart_recvidle(dev);
+    }
+#endif
+}
+
+#endif /* CONFIG_SIM_LOOPSERIAL */
@@ -90,6 +90,16 @@ static unsigned short g_fbpixelheight;
 static int g_shmcheckpoint = 0;
 static int b_useshm;
 
+/* Bounding box of the areas updated since the last presentation.  Once any
+ * area has been reported, only the updated areas are sent to the X server.
+ */
+
+static int g_x11partial;
+static unsigned short g_x11dirtyx1;
+static unsigned short g_x11dirtyy1;
+static unsigned short g_x11dirtyx2;
+static unsigned short g_x11dirtyy2;
+
 /****************************************************************************
  * Name: up_x11createframe
  ***************************************************************************/
@@ -475,3 +485,114 @@ void up_x11update(void)
     }
   XSync(g_display, 0);
 }
+
+/****************************************************************************
+ * Name: up_x11updatearea
+ *
+ * Description:
+ *   Add an area to the region that must be sent to the X server on the
+ *   next call to up_x11present().
+ *
+ ***************************************************************************/
+
+void up_x11updatearea(unsigned short x, unsigned short y,
+                      unsigned short w, unsigned short h)
+{
+  unsigned short x2 = x + w;
+  unsigned short y2 = y + h;
+
+  if (w == 0 || h == 0)
+    {
+      return;
+    }
+
+  if (x2 > g_fbpixelwidth)
+    {
+      x2 = g_fbpixelwidth;
+    }
+
+  if (y2 > g_fbpixelheight)
+    {
+      y2 = g_fbpixelheight;
+    }
+
+  if (g_x11dirtyx1 >= g_x11dirtyx2 || g_x11dirtyy1 >= g_x11dirtyy2)
+    {
+      g_x11dirtyx1 = x;
+      g_x11dirtyy1 = y;
+      g_x11dirtyx2 = x2;
+      g_x11dirtyy2 = y2;
+    }
+  else
+    {
+      if (x < g_x11dirtyx1)
+        {
+          g_x11dirtyx1 = x;
+        }
+
+      if (y < g_x11dirtyy1)
+        {
+          g_x11dirtyy1 = y;
+        }
+
+      if (x2 > g_x11dirtyx2)
+        {
+          g_x11dirtyx2 = x2;
+        }
+
+      if (y2 > g_x11dirtyy2)
+        {
+          g_x11dirtyy2 = y2;
+        }
+    }
+
+  g_x11partial = 1;
+}
+
+/****************************************************************************
+ * Name: up_x11present
+ *
+ * Description:
+ *   Send the updated part of the framebuffer to the X server.  The whole
+ *   framebuffer is sent if no updated areas have ever been reported.
+ *
+ ***************************************************************************/
+
+void up_x11present(void)
+{
+  unsigned short w;
+  unsigned short h;
+
+  if (!g_x11partial)
+    {
+      up_x11update();
+      return;
+    }
+
+  if (g_x11dirtyx1 >= g_x11dirtyx2 || g_x11dirtyy1 >= g_x11dirtyy2)
+    {
+      return;
+    }
+
+  w = g_x11dirtyx2 - g_x11dirtyx1;
+  h = g_x11dirtyy2 - g_x11dirtyy1;
+
+#ifndef CONFIG_SIM_X11NOSHM
+  if (b_useshm)
+    {
+      XShmPutImage(g_display, g_window, g_gc, g_image,
+                   g_x11dirtyx1, g_x11dirtyy1, g_x11dirtyx1, g_x11dirtyy1,
+                   w, h, 0);
+    }
+  else
+#endif
+    {
+      XPutImage(g_display, g_window, g_gc, g_image,
+                g_x11dirtyx1, g_x11dirtyy1, g_x11dirtyx1, g_x11dirtyy1,
+                w, h);
+    }
+
+  XSync(g_display, 0);
+  g_x11dirtyx1 = g_x11dirtyx2 = 0;
+  g_x11dirtyy1 = g_x11dirtyy2 = 0;
+}
@@ -305,6 +305,12 @@ static int mio283qt2_putrun(fb_coord_t row, fb_coord_t col, FAR const uint8_t *b
              size_t npixels);
 static int mio283qt2_getrun(fb_coord_t row, fb_coord_t col, FAR uint8_t *buffer,
              size_t npixels);
+static int mio283qt2_putarea(fb_coord_t row, fb_coord_t col, fb_coord_t nrows,
+             size_t npixels, FAR const uint8_t *buffer, size_t stride);
+#ifndef CONFIG_LCD_NOGETRUN
+static int mio283qt2_getarea(fb_coord_t row, fb_coord_t col, fb_coord_t nrows,
+             size_t npixels, FAR uint8_t *buffer, size_t stride);
+#endif
 
 /* LCD Configuration */
 
@@ -619,6 +625,129 @@ static int mio283qt2_getrun(fb_coord_t row, fb_coord_t col, FAR uint8_t *buffer,
 #endif
 }
 
+/**************************************************************************************
+ * Name:  mio283qt2_putarea
+ *
+ * Description:
+ *   This method can be used to write a rectangular area to the LCD.  The LCD window
+ *   is set up once and then all of the pixels are written in one burst:
+ *
+ *   row     - Starting row to write to (range: 0 <= row <= yres-nrows)
+ *   col     - Starting column to write to (range: 0 <= col <= xres-npixels)
+ *   nrows   - The number of rows to write (range: 0 < nrows <= yres-row)
+ *   npixels - The number of pixels to write in each row
+ *             (range: 0 < npixels <= xres-col)
+ *   buffer  - The buffer containing the first row of the area
+ *   stride  - Distance in bytes between rows in the buffer (0: repeat the run)
+ *
+ **************************************************************************************/
+
+static int mio283qt2_putarea(fb_coord_t row, fb_coord_t col, fb_coord_t nrows,
+                             size_t npixels, FAR const uint8_t *buffer, size_t stride)
+{
+  FAR struct mio283qt2_dev_s *priv = &g_lcddev;
+  FAR struct mio283qt2_lcd_s *lcd = priv->lcd;
+  FAR const uint16_t *src;
+  int i;
+  int j;
+
+  /* Buffer must be provided and aligned to a 16-bit address boundary */
+
+  lcdvdbg("row: %d col: %d nrows: %d npixels: %d\n", row, col, nrows, npixels);
+  DEBUGASSERT(buffer && ((uintptr_t)buffer & 1) == 0 && (stride & 1) == 0);
+
+  /* Select the LCD */
+
+  lcd->select(lcd);
+
+  /* Set the window to the area.  The GRAM address then advances through the
+   * window row by row so that the whole area can be written in one burst.
+   */
+
+  mio283qt2_setarea(lcd, col, row, col + npixels - 1, row + nrows - 1);
+  mio283qt2_gramselect(lcd);
+
+  for (i = 0; i < nrows; i++)
+    {
+      src = (FAR const uint16_t*)buffer;
+      for (j = 0; j < npixels; j++)
+        {
+          mio283qt2_gramwrite(lcd, *src);
+          src++;
+        }
+
+      buffer += stride;
+    }
+
+  /* De-select the LCD */
+
+  lcd->deselect(lcd);
+  return OK;
+}
+
+/**************************************************************************************
+ * Name:  mio283qt2_getarea
+ *
+ * Description:
+ *   This method can be used to read a rectangular area from the LCD in one burst:
+ *
+ *   row     - Starting row to read from (range: 0 <= row <= yres-nrows)
+ *   col     - Starting column to read from (range: 0 <= col <= xres-npixels)
+ *   nrows   - The number of rows to read (range: 0 < nrows <= yres-row)
+ *   npixels - The number of pixels to read in each row
+ *             (range: 0 < npixels <= xres-col)
+ *   buffer  - The buffer in which to return the area read from the LCD
+ *   stride  - Distance in bytes between rows in the buffer
+ *
+ **************************************************************************************/
+
+#ifndef CONFIG_LCD_NOGETRUN
+static int mio283qt2_getarea(fb_coord_t row, fb_coord_t col, fb_coord_t nrows,
+                             size_t npixels, FAR uint8_t *buffer, size_t stride)
+{
+  FAR struct mio283qt2_dev_s *priv = &g_lcddev;
+  FAR struct mio283qt2_lcd_s *lcd = priv->lcd;
+  FAR uint16_t *dest;
+  uint16_t accum;
+  int i;
+  int j;
+
+  /* Buffer must be provided and aligned to a 16-bit address boundary */
+
+  lcdvdbg("row: %d col: %d nrows: %d npixels: %d\n", row, col, nrows, npixels);
+  DEBUGASSERT(buffer && ((uintptr_t)buffer & 1) == 0 && (stride & 1) == 0);
+
+  /* Select the LCD */
+
+  lcd->select(lcd);
+
+  /* Read the area from GRAM. */
+
+  mio283qt2_setarea(lcd, col, row, col + npixels - 1, row + nrows - 1);
+  mio283qt2_gramselect(lcd);
+
+  /* Prime the pump for unaligned read data */
+
+  mio283qt2_readsetup(lcd, &accum);
+
+  for (i = 0; i < nrows; i++)
+    {
+      dest = (FAR uint16_t*)buffer;
+      for (j = 0; j < npixels; j++)
+        {
+          *dest++ = mio283qt2_gramread(lcd, &accum);
+        }
+
+      buffer += stride;
+    }
+
+  /* De-select the LCD */
+
+  lcd->deselect(lcd);
+  return OK;
+}
+#endif
+
 /**************************************************************************************
  * Name:  mio283qt2_getvideoinfo
  *
@@ -657,10 +786,16 @@ static int mio283qt2_getplaneinfo(FAR struct lcd_dev_s *dev, unsigned int planen
   DEBUGASSERT(dev && pinfo && planeno == 0);
   lcdvdbg("planeno: %d bpp: %d\n", planeno, MIO283QT2_BPP);
 
-  pinfo->putrun = mio283qt2_putrun;          /* Put a run into LCD memory */
-  pinfo->getrun = mio283qt2_getrun;          /* Get a run from LCD memory */
-  pinfo->buffer = (uint8_t*)priv->runbuffer; /* Run scratch buffer */
-  pinfo->bpp    = MIO283QT2_BPP;             /* Bits-per-pixel */
+  pinfo->putrun  = mio283qt2_putrun;         /* Put a run into LCD memory */
+  pinfo->getrun  = mio283qt2_getrun;         /* Get a run from LCD memory */
+  pinfo->putarea = mio283qt2_putarea;        /* Put an area into LCD memory */
+#ifndef CONFIG_LCD_NOGETRUN
+  pinfo->getarea = mio283qt2_getarea;        /* Get an area from LCD memory */
+#else
+  pinfo->getarea = NULL;
+#endif
+  pinfo->buffer  = (uint8_t*)priv->runbuffer; /* Run scratch buffer */
+  pinfo->bpp     = MIO283QT2_BPP;            /* Bits-per-pixel */
   return OK;
 }
 
@@ -314,6 +314,14 @@ static int ssd1289_putrun(fb_coord_t row, fb_coord_t col, FAR const uint8_t *buf
              size_t npixels);
 static int ssd1289_getrun(fb_coord_t row, fb_coord_t col, FAR uint8_t *buffer,
              size_t npixels);
+#ifdef CONFIG_LCD_LANDSCAPE
+static int ssd1289_putarea(fb_coord_t row, fb_coord_t col, fb_coord_t nrows,
+             size_t npixels, FAR const uint8_t *buffer, size_t stride);
+#ifndef CONFIG_LCD_NOGETRUN
+static int ssd1289_getarea(fb_coord_t row, fb_coord_t col, fb_coord_t nrows,
+             size_t npixels, FAR uint8_t *buffer, size_t stride);
+#endif
+#endif
 
 /* LCD Configuration */
 
@@ -834,6 +842,164 @@ static int ssd1289_getrun(fb_coord_t row, fb_coord_t col, FAR uint8_t *buffer,
 #endif
 }
 
+/**************************************************************************************
+ * Name:  ssd1289_setwindow
+ *
+ * Description:
+ *   Set the GRAM window in physical coordinates.  Writes and reads then advance
+ *   through the window so that a whole area can be transferred in one burst.
+ *
+ **************************************************************************************/
+
+#ifdef CONFIG_LCD_LANDSCAPE
+static void ssd1289_setwindow(FAR struct ssd1289_lcd_s *lcd, uint16_t x0,
+                              uint16_t x1, uint16_t y0, uint16_t y1)
+{
+  ssd1289_putreg(lcd, SSD1289_HADDR,
+                 (x0 << SSD1289_HADDR_HSA_SHIFT) | (x1 << SSD1289_HADDR_HEA_SHIFT));
+  ssd1289_putreg(lcd, SSD1289_VSTART, y0);
+  ssd1289_putreg(lcd, SSD1289_VEND, y1);
+}
+#endif
+
+/**************************************************************************************
+ * Name:  ssd1289_putarea
+ *
+ * Description:
+ *   This method can be used to write a rectangular area to the LCD in one burst:
+ *
+ *   row     - Starting row to write to (range: 0 <= row <= yres-nrows)
+ *   col     - Starting column to write to (range: 0 <= col <= xres-npixels)
+ *   nrows   - The number of rows to write (range: 0 < nrows <= yres-row)
+ *   npixels - The number of pixels to write in each row
+ *             (range: 0 < npixels <= xres-col)
+ *   buffer  - The buffer containing the first row of the area
+ *   stride  - Distance in bytes between rows in the buffer (0: repeat the run)
+ *
+ *   This is only supported in the default landscape orientation where the GRAM
+ *   address counter advances along the rows of the display (AM=1).
+ *
+ **************************************************************************************/
+
+#ifdef CONFIG_LCD_LANDSCAPE
+static int ssd1289_putarea(fb_coord_t row, fb_coord_t col, fb_coord_t nrows,
+                           size_t npixels, FAR const uint8_t *buffer, size_t stride)
+{
+  FAR struct ssd1289_dev_s *priv = &g_lcddev;
+  FAR struct ssd1289_lcd_s *lcd = priv->lcd;
+  FAR const uint16_t *src;
+  int i;
+  int j;
+
+  /* Buffer must be provided and aligned to a 16-bit address boundary */
+
+  lcdvdbg("row: %d col: %d nrows: %d npixels: %d\n", row, col, nrows, npixels);
+  DEBUGASSERT(buffer && ((uintptr_t)buffer & 1) == 0 && (stride & 1) == 0);
+
+  /* Select the LCD */
+
+  lcd->select(lcd);
+
+  /* Set the window to the area:  The "row" is the physical X position and the
+   * "column" is the physical Y position.  Then write all of the pixels,
+   * letting the address counter advance through the window.
+   */
+
+  ssd1289_setwindow(lcd, row, row + nrows - 1, col, col + npixels - 1);
+  ssd1289_setcursor(lcd, col, row);
+  ssd1289_gramselect(lcd);
+
+  for (i = 0; i < nrows; i++)
+    {
+      src = (FAR const uint16_t*)buffer;
+      for (j = 0; j < npixels; j++)
+        {
+          ssd1289_gramwrite(lcd, *src);
+          src++;
+        }
+
+      buffer += stride;
+    }
+
+  /* Restore the full screen window used by putrun and getrun */
+
+  ssd1289_setwindow(lcd, 0, SSD1289_YRES-1, 0, SSD1289_XRES-1);
+
+  /* De-select the LCD */
+
+  lcd->deselect(lcd);
+  return OK;
+}
+#endif
+
+/**************************************************************************************
+ * Name:  ssd1289_getarea
+ *
+ * Description:
+ *   This method can be used to read a rectangular area from the LCD in one burst:
+ *
+ *   row     - Starting row to read from (range: 0 <= row <= yres-nrows)
+ *   col     - Starting column to read from (range: 0 <= col <= xres-npixels)
+ *   nrows   - The number of rows to read (range: 0 < nrows <= yres-row)
+ *   npixels - The number of pixels to read in each row
+ *             (range: 0 < npixels <= xres-col)
+ *   buffer  - The buffer in which to return the area read from the LCD
+ *   stride  - Distance in bytes between rows in the buffer
+ *
+ **************************************************************************************/
+
+#if defined(CONFIG_LCD_LANDSCAPE) && !defined(CONFIG_LCD_NOGETRUN)
+static int ssd1289_getarea(fb_coord_t row, fb_coord_t col, fb_coord_t nrows,
+                           size_t npixels, FAR uint8_t *buffer, size_t stride)
+{
+  FAR struct ssd1289_dev_s *priv = &g_lcddev;
+  FAR struct ssd1289_lcd_s *lcd = priv->lcd;
+  FAR uint16_t *dest;
+  uint16_t accum;
+  int i;
+  int j;
+
+  /* Buffer must be provided and aligned to a 16-bit address boundary */
+
+  lcdvdbg("row: %d col: %d nrows: %d npixels: %d\n", row, col, nrows, npixels);
+  DEBUGASSERT(buffer && ((uintptr_t)buffer & 1) == 0 && (stride & 1) == 0);
+
+  /* Select the LCD */
+
+  lcd->select(lcd);
+
+  /* Set the window to the area and read all of the pixels */
+
+  ssd1289_setwindow(lcd, row, row + nrows - 1, col, col + npixels - 1);
+  ssd1289_setcursor(lcd, col, row);
+  ssd1289_gramselect(lcd);
+
+  /* Prime the pump for unaligned read data */
+
+  ssd1289_readsetup(lcd, &accum);
+
+  for (i = 0; i < nrows; i++)
+    {
+      dest = (FAR uint16_t*)buffer;
+      for (j = 0; j < npixels; j++)
+        {
+          *dest++ = ssd1289_gramread(lcd, &accum);
+        }
+
+      buffer += stride;
+    }
+
+  /* Restore the full screen window used by putrun and getrun */
+
+  ssd1289_setwindow(lcd, 0, SSD1289_YRES-1, 0, SSD1289_XRES-1);
+
+  /* De-select the LCD */
+
+  lcd->deselect(lcd);
+  return OK;
+}
+#endif
+
 /**************************************************************************************
  * Name:  ssd1289_getvideoinfo
  *
@@ -872,10 +1038,21 @@ static int ssd1289_getplaneinfo(FAR struct lcd_dev_s *dev, unsigned int planeno,
   DEBUGASSERT(dev && pinfo && planeno == 0);
   lcdvdbg("planeno: %d bpp: %d\n", planeno, SSD1289_BPP);
 
-  pinfo->putrun = ssd1289_putrun;            /* Put a run into LCD memory */
-  pinfo->getrun = ssd1289_getrun;            /* Get a run from LCD memory */
-  pinfo->buffer = (uint8_t*)priv->runbuffer; /* Run scratch buffer */
-  pinfo->bpp    = SSD1289_BPP;               /* Bits-per-pixel */
+  pinfo->putrun  = ssd1289_putrun;           /* Put a run into LCD memory */
+  pinfo->getrun  = ssd1289_getrun;           /* Get a run from LCD memory */
+#ifdef CONFIG_LCD_LANDSCAPE
+  pinfo->putarea = ssd1289_putarea;          /* Put an area into LCD memory */
+#ifndef CONFIG_LCD_NOGETRUN
+  pinfo->getarea = ssd1289_getarea;          /* Get an area from LCD memory */
+#else
+  pinfo->getarea = NULL;
+#endif
+#else
+  pinfo->putarea = NULL;                     /* Area transfers not supported */
+  pinfo->getarea = NULL;
+#endif
+  pinfo->buffer  = (uint8_t*)priv->runbuffer; /* Run scratch buffer */
+  pinfo->bpp     = SSD1289_BPP;              /* Bits-per-pixel */
   return OK;
 }
 
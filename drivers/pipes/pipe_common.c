@@ -53,6 +53,7 @@
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/ringbuf.h>
 #include <nuttx/fs/fs.h>
 #if CONFIG_DEBUG
 #  include <nuttx/arch.h>
@@ -85,6 +86,8 @@
  ****************************************************************************/
 
 static void pipecommon_semtake(sem_t *sem);
+static void pipecommon_lock(FAR struct pipe_dev_s *dev);
+static void pipecommon_unlock(FAR struct pipe_dev_s *dev);
 
 /****************************************************************************
  * Private Data
@@ -111,30 +114,31 @@ static void pipecommon_semtake(sem_t *sem)
 }
 
 /****************************************************************************
- * Name: pipecommon_pollnotify
+ * Name: pipecommon_lock and pipecommon_unlock
+ *
+ * Description:
+ *   Get exclusive access to the whole pipe by locking out both readers and
+ *   writers.
+ *
  ****************************************************************************/
 
-#ifndef CONFIG_DISABLE_POLL
-static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev, pollevent_t eventset)
+static void pipecommon_lock(FAR struct pipe_dev_s *dev)
 {
-  int i;
+  pipecommon_semtake(&dev->d_wrlock);
+  pipecommon_semtake(&dev->d_rdlock);
+}
 
-  for (i = 0; i < CONFIG_DEV_PIPE_NPOLLWAITERS; i++)
-    {
-      struct pollfd *fds = dev->d_fds[i];
-      if (fds)
-        {
-          fds->revents |= (fds->events & eventset);
-          if (fds->revents != 0)
-            {
-              fvdbg("Report events: %02x\n", fds->revents);
-              sem_post(fds->sem);
-            }
-        }
-    }
+static void pipecommon_unlock(FAR struct pipe_dev_s *dev)
+{
+  sem_post(&dev->d_rdlock);
+  sem_post(&dev->d_wrlock);
 }
+
+#ifndef CONFIG_DISABLE_POLL
+#  define pipecommon_pollnotify(dev,eventset) \
+     ringbuf_pollnotify((dev)->d_fds, CONFIG_DEV_PIPE_NPOLLWAITERS, eventset)
 #else
-#  define pipecommon_pollnotify(dev,event)
+#  define pipecommon_pollnotify(dev,eventset)
 #endif
 
 /****************************************************************************
@@ -157,7 +161,8 @@ FAR struct pipe_dev_s *pipecommon_allocdev(void)
       /* Initialize the private structure */
 
       memset(dev, 0, sizeof(struct pipe_dev_s));
-      sem_init(&dev->d_bfsem, 0, 1);
+      sem_init(&dev->d_rdlock, 0, 1);
+      sem_init(&dev->d_wrlock, 0, 1);
       sem_init(&dev->d_rdsem, 0, 0);
       sem_init(&dev->d_wrsem, 0, 0);
     }
@@ -171,7 +176,8 @@ FAR struct pipe_dev_s *pipecommon_allocdev(void)
 
 void pipecommon_freedev(FAR struct pipe_dev_s *dev)
 {
-   sem_destroy(&dev->d_bfsem);
+   sem_destroy(&dev->d_rdlock);
+   sem_destroy(&dev->d_wrlock);
    sem_destroy(&dev->d_rdsem);
    sem_destroy(&dev->d_wrsem);
    kfree(dev);
@@ -185,7 +191,7 @@ int pipecommon_open(FAR struct file *filep)
 {
   struct inode      *inode = filep->f_inode;
   struct pipe_dev_s *dev   = inode->i_private;
-  int                sval;
+  FAR uint8_t       *buffer;
   int                ret;
  
   /* Some sanity checking */
@@ -200,7 +206,16 @@ int pipecommon_open(FAR struct file *filep)
    * sem_wait() call should fail only if we are awakened by a signal.
    */
 
-  ret = sem_wait(&dev->d_bfsem);
+  ret = sem_wait(&dev->d_wrlock);
+  if (ret == OK)
+    {
+      ret = sem_wait(&dev->d_rdlock);
+      if (ret != OK)
+        {
+          sem_post(&dev->d_wrlock);
+        }
+    }
+
   if (ret != OK)
     {
       fdbg("sem_wait failed: %d\n", errno);
@@ -212,12 +227,14 @@ int pipecommon_open(FAR struct file *filep)
 
   if (dev->d_refs == 0)
     {
-      dev->d_buffer = (uint8_t*)kmalloc(CONFIG_DEV_PIPE_SIZE);
-      if (!dev->d_buffer)
+      buffer = (FAR uint8_t *)kmalloc(CONFIG_DEV_PIPE_SIZE);
+      if (!buffer)
         {
-          (void)sem_post(&dev->d_bfsem);
+          pipecommon_unlock(dev);
           return -ENOMEM;
         }
+
+      ringbuf_init(&dev->d_ring, buffer, CONFIG_DEV_PIPE_SIZE);
     }
 
   /* Increment the reference count on the pipe instance */
@@ -236,17 +253,14 @@ int pipecommon_open(FAR struct file *filep)
 
       if (dev->d_nwriters == 1)
         {
-          while (sem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0)
-            {
-              sem_post(&dev->d_rdsem);
-            }
+          ringbuf_notify(&dev->d_rdsem);
         }
     }
 
   /* If opened for read-only, then wait for at least one writer on the pipe */
 
   sched_lock();
-  (void)sem_post(&dev->d_bfsem);
+  pipecommon_unlock(dev);
   if ((filep->f_oflags & O_RDWR) == O_RDONLY && dev->d_nwriters < 1)
     {
       /* NOTE: d_rdsem is normally used when the read logic waits for more
@@ -287,7 +301,6 @@ int pipecommon_close(FAR struct file *filep)
 {
   struct inode      *inode = filep->f_inode;
   struct pipe_dev_s *dev   = inode->i_private;
-  int                sval;
 
   /* Some sanity checking */
 #if CONFIG_DEBUG
@@ -302,7 +315,7 @@ int pipecommon_close(FAR struct file *filep)
    * I've never seen anyone check that.
    */
 
-  pipecommon_semtake(&dev->d_bfsem);
+  pipecommon_lock(dev);
 
   /* Check if the decremented reference count would go to zero */
 
@@ -322,10 +335,7 @@ int pipecommon_close(FAR struct file *filep)
 
           if (--dev->d_nwriters <= 0)
             {
-              while (sem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0)
-                {
-                  sem_post(&dev->d_rdsem);
-                }
+              ringbuf_notify(&dev->d_rdsem);
             }
         }
     }
@@ -333,18 +343,16 @@ int pipecommon_close(FAR struct file *filep)
     {
       /* Yes... deallocate the buffer */
 
-      kfree(dev->d_buffer);
-      dev->d_buffer = NULL;
+      kfree(dev->d_ring.rb_buffer);
+      ringbuf_init(&dev->d_ring, NULL, 0);
+
+      /* And reset all counts */
 
-      /* And reset all counts and indices */
- 
-      dev->d_wrndx    = 0;
-      dev->d_rdndx    = 0;
       dev->d_refs     = 0;
       dev->d_nwriters = 0;
    }
 
-  sem_post(&dev->d_bfsem);
+  pipecommon_unlock(dev);
   return OK;
 }
 
@@ -359,8 +367,7 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 #ifdef CONFIG_DEV_PIPEDUMP
   FAR uint8_t       *start  = (uint8_t*)buffer;
 #endif
-  ssize_t            nread  = 0;
-  int                sval;
+  ssize_t            nread;
   int                ret;
 
   /* Some sanity checking */
@@ -371,22 +378,22 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
     }
 #endif
 
-  /* Make sure that we have exclusive access to the device structure */
+  /* Make sure that we are the only reader.  Writers may still proceed. */
 
-  if (sem_wait(&dev->d_bfsem) < 0)
+  if (sem_wait(&dev->d_rdlock) < 0)
     {
       return ERROR;
     }
 
   /* If the pipe is empty, then wait for something to be written to it */
 
-  while (dev->d_wrndx == dev->d_rdndx)
+  while (ringbuf_isempty(&dev->d_ring))
     {
       /* If O_NONBLOCK was set, then return EGAIN */
 
       if (filep->f_oflags & O_NONBLOCK)
         {
-          sem_post(&dev->d_bfsem);
+          sem_post(&dev->d_rdlock);
           return -EAGAIN;
         }
 
@@ -394,18 +401,25 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
       if (dev->d_nwriters <= 0)
         {
-          sem_post(&dev->d_bfsem);
+          sem_post(&dev->d_rdlock);
           return 0;
         }
 
-      /* Otherwise, wait for something to be written to the pipe */
+      /* Otherwise, wait for something to be written to the pipe.  The
+       * writer does not hold d_rdlock, so check again with pre-emption
+       * disabled in case it has written since the check above.
+       */
 
+      ret = OK;
       sched_lock();
-      sem_post(&dev->d_bfsem);
-      ret = sem_wait(&dev->d_rdsem);
+      sem_post(&dev->d_rdlock);
+      if (ringbuf_isempty(&dev->d_ring) && dev->d_nwriters > 0)
+        {
+          ret = sem_wait(&dev->d_rdsem);
+        }
       sched_unlock();
 
-      if (ret < 0  || sem_wait(&dev->d_bfsem) < 0) 
+      if (ret < 0  || sem_wait(&dev->d_rdlock) < 0)
         {
           return ERROR;
         }
@@ -413,29 +427,23 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 
   /* Then return whatever is available in the pipe (which is at least one byte) */
 
-  nread = 0;
-  while (nread < len && dev->d_wrndx != dev->d_rdndx)
-    {
-      *buffer++ = dev->d_buffer[dev->d_rdndx];
-      if (++dev->d_rdndx >= CONFIG_DEV_PIPE_SIZE)
-        {
-          dev->d_rdndx = 0; 
-        }
-      nread++;
-    }
+  nread = ringbuf_get(&dev->d_ring, buffer, len);
 
-  /* Notify all waiting writers that bytes have been removed from the buffer */
+  /* Notify all waiting writers once the pipe has drained to the low
+   * watermark.  Waking them for every read of a few bytes would only cost
+   * context switches.
+   */
 
-  while (sem_getvalue(&dev->d_wrsem, &sval) == 0 && sval < 0)
+  if (ringbuf_used(&dev->d_ring) <= CONFIG_DEV_PIPE_LOWATER)
     {
-      sem_post(&dev->d_wrsem);
+      ringbuf_notify(&dev->d_wrsem);
     }
 
   /* Notify all poll/select waiters that they can write to the FIFO */
 
   pipecommon_pollnotify(dev, POLLOUT);
 
-  sem_post(&dev->d_bfsem);
+  sem_post(&dev->d_rdlock);
   pipe_dumpbuffer("From PIPE:", start, nread);
   return nread;
 }
@@ -449,9 +457,9 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer, size_t
   struct inode      *inode    = filep->f_inode;
   struct pipe_dev_s *dev      = inode->i_private;
   ssize_t            nwritten = 0;
-  ssize_t            last;
-  int                nxtwrndx;
-  int                sval;
+  size_t             used;
+  size_t             n;
+  bool               full;
 
   /* Some sanity checking */
 
@@ -478,91 +486,93 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer, size_t
 
   DEBUGASSERT(up_interrupt_context() == false)
 
-  /* Make sure that we have exclusive access to the device structure */
+  /* Make sure that we are the only writer.  Readers may still proceed. */
 
-  if (sem_wait(&dev->d_bfsem) < 0)
+  if (sem_wait(&dev->d_wrlock) < 0)
     {
       return ERROR;
     }
 
   /* Loop until all of the bytes have been written */
 
-  last = 0;
   for (;;)
     {
-      /* Calculate the write index AFTER the next byte is written */
+      /* Copy as much as will fit into the pipe, but stop at the high
+       * watermark so that blocked readers can be started while the rest is
+       * copied.
+       */
 
-      nxtwrndx = dev->d_wrndx + 1;
-      if (nxtwrndx >= CONFIG_DEV_PIPE_SIZE)
+      n    = len - nwritten;
+      used = ringbuf_used(&dev->d_ring);
+      if (used < CONFIG_DEV_PIPE_HIWATER && n > CONFIG_DEV_PIPE_HIWATER - used)
         {
-          nxtwrndx = 0;
+          n = CONFIG_DEV_PIPE_HIWATER - used;
         }
 
-      /* Would the next write overflow the circular buffer? */
+      n         = ringbuf_put(&dev->d_ring, &buffer[nwritten], n);
+      nwritten += n;
+      full      = ringbuf_isfull(&dev->d_ring);
 
-      if (nxtwrndx != dev->d_rdndx)
-        {
-          /* No... copy the byte */
-
-          dev->d_buffer[dev->d_wrndx] = *buffer++;
-          dev->d_wrndx = nxtwrndx;
-
-          /* Is the write complete? */
+      /* Notify all of the waiting readers that more data is available if
+       * the high watermark has been reached or if this writer is about to
+       * return or block.
+       */
 
-          if (++nwritten >= len)
-            {
-              /* Yes.. Notify all of the waiting readers that more data is available */
+      if (n > 0 &&
+          (nwritten >= len || full ||
+           ringbuf_used(&dev->d_ring) >= CONFIG_DEV_PIPE_HIWATER ||
+           (filep->f_oflags & O_NONBLOCK) != 0))
+        {
+          ringbuf_notify(&dev->d_rdsem);
 
-              while (sem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0)
-                {
-                  sem_post(&dev->d_rdsem);
-                }
+          /* Notify all poll/select waiters that they can read from the FIFO */
 
-              /* Notify all poll/select waiters that they can write to the FIFO */
+          pipecommon_pollnotify(dev, POLLIN);
+        }
 
-              pipecommon_pollnotify(dev, POLLIN);
+      /* Is the write complete? */
 
-              /* Return the number of bytes written */
+      if (nwritten >= len)
+        {
+          /* Yes.. Return the number of bytes written */
 
-              sem_post(&dev->d_bfsem);
-              return len;
-            }
+          sem_post(&dev->d_wrlock);
+          return len;
         }
-      else
-        {
-          /* There is not enough room for the next byte.  Was anything written in this pass? */
 
-          if (last < nwritten)
-            {
-              /* Yes.. Notify all of the waiting readers that more data is available */
+      /* Keep copying if we only stopped at the high watermark */
 
-              while (sem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0)
-                {
-                  sem_post(&dev->d_rdsem);
-                }
-            }
-          last = nwritten;
+      if (!full)
+        {
+          continue;
+        }
 
-          /* If O_NONBLOCK was set, then return partial bytes written or EGAIN */
+      /* If O_NONBLOCK was set, then return partial bytes written or EGAIN */
 
-          if (filep->f_oflags & O_NONBLOCK)
+      if (filep->f_oflags & O_NONBLOCK)
+        {
+          if (nwritten == 0)
             {
-              if (nwritten == 0)
-                {
-                  nwritten = -EAGAIN;
-                }
-              sem_post(&dev->d_bfsem);
-              return nwritten;
+              nwritten = -EAGAIN;
             }
 
-          /* There is more to be written.. wait for data to be removed from the pipe */
+          sem_post(&dev->d_wrlock);
+          return nwritten;
+        }
+
+      /* There is more to be written.. wait for data to be removed from the
+       * pipe.  The reader does not hold d_wrlock, so check again with
+       * pre-emption disabled in case it has drained the pipe already.
+       */
 
-          sched_lock();
-          sem_post(&dev->d_bfsem);
+      sched_lock();
+      sem_post(&dev->d_wrlock);
+      if (ringbuf_isfull(&dev->d_ring))
+        {
           pipecommon_semtake(&dev->d_wrsem);
-          sched_unlock();
-          pipecommon_semtake(&dev->d_bfsem);
         }
+      sched_unlock();
+      pipecommon_semtake(&dev->d_wrlock);
     }
 }
 
@@ -577,7 +587,6 @@ int pipecommon_poll(FAR struct file *filep, FAR struct pollfd *fds,
   FAR struct inode      *inode    = filep->f_inode;
   FAR struct pipe_dev_s *dev      = inode->i_private;
   pollevent_t            eventset;
-  pipe_ndx_t             nbytes;
   int                    ret      = OK;
   int                    i;
 
@@ -592,7 +601,7 @@ int pipecommon_poll(FAR struct file *filep, FAR struct pollfd *fds,
 
   /* Are we setting up the poll?  Or tearing it down? */
 
-  pipecommon_semtake(&dev->d_bfsem);
+  pipecommon_lock(dev);
   if (setup)
     {
       /* This is a request to set up the poll.  Find an available
@@ -620,34 +629,11 @@ int pipecommon_poll(FAR struct file *filep, FAR struct pollfd *fds,
           goto errout;
         }
 
-      /* Should immediately notify on any of the requested events?
-       * First, determine how many bytes are in the buffer
+      /* Should immediately notify on any of the requested events?  POLLOUT
+       * if the pipe is not full and POLLIN if the pipe is not empty.
        */
 
-      if (dev->d_wrndx >= dev->d_rdndx)
-        {
-          nbytes = dev->d_wrndx - dev->d_rdndx;
-        }
-      else
-        {
-          nbytes = (CONFIG_DEV_PIPE_SIZE-1) + dev->d_wrndx - dev->d_rdndx;
-        }
-
-      /* Notify the POLLOUT event if the pipe is not full */
-
-      eventset = 0;
-      if (nbytes < (CONFIG_DEV_PIPE_SIZE-1))
-        {
-          eventset |= POLLOUT;
-        }
-
-      /* Notify the POLLIN event if the pipe is not empty */
-
-      if (nbytes > 0)
-        {
-          eventset |= POLLIN;
-        }
-
+      eventset = ringbuf_pollevents(&dev->d_ring);
       if (eventset)
         {
           pipecommon_pollnotify(dev, eventset);
@@ -674,7 +660,7 @@ int pipecommon_poll(FAR struct file *filep, FAR struct pollfd *fds,
     }
 
 errout:
-  sem_post(&dev->d_bfsem);
+  pipecommon_unlock(dev);
   return ret;
 }
 #endif
@@ -47,6 +47,8 @@
 #include <stdbool.h>
 #include <poll.h>
 
+#include <nuttx/ringbuf.h>
+
 #ifndef CONFIG_DEV_PIPE_SIZE
 #  define CONFIG_DEV_PIPE_SIZE 1024
 #endif
@@ -63,6 +65,28 @@
 #  define CONFIG_DEV_PIPE_NPOLLWAITERS 2
 #endif
 
+/* Wake-up watermarks.  Writers blocked on a full pipe are woken once the
+ * pipe has drained to CONFIG_DEV_PIPE_LOWATER bytes or fewer.  Readers
+ * blocked on an empty pipe are woken once the pipe holds
+ * CONFIG_DEV_PIPE_HIWATER bytes, or when the writer finishes or blocks.
+ */
+
+#ifndef CONFIG_DEV_PIPE_LOWATER
+#  define CONFIG_DEV_PIPE_LOWATER (CONFIG_DEV_PIPE_SIZE / 2)
+#endif
+
+#ifndef CONFIG_DEV_PIPE_HIWATER
+#  define CONFIG_DEV_PIPE_HIWATER (CONFIG_DEV_PIPE_SIZE / 2)
+#endif
+
+/* A reader wake-up level larger than the pipe could never be reached */
+
+#if CONFIG_DEV_PIPE_HIWATER > CONFIG_DEV_PIPE_SIZE
+#  warning "CONFIG_DEV_PIPE_HIWATER exceeds CONFIG_DEV_PIPE_SIZE"
+#  undef CONFIG_DEV_PIPE_HIWATER
+#  define CONFIG_DEV_PIPE_HIWATER CONFIG_DEV_PIPE_SIZE
+#endif
+
 /* Maximum number of open's supported on pipe */
 
 #define CONFIG_DEV_PIPE_MAXUSER 255
@@ -71,32 +95,26 @@
  * Public Types
  ****************************************************************************/
 
-/* Make the buffer index as small as possible for the configured pipe size */
- 
-#if CONFIG_DEV_PIPE_SIZE > 65535
-typedef uint32_t pipe_ndx_t;  /* 32-bit index */
-#elif CONFIG_DEV_PIPE_SIZE > 255
-typedef uint16_t pipe_ndx_t;  /* 16-bit index */
-#else
-typedef uint8_t pipe_ndx_t;   /*  8-bit index */
-#endif
-
 /* This structure represents the state of one pipe.  A reference to this
  * structure is retained in the i_private field of the inode whenthe pipe/fifo
  * device is registered.
+ *
+ * Readers only move the tail of d_ring and writers only move the head, so
+ * one reader and one writer may run at the same time.  d_rdlock serializes
+ * the readers and d_wrlock serializes the writers.  Open, close and poll
+ * setup take both, always d_wrlock first.
  */
 
 struct pipe_dev_s
 {
-  sem_t      d_bfsem;       /* Used to serialize access to d_buffer and indices */
+  sem_t      d_rdlock;      /* Serializes readers of d_ring */
+  sem_t      d_wrlock;      /* Serializes writers of d_ring */
   sem_t      d_rdsem;       /* Empty buffer - Reader waits for data write */
   sem_t      d_wrsem;       /* Full buffer - Writer waits for data read */
-  pipe_ndx_t d_wrndx;       /* Index in d_buffer to save next byte written */
-  pipe_ndx_t d_rdndx;       /* Index in d_buffer to return the next byte read */
+  struct ringbuf_s d_ring;  /* Buffer allocated when device opened */
   uint8_t    d_refs;        /* References counts on pipe (limited to 255) */
   uint8_t    d_nwriters;    /* Number of reference counts for write access */
   uint8_t    d_pipeno;      /* Pipe minor number */
-  uint8_t   *d_buffer;      /* Buffer allocated when device opened */
 
   /* The following is a list if poll structures of threads waiting for
    * driver events. The 'struct pollfd' reference for each open is also
@@ -50,6 +50,13 @@
 #include <errno.h>
 #include <debug.h>
 
+#ifdef CONFIG_SERIAL_TERMIOS
+#  include <termios.h>
+#  include <wdog.h>
+#  include <nuttx/clock.h>
+#  include <nuttx/fs/ioctl.h>
+#endif
+
 #include <nuttx/irq.h>
 #include <nuttx/arch.h>
 #include <nuttx/fs/fs.h>
@@ -174,20 +181,162 @@ static void uart_pollnotify(FAR uart_dev_t *dev, pollevent_t eventset)
 #  define uart_pollnotify(dev,event)
 #endif
 
+/************************************************************************************
+ * Name: uart_recvcount
+ *
+ * Description:
+ *   Return the number of bytes currently held in the recv buffer.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_TERMIOS
+static int16_t uart_recvcount(FAR uart_dev_t *dev)
+{
+  int16_t nbytes = dev->recv.head - dev->recv.tail;
+
+  if (nbytes < 0)
+    {
+      nbytes += dev->recv.size;
+    }
+
+  return nbytes;
+}
+#endif
+
+/************************************************************************************
+ * Name: uart_rxexpired
+ *
+ * Description:
+ *   The VTIME timer expired or the lower half reported that the RX line went
+ *   idle.  Wake up any reader so that it can return the data received so far.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_TERMIOS
+static void uart_rxexpired(FAR uart_dev_t *dev)
+{
+  dev->rxexpired = true;
+  if (dev->recvwaiting)
+    {
+      dev->recvwaiting = false;
+      (void)sem_post(&dev->recvsem);
+    }
+}
+#endif
+
+/************************************************************************************
+ * Name: uart_rxtimeout
+ *
+ * Description:
+ *   Watchdog timer handler for the VTIME timeout.  Runs in interrupt context.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_TERMIOS
+static void uart_rxtimeout(int argc, uint32_t arg1, ...)
+{
+  uart_rxexpired((FAR uart_dev_t *)arg1);
+}
+#endif
+
+/************************************************************************************
+ * Name: uart_waitxmit
+ *
+ * Description:
+ *   The xmit buffer is full.  Wait for the lower half to remove some data from
+ *   the buffer (if blocking is permitted).
+ *
+ ************************************************************************************/
+
+static int uart_waitxmit(FAR uart_dev_t *dev, bool oktoblock)
+{
+  irqstate_t flags;
+  int ret;
+
+  /* The caller has request that we not block for data.  So return the
+   * EAGAIN error to signal this situation.
+   */
+
+  if (!oktoblock)
+    {
+      return -EAGAIN;
+    }
+
+  /* Inform the interrupt level logic that we are waiting. This and
+   * the following steps must be atomic.
+   */
+
+  flags = irqsave();
+
+#ifdef CONFIG_SERIAL_REMOVABLE
+  /* Check if the removable device is no longer connected while we
+   * have interrupts off.  We do not want the transition to occur
+   * as a race condition before we begin the wait.
+   */
+
+  if (dev->disconnected)
+    {
+      ret = -ENOTCONN;
+    }
+  else
+#endif
+    {
+      /* Wait for some characters to be sent from the buffer with
+       * the TX interrupt enabled.  When the TX interrupt is
+       * enabled, uart_xmitchars should execute and remove some
+       * of the data from the TX buffer.  If the lower half
+       * supports DMA, make sure that the TX DMA is running as well.
+       */
+
+      dev->xmitwaiting = true;
+#ifdef CONFIG_SERIAL_DMA
+      uart_dmatxavail(dev);
+#endif
+      uart_enabletxint(dev);
+      ret = uart_takesem(&dev->xmitsem, true);
+      uart_disabletxint(dev);
+    }
+
+  irqrestore(flags);
+
+#ifdef CONFIG_SERIAL_REMOVABLE
+  /* Check if the removable device was disconnected while we were
+   * waiting.
+   */
+
+  if (dev->disconnected)
+    {
+      return -ENOTCONN;
+    }
+#endif
+
+  /* Check if we were awakened by signal. */
+
+  if (ret < 0)
+    {
+      /* A signal received while waiting for the xmit buffer to become
+       * non-full will abort the transfer.
+       */
+
+      return -EINTR;
+    }
+
+  return OK;
+}
+
 /************************************************************************************
  * Name: uart_putxmitchar
  ************************************************************************************/
 
 static int uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock)
 {
-  irqstate_t flags;
   int nexthead;
   int ret;
 
   /* Increment to see what the next head pointer will be.  We need to use the "next"
    * head pointer to determine when the circular buffer would overrun
    */
- 
+
   nexthead = dev->xmit.head + 1;
   if (nexthead >= dev->xmit.size)
     {
@@ -195,7 +344,7 @@ static int uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock)
     }
 
   /* Loop until we are able to add the character to the TX buffer */
-  
+
   for (;;)
     {
       if (nexthead != dev->xmit.tail)
@@ -210,78 +359,100 @@ static int uart_putxmitchar(FAR uart_dev_t *dev, int ch, bool oktoblock)
        * buffer?
        */
 
-      else if (oktoblock)
+      ret = uart_waitxmit(dev, oktoblock);
+      if (ret < 0)
         {
-          /* Inform the interrupt level logic that we are waiting. This and
-           * the following steps must be atomic.
-           */
+          return ret;
+        }
+    }
 
-          flags = irqsave();
+  /* We won't get here.  Some compilers may complain that this code is
+   * unreachable.
+   */
 
-#ifdef CONFIG_SERIAL_REMOVABLE
-          /* Check if the removable device is no longer connected while we
-           * have interrupts off.  We do not want the transition to occur
-           * as a race condition before we begin the wait.
-           */
+  return OK;
+}
+
+/************************************************************************************
+ * Name: uart_putxmitbuf
+ *
+ * Description:
+ *   Copy a block of data into the xmit buffer.  Data is copied with memcpy() in
+ *   contiguous spans of the circular buffer and the head index is updated once
+ *   per span.  If the buffer is full, this function will wait (if blocking is
+ *   permitted) until at least some space becomes available.
+ *
+ * Returned Value:
+ *   The number of bytes copied (always > 0) on success; a negated errno value on
+ *   failure.  Fewer than 'buflen' bytes may be copied; the caller must call
+ *   again to transfer the remainder.
+ *
+ ************************************************************************************/
+
+static ssize_t uart_putxmitbuf(FAR uart_dev_t *dev, FAR const char *buffer,
+                               size_t buflen, bool oktoblock)
+{
+  size_t nbytes;
+  int16_t head;
+  int16_t tail;
+  int ret;
+
+  for (;;)
+    {
+      /* Get the size of the free, contiguous region beginning at the head
+       * index.  The tail index may be modified asynchronously by the lower
+       * half, but it can only move in a direction that increases the free
+       * space.  One byte is always left unused so that a full buffer can be
+       * distinguished from an empty one.
+       */
 
-          if (dev->disconnected)
+      head = dev->xmit.head;
+      tail = dev->xmit.tail;
+
+      if (head >= tail)
+        {
+          nbytes = dev->xmit.size - head;
+          if (tail == 0)
             {
-              ret = -ENOTCONN;
+              nbytes--;
             }
-          else
-#endif
-            {
-              /* Wait for some characters to be sent from the buffer with
-               * the TX interrupt enabled.  When the TX interrupt is
-               * enabled, uart_xmitchars should execute and remove some
-               * of the data from the TX buffer.
-               */
+        }
+      else
+        {
+          nbytes = tail - head - 1;
+        }
 
-              dev->xmitwaiting = true;
-              uart_enabletxint(dev);
-              ret = uart_takesem(&dev->xmitsem, true);
-              uart_disabletxint(dev);
+      if (nbytes > 0)
+        {
+          if (nbytes > buflen)
+            {
+              nbytes = buflen;
             }
 
-          irqrestore(flags);
+          memcpy(&dev->xmit.buffer[head], buffer, nbytes);
 
-#ifdef CONFIG_SERIAL_REMOVABLE
-          /* Check if the removable device was disconnected while we were
-           * waiting.
+          /* Update the head index once so that the lower half sees the
+           * whole block at once.
            */
 
-          if (dev->disconnected)
+          head += nbytes;
+          if (head >= dev->xmit.size)
             {
-              return -ENOTCONN;
+              head = 0;
             }
-#endif
-          /* Check if we were awakened by signal. */
 
-          if (ret < 0)
-            {
-             /* A signal received while waiting for the xmit buffer to become
-              * non-full will abort the transfer.
-              */
-
-              return -EINTR;
-            }
+          dev->xmit.head = head;
+          return (ssize_t)nbytes;
         }
 
-      /* The caller has request that we not block for data.  So return the
-       * EAGAIN error to signal this situation.
-       */
+      /* The buffer is full.  Wait for some space to become available */
 
-      else
+      ret = uart_waitxmit(dev, oktoblock);
+      if (ret < 0)
         {
-          return -EAGAIN;
+          return ret;
         }
     }
-
-  /* We won't get here.  Some compilers may complain that this code is
-   * unreachable.
-   */
-
-  return OK;
 }
 
 /************************************************************************************
@@ -322,6 +493,7 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer, size_t
   FAR struct inode *inode  = filep->f_inode;
   FAR uart_dev_t   *dev    = inode->i_private;
   ssize_t           nread  = buflen;
+  ssize_t           nwritten;
   bool              oktoblock;
   int               ret;
 
@@ -399,33 +571,62 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer, size_t
    */
 
   uart_disabletxint(dev);
-  for (; buflen; buflen--)
+  while (buflen > 0)
     {
-      int ch = *buffer++;
-
       /* If this is the console, then we should replace LF with CR-LF */
 
-      ret = OK;
-      if (dev->isconsole && ch == '\n')
+      if (dev->isconsole && *buffer == '\n')
         {
           ret = uart_putxmitchar(dev, '\r', oktoblock);
+          if (ret == OK)
+            {
+              ret = uart_putxmitchar(dev, '\n', oktoblock);
+            }
+
+          if (ret == OK)
+            {
+              buffer++;
+              buflen--;
+            }
         }
+      else
+        {
+          FAR const char *lf;
+          size_t nbytes = buflen;
 
-      /* Put the character into the transmit buffer */
+          /* Copy the run of characters up to the next LF (console only) into
+           * the transmit buffer as a block.
+           */
 
-      if (ret == OK)
-        {
-          ret = uart_putxmitchar(dev, ch, oktoblock);
+          if (dev->isconsole)
+            {
+              lf = memchr(buffer, '\n', buflen);
+              if (lf)
+                {
+                  nbytes = lf - buffer;
+                }
+            }
+
+          nwritten = uart_putxmitbuf(dev, buffer, nbytes, oktoblock);
+          if (nwritten > 0)
+            {
+              buffer += nwritten;
+              buflen -= nwritten;
+              ret     = OK;
+            }
+          else
+            {
+              ret     = (int)nwritten;
+            }
         }
 
-      /* uart_putxmitchar() might return an error under one of two
-       * conditions:  (1) The wait for buffer space might have been
+      /* uart_putxmitchar() and uart_putxmitbuf() might return an error under
+       * one of three conditions:  (1) The wait for buffer space might have been
        * interrupted by a signal (ret should be -EINTR), (2) if
-       * CONFIG_SERIAL_REMOVABLE is defined, then uart_putxmitchar()
-       * might also return if the serial device was disconnected
-       * (with -ENOTCONN), or (3) if O_NONBLOCK is specified, then
-       * then uart_putxmitchar() might return -EAGAIN if the output
-       * TX buffer is full.
+       * CONFIG_SERIAL_REMOVABLE is defined, then they might also return if the
+       * serial device was disconnected (with -ENOTCONN), or (3) if O_NONBLOCK
+       * is specified, then they might return -EAGAIN if the output TX buffer is
+       * full.
        */
 
       if (ret < 0)
@@ -448,7 +649,7 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer, size_t
               /* No data was transferred. Return the negated errno value.
                * The VFS layer will set the errno value appropriately).
                */
- 
+
               nread = ret;
             }
 
@@ -458,6 +659,9 @@ static ssize_t uart_write(FAR struct file *filep, FAR const char *buffer, size_t
 
   if (dev->xmit.head != dev->xmit.tail)
     {
+#ifdef CONFIG_SERIAL_DMA
+      uart_dmatxavail(dev);
+#endif
       uart_enabletxint(dev);
     }
 
@@ -475,9 +679,31 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
   FAR uart_dev_t   *dev   = inode->i_private;
   irqstate_t        flags;
   ssize_t           recvd = 0;
+  int16_t           head;
   int16_t           tail;
+  size_t            nbytes;
+#if defined(CONFIG_SERIAL_TERMIOS) && !defined(CONFIG_DEV_SERIAL_FULLBLOCKS)
+  ssize_t           minread;
+  bool              expired = false;
+#endif
   int               ret;
 
+#if defined(CONFIG_SERIAL_TERMIOS) && !defined(CONFIG_DEV_SERIAL_FULLBLOCKS)
+  /* Get the minimum number of bytes to return (VMIN).  If VMIN is zero but
+   * VTIME is not, then we will wait (up to VTIME) for at least one byte.  If
+   * both are zero, then read() returns what is available without waiting.
+   */
+
+  if (dev->vmin > 0)
+    {
+      minread = dev->vmin < buflen ? dev->vmin : buflen;
+    }
+  else
+    {
+      minread = dev->vtime > 0 ? 1 : 0;
+    }
+#endif
+
   /* Only one user can access dev->recv.tail at a time */
 
   ret = uart_takesem(&dev->recv.sem, true);
@@ -525,20 +751,31 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
        * 8-bit accesses to obtain the 16-bit head index.
        */
 
+      head = dev->recv.head;
       tail = dev->recv.tail;
-      if (dev->recv.head != tail)
+      if (head != tail)
         {
-          /* Take the next character from the tail of the buffer */
+          /* Take the contiguous block of data beginning at the tail of the
+           * buffer.
+           */
 
-          *buffer++ = dev->recv.buffer[tail];
-          recvd++;
+          nbytes = (head > tail ? head : dev->recv.size) - tail;
+          if (nbytes > buflen - recvd)
+            {
+              nbytes = buflen - recvd;
+            }
+
+          memcpy(buffer, &dev->recv.buffer[tail], nbytes);
+          buffer += nbytes;
+          recvd  += nbytes;
 
           /* Increment the tail index.  Most operations are done using the
            * local variable 'tail' so that the final dev->recv.tail update
            * is atomic.
            */
 
-          if (++tail >= dev->recv.size)
+          tail += nbytes;
+          if (tail >= dev->recv.size)
             {
               tail = 0;
             }
@@ -570,6 +807,19 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
        * to the caller?
        */
 
+#ifdef CONFIG_SERIAL_TERMIOS
+      else if (recvd >= minread ||
+               (expired && (recvd > 0 || dev->vmin == 0)))
+       {
+          /* Yes.. we have returned at least VMIN bytes, or the VTIME timer
+           * expired, or the line went idle.  Break out of the loop and
+           * return the number of bytes received up to the wait condition
+           * (which may be zero if VMIN is zero).
+           */
+
+          break;
+       }
+#else
       else if (recvd > 0)
        {
           /* Yes.. break out of the loop and return the number of bytes
@@ -578,6 +828,7 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 
           break;
        }
+#endif
 
       /* No... then we would have to wait to get receive some data.
        * If the user has specified the O_NONBLOCK option, then do not
@@ -586,9 +837,17 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
 
       else if ((filep->f_oflags & O_NONBLOCK) != 0)
         {
-          /* Break out of the loop returning -EAGAIN */
+          /* Break out of the loop returning -EAGAIN if nothing was
+           * transferred.  Otherwise, return what we have (fewer than VMIN
+           * bytes):  Those bytes have already been removed from the Rx
+           * buffer.
+           */
+
+          if (recvd < 1)
+            {
+              recvd = -EAGAIN;
+            }
 
-          recvd = -EAGAIN;
           break;
         }
 #endif
@@ -634,8 +893,49 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
                    * thread goes to sleep.
                    */
 
+#if defined(CONFIG_SERIAL_TERMIOS) && !defined(CONFIG_DEV_SERIAL_FULLBLOCKS)
+                  /* Don't wake up until enough data has been buffered to
+                   * satisfy VMIN.  If VTIME is non-zero, then also wake up
+                   * when the timer expires:  For VMIN == 0, this is a
+                   * timeout on the whole read(); otherwise, it is an inter-
+                   * byte timer that uart_datareceived() (re-)starts as each
+                   * byte arrives, including the first.  If bytes have
+                   * already been received, the inter-byte timer is started
+                   * now.
+                   */
+
+                  dev->rxthreshold = minread - recvd;
+                  dev->rxexpired   = false;
+                  dev->rxinterbyte = (dev->vmin > 0 && dev->vtime > 0);
+
+                  if (dev->vtime > 0 && (dev->vmin == 0 || recvd > 0))
+                    {
+                      (void)wd_start(dev->rxtimer, DSEC2TICK(dev->vtime),
+                                     uart_rxtimeout, 1,
+                                     (uint32_t)dev);
+                    }
+#endif
+
                   dev->recvwaiting = true;
+#ifdef CONFIG_SERIAL_DMA
+                  /* Make sure that the RX DMA is running.  It may have stalled
+                   * when the recv buffer became full.
+                   */
+
+                  uart_dmarxfree(dev);
+#endif
                   ret = uart_takesem(&dev->recvsem, true);
+
+#if defined(CONFIG_SERIAL_TERMIOS) && !defined(CONFIG_DEV_SERIAL_FULLBLOCKS)
+                  /* Stop the timer and check if it expired (or if the line
+                   * went idle) while we waited.
+                   */
+
+                  (void)wd_cancel(dev->rxtimer);
+                  dev->rxinterbyte = false;
+                  dev->rxthreshold = 1;
+                  expired          = dev->rxexpired;
+#endif
                 }
 
               irqrestore(flags);
@@ -685,6 +985,15 @@ static ssize_t uart_read(FAR struct file *filep, FAR char *buffer, size_t buflen
         }
     }
 
+#ifdef CONFIG_SERIAL_DMA
+  /* Notify the lower half that space is available in the recv buffer */
+
+  if (recvd > 0)
+    {
+      uart_dmarxfree(dev);
+    }
+#endif
+
   uart_givesem(&dev->recv.sem);
   return recvd;
 }
@@ -697,8 +1006,54 @@ static int uart_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 {
   FAR struct inode *inode = filep->f_inode;
   FAR uart_dev_t   *dev   = inode->i_private;
+#ifdef CONFIG_SERIAL_TERMIOS
+  FAR struct termios *termiosp = (FAR struct termios *)((uintptr_t)arg);
+  bool              istermios = ((cmd == TCGETS || cmd == TCSETS) && termiosp);
+#endif
+  int               ret;
+
+#ifdef CONFIG_SERIAL_TERMIOS
+  /* VMIN and VTIME are handled by the upper half; everything else in the
+   * termios structure belongs to the lower half.
+   */
 
-  return dev->ops->ioctl(filep, cmd, arg);
+  if (istermios)
+    {
+      if (cmd == TCSETS)
+        {
+          dev->vmin  = termiosp->c_cc[VMIN]  > UINT8_MAX ? UINT8_MAX :
+                       (uint8_t)termiosp->c_cc[VMIN];
+          dev->vtime = termiosp->c_cc[VTIME] > UINT8_MAX ? UINT8_MAX :
+                       (uint8_t)termiosp->c_cc[VTIME];
+        }
+      else
+        {
+          memset(termiosp, 0, sizeof(struct termios));
+        }
+    }
+#endif
+
+  ret = dev->ops->ioctl(filep, cmd, arg);
+
+#ifdef CONFIG_SERIAL_TERMIOS
+  if (istermios)
+    {
+      /* The lower half may not support termios at all */
+
+      if (ret == -ENOTTY)
+        {
+          ret = OK;
+        }
+
+      if (cmd == TCGETS && ret == OK)
+        {
+          termiosp->c_cc[VMIN]  = dev->vmin;
+          termiosp->c_cc[VTIME] = dev->vtime;
+        }
+    }
+#endif
+
+  return ret;
 }
 
 /****************************************************************************
@@ -1013,6 +1368,12 @@ static int uart_open(FAR struct file *filep)
       /* Enable the RX interrupt */
 
       uart_enablerxint(dev);
+
+#ifdef CONFIG_SERIAL_DMA
+      /* Start the RX DMA (if supported by the lower half) */
+
+      uart_dmarxfree(dev);
+#endif
       irqrestore(flags);
     }
 
@@ -1048,6 +1409,21 @@ int uart_register(FAR const char *path, FAR uart_dev_t *dev)
   sem_init(&dev->pollsem,  0, 1);
 #endif
 
+#ifdef CONFIG_SERIAL_TERMIOS
+  /* The default is the traditional behavior:  read() returns as soon as any
+   * data is available.
+   */
+
+  dev->vmin        = 1;
+  dev->vtime       = 0;
+  dev->rxthreshold = 1;
+  dev->rxtimer     = wd_create();
+  if (!dev->rxtimer)
+    {
+      return -ENOMEM;
+    }
+#endif
+
   dbg("Registering %s\n", path);
   return register_driver(path, &g_serialops, 0666, dev);
 }
@@ -1068,17 +1444,57 @@ void uart_datareceived(FAR uart_dev_t *dev)
 
   if (dev->recvwaiting)
     {
-      /* Yes... wake it up */
+#ifdef CONFIG_SERIAL_TERMIOS
+      /* Yes... but don't wake it up until enough data has been buffered to
+       * satisfy its VMIN threshold (or until the buffer is full).  If VTIME
+       * is an inter-byte timeout, (re-)start the timer on each byte,
+       * including the first.
+       */
 
-      dev->recvwaiting = false;
-      (void)sem_post(&dev->recvsem);
+      int16_t nbytes = uart_recvcount(dev);
+
+      if (nbytes < dev->rxthreshold && nbytes < dev->recv.size - 1)
+        {
+          if (dev->rxinterbyte)
+            {
+              (void)wd_start(dev->rxtimer, DSEC2TICK(dev->vtime),
+                             uart_rxtimeout, 1, (uint32_t)dev);
+            }
+        }
+      else
+#endif
+        {
+          /* Yes... wake it up */
+
+          dev->recvwaiting = false;
+          (void)sem_post(&dev->recvsem);
+        }
     }
 
   /* Notify all poll/select waiters that they can read from the recv buffer */
 
   uart_pollnotify(dev, POLLIN);
+}
 
+/************************************************************************************
+ * Name: uart_recvidle
+ *
+ * Description:
+ *   This function may be called by the lower half when it detects that the RX
+ *   line has gone idle after receiving data (for example, from an IDLE line
+ *   interrupt or a receiver timeout).  Any new RX data must already have been
+ *   added to the recv buffer.  A reader that is waiting for more data to satisfy
+ *   its VMIN threshold will be awakened and will return the data received so
+ *   far.  This allows framed protocols to receive one frame per wakeup.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_TERMIOS
+void uart_recvidle(FAR uart_dev_t *dev)
+{
+  uart_rxexpired(dev);
 }
+#endif
 
 /************************************************************************************
  * Name: uart_datasent
@@ -0,0 +1,270 @@
+/************************************************************************************
+ * drivers/serial/serial_dma.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ************************************************************************************/
+
+/************************************************************************************
+ * Included Files
+ ************************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <semaphore.h>
+#include <debug.h>
+
+#include <nuttx/serial/serial.h>
+
+#ifdef CONFIG_SERIAL_DMA
+
+/************************************************************************************
+ * Pre-processor Definitions
+ ************************************************************************************/
+
+/************************************************************************************
+ * Private Types
+ ************************************************************************************/
+
+/************************************************************************************
+ * Private Function Prototypes
+ ************************************************************************************/
+
+/************************************************************************************
+ * Private Variables
+ ************************************************************************************/
+
+/************************************************************************************
+ * Private Functions
+ ************************************************************************************/
+
+/************************************************************************************
+ * Public Functions
+ ************************************************************************************/
+
+/************************************************************************************
+ * Name: uart_xmitchars_dma
+ *
+ * Description:
+ *   Set up to transfer the contents of the xmit buffer using DMA.  This function
+ *   describes the pending TX data in dev->dmatx and calls the lower half dmasend()
+ *   method.  It is normally called by the lower half from its dmatxavail() method
+ *   or from its TX DMA completion logic.
+ *
+ ************************************************************************************/
+
+void uart_xmitchars_dma(FAR uart_dev_t *dev)
+{
+  FAR struct uart_dmaxfer_s *xfer = &dev->dmatx;
+  int16_t head = dev->xmit.head;
+  int16_t tail = dev->xmit.tail;
+
+  /* Is there anything to send? */
+
+  if (head == tail)
+    {
+      return;
+    }
+
+  /* Describe the data in the buffer beginning at the tail index.  If the
+   * data wraps around the end of the buffer, then there are two regions.
+   */
+
+  xfer->buffer = &dev->xmit.buffer[tail];
+  xfer->nbytes = 0;
+
+  if (tail < head)
+    {
+      xfer->length  = head - tail;
+      xfer->nbuffer = dev->xmit.buffer;
+      xfer->nlength = 0;
+    }
+  else
+    {
+      xfer->length  = dev->xmit.size - tail;
+      xfer->nbuffer = dev->xmit.buffer;
+      xfer->nlength = head;
+    }
+
+  /* Start the transfer */
+
+  uart_dmasend(dev);
+}
+
+/************************************************************************************
+ * Name: uart_xmitchars_done
+ *
+ * Description:
+ *   Perform xmit-related operations after the completion of a TX DMA transfer.
+ *   The lower half must have set dev->dmatx.nbytes to the number of bytes sent.
+ *
+ ************************************************************************************/
+
+void uart_xmitchars_done(FAR uart_dev_t *dev)
+{
+  FAR struct uart_dmaxfer_s *xfer = &dev->dmatx;
+  size_t nbytes = xfer->nbytes;
+  int tail;
+
+  /* Remove the transferred data from the xmit buffer with a single update of
+   * the tail index.
+   */
+
+  if (nbytes > 0)
+    {
+      tail = dev->xmit.tail + nbytes;
+      if (tail >= dev->xmit.size)
+        {
+          tail -= dev->xmit.size;
+        }
+
+      dev->xmit.tail = tail;
+    }
+
+  xfer->buffer  = NULL;
+  xfer->nbuffer = NULL;
+  xfer->length  = 0;
+  xfer->nlength = 0;
+  xfer->nbytes  = 0;
+
+  /* If any bytes were removed from the buffer, inform any waiters there there
+   * is space available.
+   */
+
+  if (nbytes > 0)
+    {
+      uart_datasent(dev);
+    }
+}
+
+/************************************************************************************
+ * Name: uart_recvchars_dma
+ *
+ * Description:
+ *   Set up to receive into the free space of the recv buffer using DMA.  This
+ *   function describes the free regions in dev->dmarx and calls the lower half
+ *   dmareceive() method.
+ *
+ ************************************************************************************/
+
+void uart_recvchars_dma(FAR uart_dev_t *dev)
+{
+  FAR struct uart_dmaxfer_s *xfer = &dev->dmarx;
+  int16_t head = dev->recv.head;
+  int16_t tail = dev->recv.tail;
+
+  /* Describe the free space in the buffer beginning at the head index.  One
+   * byte is always left unused so that a full buffer can be distinguished from
+   * an empty one.
+   */
+
+  xfer->buffer  = &dev->recv.buffer[head];
+  xfer->nbuffer = dev->recv.buffer;
+  xfer->nbytes  = 0;
+
+  if (tail > head)
+    {
+      xfer->length  = tail - head - 1;
+      xfer->nlength = 0;
+    }
+  else if (tail == 0)
+    {
+      xfer->length  = dev->recv.size - head - 1;
+      xfer->nlength = 0;
+    }
+  else
+    {
+      xfer->length  = dev->recv.size - head;
+      xfer->nlength = tail - 1;
+    }
+
+  /* Is there any space to receive into? */
+
+  if (xfer->length == 0 && xfer->nlength == 0)
+    {
+      return;
+    }
+
+  /* Start the transfer */
+
+  uart_dmareceive(dev);
+}
+
+/************************************************************************************
+ * Name: uart_recvchars_done
+ *
+ * Description:
+ *   Perform recv-related operations after the completion of an RX DMA transfer.
+ *   The lower half must have set dev->dmarx.nbytes to the number of bytes
+ *   received.
+ *
+ ************************************************************************************/
+
+void uart_recvchars_done(FAR uart_dev_t *dev)
+{
+  FAR struct uart_dmaxfer_s *xfer = &dev->dmarx;
+  size_t nbytes = xfer->nbytes;
+  int head;
+
+  /* Add the received data to the recv buffer with a single update of the head
+   * index.
+   */
+
+  if (nbytes > 0)
+    {
+      head = dev->recv.head + nbytes;
+      if (head >= dev->recv.size)
+        {
+          head -= dev->recv.size;
+        }
+
+      dev->recv.head = head;
+    }
+
+  xfer->buffer  = NULL;
+  xfer->nbuffer = NULL;
+  xfer->length  = 0;
+  xfer->nlength = 0;
+  xfer->nbytes  = 0;
+
+  /* If any bytes were added to the buffer, inform any waiters there there is
+   * new incoming data available.
+   */
+
+  if (nbytes > 0)
+    {
+      uart_datareceived(dev);
+    }
+}
+
+#endif /* CONFIG_SERIAL_DMA */
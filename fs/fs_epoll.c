@@ -0,0 +1,606 @@
+/****************************************************************************
+ * fs/fs_epoll.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/epoll.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <poll.h>
+#include <sched.h>
+#include <wdog.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <arch/irq.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/clock.h>
+
+#include "fs_internal.h"
+
+#if defined(CONFIG_FS_EPOLL) && !defined(CONFIG_DISABLE_POLL) && \
+    CONFIG_NFILE_DESCRIPTORS > 0
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef CONFIG_FS_EPOLL_NINSTANCES
+#  define CONFIG_FS_EPOLL_NINSTANCES 2
+#endif
+
+/* The option bits in the requested events.  These are not passed to the
+ * driver.
+ */
+
+#define EPOLL_OPTIONS (EPOLLET|EPOLLONESHOT)
+
+#define SIZEOF_EPOLL_HEAD_S(n) \
+  (sizeof(struct epoll_head_s) + ((n) - 1) * sizeof(struct epoll_entry_s))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One descriptor in the interest set.  The pollfd structure is registered
+ * with the driver (or with net_poll()) when the descriptor is added and
+ * remains registered until it is removed.  The driver reports events in
+ * the usual way:  By setting pfd.revents and posting pfd.sem, which is the
+ * semaphore of the interest set.
+ */
+
+struct epoll_entry_s
+{
+  struct pollfd pfd;              /* Persistent poll slot */
+  epoll_data_t  data;             /* User data returned with the events */
+  int16_t       link;             /* Next entry in the re-arm list */
+  uint8_t       options;          /* EPOLLET and/or EPOLLONESHOT */
+  bool          armed;            /* True: pfd is registered with the driver */
+  bool          pending;          /* True: Entry is in the re-arm list */
+};
+
+/* One interest set */
+
+struct epoll_head_s
+{
+  sem_t         sem;              /* Posted on any event in the set */
+  uint16_t      size;             /* Number of entries in the set */
+  uint16_t      next;             /* Where the next ready scan begins */
+  int16_t       rearm;            /* Head of the list of entries to re-arm */
+  volatile bool expired;          /* True: epoll_wait() timeout expired */
+  struct epoll_entry_s entry[1];  /* Actual size is 'size' */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The table of allocated interest sets.  An epoll handle is an index into
+ * this table.
+ */
+
+static FAR struct epoll_head_s *g_epoll[CONFIG_FS_EPOLL_NINSTANCES];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_head
+ *
+ * Description:
+ *   Map an epoll handle to the interest set
+ *
+ ****************************************************************************/
+
+static inline FAR struct epoll_head_s *epoll_head(int epfd)
+{
+  if ((unsigned int)epfd >= CONFIG_FS_EPOLL_NINSTANCES)
+    {
+      return NULL;
+    }
+
+  return g_epoll[epfd];
+}
+
+/****************************************************************************
+ * Name: epoll_find
+ *
+ * Description:
+ *   Find the entry for 'fd' in the interest set
+ *
+ ****************************************************************************/
+
+static FAR struct epoll_entry_s *epoll_find(FAR struct epoll_head_s *eph,
+                                            int fd)
+{
+  int i;
+
+  for (i = 0; i < eph->size; i++)
+    {
+      if (eph->entry[i].pfd.fd == fd)
+        {
+          return &eph->entry[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: epoll_arm
+ *
+ * Description:
+ *   Register the entry's pollfd with the driver.  If the descriptor is
+ *   already ready, the driver will set revents and post the semaphore
+ *   immediately.
+ *
+ ****************************************************************************/
+
+static int epoll_arm(FAR struct epoll_head_s *eph,
+                     FAR struct epoll_entry_s *entry)
+{
+  int ret;
+
+  entry->pfd.sem     = &eph->sem;
+  entry->pfd.revents = 0;
+  entry->pfd.priv    = NULL;
+
+  ret = poll_fdsetup(entry->pfd.fd, &entry->pfd, true);
+  entry->armed = (ret >= 0);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: epoll_disarm
+ *
+ * Description:
+ *   Unregister the entry's pollfd from the driver
+ *
+ ****************************************************************************/
+
+static void epoll_disarm(FAR struct epoll_entry_s *entry)
+{
+  if (entry->armed)
+    {
+      (void)poll_fdsetup(entry->pfd.fd, &entry->pfd, false);
+      entry->armed = false;
+    }
+
+  entry->pfd.sem     = NULL;
+  entry->pfd.revents = 0;
+}
+
+/****************************************************************************
+ * Name: epoll_harvest
+ *
+ * Description:
+ *   Collect up to 'maxevents' ready entries.  Only the reported entries are
+ *   touched:  A level-triggered entry is queued for re-arming by the next
+ *   epoll_wait(); an edge-triggered entry just has its revents cleared; a
+ *   one-shot entry is disarmed.  The scan resumes where the previous one
+ *   left off so that a busy descriptor cannot starve the others when
+ *   'maxevents' is small.
+ *
+ ****************************************************************************/
+
+static int epoll_harvest(FAR struct epoll_head_s *eph,
+                         FAR struct epoll_event *evs, int maxevents)
+{
+  FAR struct epoll_entry_s *entry;
+  pollevent_t revents;
+  irqstate_t flags;
+  int nevents = 0;
+  int ndx = eph->next;
+  int i;
+
+  for (i = 0; i < eph->size && nevents < maxevents; i++)
+    {
+      entry = &eph->entry[ndx];
+      if (++ndx >= eph->size)
+        {
+          ndx = 0;
+        }
+
+      if (!entry->armed || entry->pfd.revents == 0)
+        {
+          continue;
+        }
+
+      /* Sample and clear the events.  The driver may post new events from
+       * the interrupt level at any time.
+       */
+
+      flags = irqsave();
+      revents = entry->pfd.revents;
+      entry->pfd.revents = 0;
+      irqrestore(flags);
+
+      evs[nevents].events = revents;
+      evs[nevents].data   = entry->data;
+      nevents++;
+
+      /* Re-arm or disarm as requested */
+
+      if ((entry->options & EPOLLONESHOT) != 0)
+        {
+          epoll_disarm(entry);
+        }
+      else if ((entry->options & EPOLLET) == 0 && !entry->pending)
+        {
+          entry->pending = true;
+          entry->link    = eph->rearm;
+          eph->rearm     = (int16_t)(entry - eph->entry);
+        }
+    }
+
+  eph->next = ndx;
+  return nevents;
+}
+
+/****************************************************************************
+ * Name: epoll_rearm
+ *
+ * Description:
+ *   Re-arm the level-triggered entries that were reported by the previous
+ *   epoll_wait().  This is deferred until now so that the caller has had a
+ *   chance to consume the data:  The driver's poll setup re-evaluates the
+ *   current state and reports the descriptor again only if it is still
+ *   ready.  The cost is proportional to the number of entries reported, not
+ *   to the size of the set.
+ *
+ ****************************************************************************/
+
+static void epoll_rearm(FAR struct epoll_head_s *eph)
+{
+  FAR struct epoll_entry_s *entry;
+
+  while (eph->rearm >= 0)
+    {
+      entry          = &eph->entry[eph->rearm];
+      eph->rearm     = entry->link;
+      entry->pending = false;
+
+      /* The entry may have been removed or disarmed since it was queued */
+
+      if (entry->pfd.fd >= 0 && entry->armed)
+        {
+          (void)poll_fdsetup(entry->pfd.fd, &entry->pfd, false);
+          (void)epoll_arm(eph, entry);
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_timeout
+ *
+ * Description:
+ *   The wdog expired before any events were received.
+ *
+ ****************************************************************************/
+
+static void epoll_timeout(int argc, uint32_t arg, ...)
+{
+  FAR struct epoll_head_s *eph = (FAR struct epoll_head_s *)arg;
+
+  eph->expired = true;
+  sem_post(&eph->sem);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_create
+ *
+ * Description:
+ *   Create a persistent interest set.  See include/sys/epoll.h.
+ *
+ ****************************************************************************/
+
+int epoll_create(int size)
+{
+  FAR struct epoll_head_s *eph;
+  int err;
+  int epfd;
+  int i;
+
+  if (size <= 0 || size > INT16_MAX)
+    {
+      err = EINVAL;
+      goto errout;
+    }
+
+  /* Allocate and initialize the interest set */
+
+  eph = (FAR struct epoll_head_s *)kzalloc(SIZEOF_EPOLL_HEAD_S(size));
+  if (!eph)
+    {
+      err = ENOMEM;
+      goto errout;
+    }
+
+  sem_init(&eph->sem, 0, 0);
+  eph->size  = size;
+  eph->rearm = -1;
+
+  for (i = 0; i < size; i++)
+    {
+      eph->entry[i].pfd.fd = -1;
+    }
+
+  /* Then find a free handle for it */
+
+  sched_lock();
+  for (epfd = 0; epfd < CONFIG_FS_EPOLL_NINSTANCES; epfd++)
+    {
+      if (g_epoll[epfd] == NULL)
+        {
+          g_epoll[epfd] = eph;
+          sched_unlock();
+          return epfd;
+        }
+    }
+
+  sched_unlock();
+  sem_destroy(&eph->sem);
+  kfree(eph);
+  err = EMFILE;
+
+errout:
+  set_errno(err);
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: epoll_close
+ *
+ * Description:
+ *   Release an interest set.  See include/sys/epoll.h.
+ *
+ ****************************************************************************/
+
+void epoll_close(int epfd)
+{
+  FAR struct epoll_head_s *eph = epoll_head(epfd);
+  int i;
+
+  if (eph)
+    {
+      g_epoll[epfd] = NULL;
+
+      for (i = 0; i < eph->size; i++)
+        {
+          if (eph->entry[i].pfd.fd >= 0)
+            {
+              epoll_disarm(&eph->entry[i]);
+            }
+        }
+
+      sem_destroy(&eph->sem);
+      kfree(eph);
+    }
+}
+
+/****************************************************************************
+ * Name: epoll_ctl
+ *
+ * Description:
+ *   Modify an interest set.  See include/sys/epoll.h.
+ *
+ ****************************************************************************/
+
+int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
+{
+  FAR struct epoll_head_s *eph = epoll_head(epfd);
+  FAR struct epoll_entry_s *entry;
+  int ret;
+
+  if (!eph || fd < 0)
+    {
+      ret = -EBADF;
+      goto errout;
+    }
+
+  if (op != EPOLL_CTL_DEL && !ev)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  switch (op)
+    {
+      case EPOLL_CTL_ADD:
+        if (epoll_find(eph, fd) != NULL)
+          {
+            ret = -EEXIST;
+            goto errout;
+          }
+
+        /* Use the first free entry */
+
+        entry = epoll_find(eph, -1);
+        if (!entry)
+          {
+            ret = -ENOSPC;
+            goto errout;
+          }
+
+        entry->pfd.fd = fd;
+        break;
+
+      case EPOLL_CTL_MOD:
+      case EPOLL_CTL_DEL:
+        entry = epoll_find(eph, fd);
+        if (!entry)
+          {
+            ret = -ENOENT;
+            goto errout;
+          }
+
+        epoll_disarm(entry);
+        if (op == EPOLL_CTL_DEL)
+          {
+            entry->pfd.fd = -1;
+            return OK;
+          }
+        break;
+
+      default:
+        ret = -EINVAL;
+        goto errout;
+    }
+
+  /* Register the (new or modified) entry with the driver */
+
+  entry->pfd.events = (pollevent_t)(ev->events & ~EPOLL_OPTIONS);
+  entry->options    = (uint8_t)(ev->events & EPOLL_OPTIONS);
+  entry->data       = ev->data;
+
+  ret = epoll_arm(eph, entry);
+  if (ret < 0)
+    {
+      /* The driver refused the descriptor.  Don't keep it in the set. */
+
+      entry->pfd.fd = -1;
+      goto errout;
+    }
+
+  return OK;
+
+errout:
+  set_errno(-ret);
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: epoll_wait
+ *
+ * Description:
+ *   Wait for events on an interest set.  See include/sys/epoll.h.
+ *
+ *   Because the descriptors stay registered with their drivers, the cost of
+ *   each call is independent of the number of descriptors in the set
+ *   except for the scan of the in-memory entries:  No driver poll methods
+ *   are called other than to re-arm the descriptors that are reported.
+ *
+ ****************************************************************************/
+
+int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents,
+               int timeout)
+{
+  FAR struct epoll_head_s *eph = epoll_head(epfd);
+  WDOG_ID wdog = NULL;
+  int nevents;
+  int err = 0;
+
+  if (!eph)
+    {
+      set_errno(EBADF);
+      return ERROR;
+    }
+
+  if (!evs || maxevents <= 0)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  eph->expired = false;
+
+  /* Re-arm the level-triggered descriptors reported by the last call */
+
+  epoll_rearm(eph);
+
+  for (;;)
+    {
+      /* Return any descriptors that are already ready */
+
+      nevents = epoll_harvest(eph, evs, maxevents);
+      if (nevents > 0 || timeout == 0 || eph->expired)
+        {
+          break;
+        }
+
+      /* Start the timeout the first time that we have to wait.  Note that
+       * the millisecond timeout has to be converted to system clock ticks
+       * for wd_start.
+       */
+
+      if (timeout > 0 && !wdog)
+        {
+          wdog = wd_create();
+          if (!wdog)
+            {
+              /* Without a watchdog the timeout could never expire */
+
+              err = ENOMEM;
+              break;
+            }
+
+          wd_start(wdog, MSEC2TICK(timeout), (wdentry_t)epoll_timeout, 1,
+                   (uint32_t)eph);
+        }
+
+      /* Wait for a driver to post an event (or for the timeout) */
+
+      if (sem_wait(&eph->sem) < 0)
+        {
+          err = get_errno();
+          break;
+        }
+    }
+
+  if (wdog)
+    {
+      wd_delete(wdog);
+    }
+
+  if (err != 0)
+    {
+      set_errno(err);
+      return ERROR;
+    }
+
+  return nevents;
+}
+
+#endif /* CONFIG_FS_EPOLL && !CONFIG_DISABLE_POLL */
@@ -319,6 +319,21 @@ EXTERN void files_release(int filedes);
 EXTERN int find_blockdriver(FAR const char *pathname, int mountflags,
                             FAR struct inode **ppinode);
 
+/* fs_poll.c ****************************************************************/
+/****************************************************************************
+ * Name: poll_fdsetup
+ *
+ * Description:
+ *   Configure (or unconfigure) one file/socket descriptor for the poll
+ *   operation.  Used by poll() and by the persistent epoll interest sets.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_DISABLE_POLL) && CONFIG_NFILE_DESCRIPTORS > 0
+struct pollfd;
+EXTERN int poll_fdsetup(int fd, FAR struct pollfd *fds, bool setup);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
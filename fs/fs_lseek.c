@@ -52,6 +52,74 @@
  * Global Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: file_seek
+ *
+ * Description:
+ *   Reposition the file offset of an open file.  This is the internal
+ *   lseek() logic that operates on a file structure rather than a file
+ *   descriptor.
+ *
+ * Returned Value:
+ *   The resulting offset on success; a negated errno value on failure.
+ *   errno is NOT set.
+ *
+ ****************************************************************************/
+
+off_t file_seek(FAR struct file *filep, off_t offset, int whence)
+{
+  FAR struct inode *inode = filep->f_inode;
+  off_t ret;
+
+  /* Is a driver registered? */
+
+  if (inode && inode->u.i_ops)
+    {
+      /* Does it support the seek method */
+
+      if (inode->u.i_ops->seek)
+        {
+          /* Yes, then let it perform the seek */
+
+          ret = inode->u.i_ops->seek(filep, offset, whence);
+          if (ret < 0)
+            {
+              return ret;
+            }
+         }
+      else
+        {
+          /* No... there are a couple of default actions we can take */
+
+          switch (whence)
+            {
+              case SEEK_CUR:
+                offset += filep->f_pos;
+
+              case SEEK_SET:
+                if (offset >= 0)
+                  {
+                    filep->f_pos = offset; /* Might be beyond the end-of-file */
+                    break;
+                  }
+                else
+                  {
+                    return -EINVAL;
+                  }
+                break;
+
+              case SEEK_END:
+                return -ENOSYS;
+
+              default:
+                return -EINVAL;
+            }
+        }
+    }
+
+  return filep->f_pos;
+}
+
 /****************************************************************************
  * Name: lseek
  *
@@ -92,8 +160,7 @@
 off_t lseek(int fd, off_t offset, int whence)
 {
   FAR struct filelist *list;
-  FAR struct file     *filep;
-  FAR struct inode    *inode;
+  off_t                ret;
   int                  err;
 
   /* Did we get a valid file descriptor? */
@@ -113,60 +180,16 @@ off_t lseek(int fd, off_t offset, int whence)
       goto errout;
     }
 
-  /* Is a driver registered? */
-
-  filep = &list->fl_files[fd];
-  inode =  filep->f_inode;
+  /* Then let file_seek do the real work */
 
-  if (inode && inode->u.i_ops)
+  ret = file_seek(&list->fl_files[fd], offset, whence);
+  if (ret < 0)
     {
-      /* Does it support the seek method */
-
-      if (inode->u.i_ops->seek)
-        {
-          /* Yes, then let it perform the seek */
-
-          err = (int)inode->u.i_ops->seek(filep, offset, whence);
-          if (err < 0)
-            {
-              err = -err;
-              goto errout;
-            }
-         }
-      else
-        {
-          /* No... there are a couple of default actions we can take */
-
-          switch (whence)
-            {
-              case SEEK_CUR:
-                offset += filep->f_pos;
-
-              case SEEK_SET:
-                if (offset >= 0)
-                  {
-                    filep->f_pos = offset; /* Might be beyond the end-of-file */
-                    break;
-                  }
-                else
-                  {
-                    err = EINVAL;
-                    goto errout;
-                  }
-                break;
-
-              case SEEK_END:
-                err = ENOSYS;
-                goto errout;
-
-              default:
-                err = EINVAL;
-                goto errout;
-            }
-        }
+      err = (int)-ret;
+      goto errout;
     }
 
-  return filep->f_pos;
+  return ret;
 
 errout:
   set_errno(err);
@@ -49,74 +49,56 @@
 #include "fs_internal.h"
 
 /****************************************************************************
- * Private Functions
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: file_read
+ *
+ * Description:
+ *   Read data from an open file.  This is the internal read() logic that
+ *   operates on a file structure rather than a file descriptor.  It is used
+ *   by read() and by OS internal logic (such as the kernel sendfile()) that
+ *   already holds a reference to the file structure.
+ *
+ * Returned Value:
+ *   The number of bytes read on success; a negated errno value on failure.
+ *   errno is NOT set.
+ *
  ****************************************************************************/
 
 #if CONFIG_NFILE_DESCRIPTORS > 0
-static inline ssize_t file_read(int fd, FAR void *buf, size_t nbytes)
+ssize_t file_read(FAR struct file *filep, FAR void *buf, size_t nbytes)
 {
-  FAR struct filelist *list;
-  int ret = -EBADF;
+  FAR struct inode *inode = filep->f_inode;
 
-  /* Get the thread-specific file list */
+  /* Was this file opened for read access? */
 
-  list = sched_getfiles();
-  if (!list)
+  if ((filep->f_oflags & O_RDOK) == 0)
     {
-      /* Failed to get the file list */
+      /* No.. File is not read-able */
 
-      ret = -EMFILE;
+      return -EACCES;
     }
 
-  /* Were we given a valid file descriptor? */
+  /* Is a driver or mountpoint registered? If so, does it support
+   * the read method?
+   */
 
-  else if ((unsigned int)fd < CONFIG_NFILE_DESCRIPTORS)
+  if (inode && inode->u.i_ops && inode->u.i_ops->read)
     {
-      FAR struct file *this_file = &list->fl_files[fd];
-      FAR struct inode *inode    = this_file->f_inode;
-
-      /* Yes.. Was this file opened for read access? */
-
-      if ((this_file->f_oflags & O_RDOK) == 0)
-        {
-          /* No.. File is not read-able */
-
-          ret = -EACCES;
-        }
-
-      /* Is a driver or mountpoint registered? If so, does it support
-       * the read method?
+      /* Yes.. then let it perform the read.  NOTE that for the case
+       * of the mountpoint, we depend on the read methods bing
+       * identical in signature and position in the operations vtable.
        */
 
-      else if (inode && inode->u.i_ops && inode->u.i_ops->read)
-        {
-          /* Yes.. then let it perform the read.  NOTE that for the case
-           * of the mountpoint, we depend on the read methods bing
-           * identical in signature and position in the operations vtable.
-           */
-
-          ret = (int)inode->u.i_ops->read(this_file, (char*)buf, (size_t)nbytes);
-        }
-    }
-
-  /* If an error occurred, set errno and return -1 (ERROR) */
-
-  if (ret < 0)
-    {
-      set_errno(-ret);
-      return ERROR;
+      return inode->u.i_ops->read(filep, (char*)buf, (size_t)nbytes);
     }
 
-  /* Otherwise, return the number of bytes read */
-
-  return ret;
+  return -EBADF;
 }
 #endif
 
-/****************************************************************************
- * Public Functions
- ****************************************************************************/
-
 ssize_t read(int fd, FAR void *buf, size_t nbytes)
 {
   /* Did we get a valid file descriptor? */
@@ -142,6 +124,36 @@ ssize_t read(int fd, FAR void *buf, size_t nbytes)
   /* The descriptor is in a valid range to file descriptor... do the read */
 
 #if CONFIG_NFILE_DESCRIPTORS > 0
-  return file_read(fd, buf, nbytes);
+  else
+    {
+      FAR struct filelist *list;
+      ssize_t ret;
+
+      /* Get the thread-specific file list */
+
+      list = sched_getfiles();
+      if (!list)
+        {
+          /* Failed to get the file list */
+
+          set_errno(EMFILE);
+          return ERROR;
+        }
+
+      /* Then let file_read do all of the work */
+
+      ret = file_read(&list->fl_files[fd], buf, nbytes);
+      if (ret < 0)
+        {
+          /* If an error occurred, set errno and return -1 (ERROR) */
+
+          set_errno((int)-ret);
+          return ERROR;
+        }
+
+      /* Otherwise, return the number of bytes read */
+
+      return ret;
+    }
 #endif
 }
@@ -0,0 +1,113 @@
+/****************************************************************************
+ * fs/fs_sendfile.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/sendfile.h>
+#include <sched.h>
+#include <errno.h>
+
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "fs_internal.h"
+
+#if defined(CONFIG_NET_SENDFILE) && CONFIG_NFILE_DESCRIPTORS > 0
+
+/****************************************************************************
+ * Global Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sendfile
+ *
+ * Description:
+ *   sendfile() copies data between one file descriptor and another.  This
+ *   is the OS version of sendfile() that is used when CONFIG_NET_SENDFILE
+ *   is selected.  If 'infd' refers to a regular file on a mounted volume
+ *   and 'outfd' refers to a connected TCP socket, then the transfer is
+ *   performed by the network layer with no intermediate user buffer.  All
+ *   other combinations of descriptors (including character drivers such as
+ *   pipes and serial ports, which may block and cannot seek) fall back to
+ *   the generic read()/write() loop of lib_sendfile().
+ *
+ *   See include/sys/sendfile.h for a full description of the parameters
+ *   and returned values.
+ *
+ ****************************************************************************/
+
+ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
+{
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+  /* Is 'infd' a file descriptor and 'outfd' a socket descriptor? */
+
+  if ((unsigned int)infd < CONFIG_NFILE_DESCRIPTORS &&
+      (unsigned int)outfd >= CONFIG_NFILE_DESCRIPTORS)
+    {
+      FAR struct filelist *list;
+      FAR struct file *filep;
+
+      /* Get the thread-specific file list */
+
+      list = sched_getfiles();
+      if (!list)
+        {
+          set_errno(EMFILE);
+          return ERROR;
+        }
+
+      /* Only regular files on a mounted volume are sent by the network
+       * layer.  Everything else uses the read()/write() loop below.
+       */
+
+      filep = &list->fl_files[infd];
+      if (filep->f_inode && INODE_IS_MOUNTPT(filep->f_inode))
+        {
+          return net_sendfile(outfd, filep, offset, count);
+        }
+    }
+#endif
+
+  /* No... use the generic read()/write() implementation */
+
+  return lib_sendfile(outfd, infd, offset, count);
+}
+
+#endif /* CONFIG_NET_SENDFILE && CONFIG_NFILE_DESCRIPTORS > 0 */
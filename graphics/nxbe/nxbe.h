@@ -62,6 +62,46 @@
 #  define CONFIG_NX_NCOLORS 256
 #endif
 
+/* Damage tracking and the shadow framebuffer are only supported in
+ * multi-user mode:  The damaged regions and the changed regions of the
+ * shadow framebuffer are flushed by the NX server message loop once per
+ * frame.  There is no shadow framebuffer for LCD devices.
+ */
+
+#ifndef CONFIG_NX_MULTIUSER
+#  undef CONFIG_NX_DAMAGE
+#  undef CONFIG_NX_FBSHADOW
+#  undef CONFIG_NX_BATCH
+#endif
+
+#ifdef CONFIG_NX_LCDDRIVER
+#  undef CONFIG_NX_FBSHADOW
+#endif
+
+#ifdef CONFIG_NX_DAMAGE
+#  ifndef CONFIG_NX_NDAMAGE
+#    define CONFIG_NX_NDAMAGE 8      /* Max number of damaged regions */
+#  endif
+#endif
+
+#ifdef CONFIG_NX_FBSHADOW
+#  ifndef CONFIG_NX_NDIRTY
+#    define CONFIG_NX_NDIRTY 8       /* Max number of changed regions */
+#  endif
+#endif
+
+#if defined(CONFIG_NX_DAMAGE) || defined(CONFIG_NX_FBSHADOW)
+#  ifndef CONFIG_NX_FRAMEMS
+#    define CONFIG_NX_FRAMEMS 20     /* Frame period in milliseconds */
+#  endif
+#endif
+
+#ifdef CONFIG_NX_BATCH
+#  ifndef CONFIG_NX_BATCHCLIP
+#    define CONFIG_NX_BATCHCLIP 8    /* Max visible regions per batch */
+#  endif
+#endif
+
 /* NXBE Definitions *********************************************************/
 /* These are the values for the clipping order provided to nx_clipper */
 
@@ -177,6 +217,21 @@ struct nxbe_window_s
   FAR void *arg;
 };
 
+/* This structure holds the visible parts of a window.  It is filled once
+ * by nxbe_cliplist() and then used to clip each of a batch of drawing
+ * commands to the window.
+ */
+
+#ifdef CONFIG_NX_BATCH
+struct nxbe_cliplist_s
+{
+  FAR struct nxbe_window_s *wnd;      /* The window that was clipped */
+  bool overflow;                      /* True: Too many visible regions */
+  uint8_t nrects;                     /* Number of visible regions */
+  struct nxgl_rect_s rect[CONFIG_NX_BATCHCLIP]; /* Visible regions */
+};
+#endif
+
 /* Back-end state ***********************************************************/
 
 /* This structure describes the overall back-end window state */
@@ -206,6 +261,28 @@ struct nxbe_state_s
   /* Rasterizing functions selected to match the BPP reported in pinfo[] */
 
   struct nxbe_plane_s plane[CONFIG_NX_NPLANES];
+
+#ifdef CONFIG_NX_DAMAGE
+  /* Regions of the display that must be redrawn at the next frame.  The
+   * regions are in absolute screen coordinates and do not overlap.
+   */
+
+  uint8_t ndamage;                  /* Number of damaged regions */
+  struct nxgl_rect_s damage[CONFIG_NX_NDAMAGE];
+#endif
+
+#ifdef CONFIG_NX_FBSHADOW
+  /* When the shadow framebuffer is used, plane[n].pinfo.fbmem refers to an
+   * off-screen copy of the display and all rendering is done there.  The
+   * regions changed since the last frame are copied to the real framebuffer
+   * memory at the end of the frame.
+   */
+
+  FAR NX_DRIVERTYPE *dev;           /* The framebuffer driver */
+  FAR void *fbmem[CONFIG_NX_NPLANES]; /* The real framebuffer memory */
+  uint8_t ndirty;                   /* Number of changed regions */
+  struct nxgl_rect_s dirty[CONFIG_NX_NDIRTY];
+#endif
 };
 
 /****************************************************************************
@@ -473,6 +550,147 @@ EXTERN void nxbe_redrawbelow(FAR struct nxbe_state_s *be,
                              FAR struct nxbe_window_s *wnd,
                              FAR const struct nxgl_rect_s *rect);
 
+/****************************************************************************
+ * Name: nxbe_rectlistadd
+ *
+ * Descripton:
+ *   Add a rectangle to a bounded list of non-overlapping rectangles,
+ *   merging it with the entries that it overlaps or abuts.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NX_DAMAGE) || defined(CONFIG_NX_FBSHADOW)
+EXTERN void nxbe_rectlistadd(FAR struct nxgl_rect_s *list,
+                             FAR uint8_t *nrects, int mxrects,
+                             FAR const struct nxgl_rect_s *rect);
+#endif
+
+/****************************************************************************
+ * Name: nxbe_damage
+ *
+ * Descripton:
+ *   Add a rectangular region of the display to the list of damaged regions.
+ *   Overlapping and adjacent regions are merged; if the list is full, the
+ *   region is merged with the entry whose area grows the least.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_DAMAGE
+EXTERN void nxbe_damage(FAR struct nxbe_state_s *be,
+                        FAR const struct nxgl_rect_s *rect);
+#endif
+
+/****************************************************************************
+ * Name: nxbe_damagebelow
+ *
+ * Descripton:
+ *   Mark the visible portions of the rectangular region for all windows
+ *   below (and including) the specified window as damaged.  This is the
+ *   deferred form of nxbe_redrawbelow().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_DAMAGE
+EXTERN void nxbe_damagebelow(FAR struct nxbe_state_s *be,
+                             FAR struct nxbe_window_s *wnd,
+                             FAR const struct nxgl_rect_s *rect);
+#endif
+
+/****************************************************************************
+ * Name: nxbe_damageflush
+ *
+ * Descripton:
+ *   Issue one set of redraw requests for each accumulated damaged region
+ *   and empty the damage list.  This is called by the NX server once per
+ *   frame.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_DAMAGE
+EXTERN void nxbe_damageflush(FAR struct nxbe_state_s *be);
+#endif
+
+/****************************************************************************
+ * Name: nxbe_shadowinit
+ *
+ * Descripton:
+ *   Allocate the shadow framebuffer for each color plane and redirect all
+ *   rendering to it.  This is called by nxbe_configure().
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_FBSHADOW
+EXTERN int nxbe_shadowinit(FAR NX_DRIVERTYPE *dev,
+                           FAR struct nxbe_state_s *be);
+#endif
+
+/****************************************************************************
+ * Name: nxbe_shadowdirty
+ *
+ * Descripton:
+ *   Mark a region of the shadow framebuffer as changed.  The region is in
+ *   absolute screen coordinates.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_FBSHADOW
+EXTERN void nxbe_shadowdirty(FAR struct nxbe_state_s *be,
+                             FAR const struct nxgl_rect_s *rect);
+#endif
+
+/****************************************************************************
+ * Name: nxbe_shadowflush
+ *
+ * Descripton:
+ *   Copy all changed regions of the shadow framebuffer to the display.
+ *   This is called by the NX server once per frame.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_FBSHADOW
+EXTERN void nxbe_shadowflush(FAR struct nxbe_state_s *be);
+#endif
+
+/****************************************************************************
+ * Name: nxbe_cliplist
+ *
+ * Descripton:
+ *   Collect the visible parts of a window (in absolute screen coordinates)
+ *   in a clip list.  If the window has more visible parts than the list can
+ *   hold, the overflow flag is set and the batch functions below fall back
+ *   to clipping each command individually.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_BATCH
+EXTERN void nxbe_cliplist(FAR struct nxbe_cliplist_s *list,
+                          FAR struct nxbe_window_s *wnd);
+#endif
+
+/****************************************************************************
+ * Name: nxbe_batchsetpixel, nxbe_batchfill, nxbe_batchfilltrapezoid
+ *
+ * Descripton:
+ *   These are the same as nxbe_setpixel(), nxbe_fill(), and
+ *   nxbe_filltrapezoid() except that the drawing is clipped using a clip
+ *   list prepared by nxbe_cliplist() for the window rather than by
+ *   walking the windows above it for each command.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_BATCH
+EXTERN void nxbe_batchsetpixel(FAR struct nxbe_cliplist_s *list,
+                               FAR const struct nxgl_point_s *pos,
+                               nxgl_mxpixel_t color[CONFIG_NX_NPLANES]);
+EXTERN void nxbe_batchfill(FAR struct nxbe_cliplist_s *list,
+                           FAR const struct nxgl_rect_s *rect,
+                           nxgl_mxpixel_t color[CONFIG_NX_NPLANES]);
+EXTERN void nxbe_batchfilltrapezoid(FAR struct nxbe_cliplist_s *list,
+                                    FAR const struct nxgl_rect_s *clip,
+                                    FAR const struct nxgl_trapezoid_s *trap,
+                                    nxgl_mxpixel_t color[CONFIG_NX_NPLANES]);
+#endif
+
 /****************************************************************************
  * Name: nxbe_visible
  *
@@ -0,0 +1,373 @@
+/****************************************************************************
+ * graphics/nxbe/nxbe_batch.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <fixedmath.h>
+
+#include <nuttx/nx/nxglib.h>
+
+#include "nxbe.h"
+
+#ifdef CONFIG_NX_BATCH
+
+/****************************************************************************
+ * Pre-Processor Definitions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct nxbe_cliplistinfo_s
+{
+  struct nxbe_clipops_s cops;
+  FAR struct nxbe_cliplist_s *list;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_clipvisible
+ *
+ * Description:
+ *  Called from nxbe_clipper() to add each visible portion of the window to
+ *  the clip list.
+ *
+ ****************************************************************************/
+
+static void nxbe_clipvisible(FAR struct nxbe_clipops_s *cops,
+                             FAR struct nxbe_plane_s *plane,
+                             FAR const struct nxgl_rect_s *rect)
+{
+  FAR struct nxbe_cliplist_s *list = ((struct nxbe_cliplistinfo_s *)cops)->list;
+
+  if (list->nrects < CONFIG_NX_BATCHCLIP)
+    {
+      nxgl_rectcopy(&list->rect[list->nrects], rect);
+      list->nrects++;
+    }
+  else
+    {
+      list->overflow = true;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_cliplist
+ *
+ * Description:
+ *   Collect the visible parts of a window in a clip list.
+ *
+ * Input Parameters:
+ *   list - The clip list to be filled
+ *   wnd  - The window structure reference
+ *
+ * Return:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_cliplist(FAR struct nxbe_cliplist_s *list,
+                   FAR struct nxbe_window_s *wnd)
+{
+  struct nxbe_cliplistinfo_s info;
+  struct nxgl_rect_s bounds;
+
+  list->wnd      = wnd;
+  list->overflow = false;
+  list->nrects   = 0;
+
+  /* Clip the window to the limits of the background screen */
+
+  nxgl_rectintersect(&bounds, &wnd->bounds, &wnd->be->bkgd.bounds);
+  if (!nxgl_nullrect(&bounds))
+    {
+      /* Then collect the parts that are not obscured by the windows above */
+
+      info.cops.visible  = nxbe_clipvisible;
+      info.cops.obscured = nxbe_clipnull;
+      info.list          = list;
+
+      nxbe_clipper(wnd->above, &bounds, NX_CLIPORDER_DEFAULT,
+                   &info.cops, &wnd->be->plane[0]);
+    }
+}
+
+/****************************************************************************
+ * Name: nxbe_batchsetpixel
+ *
+ * Description:
+ *  Set a single pixel in the window to the specified color using the
+ *  visible regions in the clip list.
+ *
+ * Input Parameters:
+ *   list  - The clip list of the window
+ *   pos   - The pixel location to be set (in relative window coordinates)
+ *   color - The color to use
+ *
+ * Return:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_batchsetpixel(FAR struct nxbe_cliplist_s *list,
+                        FAR const struct nxgl_point_s *pos,
+                        nxgl_mxpixel_t color[CONFIG_NX_NPLANES])
+{
+  FAR struct nxbe_window_s *wnd = list->wnd;
+  struct nxgl_point_s pt;
+  int i;
+  int j;
+
+  if (list->overflow)
+    {
+      nxbe_setpixel(wnd, pos, color);
+      return;
+    }
+
+  /* Offset the position by the window origin */
+
+  nxgl_vectoradd(&pt, pos, &wnd->bounds.pt1);
+
+  /* Find the visible region that contains the point (if any) */
+
+  for (j = 0; j < list->nrects; j++)
+    {
+      if (nxgl_rectinside(&list->rect[j], &pt))
+        {
+#ifdef CONFIG_NX_FBSHADOW
+          struct nxgl_rect_s rect;
+
+          rect.pt1.x = pt.x;
+          rect.pt1.y = pt.y;
+          rect.pt2.x = pt.x;
+          rect.pt2.y = pt.y;
+          nxbe_shadowdirty(wnd->be, &rect);
+#endif
+
+#if CONFIG_NX_NPLANES > 1
+          for (i = 0; i < wnd->be->vinfo.nplanes; i++)
+#else
+          i = 0;
+#endif
+            {
+              FAR struct nxbe_plane_s *plane = &wnd->be->plane[i];
+              plane->setpixel(&plane->pinfo, &pt, color[i]);
+            }
+
+          return;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nxbe_batchfill
+ *
+ * Description:
+ *  Fill the specified rectangle in the window with the specified color
+ *  using the visible regions in the clip list.
+ *
+ * Input Parameters:
+ *   list  - The clip list of the window
+ *   rect  - The location to be filled (in relative window coordinates)
+ *   color - The color to use in the fill
+ *
+ * Return:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_batchfill(FAR struct nxbe_cliplist_s *list,
+                    FAR const struct nxgl_rect_s *rect,
+                    nxgl_mxpixel_t color[CONFIG_NX_NPLANES])
+{
+  FAR struct nxbe_window_s *wnd = list->wnd;
+  struct nxgl_rect_s remaining;
+  struct nxgl_rect_s part;
+  int i;
+  int j;
+
+  if (list->overflow)
+    {
+      nxbe_fill(wnd, rect, color);
+      return;
+    }
+
+  /* Offset the rectangle by the window origin and clip it to the window
+   * and to the background screen
+   */
+
+  nxgl_rectoffset(&remaining, rect, wnd->bounds.pt1.x, wnd->bounds.pt1.y);
+  nxgl_rectintersect(&remaining, &remaining, &wnd->bounds);
+  nxgl_rectintersect(&remaining, &remaining, &wnd->be->bkgd.bounds);
+  if (nxgl_nullrect(&remaining))
+    {
+      return;
+    }
+
+#ifdef CONFIG_NX_FBSHADOW
+  nxbe_shadowdirty(wnd->be, &remaining);
+#endif
+
+  /* Then fill the part of the rectangle in each visible region */
+
+  for (j = 0; j < list->nrects; j++)
+    {
+      nxgl_rectintersect(&part, &remaining, &list->rect[j]);
+      if (!nxgl_nullrect(&part))
+        {
+#if CONFIG_NX_NPLANES > 1
+          for (i = 0; i < wnd->be->vinfo.nplanes; i++)
+#else
+          i = 0;
+#endif
+            {
+              FAR struct nxbe_plane_s *plane = &wnd->be->plane[i];
+              plane->fillrectangle(&plane->pinfo, &part, color[i]);
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: nxbe_batchfilltrapezoid
+ *
+ * Description:
+ *  Fill the specified trapezoidal region in the window with the specified
+ *  color using the visible regions in the clip list.
+ *
+ * Input Parameters:
+ *   list  - The clip list of the window
+ *   clip  - Clipping region (in relative window coordinates)
+ *   trap  - The trapezoidal region to be filled (in relative window
+ *           coordinates)
+ *   color - The color to use in the fill
+ *
+ * Return:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_batchfilltrapezoid(FAR struct nxbe_cliplist_s *list,
+                             FAR const struct nxgl_rect_s *clip,
+                             FAR const struct nxgl_trapezoid_s *trap,
+                             nxgl_mxpixel_t color[CONFIG_NX_NPLANES])
+{
+  FAR struct nxbe_window_s *wnd = list->wnd;
+  struct nxgl_trapezoid_s abstrap;
+  struct nxgl_rect_s remaining;
+  struct nxgl_rect_s part;
+  int i;
+  int j;
+
+  if (list->overflow)
+    {
+      nxbe_filltrapezoid(wnd, clip, trap, color);
+      return;
+    }
+
+  /* Offset the trapezoid by the window origin and create a bounding box
+   * that contains it.
+   */
+
+  nxgl_trapoffset(&abstrap, trap, wnd->bounds.pt1.x, wnd->bounds.pt1.y);
+
+  remaining.pt1.x = b16toi(ngl_min(abstrap.top.x1, abstrap.bot.x1));
+  remaining.pt1.y = abstrap.top.y;
+  remaining.pt2.x = b16toi(ngl_max(abstrap.top.x2, abstrap.bot.x2));
+  remaining.pt2.y = abstrap.bot.y;
+
+  /* Clip to any user specified clipping window, to the window, and to the
+   * background screen
+   */
+
+  if (clip)
+    {
+      nxgl_rectoffset(&part, clip, wnd->bounds.pt1.x, wnd->bounds.pt1.y);
+      nxgl_rectintersect(&remaining, &remaining, &part);
+    }
+
+  nxgl_rectintersect(&remaining, &remaining, &wnd->bounds);
+  nxgl_rectintersect(&remaining, &remaining, &wnd->be->bkgd.bounds);
+  if (nxgl_nullrect(&remaining))
+    {
+      return;
+    }
+
+#ifdef CONFIG_NX_FBSHADOW
+  nxbe_shadowdirty(wnd->be, &remaining);
+#endif
+
+  /* Then render the part of the trapezoid in each visible region */
+
+  for (j = 0; j < list->nrects; j++)
+    {
+      nxgl_rectintersect(&part, &remaining, &list->rect[j]);
+      if (!nxgl_nullrect(&part))
+        {
+#if CONFIG_NX_NPLANES > 1
+          for (i = 0; i < wnd->be->vinfo.nplanes; i++)
+#else
+          i = 0;
+#endif
+            {
+              FAR struct nxbe_plane_s *plane = &wnd->be->plane[i];
+              plane->filltrapezoid(&plane->pinfo, &abstrap, &part, color[i]);
+            }
+        }
+    }
+}
+
+#endif /* CONFIG_NX_BATCH */
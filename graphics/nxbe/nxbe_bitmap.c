@@ -170,6 +170,10 @@ void nxbe_bitmap(FAR struct nxbe_window_s *wnd, FAR const struct nxgl_rect_s *de
       return;
     }
 
+#ifdef CONFIG_NX_FBSHADOW
+  nxbe_shadowdirty(wnd->be, &remaining);
+#endif
+
   /* Then perform the clipped fill */
 
 #if CONFIG_NX_NPLANES > 1
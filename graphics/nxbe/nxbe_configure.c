@@ -215,5 +215,12 @@ int nxbe_configure(FAR NX_DRIVERTYPE *dev, FAR struct nxbe_state_s *be)
           return -ENOSYS;
         }
     }
+
+  /* Redirect all rendering to the shadow framebuffer */
+
+#ifdef CONFIG_NX_FBSHADOW
+  return nxbe_shadowinit(dev, be);
+#else
   return OK;
+#endif
 }
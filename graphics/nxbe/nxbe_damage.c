@@ -0,0 +1,181 @@
+/****************************************************************************
+ * graphics/nxbe/nxbe_damage.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <debug.h>
+
+#include <nuttx/nx/nxglib.h>
+
+#include "nxbe.h"
+
+#ifdef CONFIG_NX_DAMAGE
+
+/****************************************************************************
+ * Pre-Processor Definitions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct nxbe_damage_s
+{
+  struct nxbe_clipops_s cops;
+  FAR struct nxbe_state_s *be;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_damagevisible
+ *
+ * Description:
+ *   Clipping callback used by nxbe_damagebelow().  Each visible portion of
+ *   the region is added to the damage list.
+ *
+ ****************************************************************************/
+
+static void nxbe_damagevisible(FAR struct nxbe_clipops_s *cops,
+                               FAR struct nxbe_plane_s *plane,
+                               FAR const struct nxgl_rect_s *rect)
+{
+  FAR struct nxbe_state_s *be = ((FAR struct nxbe_damage_s *)cops)->be;
+  nxbe_damage(be, rect);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_damage
+ *
+ * Descripton:
+ *   Add a rectangular region of the display to the list of damaged regions.
+ *   See nxbe_rectlistadd() for the way that regions are merged.
+ *
+ ****************************************************************************/
+
+void nxbe_damage(FAR struct nxbe_state_s *be,
+                 FAR const struct nxgl_rect_s *rect)
+{
+  struct nxgl_rect_s region;
+
+  /* Clip to the limits of the background screen */
+
+  nxgl_rectintersect(&region, rect, &be->bkgd.bounds);
+  if (!nxgl_nullrect(&region))
+    {
+      nxbe_rectlistadd(be->damage, &be->ndamage, CONFIG_NX_NDAMAGE, &region);
+    }
+}
+
+/****************************************************************************
+ * Name: nxbe_damagebelow
+ *
+ * Descripton:
+ *   Mark the visible portions of the rectangular region for all windows
+ *   below (and including) the specified window as damaged.  Portions of the
+ *   region covered by windows above 'wnd' are unaffected and are not added
+ *   to the damage list.
+ *
+ ****************************************************************************/
+
+void nxbe_damagebelow(FAR struct nxbe_state_s *be,
+                      FAR struct nxbe_window_s *wnd,
+                      FAR const struct nxgl_rect_s *rect)
+{
+  struct nxbe_damage_s info;
+  struct nxgl_rect_s remaining;
+
+  nxgl_rectintersect(&remaining, rect, &be->bkgd.bounds);
+  if (!nxgl_nullrect(&remaining))
+    {
+      info.cops.visible  = nxbe_damagevisible;
+      info.cops.obscured = nxbe_clipnull;
+      info.be            = be;
+
+      nxbe_clipper(wnd->above, &remaining, NX_CLIPORDER_DEFAULT,
+                   &info.cops, &be->plane[0]);
+    }
+}
+
+/****************************************************************************
+ * Name: nxbe_damageflush
+ *
+ * Descripton:
+ *   Issue the redraw requests for all accumulated damaged regions and empty
+ *   the damage list.  The windows are visited from the top of the display
+ *   to the bottom so that each damaged pixel is requested exactly once, from
+ *   the window that is visible at that pixel.
+ *
+ ****************************************************************************/
+
+void nxbe_damageflush(FAR struct nxbe_state_s *be)
+{
+  FAR struct nxbe_window_s *wnd;
+  int i;
+
+  for (i = 0; i < be->ndamage; i++)
+    {
+      gvdbg("Damage rect={(%d,%d),(%d,%d)}\n",
+            be->damage[i].pt1.x, be->damage[i].pt1.y,
+            be->damage[i].pt2.x, be->damage[i].pt2.y);
+
+      for (wnd = be->topwnd; wnd; wnd = wnd->below)
+        {
+          nxbe_redraw(be, wnd, &be->damage[i]);
+        }
+    }
+
+  be->ndamage = 0;
+}
+
+#endif /* CONFIG_NX_DAMAGE */
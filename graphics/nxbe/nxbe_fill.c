@@ -140,6 +140,10 @@ void nxbe_fill(FAR struct nxbe_window_s *wnd,
 
   if (!nxgl_nullrect(&remaining))
     {
+#ifdef CONFIG_NX_FBSHADOW
+      nxbe_shadowdirty(wnd->be, &remaining);
+#endif
+
 #if CONFIG_NX_NPLANES > 1
       for (i = 0; i < wnd->be->vinfo.nplanes; i++)
 #else
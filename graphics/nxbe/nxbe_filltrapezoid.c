@@ -157,6 +157,10 @@ void nxbe_filltrapezoid(FAR struct nxbe_window_s *wnd,
       info.cops.visible  = nxbe_clipfilltrapezoid;
       info.cops.obscured = nxbe_clipnull;
 
+#ifdef CONFIG_NX_FBSHADOW
+      nxbe_shadowdirty(wnd->be, &remaining);
+#endif
+
       /* Then process each color plane */
 
 #if CONFIG_NX_NPLANES > 1
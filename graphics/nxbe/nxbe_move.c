@@ -270,6 +270,18 @@ void nxbe_move(FAR struct nxbe_window_s *wnd, FAR const struct nxgl_rect_s *rect
         }
     }
 
+  /* Only the destination of the move is changed in the framebuffer */
+
+#ifdef CONFIG_NX_FBSHADOW
+  {
+    struct nxgl_rect_s dest;
+
+    nxgl_rectoffset(&dest, &info.srcrect, offset->x, offset->y);
+    nxgl_rectintersect(&dest, &dest, &wnd->bounds);
+    nxbe_shadowdirty(wnd->be, &dest);
+  }
+#endif
+
   /* Then perform the move */
 
 #if CONFIG_NX_NPLANES > 1
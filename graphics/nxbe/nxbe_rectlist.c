@@ -0,0 +1,205 @@
+/****************************************************************************
+ * graphics/nxbe/nxbe_rectlist.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/nx/nxglib.h>
+
+#include "nxbe.h"
+
+#if defined(CONFIG_NX_DAMAGE) || defined(CONFIG_NX_FBSHADOW)
+
+/****************************************************************************
+ * Pre-Processor Definitions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_rectarea
+ *
+ * Description:
+ *   Return the number of pixels in a (non-null) rectangle
+ *
+ ****************************************************************************/
+
+static inline uint32_t nxbe_rectarea(FAR const struct nxgl_rect_s *rect)
+{
+  return (uint32_t)(rect->pt2.x - rect->pt1.x + 1) *
+         (uint32_t)(rect->pt2.y - rect->pt1.y + 1);
+}
+
+/****************************************************************************
+ * Name: nxbe_rectremove
+ *
+ * Description:
+ *   Remove entry 'ndx' from the list.  The order of the list is not
+ *   important, so the last entry is just moved into the vacated slot.
+ *
+ ****************************************************************************/
+
+static inline void nxbe_rectremove(FAR struct nxgl_rect_s *list,
+                                   FAR uint8_t *nrects, int ndx)
+{
+  (*nrects)--;
+  if (ndx < *nrects)
+    {
+      nxgl_rectcopy(&list[ndx], &list[*nrects]);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_rectlistadd
+ *
+ * Descripton:
+ *   Add a rectangle to a bounded list of non-overlapping rectangles.  The
+ *   rectangle is merged with any entry that it overlaps or that it abuts
+ *   exactly so that no pixel appears in more than one entry of the list.
+ *   If the list is full, the rectangle is merged with the entry whose area
+ *   grows the least.
+ *
+ * Input Parameters:
+ *   list    - The list of rectangles
+ *   nrects  - The number of rectangles in the list (updated)
+ *   mxrects - The capacity of the list
+ *   rect    - The (non-null) rectangle to add
+ *
+ * Return:
+ *   None
+ *
+ ****************************************************************************/
+
+void nxbe_rectlistadd(FAR struct nxgl_rect_s *list, FAR uint8_t *nrects,
+                      int mxrects, FAR const struct nxgl_rect_s *rect)
+{
+  FAR struct nxgl_rect_s *entry;
+  struct nxgl_rect_s region;
+  struct nxgl_rect_s merged;
+  struct nxgl_rect_s isect;
+  uint32_t growth;
+  uint32_t best;
+  int bestndx;
+  int i;
+
+  nxgl_rectcopy(&region, rect);
+
+  /* Absorb every entry that overlaps the new region or that can be merged
+   * with it without adding any new pixels.  Each merge removes one entry
+   * from the list, so this loop must terminate.
+   */
+
+restart:
+  for (i = 0; i < *nrects; i++)
+    {
+      entry = &list[i];
+
+      /* Nothing to do if the new region is already fully contained */
+
+      if (nxgl_rectinside(entry, &region.pt1) &&
+          nxgl_rectinside(entry, &region.pt2))
+        {
+          return;
+        }
+
+      nxgl_rectunion(&merged, entry, &region);
+      nxgl_rectintersect(&isect, entry, &region);
+
+      if (!nxgl_nullrect(&isect) ||
+          nxbe_rectarea(&merged) == nxbe_rectarea(entry) + nxbe_rectarea(&region))
+        {
+          nxgl_rectcopy(&region, &merged);
+          nxbe_rectremove(list, nrects, i);
+          goto restart;
+        }
+    }
+
+  /* The region is now disjoint from all entries in the list.  If there is
+   * no space left, merge it with the entry that results in the smallest
+   * bounding box.  The union may now overlap other entries, so go back
+   * and absorb those as well.
+   */
+
+  if (*nrects >= mxrects)
+    {
+      best    = UINT32_MAX;
+      bestndx = 0;
+
+      for (i = 0; i < *nrects; i++)
+        {
+          nxgl_rectunion(&merged, &list[i], &region);
+          growth = nxbe_rectarea(&merged) - nxbe_rectarea(&list[i]);
+          if (growth < best)
+            {
+              best    = growth;
+              bestndx = i;
+            }
+        }
+
+      nxgl_rectunion(&region, &list[bestndx], &region);
+      nxbe_rectremove(list, nrects, bestndx);
+      goto restart;
+    }
+
+  /* Then add the region to the end of the list */
+
+  nxgl_rectcopy(&list[*nrects], &region);
+  (*nrects)++;
+}
+
+#endif /* CONFIG_NX_DAMAGE || CONFIG_NX_FBSHADOW */
@@ -77,15 +77,22 @@
  *   whenever a window is closed, moved, lowered or re-sized in order to
  *   expose newly visible portions of lower windows.
  *
+ *   If damage tracking is enabled, the region is only recorded here and
+ *   the redraw requests are issued by the server at the next frame.
+ *
  ****************************************************************************/
 
 void nxbe_redrawbelow(FAR struct nxbe_state_s *be, FAR struct nxbe_window_s *wnd,
                       FAR const struct nxgl_rect_s *rect)
 {
+#ifdef CONFIG_NX_DAMAGE
+  nxbe_damagebelow(be, wnd, rect);
+#else
   FAR struct nxbe_window_s *currwnd;
 
   for (currwnd = wnd; currwnd; currwnd = currwnd->below)
     {
       nxbe_redraw(be, currwnd, rect);
     }
+#endif
 }
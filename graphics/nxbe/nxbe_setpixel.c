@@ -141,7 +141,11 @@ void nxbe_setpixel(FAR struct nxbe_window_s *wnd,
 
   rect.pt2.x = rect.pt1.x;
   rect.pt2.y = rect.pt1.y;
- 
+
+#ifdef CONFIG_NX_FBSHADOW
+  nxbe_shadowdirty(wnd->be, &rect);
+#endif
+
 #if CONFIG_NX_NPLANES > 1
   for (i = 0; i < wnd->be->vinfo.nplanes; i++)
 #else
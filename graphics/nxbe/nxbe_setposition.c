@@ -99,6 +99,19 @@ void nxbe_setposition(FAR struct nxbe_window_s *wnd,
   nxgl_rectcopy(&before, &wnd->bounds);
   nxgl_rectoffset(&wnd->bounds, &rect, pos->x, pos->y);
 
+#ifdef CONFIG_NX_DAMAGE
+  /* Report the new size/position */
+
+  nxfe_reportposition(wnd);
+
+  /* Mark the 'before' and 'after' bounding boxes as damaged separately.
+   * Their union may contain many pixels that are in neither box; the
+   * damage list will merge the two if they overlap.
+   */
+
+  nxbe_damagebelow(wnd->be, wnd, &before);
+  nxbe_damagebelow(wnd->be, wnd, &wnd->bounds);
+#else
   /* Get the union of the 'before' bounding box and the 'after' bounding
    * this union is the region of the display that must be updated.
    */
@@ -116,4 +129,5 @@ void nxbe_setposition(FAR struct nxbe_window_s *wnd,
    */
 
   nxbe_redrawbelow(wnd->be, wnd, &rect);
+#endif
 }
@@ -102,6 +102,18 @@ void nxbe_setsize(FAR struct nxbe_window_s *wnd,
 
   nxgl_rectintersect(&wnd->bounds, &wnd->bounds, &wnd->be->bkgd.bounds);
 
+#ifdef CONFIG_NX_DAMAGE
+  /* Report the new size/position */
+
+  nxfe_reportposition(wnd);
+
+  /* Mark the before and after bounding boxes as damaged.  The damage list
+   * will merge the two.
+   */
+
+  nxbe_damagebelow(wnd->be, wnd, &bounds);
+  nxbe_damagebelow(wnd->be, wnd, &wnd->bounds);
+#else
   /* We need to update the larger of the two rectangles.  That will be the
    * union of the before and after sizes.
    */
@@ -118,4 +130,5 @@ void nxbe_setsize(FAR struct nxbe_window_s *wnd,
    */
 
   nxbe_redrawbelow(wnd->be, wnd, &bounds);
+#endif
 }
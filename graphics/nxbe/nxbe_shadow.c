@@ -0,0 +1,228 @@
+/****************************************************************************
+ * graphics/nxbe/nxbe_shadow.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/nx/nxglib.h>
+
+#include "nxbe.h"
+
+#ifdef CONFIG_NX_FBSHADOW
+
+/****************************************************************************
+ * Pre-Processor Definitions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_shadowcopy
+ *
+ * Description:
+ *   Copy one rectangular region of one color plane from the shadow
+ *   framebuffer to the real framebuffer.
+ *
+ ****************************************************************************/
+
+static inline void nxbe_shadowcopy(FAR struct nxbe_plane_s *plane,
+                                   FAR uint8_t *fbmem,
+                                   FAR const struct nxgl_rect_s *rect)
+{
+  FAR const uint8_t *src;
+  FAR uint8_t *dest;
+  unsigned int stride = plane->pinfo.stride;
+  unsigned int start;
+  unsigned int width;
+  nxgl_coord_t row;
+
+  /* Get the range of bytes in each row.  For sub-byte pixels, this range
+   * includes the partial bytes at each end.
+   */
+
+  start = ((unsigned int)rect->pt1.x * plane->pinfo.bpp) >> 3;
+  width = ((((unsigned int)rect->pt2.x + 1) * plane->pinfo.bpp + 7) >> 3) - start;
+
+  src   = (FAR const uint8_t *)plane->pinfo.fbmem + rect->pt1.y * stride + start;
+  dest  = fbmem + rect->pt1.y * stride + start;
+
+  for (row = rect->pt1.y; row <= rect->pt2.y; row++)
+    {
+      memcpy(dest, src, width);
+      src  += stride;
+      dest += stride;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxbe_shadowinit
+ *
+ * Descripton:
+ *   Allocate the shadow framebuffer for each color plane and redirect all
+ *   rendering to it.  The shadow framebuffer is initialized with the
+ *   current content of the display.
+ *
+ ****************************************************************************/
+
+int nxbe_shadowinit(FAR NX_DRIVERTYPE *dev, FAR struct nxbe_state_s *be)
+{
+  FAR void *shadow;
+  int i;
+
+  be->dev    = dev;
+  be->ndirty = 0;
+
+  for (i = 0; i < be->vinfo.nplanes; i++)
+    {
+      shadow = kmalloc(be->plane[i].pinfo.fblen);
+      if (!shadow)
+        {
+          gdbg("Failed to allocate shadow framebuffer[%d]\n", i);
+
+          /* Restore the planes that were already redirected */
+
+          while (--i >= 0)
+            {
+              kfree(be->plane[i].pinfo.fbmem);
+              be->plane[i].pinfo.fbmem = be->fbmem[i];
+            }
+
+          return -ENOMEM;
+        }
+
+      memcpy(shadow, be->plane[i].pinfo.fbmem, be->plane[i].pinfo.fblen);
+      be->fbmem[i]             = be->plane[i].pinfo.fbmem;
+      be->plane[i].pinfo.fbmem = shadow;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxbe_shadowdirty
+ *
+ * Descripton:
+ *   Mark a region of the shadow framebuffer as changed.  The region is in
+ *   absolute screen coordinates.
+ *
+ ****************************************************************************/
+
+void nxbe_shadowdirty(FAR struct nxbe_state_s *be,
+                      FAR const struct nxgl_rect_s *rect)
+{
+  struct nxgl_rect_s region;
+
+  nxgl_rectintersect(&region, rect, &be->bkgd.bounds);
+  if (!nxgl_nullrect(&region))
+    {
+      nxbe_rectlistadd(be->dirty, &be->ndirty, CONFIG_NX_NDIRTY, &region);
+    }
+}
+
+/****************************************************************************
+ * Name: nxbe_shadowflush
+ *
+ * Descripton:
+ *   Copy all changed regions of the shadow framebuffer to the display.  If
+ *   the framebuffer driver needs to know about changes, it is told about
+ *   each changed region after the copy.
+ *
+ ****************************************************************************/
+
+void nxbe_shadowflush(FAR struct nxbe_state_s *be)
+{
+  FAR struct nxgl_rect_s *rect;
+#ifdef CONFIG_FB_UPDATE
+  struct fb_area_s area;
+#endif
+  int i;
+  int j;
+
+  for (i = 0; i < be->ndirty; i++)
+    {
+      rect = &be->dirty[i];
+
+#if CONFIG_NX_NPLANES > 1
+      for (j = 0; j < be->vinfo.nplanes; j++)
+#else
+      j = 0;
+#endif
+        {
+          nxbe_shadowcopy(&be->plane[j], (FAR uint8_t *)be->fbmem[j], rect);
+        }
+
+#ifdef CONFIG_FB_UPDATE
+      if (be->dev->updatearea)
+        {
+          area.x = rect->pt1.x;
+          area.y = rect->pt1.y;
+          area.w = rect->pt2.x - rect->pt1.x + 1;
+          area.h = rect->pt2.y - rect->pt1.y + 1;
+          (void)be->dev->updatearea(be->dev, &area);
+        }
+#endif
+    }
+
+  be->ndirty = 0;
+}
+
+#endif /* CONFIG_NX_FBSHADOW */
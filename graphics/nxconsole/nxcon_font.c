@@ -74,6 +74,16 @@
 #  error "Unsupported CONFIG_NXCONSOLE_BPP"
 #endif
 
+/* Glyphs come from the shared glyph cache or from the console's own cache */
+
+#ifdef CONFIG_NXFONTS_CACHE
+#  define NXCON_GLYPH_T const struct nxf_glyph_s
+#  define nxcon_releaseglyph(g) nxf_cache_release(g)
+#else
+#  define NXCON_GLYPH_T struct nxcon_glyph_s
+#  define nxcon_releaseglyph(g)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -94,6 +104,7 @@
  * Private Functions
  ****************************************************************************/
 
+#ifndef CONFIG_NXFONTS_CACHE
 /****************************************************************************
  * Name: nxcon_freeglyph
  ****************************************************************************/
@@ -326,6 +337,7 @@ nxcon_renderglyph(FAR struct nxcon_state_s *priv,
 
   return glyph;
 }
+#endif
 
 /****************************************************************************
  * Name: nxcon_fontsize
@@ -354,6 +366,18 @@ static int nxcon_fontsize(NXHANDLE hfont, uint8_t ch, FAR struct nxgl_size_s *si
  * Name: nxcon_getglyph
  ****************************************************************************/
 
+#ifdef CONFIG_NXFONTS_CACHE
+static inline FAR const struct nxf_glyph_s *
+nxcon_getglyph(NXHANDLE hfont, FAR struct nxcon_state_s *priv, uint8_t ch)
+{
+  /* Get the glyph (perhaps rendered by another console) from the shared
+   * glyph cache.  It must be released with nxcon_releaseglyph().
+   */
+
+  return nxf_cache_getglyph(hfont, ch, CONFIG_NXCONSOLE_BPP,
+                            priv->wndo.fcolor[0], priv->wndo.wcolor[0]);
+}
+#else
 static FAR struct nxcon_glyph_s *
 nxcon_getglyph(NXHANDLE hfont, FAR struct nxcon_state_s *priv, uint8_t ch)
 {
@@ -382,6 +406,7 @@ nxcon_getglyph(NXHANDLE hfont, FAR struct nxcon_state_s *priv, uint8_t ch)
 
   return glyph;
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -400,7 +425,7 @@ FAR const struct nxcon_bitmap_s *
 nxcon_addchar(NXHANDLE hfont, FAR struct nxcon_state_s *priv, uint8_t ch)
 {
   FAR struct nxcon_bitmap_s *bm = NULL;
-  FAR struct nxcon_glyph_s *glyph;
+  FAR NXCON_GLYPH_T *glyph;
 
   /* Is there space for another character on the display? */
 
@@ -432,6 +457,7 @@ nxcon_addchar(NXHANDLE hfont, FAR struct nxcon_state_s *priv, uint8_t ch)
           /* Set up the next character position */
 
           priv->fpos.x += glyph->width;
+          nxcon_releaseglyph(glyph);
         }
 
       /* Success.. increment nchars to retain this character */
@@ -575,7 +601,7 @@ void nxcon_fillchar(FAR struct nxcon_state_s *priv,
                     FAR const struct nxgl_rect_s *rect,
                     FAR const struct nxcon_bitmap_s *bm)
 {
-  FAR struct nxcon_glyph_s *glyph;
+  FAR NXCON_GLYPH_T *glyph;
   struct nxgl_rect_s bounds;
   struct nxgl_rect_s intersection;
   struct nxgl_size_s fsize;
@@ -646,6 +672,10 @@ void nxcon_fillchar(FAR struct nxcon_state_s *priv,
       ret = priv->ops->bitmap(priv, &intersection, &src,
                               &bm->pos, (unsigned int)glyph->stride);
       DEBUGASSERT(ret >= 0);
+
+      /* The bitmap has been drawn, the glyph is no longer needed */
+
+      nxcon_releaseglyph(glyph);
     }
 }
 
@@ -151,7 +151,9 @@ struct nxcon_state_s
   uint8_t fheight;                          /* Max height of a font in pixels */
   uint8_t fwidth;                           /* Max width of a font in pixels */
   uint8_t spwidth;                          /* The width of a space */
+#ifndef CONFIG_NXFONTS_CACHE
   uint8_t maxglyphs;                        /* Size of the glyph[] array */
+#endif
 
   uint16_t maxchars;                        /* Size of the bm[] array */
   uint16_t nchars;                          /* Number of chars in the bm[] array */
@@ -168,9 +170,11 @@ struct nxcon_state_s
   struct nxcon_bitmap_s cursor;
   struct nxcon_bitmap_s bm[CONFIG_NXCONSOLE_MXCHARS];
 
-  /* Glyph cache data storage */
+  /* Glyph cache data storage (unless the shared glyph cache is used) */
 
+#ifndef CONFIG_NXFONTS_CACHE
   struct nxcon_glyph_s  glyph[CONFIG_NXCONSOLE_CACHESIZE];
+#endif
 
   /* Keyboard input support */
 
@@ -133,7 +133,9 @@ FAR struct nxcon_state_s *
 
   /* Set up the font glyph bitmap cache */
 
+#ifndef CONFIG_NXFONTS_CACHE
   priv->maxglyphs = CONFIG_NXCONSOLE_CACHESIZE;
+#endif
 
   /* Set the initial display position */
 
@@ -83,8 +83,14 @@
  * Description:
  *   This function implements the data movement for the scroll operation.  If
  *   we can read the displays framebuffer memory, then the job is pretty
- *   easy.  However, many displays (such as SPI-based LCDs) are often read-
- *   only.
+ *   easy:  The text above the bottom line is moved up as one region and
+ *   the device moves the pixels with its moverectangle method.  However,
+ *   many displays (such as SPI-based LCDs) are often read-only.  In that
+ *   case, each row of text must be cleared and re-rendered.
+ *
+ *   In either case, the exposed region at the bottom of the display (from
+ *   'bottom' to the end of the window) is left for the caller to clear.
+ *
  ****************************************************************************/
 
 #ifdef CONFIG_NX_WRITEONLY
@@ -132,17 +138,6 @@ static inline void nxcon_movedisplay(FAR struct nxcon_state_s *priv,
             }
         }
     }
-
-  /* Finally, clear the bottom part of the display */
-
-  rect.pt1.y = bottom;
-  rect.pt2.y = priv->wndo.wsize.h- 1;
-
-  ret = priv->ops->fill(priv, &rect, priv->wndo.wcolor);
-  if (ret < 0)
-    {
-      gdbg("nxcon_movedisplay: fill failed: %d\n", errno);
-    }
 }
 #else
 static inline void nxcon_movedisplay(FAR struct nxcon_state_s *priv,
@@ -152,8 +147,9 @@ static inline void nxcon_movedisplay(FAR struct nxcon_state_s *priv,
   struct nxgl_point_s offset;
   int ret;
 
-  /* Move the display in the range of 0-height up one scrollheight.  The
-   * line at the bottom will be reset to the background color automatically.
+  /* Move the display in the range of 0-bottom up one scrollheight.  Nothing
+   * below the previous text position needs to be moved; that region is
+   * blank and will be cleared by the caller.
    *
    * The source rectangle to be moved.
    */
@@ -161,7 +157,12 @@ static inline void nxcon_movedisplay(FAR struct nxcon_state_s *priv,
   rect.pt1.x = 0;
   rect.pt1.y = scrollheight + CONFIG_NXCONSOLE_LINESEPARATION;
   rect.pt2.x = priv->wndo.wsize.w - 1;
-  rect.pt2.y = priv->wndo.wsize.h - 1;
+  rect.pt2.y = bottom + scrollheight - 1;
+
+  if (rect.pt2.y < rect.pt1.y)
+    {
+      return;
+    }
 
   /* The offset that determines how far to move the source rectangle */
 
@@ -188,47 +189,40 @@ static inline void nxcon_movedisplay(FAR struct nxcon_state_s *priv,
 
 void nxcon_scroll(FAR struct nxcon_state_s *priv, int scrollheight)
 {
+  struct nxgl_rect_s rect;
+  int ret;
   int i;
   int j;
 
-  /* Adjust the vertical position of each character */
+  /* Adjust the vertical position of each character, discarding any
+   * character that has scrolled off the display.  The retained characters
+   * are packed down in place in a single pass.
+   */
 
-  for (i = 0; i < priv->nchars; )
+  for (i = 0, j = 0; i < priv->nchars; i++)
     {
       FAR struct nxcon_bitmap_s *bm = &priv->bm[i];
 
       /* Has any part of this character scrolled off the screen? */
 
-      if (bm->pos.y < scrollheight + CONFIG_NXCONSOLE_LINESEPARATION)
+      if (bm->pos.y >= scrollheight + CONFIG_NXCONSOLE_LINESEPARATION)
         {
-          /* Yes... Delete the character by moving all of the data */
-
-          for (j = i; j < priv->nchars-1; j++)
-            {
-              memcpy(&priv->bm[j], &priv->bm[j+1], sizeof(struct nxcon_bitmap_s));
-            }
-
-          /* Decrement the number of cached characters ('i' is not incremented
-           * in this case because it already points to the next character)
+          /* No.. decrement its vertical position (moving it "up" the
+           * display by one line) and keep it.
            */
 
-          priv->nchars--;
-        }
-
-      /* No.. just decrement its vertical position (moving it "up" the
-       * display by one line).
-       */
-
-      else
-        {
           bm->pos.y -= scrollheight;
+          if (j != i)
+            {
+              memcpy(&priv->bm[j], bm, sizeof(struct nxcon_bitmap_s));
+            }
 
-          /* We are keeping this one so increment to the next character */
- 
-          i++;
+          j++;
         }
     }
 
+  priv->nchars = j;
+
   /* And move the next display position up by one line as well */
 
   priv->fpos.y -= scrollheight;
@@ -236,4 +230,17 @@ void nxcon_scroll(FAR struct nxcon_state_s *priv, int scrollheight)
   /* Move the display in the range of 0-height up one scrollheight. */
 
   nxcon_movedisplay(priv, priv->fpos.y, scrollheight);
+
+  /* Finally, clear only the exposed region at the bottom of the display */
+
+  rect.pt1.x = 0;
+  rect.pt1.y = priv->fpos.y;
+  rect.pt2.x = priv->wndo.wsize.w - 1;
+  rect.pt2.y = priv->wndo.wsize.h - 1;
+
+  ret = priv->ops->fill(priv, &rect, priv->wndo.wcolor);
+  if (ret < 0)
+    {
+      gdbg("fill failed: %d\n", errno);
+    }
 }
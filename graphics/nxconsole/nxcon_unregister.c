@@ -89,7 +89,9 @@ void nxcon_unregister(NXCONSOLE handle)
 {
   FAR struct nxcon_state_s *priv;
   char devname[NX_DEVNAME_SIZE];
+#ifndef CONFIG_NXFONTS_CACHE
   int i;
+#endif
 
   DEBUGASSERT(handle);
 
@@ -101,8 +103,11 @@ void nxcon_unregister(NXCONSOLE handle)
   sem_destroy(&priv->waitsem);
 #endif
 
-  /* Free all allocated glyph bitmap */
+  /* Free all allocated glyph bitmap (glyphs in the shared glyph cache are
+   * retained for use by other text renderers).
+   */
 
+#ifndef CONFIG_NXFONTS_CACHE
   for (i = 0; i < CONFIG_NXCONSOLE_CACHESIZE; i++)
     {
       FAR struct nxcon_glyph_s *glyph = &priv->glyph[i];
@@ -111,6 +116,7 @@ void nxcon_unregister(NXCONSOLE handle)
           kfree(glyph->bitmap);
         }
     }
+#endif
 
   /* Unregister the driver */
 
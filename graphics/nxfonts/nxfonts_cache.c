@@ -0,0 +1,506 @@
+/****************************************************************************
+ * graphics/nxfonts/nxfonts_cache.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/nx/nxfonts.h>
+
+#include "nxfonts_internal.h"
+
+#ifdef CONFIG_NXFONTS_CACHE
+
+/****************************************************************************
+ * Pre-processor definitions
+ ****************************************************************************/
+
+/* Hash a glyph key into a bucket index */
+
+#define NXF_HASH(id,ch,bpp,fg) \
+  ((((unsigned int)(id) << 8) ^ (unsigned int)(ch) ^ \
+    ((unsigned int)(bpp) << 4) ^ (unsigned int)(fg)) % CONFIG_NXFONTS_CACHEHASH)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes the state of the glyph cache */
+
+struct nxf_cache_s
+{
+  sem_t exclsem;                         /* Mutually exclusive access */
+  FAR struct nxf_glyph_s *mru;           /* Most recently used glyph */
+  FAR struct nxf_glyph_s *lru;           /* Least recently used glyph */
+  struct nxf_cachestats_s stats;         /* Cache statistics */
+
+  /* Hash table of cached glyphs */
+
+  FAR struct nxf_glyph_s *hash[CONFIG_NXFONTS_CACHEHASH];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct nxf_cache_s g_nxfcache =
+{
+  SEM_INITIALIZER(1),
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxf_cache_takesem
+ ****************************************************************************/
+
+static void nxf_cache_takesem(void)
+{
+  /* Take the semaphore (perhaps waiting) */
+
+  while (sem_wait(&g_nxfcache.exclsem) != 0)
+    {
+      /* The only case that an error should occur here is if the wait was
+       * awakened by a signal.
+       */
+
+      ASSERT(errno == EINTR);
+    }
+}
+
+#define nxf_cache_givesem() sem_post(&g_nxfcache.exclsem)
+
+/****************************************************************************
+ * Name: nxf_cache_unlink
+ *
+ * Description:
+ *   Remove a glyph from the LRU list.
+ *
+ ****************************************************************************/
+
+static void nxf_cache_unlink(FAR struct nxf_glyph_s *glyph)
+{
+  if (glyph->blink)
+    {
+      glyph->blink->flink = glyph->flink;
+    }
+  else
+    {
+      g_nxfcache.mru = glyph->flink;
+    }
+
+  if (glyph->flink)
+    {
+      glyph->flink->blink = glyph->blink;
+    }
+  else
+    {
+      g_nxfcache.lru = glyph->blink;
+    }
+}
+
+/****************************************************************************
+ * Name: nxf_cache_addmru
+ *
+ * Description:
+ *   Add a glyph to the head (most recently used end) of the LRU list.
+ *
+ ****************************************************************************/
+
+static void nxf_cache_addmru(FAR struct nxf_glyph_s *glyph)
+{
+  glyph->blink = NULL;
+  glyph->flink = g_nxfcache.mru;
+
+  if (g_nxfcache.mru)
+    {
+      g_nxfcache.mru->blink = glyph;
+    }
+  else
+    {
+      g_nxfcache.lru = glyph;
+    }
+
+  g_nxfcache.mru = glyph;
+}
+
+/****************************************************************************
+ * Name: nxf_cache_evict
+ *
+ * Description:
+ *   Free glyphs, starting with the least recently used, until 'needed'
+ *   more bytes fit within CONFIG_NXFONTS_CACHEBUDGET.  Glyphs that are
+ *   still referenced by a caller cannot be freed.
+ *
+ ****************************************************************************/
+
+static void nxf_cache_evict(size_t needed)
+{
+  FAR struct nxf_glyph_s *glyph;
+  FAR struct nxf_glyph_s *prev;
+  FAR struct nxf_glyph_s **pprev;
+
+  for (glyph = g_nxfcache.lru;
+       glyph && g_nxfcache.stats.nbytes + needed > CONFIG_NXFONTS_CACHEBUDGET;
+       glyph = prev)
+    {
+      prev = glyph->blink;
+      if (glyph->crefs > 0)
+        {
+          continue;
+        }
+
+      /* Remove the glyph from its hash chain */
+
+      pprev = &g_nxfcache.hash[NXF_HASH(glyph->fontid, glyph->code,
+                                        glyph->bpp, glyph->fgcolor)];
+      while (*pprev != glyph)
+        {
+          pprev = &(*pprev)->hnext;
+        }
+
+      *pprev = glyph->hnext;
+
+      /* Then from the LRU list and free it */
+
+      nxf_cache_unlink(glyph);
+
+      g_nxfcache.stats.nbytes -= glyph->size;
+      g_nxfcache.stats.nglyphs--;
+      g_nxfcache.stats.evictions++;
+      kfree(glyph);
+    }
+}
+
+/****************************************************************************
+ * Name: nxf_cache_fill
+ *
+ * Description:
+ *   Initialize the glyph memory to the background color.
+ *
+ ****************************************************************************/
+
+static void nxf_cache_fill(FAR struct nxf_glyph_s *glyph)
+{
+  nxgl_mxpixel_t pixel = glyph->bgcolor;
+  int npixels;
+  int i;
+
+  switch (glyph->bpp)
+    {
+      /* Pack sub-byte pixels into a byte and fill the whole bitmap */
+
+      case 1:
+        pixel &= 0x01;
+        pixel  = pixel << 1 | pixel;
+        /* Fall through */
+
+      case 2:
+        pixel &= 0x03;
+        pixel  = pixel << 2 | pixel;
+        /* Fall through */
+
+      case 4:
+        pixel &= 0x0f;
+        pixel  = pixel << 4 | pixel;
+        /* Fall through */
+
+      case 8:
+        memset(glyph->bitmap, (uint8_t)pixel, glyph->stride * glyph->height);
+        break;
+
+      case 16:
+        {
+          FAR uint16_t *ptr = (FAR uint16_t *)glyph->bitmap;
+
+          npixels = glyph->width * glyph->height;
+          for (i = 0; i < npixels; i++)
+            {
+              *ptr++ = (uint16_t)pixel;
+            }
+        }
+        break;
+
+      case 32:
+        {
+          FAR uint32_t *ptr = (FAR uint32_t *)glyph->bitmap;
+
+          npixels = glyph->width * glyph->height;
+          for (i = 0; i < npixels; i++)
+            {
+              *ptr++ = (uint32_t)pixel;
+            }
+        }
+        break;
+    }
+}
+
+/****************************************************************************
+ * Name: nxf_cache_render
+ *
+ * Description:
+ *   Render the font bitmap into the glyph memory.
+ *
+ ****************************************************************************/
+
+static int nxf_cache_render(FAR struct nxf_glyph_s *glyph,
+                            FAR const struct nx_fontbitmap_s *fbm)
+{
+  switch (glyph->bpp)
+    {
+      case 1:
+        return nxf_convert_1bpp(glyph->bitmap, glyph->height, glyph->width,
+                                glyph->stride, fbm, glyph->fgcolor);
+
+      case 2:
+        return nxf_convert_2bpp(glyph->bitmap, glyph->height, glyph->width,
+                                glyph->stride, fbm, glyph->fgcolor);
+
+      case 4:
+        return nxf_convert_4bpp(glyph->bitmap, glyph->height, glyph->width,
+                                glyph->stride, fbm, glyph->fgcolor);
+
+      case 8:
+        return nxf_convert_8bpp(glyph->bitmap, glyph->height, glyph->width,
+                                glyph->stride, fbm, glyph->fgcolor);
+
+      case 16:
+        return nxf_convert_16bpp((FAR uint16_t *)glyph->bitmap,
+                                 glyph->height, glyph->width,
+                                 glyph->stride, fbm, glyph->fgcolor);
+
+      case 32:
+        return nxf_convert_32bpp((FAR uint32_t *)glyph->bitmap,
+                                 glyph->height, glyph->width,
+                                 glyph->stride, fbm, glyph->fgcolor);
+
+      default:
+        return ERROR;
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxf_cache_getglyph
+ *
+ * Description:
+ *   Return the pre-rendered glyph for a character, rendering it and adding
+ *   it to the shared glyph cache if it is not already there.  Glyphs are
+ *   identified by font, character code, pixel depth, and colors.
+ *
+ *   The returned glyph remains valid until it is released with
+ *   nxf_cache_release().
+ *
+ * Input Parameters:
+ *   hfont:   A font handle previously returned by nxf_getfonthandle()
+ *   ch:      The character code
+ *   bpp:     The pixel depth of the glyph (1, 2, 4, 8, 16, or 32)
+ *   fgcolor: The color of the character
+ *   bgcolor: The color of the glyph background
+ *
+ * Returned Value:
+ *   The glyph on success; NULL if the font has no glyph for the character
+ *   code or if the glyph could not be allocated.
+ *
+ ****************************************************************************/
+
+FAR const struct nxf_glyph_s *
+nxf_cache_getglyph(NXHANDLE hfont, uint16_t ch, uint8_t bpp,
+                   nxgl_mxpixel_t fgcolor, nxgl_mxpixel_t bgcolor)
+{
+  FAR const struct nx_fontpackage_s *package =
+    (FAR const struct nx_fontpackage_s *)hfont;
+  FAR const struct nx_fontbitmap_s *fbm;
+  FAR struct nxf_glyph_s *glyph;
+  unsigned int ndx;
+  uint8_t width;
+  uint8_t height;
+  uint16_t stride;
+  size_t size;
+
+  DEBUGASSERT(package);
+  nxf_cache_takesem();
+
+  /* Look for the glyph in its hash bucket */
+
+  ndx = NXF_HASH(package->id, ch, bpp, fgcolor);
+  for (glyph = g_nxfcache.hash[ndx]; glyph; glyph = glyph->hnext)
+    {
+      if (glyph->code == ch && glyph->fontid == package->id &&
+          glyph->bpp == bpp && glyph->fgcolor == fgcolor &&
+          glyph->bgcolor == bgcolor)
+        {
+          /* Found it.  It is now the most recently used glyph */
+
+          if (g_nxfcache.mru != glyph)
+            {
+              nxf_cache_unlink(glyph);
+              nxf_cache_addmru(glyph);
+            }
+
+          g_nxfcache.stats.hits++;
+          glyph->crefs++;
+          nxf_cache_givesem();
+          return glyph;
+        }
+    }
+
+  g_nxfcache.stats.misses++;
+
+  /* Not cached... Does the code map to a font? */
+
+  fbm = nxf_getbitmap(hfont, ch);
+  if (!fbm)
+    {
+      nxf_cache_givesem();
+      return NULL;
+    }
+
+  /* Yes.. get the dimensions of the glyph with its offsets */
+
+  width  = fbm->metric.width + fbm->metric.xoffset;
+  height = fbm->metric.height + fbm->metric.yoffset;
+  stride = (width * bpp + 7) >> 3;
+  size   = sizeof(struct nxf_glyph_s) + stride * height;
+
+  /* Make room for the glyph, then allocate it with its bitmap memory */
+
+  nxf_cache_evict(size);
+
+  glyph = (FAR struct nxf_glyph_s *)kmalloc(size);
+  if (!glyph)
+    {
+      gdbg("ERROR: Failed to allocate glyph\n");
+      nxf_cache_givesem();
+      return NULL;
+    }
+
+  glyph->bitmap  = (FAR uint8_t *)&glyph[1];
+  glyph->size    = size;
+  glyph->fgcolor = fgcolor;
+  glyph->bgcolor = bgcolor;
+  glyph->code    = ch;
+  glyph->stride  = stride;
+  glyph->fontid  = package->id;
+  glyph->bpp     = bpp;
+  glyph->width   = width;
+  glyph->height  = height;
+  glyph->crefs   = 1;
+
+  /* Render the glyph */
+
+  nxf_cache_fill(glyph);
+  if (nxf_cache_render(glyph, fbm) < 0)
+    {
+      gdbg("ERROR: Unsupported pixel depth: %d\n", bpp);
+      kfree(glyph);
+      nxf_cache_givesem();
+      return NULL;
+    }
+
+  /* And add it to the cache */
+
+  glyph->hnext = g_nxfcache.hash[ndx];
+  g_nxfcache.hash[ndx] = glyph;
+  nxf_cache_addmru(glyph);
+
+  g_nxfcache.stats.nbytes += size;
+  g_nxfcache.stats.nglyphs++;
+
+  nxf_cache_givesem();
+  return glyph;
+}
+
+/****************************************************************************
+ * Name: nxf_cache_release
+ *
+ * Description:
+ *   Release a glyph returned by nxf_cache_getglyph().  The glyph stays in
+ *   the cache but may be evicted once no caller is using it.
+ *
+ * Input Parameters:
+ *   glyph:   The glyph to release
+ *
+ ****************************************************************************/
+
+void nxf_cache_release(FAR const struct nxf_glyph_s *glyph)
+{
+  FAR struct nxf_glyph_s *priv = (FAR struct nxf_glyph_s *)glyph;
+
+  DEBUGASSERT(priv && priv->crefs > 0);
+
+  nxf_cache_takesem();
+  priv->crefs--;
+  nxf_cache_givesem();
+}
+
+/****************************************************************************
+ * Name: nxf_cache_getstats
+ *
+ * Description:
+ *   Return a snapshot of the glyph cache statistics.
+ *
+ * Input Parameters:
+ *   stats:   The location to return the statistics
+ *
+ ****************************************************************************/
+
+void nxf_cache_getstats(FAR struct nxf_cachestats_s *stats)
+{
+  nxf_cache_takesem();
+  memcpy(stats, &g_nxfcache.stats, sizeof(struct nxf_cachestats_s));
+  nxf_cache_givesem();
+}
+
+#endif /* CONFIG_NXFONTS_CACHE */
@@ -100,7 +100,19 @@ void NXGL_FUNCNAME(nxgl_fillrectangle,NXGLIB_SUFFIX)
 
   NXGL_FUNCNAME(nxgl_fillrun,NXGLIB_SUFFIX)((NXGLIB_RUNTYPE*)pinfo->buffer, color, ncols);
 
-  /* Then fill the rectangle line-by-line */
+  /* If the LCD supports area transfers, then write the same run to every
+   * row of the rectangle in one transfer (stride == 0).
+   */
+
+  if (pinfo->putarea)
+    {
+      (void)pinfo->putarea(rect->pt1.y, rect->pt1.x,
+                           rect->pt2.y - rect->pt1.y + 1, ncols,
+                           pinfo->buffer, 0);
+      return;
+    }
+
+  /* Otherwise, fill the rectangle line-by-line */
 
   for (row = rect->pt1.y; row <= rect->pt2.y; row++)
     {
@@ -95,7 +95,19 @@ void NXGL_FUNCNAME(nxgl_getrectangle,NXGLIB_SUFFIX)
 
   dline = (FAR uint8_t *)dest;
 
-  /* Copy the rectangle */
+  /* If the LCD supports area transfers, then read the whole rectangle in
+   * one transfer.
+   */
+
+  if (pinfo->getarea)
+    {
+      (void)pinfo->getarea(rect->pt1.y, rect->pt1.x,
+                           rect->pt2.y - rect->pt1.y + 1, ncols,
+                           dline, deststride);
+      return;
+    }
+
+  /* Otherwise, copy the rectangle one row at a time */
 
   for (srcrow = rect->pt1.y; srcrow <= rect->pt2.y; srcrow++)
     {
@@ -0,0 +1,139 @@
+/****************************************************************************
+ * graphics/nxmu/nx_batch.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/nx/nx.h>
+
+#include "nxfe.h"
+
+#ifdef CONFIG_NX_BATCH
+
+/****************************************************************************
+ * Pre-Processor Definitions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nx_batch
+ *
+ * Description:
+ *   Enable or disable batching of drawing commands on this connection.
+ *   While batching is enabled, nx_setpixel, nx_fill, nx_filltrapezoid, and
+ *   nx_move (and the drawing functions built on them) are collected into
+ *   messages of up to CONFIG_NX_BATCHSIZE bytes and sent to the server
+ *   together.  See nx_flush().
+ *
+ * Input Parameters:
+ *   handle - The handle returned by nx_connect
+ *   enable - True: Start batching; false: send any pending commands and
+ *            stop batching.
+ *
+ * Return:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+int nx_batch(NXHANDLE handle, bool enable)
+{
+  FAR struct nxfe_conn_s *conn = (FAR struct nxfe_conn_s *)handle;
+  FAR struct nxsvrmsg_batch_s *batch;
+  int ret = OK;
+
+#ifdef CONFIG_DEBUG
+  if (!conn)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+#endif
+
+  if (enable && !conn->batch)
+    {
+      /* Allocate the buffer that holds the pending commands */
+
+      batch = (FAR struct nxsvrmsg_batch_s *)kmalloc(NX_MXSVRMSGLEN);
+      if (!batch)
+        {
+          set_errno(ENOMEM);
+          return ERROR;
+        }
+
+      batch->msgid  = NX_SVRMSG_BATCH;
+      batch->nbytes = NX_BATCHHDRLEN;
+      conn->batch   = batch;
+    }
+  else if (!enable && conn->batch)
+    {
+      /* Send the pending commands and free the buffer */
+
+      ret = nxmu_batchflush(conn);
+
+      kfree(conn->batch);
+      conn->batch = NULL;
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_NX_BATCH */
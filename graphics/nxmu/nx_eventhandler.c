@@ -96,8 +96,15 @@ static inline void nx_disconnected(FAR struct nxfe_conn_s *conn)
   (void)mq_close(conn->cwrmq);
   (void)mq_close(conn->crdmq);
 
-  /* And free the client structure */
+  /* And free the client structure (and any batch buffer) */
 
+#ifdef CONFIG_NX_BATCH
+  if (conn->batch)
+    {
+      kfree(conn->batch);
+    }
+
+#endif
   kfree(conn);
 }
 
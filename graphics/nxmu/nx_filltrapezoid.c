@@ -138,5 +138,9 @@ int nx_filltrapezoid(NXWINDOW hwnd, FAR const struct nxgl_rect_s *clip,
 
   /* Forward the trapezoid fill command to the server */
 
+#ifdef CONFIG_NX_BATCH
+  return nxmu_batchwindow(wnd, &outmsg, sizeof(struct nxsvrmsg_filltrapezoid_s));
+#else
   return nxmu_sendwindow(wnd, &outmsg, sizeof(struct nxsvrmsg_filltrapezoid_s));
+#endif
 }
@@ -110,5 +110,9 @@ int nx_move(NXWINDOW hwnd, FAR const struct nxgl_rect_s *rect,
 
   /* Forward the fill command to the server */
 
+#ifdef CONFIG_NX_BATCH
+  return nxmu_batchwindow(wnd, &outmsg, sizeof(struct nxsvrmsg_move_s));
+#else
   return nxmu_sendwindow(wnd, &outmsg, sizeof(struct nxsvrmsg_move_s));
+#endif
 }
@@ -114,5 +114,9 @@ int nx_setpixel(NXWINDOW hwnd, FAR const struct nxgl_point_s *pos,
 
   /* Forward the fill command to the server */
 
+#ifdef CONFIG_NX_BATCH
+  return nxmu_batchwindow(wnd, &outmsg, sizeof(struct nxsvrmsg_setpixel_s));
+#else
   return nxmu_sendwindow(wnd, &outmsg, sizeof(struct nxsvrmsg_setpixel_s));
+#endif
 }
@@ -74,7 +74,14 @@
 #define NX_CLIENT_MQNAMEFMT  "/dev/nxc%d"
 #define NX_CLIENT_MXNAMELEN  (16)
 
-#define NX_MXSVRMSGLEN       (64) /* Maximum size of a client->server command */
+#ifdef CONFIG_NX_BATCH
+#  ifndef CONFIG_NX_BATCHSIZE
+#    define CONFIG_NX_BATCHSIZE 256 /* Size of one batch of drawing commands */
+#  endif
+#  define NX_MXSVRMSGLEN     CONFIG_NX_BATCHSIZE /* Maximum size of a client->server command */
+#else
+#  define NX_MXSVRMSGLEN     (64) /* Maximum size of a client->server command */
+#endif
 #define NX_MXEVENTLEN        (64) /* Maximum size of an event */
 #define NX_MXCLIMSGLEN       (64) /* Maximum size of a server->client message */
 
@@ -110,6 +117,9 @@ struct nxfe_conn_s
 
   mqd_t crdmq;            /* MQ to read from the server (may be non-blocking) */
   mqd_t cwrmq;            /* MQ to write to the server (blocking) */
+#ifdef CONFIG_NX_BATCH
+  FAR struct nxsvrmsg_batch_s *batch; /* Pending drawing commands (NULL if not batching) */
+#endif
 
   /* These are only usable on the server side of the connection */
 
@@ -171,6 +181,7 @@ enum nxmsg_e
   NX_SVRMSG_SETBGCOLOR,       /* Set the color of the background */
   NX_SVRMSG_MOUSEIN,          /* New mouse report from mouse client */
   NX_SVRMSG_KBDIN,            /* New keyboard report from keyboard client */
+  NX_SVRMSG_BATCH,            /* A batch of drawing commands from one client */
 };
 
 /* Message priorities -- they must all be at the same priority to assure
@@ -465,6 +476,23 @@ struct nxsvrmsg_kbdin_s
 };
 #endif
 
+/* This message carries a batch of drawing commands (SETPIXEL, FILL, FILLTRAP,
+ * and MOVE) collected by the client.  The commands follow the header, each
+ * beginning on an NX_BATCHALIGN() boundary, and are executed in order.
+ */
+
+#ifdef CONFIG_NX_BATCH
+struct nxsvrmsg_batch_s
+{
+  uint32_t msgid;                  /* NX_SVRMSG_BATCH */
+  uint32_t nbytes;                 /* Size of the message, header included */
+};
+
+#  define NX_BATCHALIGN(n) \
+    (((n) + sizeof(uintptr_t) - 1) & ~(sizeof(uintptr_t) - 1))
+#  define NX_BATCHHDRLEN   NX_BATCHALIGN(sizeof(struct nxsvrmsg_batch_s))
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -569,6 +597,47 @@ EXTERN int nxmu_sendserver(FAR struct nxfe_conn_s *conn,
 EXTERN int nxmu_sendwindow(FAR struct nxbe_window_s *wnd, FAR const void *msg,
                            size_t msglen);
 
+/****************************************************************************
+ * Name: nxmu_batchwindow
+ *
+ * Description:
+ *  Add a drawing command to the connection's pending batch.  If the client
+ *  has not enabled batching (see nx_batch()), the command is sent
+ *  immediately just as with nxmu_sendwindow().
+ *
+ * Input Parameters:
+ *   wnd    - A pointer to the back-end window structure
+ *   msg    - A pointer to the message to send
+ *   msglen - The length of the message in bytes.
+ *
+ * Return:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_BATCH
+EXTERN int nxmu_batchwindow(FAR struct nxbe_window_s *wnd, FAR const void *msg,
+                            size_t msglen);
+#endif
+
+/****************************************************************************
+ * Name: nxmu_batchflush
+ *
+ * Description:
+ *  Send any pending batch of drawing commands to the server.
+ *
+ * Input Parameters:
+ *   conn - The client containing connection information
+ *
+ * Return:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_BATCH
+EXTERN int nxmu_batchflush(FAR struct nxfe_conn_s *conn);
+#endif
+
 /****************************************************************************
  * Name: nxmu_sendclient
  *
@@ -0,0 +1,184 @@
+/****************************************************************************
+ * graphics/nxmu/nxmu_batch.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <string.h>
+#include <mqueue.h>
+#include <errno.h>
+#include <debug.h>
+
+#include "nxfe.h"
+
+#ifdef CONFIG_NX_BATCH
+
+/****************************************************************************
+ * Pre-Processor Definitions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmu_batchwindow
+ *
+ * Description:
+ *  Add a drawing command to the connection's pending batch.  If the client
+ *  has not enabled batching (see nx_batch()), the command is sent
+ *  immediately just as with nxmu_sendwindow().
+ *
+ * Input Parameters:
+ *   wnd    - A pointer to the back-end window structure
+ *   msg    - A pointer to the message to send
+ *   msglen - The length of the message in bytes.
+ *
+ * Return:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+int nxmu_batchwindow(FAR struct nxbe_window_s *wnd, FAR const void *msg,
+                     size_t msglen)
+{
+  FAR struct nxsvrmsg_batch_s *batch;
+  size_t cmdlen;
+  int ret;
+
+  /* Sanity checking */
+
+#ifdef CONFIG_DEBUG
+  if (!wnd || !wnd->conn)
+    {
+      errno = EINVAL;
+      return ERROR;
+    }
+#endif
+
+  /* Send the message immediately if batching is not enabled or if the
+   * command could never fit into a batch.
+   */
+
+  batch  = wnd->conn->batch;
+  cmdlen = NX_BATCHALIGN(msglen);
+
+  if (!batch || NX_BATCHHDRLEN + cmdlen > NX_MXSVRMSGLEN)
+    {
+      return nxmu_sendwindow(wnd, msg, msglen);
+    }
+
+  /* Ignore messages destined to a blocked window (no errors reported) */
+
+  if (NXBE_ISBLOCKED(wnd))
+    {
+      return OK;
+    }
+
+  /* Send the pending batch if there is no room left for this command */
+
+  if (batch->nbytes + cmdlen > NX_MXSVRMSGLEN)
+    {
+      ret = nxmu_batchflush(wnd->conn);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  /* Then append the command to the batch */
+
+  memcpy((FAR uint8_t *)batch + batch->nbytes, msg, msglen);
+  batch->nbytes += cmdlen;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: nxmu_batchflush
+ *
+ * Description:
+ *  Send any pending batch of drawing commands to the server.
+ *
+ * Input Parameters:
+ *   conn - The client containing connection information
+ *
+ * Return:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+int nxmu_batchflush(FAR struct nxfe_conn_s *conn)
+{
+  FAR struct nxsvrmsg_batch_s *batch = conn->batch;
+  int ret = OK;
+
+  if (batch && batch->nbytes > NX_BATCHHDRLEN)
+    {
+      /* The batch is sent with mq_send() directly, nxmu_sendserver() would
+       * try to flush it again.
+       */
+
+      ret = mq_send(conn->cwrmq, batch, batch->nbytes, NX_SVRMSG_PRIO);
+      if (ret < 0)
+        {
+          gdbg("mq_send failed: %d\n", errno);
+        }
+
+      batch->nbytes = NX_BATCHHDRLEN;
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_NX_BATCH */
@@ -100,6 +100,18 @@ int nxmu_sendserver(FAR struct nxfe_conn_s *conn, FAR const void *msg,
     }
 #endif
 
+#ifdef CONFIG_NX_BATCH
+  /* Send any batched drawing commands first so that the server sees all
+   * commands from this client in the order that they were issued.
+   */
+
+  ret = nxmu_batchflush(conn);
+  if (ret < 0)
+    {
+      return ret;
+    }
+#endif
+
   /* Send the message to the server */
 
   ret = mq_send(conn->cwrmq, msg, msglen, NX_SVRMSG_PRIO);
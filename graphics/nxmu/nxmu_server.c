@@ -40,11 +40,13 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 #include <semaphore.h>
 #include <mqueue.h>
 #include <fcntl.h>
+#include <time.h>
 #include <errno.h>
 #include <debug.h>
 
@@ -55,6 +57,12 @@
  * Pre-Processor Definitions
  ****************************************************************************/
 
+/* Some work is deferred to the end of each display frame */
+
+#if defined(CONFIG_NX_DAMAGE) || defined(CONFIG_NX_FBSHADOW)
+#  define NXMU_HAVE_FRAMES 1
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -128,6 +136,88 @@ static inline void nxmu_connect(FAR struct nxfe_conn_s *conn)
     }
 }
 
+/****************************************************************************
+ * Name: nxmu_batch
+ *
+ * Description:
+ *   Execute each drawing command in a batch.  The visible rectangles of the
+ *   window are found once and reused for each following command to the
+ *   same window.  Nothing in a batch changes the window hierarchy so the
+ *   list remains valid until the window changes.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_BATCH
+static void nxmu_batch(FAR struct nxsvrmsg_batch_s *batch)
+{
+  struct nxbe_cliplist_s list;
+  FAR uint8_t *cmd = (FAR uint8_t *)batch + NX_BATCHHDRLEN;
+  FAR uint8_t *end = (FAR uint8_t *)batch + batch->nbytes;
+  size_t cmdlen;
+
+  list.wnd = NULL;
+  while (cmd < end)
+    {
+      switch (((FAR struct nxsvrmsg_s *)cmd)->msgid)
+        {
+          case NX_SVRMSG_SETPIXEL:
+            {
+              FAR struct nxsvrmsg_setpixel_s *setmsg = (FAR struct nxsvrmsg_setpixel_s *)cmd;
+              if (list.wnd != setmsg->wnd)
+                {
+                  nxbe_cliplist(&list, setmsg->wnd);
+                }
+
+              nxbe_batchsetpixel(&list, &setmsg->pos, setmsg->color);
+              cmdlen = sizeof(struct nxsvrmsg_setpixel_s);
+            }
+            break;
+
+          case NX_SVRMSG_FILL:
+            {
+              FAR struct nxsvrmsg_fill_s *fillmsg = (FAR struct nxsvrmsg_fill_s *)cmd;
+              if (list.wnd != fillmsg->wnd)
+                {
+                  nxbe_cliplist(&list, fillmsg->wnd);
+                }
+
+              nxbe_batchfill(&list, &fillmsg->rect, fillmsg->color);
+              cmdlen = sizeof(struct nxsvrmsg_fill_s);
+            }
+            break;
+
+          case NX_SVRMSG_FILLTRAP:
+            {
+              FAR struct nxsvrmsg_filltrapezoid_s *trapmsg = (FAR struct nxsvrmsg_filltrapezoid_s *)cmd;
+              if (list.wnd != trapmsg->wnd)
+                {
+                  nxbe_cliplist(&list, trapmsg->wnd);
+                }
+
+              nxbe_batchfilltrapezoid(&list, &trapmsg->clip, &trapmsg->trap, trapmsg->color);
+              cmdlen = sizeof(struct nxsvrmsg_filltrapezoid_s);
+            }
+            break;
+
+          case NX_SVRMSG_MOVE:
+            {
+              FAR struct nxsvrmsg_move_s *movemsg = (FAR struct nxsvrmsg_move_s *)cmd;
+              nxbe_move(movemsg->wnd, &movemsg->rect, &movemsg->offset);
+              cmdlen = sizeof(struct nxsvrmsg_move_s);
+            }
+            break;
+
+          default:
+            gdbg("ERROR: Unrecognized batch command: %d\n",
+                 ((FAR struct nxsvrmsg_s *)cmd)->msgid);
+            return;
+        }
+
+      cmd += NX_BATCHALIGN(cmdlen);
+    }
+}
+#endif
+
 /****************************************************************************
  * Name: nxmu_shutdown
  ****************************************************************************/
@@ -265,6 +355,93 @@ static inline int nxmu_setup(FAR const char *mqname, FAR NX_DRIVERTYPE *dev,
   return OK;
 }
 
+/****************************************************************************
+ * Name: nxmu_framestart
+ *
+ * Description:
+ *   Set up the deadline for the end of the current frame:  The damage and
+ *   the framebuffer changes accumulated from now will be flushed
+ *   CONFIG_NX_FRAMEMS milliseconds from now.
+ *
+ ****************************************************************************/
+
+#ifdef NXMU_HAVE_FRAMES
+static inline void nxmu_framestart(FAR struct timespec *deadline)
+{
+  (void)clock_gettime(CLOCK_REALTIME, deadline);
+
+  deadline->tv_sec  += CONFIG_NX_FRAMEMS / 1000;
+  deadline->tv_nsec += (CONFIG_NX_FRAMEMS % 1000) * 1000000;
+  if (deadline->tv_nsec >= 1000000000)
+    {
+      deadline->tv_sec++;
+      deadline->tv_nsec -= 1000000000;
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: nxmu_frameexpired
+ *
+ * Description:
+ *   Return true if the frame deadline has passed.
+ *
+ ****************************************************************************/
+
+#ifdef NXMU_HAVE_FRAMES
+static inline bool nxmu_frameexpired(FAR const struct timespec *deadline)
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_REALTIME, &now);
+  return now.tv_sec > deadline->tv_sec ||
+         (now.tv_sec == deadline->tv_sec && now.tv_nsec >= deadline->tv_nsec);
+}
+#endif
+
+/****************************************************************************
+ * Name: nxmu_framepending
+ *
+ * Description:
+ *   Return true if there is anything to be done at the end of the frame.
+ *
+ ****************************************************************************/
+
+#ifdef NXMU_HAVE_FRAMES
+static inline bool nxmu_framepending(FAR struct nxbe_state_s *be)
+{
+#if defined(CONFIG_NX_DAMAGE) && defined(CONFIG_NX_FBSHADOW)
+  return be->ndamage > 0 || be->ndirty > 0;
+#elif defined(CONFIG_NX_DAMAGE)
+  return be->ndamage > 0;
+#else
+  return be->ndirty > 0;
+#endif
+}
+#endif
+
+/****************************************************************************
+ * Name: nxmu_frameflush
+ *
+ * Description:
+ *   End the current frame:  Send the redraw requests for the damaged
+ *   regions and copy the changed regions of the shadow framebuffer to the
+ *   display.
+ *
+ ****************************************************************************/
+
+#ifdef NXMU_HAVE_FRAMES
+static inline void nxmu_frameflush(FAR struct nxbe_state_s *be)
+{
+#ifdef CONFIG_NX_DAMAGE
+  nxbe_damageflush(be);
+#endif
+#ifdef CONFIG_NX_FBSHADOW
+  nxbe_shadowflush(be);
+#endif
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -294,6 +471,10 @@ int nx_runinstance(FAR const char *mqname, FAR NX_DRIVERTYPE *dev)
   struct nxfe_state_s     fe;
   FAR struct nxsvrmsg_s *msg;
   uint8_t                buffer[NX_MXSVRMSGLEN];
+#ifdef NXMU_HAVE_FRAMES
+  struct timespec        deadline;
+  bool                   pending = false;
+#endif
   int                    nbytes;
   int                    ret;
 
@@ -327,9 +508,43 @@ int nx_runinstance(FAR const char *mqname, FAR NX_DRIVERTYPE *dev)
 
   for (;;)
     {
-       /* Receive the next server message */
+#ifdef NXMU_HAVE_FRAMES
+       /* If any part of the display has been damaged or changed, then all
+        * of the redraw requests and display updates accumulated during this
+        * frame are performed when the frame period expires.  Until then,
+        * wait for the next message only until the end of the frame.
+        */
+
+       if (nxmu_framepending(&fe.be))
+         {
+           if (!pending)
+             {
+               nxmu_framestart(&deadline);
+               pending = true;
+             }
+
+           if (nxmu_frameexpired(&deadline))
+             {
+               nxmu_frameflush(&fe.be);
+               pending = false;
+               continue;
+             }
+
+           nbytes = mq_timedreceive(fe.conn.crdmq, buffer, NX_MXSVRMSGLEN,
+                                    0, &deadline);
+           if (nbytes < 0 && errno == ETIMEDOUT)
+             {
+               continue;
+             }
+         }
+       else
+#endif
+         {
+           /* Receive the next server message */
+
+           nbytes = mq_receive(fe.conn.crdmq, buffer, NX_MXSVRMSGLEN, 0);
+         }
 
-       nbytes = mq_receive(fe.conn.crdmq, buffer, NX_MXSVRMSGLEN, 0);
        if (nbytes < 0)
          {
            if (errno != EINTR)
@@ -508,6 +723,13 @@ int nx_runinstance(FAR const char *mqname, FAR NX_DRIVERTYPE *dev)
            }
            break;
 #endif
+#ifdef CONFIG_NX_BATCH
+         case NX_SVRMSG_BATCH: /* A batch of drawing commands from one client */
+           {
+             nxmu_batch((FAR struct nxsvrmsg_batch_s *)buffer);
+           }
+           break;
+#endif
 
          /* Messages sent to the backgound window ***************************/
 
@@ -43,6 +43,18 @@
 #include <sys/types.h>
 #include <stdint.h>
 
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The state of an incremental CRC calculation (see crc16_init()) */
+
+struct crc16_s
+{
+  uint16_t crc;              /* The running CRC value */
+  uint16_t xorout;           /* Value XOR'ed with the CRC by crc16_final() */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -75,6 +87,42 @@ uint16_t crc16part(FAR const uint8_t *src, size_t len, uint16_t crc16val);
 
 uint16_t crc16(FAR const uint8_t *src, size_t len);
 
+/****************************************************************************
+ * Name: crc16_init
+ *
+ * Description:
+ *   Begin an incremental CRC calculation.  'initial' is the starting CRC
+ *   value and 'xorout' is XOR'ed with the result by crc16_final().  For the
+ *   XMODEM/ZMODEM CRC-16, both are zero.
+ *
+ ****************************************************************************/
+
+void crc16_init(FAR struct crc16_s *ctx, uint16_t initial, uint16_t xorout);
+
+/****************************************************************************
+ * Name: crc16_update
+ *
+ * Description:
+ *   Add the 'len' bytes at 'src' to an incremental CRC calculation.  The
+ *   data may be passed in pieces of any size.
+ *
+ ****************************************************************************/
+
+void crc16_update(FAR struct crc16_s *ctx, FAR const uint8_t *src, size_t len);
+
+/****************************************************************************
+ * Name: crc16_final
+ *
+ * Description:
+ *   Return the CRC of all of the data passed to crc16_update().  crc16part()
+ *   calculates an augmented CRC so the two zero bytes that complete it are
+ *   added here.  The context is not modified so more data may still be
+ *   added.
+ *
+ ****************************************************************************/
+
+uint16_t crc16_final(FAR const struct crc16_s *ctx);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -43,6 +43,18 @@
 #include <sys/types.h>
 #include <stdint.h>
 
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The state of an incremental CRC calculation (see crc32_init()) */
+
+struct crc32_s
+{
+  uint32_t crc;              /* The running CRC value */
+  uint32_t xorout;           /* Value XOR'ed with the CRC by crc32_final() */
+};
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -75,6 +87,40 @@ uint32_t crc32part(FAR const uint8_t *src, size_t len, uint32_t crc32val);
 
 uint32_t crc32(FAR const uint8_t *src, size_t len);
 
+/****************************************************************************
+ * Name: crc32_init
+ *
+ * Description:
+ *   Begin an incremental CRC calculation.  'initial' is the starting CRC
+ *   value and 'xorout' is XOR'ed with the result by crc32_final().  For the
+ *   common (IEEE 802.3) CRC-32, both are 0xffffffff.
+ *
+ ****************************************************************************/
+
+void crc32_init(FAR struct crc32_s *ctx, uint32_t initial, uint32_t xorout);
+
+/****************************************************************************
+ * Name: crc32_update
+ *
+ * Description:
+ *   Add the 'len' bytes at 'src' to an incremental CRC calculation.  The
+ *   data may be passed in pieces of any size.
+ *
+ ****************************************************************************/
+
+void crc32_update(FAR struct crc32_s *ctx, FAR const uint8_t *src, size_t len);
+
+/****************************************************************************
+ * Name: crc32_final
+ *
+ * Description:
+ *   Return the CRC of all of the data passed to crc32_update().  The
+ *   context is not modified so more data may still be added.
+ *
+ ****************************************************************************/
+
+uint32_t crc32_final(FAR const struct crc32_s *ctx);
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -828,6 +828,35 @@ int up_addrenv_release(FAR struct tcb_s *tcb);
 
 bool up_interrupt_context(void);
 
+/****************************************************************************
+ * Name: up_cmpxchg16
+ *
+ * Description:
+ *   Atomically compare the 16-bit value at addr with oldval and, if they
+ *   are equal, replace it with newval.  This is used to implement the
+ *   uncontended fast paths of semaphores and pthread mutexes.  It must be
+ *   atomic with respect to interrupt handlers (for example, using
+ *   LDREXH/STREXH) but must not disable interrupts.
+ *
+ *   Provided only if the architecture selects CONFIG_ARCH_HAVE_CMPXCHG.
+ *   Otherwise, the OS uses a fallback that disables interrupts.
+ *
+ * Input Parameters:
+ *   addr   - The address of the value to be updated
+ *   oldval - The expected current value
+ *   newval - The new value
+ *
+ * Returned Value:
+ *   true if the value was replaced; false if the value at addr was not
+ *   equal to oldval.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_CMPXCHG
+bool up_cmpxchg16(FAR volatile int16_t *addr, int16_t oldval,
+                  int16_t newval);
+#endif
+
 /****************************************************************************
  * Name: up_enable_irq
  *
@@ -935,6 +964,23 @@ char up_romgetc(FAR const char *ptr);
 void up_mdelay(unsigned int milliseconds);
 void up_udelay(useconds_t microseconds);
 
+/****************************************************************************
+ * Name: up_cpuload_clock
+ *
+ * Description:
+ *   Return the current value of a free-running counter that increments at
+ *   CONFIG_SCHED_CPULOAD_CLKFREQ Hz.  The counter is read on every context
+ *   switch to measure the run time of each task, so it must be cheap to
+ *   read.  It is expected to wrap through all 32-bits.
+ *
+ *   Provided only if CONFIG_SCHED_CPULOAD_EXTCLK is selected.
+ *
+ ***************************************************************************/
+
+#ifdef CONFIG_SCHED_CPULOAD_EXTCLK
+uint32_t up_cpuload_clock(void);
+#endif
+
 /****************************************************************************
  * Name: up_cxxinitialize
  *
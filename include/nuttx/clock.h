@@ -42,6 +42,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/types.h>
 #include <stdint.h>
 #include <time.h>
 #include <nuttx/compiler.h>
@@ -121,6 +122,41 @@
 #define TICK2DSEC(tick)       (((tick)+(TICK_PER_DSEC/2))/TICK_PER_DSEC) /* Rounds */
 #define TICK2SEC(tick)        (((tick)+(TICK_PER_SEC/2))/TICK_PER_SEC)   /* Rounds */
 
+/* CPU load measurement.  Run times are counted in system timer ticks or, if
+ * CONFIG_SCHED_CPULOAD_EXTCLK is selected, in counts of the architecture-
+ * specific run-time counter.
+ */
+
+#ifdef CONFIG_SCHED_CPULOAD
+#  ifdef CONFIG_SCHED_CPULOAD_EXTCLK
+#    define CPULOAD_CLOCKS_PER_SEC CONFIG_SCHED_CPULOAD_CLKFREQ
+#  else
+#    define CPULOAD_CLOCKS_PER_SEC TICK_PER_SEC
+#  endif
+
+#  ifndef CONFIG_SCHED_CPULOAD_TIMECONSTANT
+#    define CONFIG_SCHED_CPULOAD_TIMECONSTANT 2
+#  endif
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This structure is returned by clock_cpuload().  active/total is the
+ * fraction of the CPU used by the task over the recent load window.
+ * runtime is the cumulative run time of the task since it was started.
+ */
+
+#ifdef CONFIG_SCHED_CPULOAD
+struct cpuload_s
+{
+  uint32_t total;    /* Clocks counted in the load window for all tasks */
+  uint32_t active;   /* Clocks counted in the load window for this task */
+  uint32_t runtime;  /* Cumulative run time of this task in clocks (wraps) */
+};
+#endif
+
 /****************************************************************************
  * Global Data
  ****************************************************************************/
@@ -242,6 +278,29 @@ EXTERN uint32_t clock_systimer(void);
 EXTERN uint64_t clock_systimer64(void);
 #endif
 
+/****************************************************************************
+ * Function:  clock_cpuload
+ *
+ * Description:
+ *   Return the CPU load of one task.  The load of the whole system is
+ *   100% less the load of the IDLE task (PID 0).
+ *
+ * Parameters:
+ *   pid     - The task ID of the task of interest
+ *   cpuload - The location to return the CPU load
+ *
+ * Return Value:
+ *   OK (0) on success; a negated errno value on failure.  The only
+ *   expected failure is -ESRCH if there is no task with that ID.
+ *
+ * Assumptions:
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPULOAD
+EXTERN int clock_cpuload(pid_t pid, FAR struct cpuload_s *cpuload);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -205,6 +205,22 @@ struct fb_planeinfo_s
   uint8_t    bpp;         /* Bits per pixel */
 };
 
+/* If the video controller does not display the framebuffer memory directly
+ * (for example, if the framebuffer is a shadow of the video memory or the
+ * display must be explicitly refreshed) then the following structure is
+ * used to tell the driver which area of the framebuffer has changed.
+ */
+
+#ifdef CONFIG_FB_UPDATE
+struct fb_area_s
+{
+  fb_coord_t x;           /* x-offset of the area in pixels */
+  fb_coord_t y;           /* y-offset of the area in rows */
+  fb_coord_t w;           /* Width of the area in pixels */
+  fb_coord_t h;           /* Height of the area in rows */
+};
+#endif
+
 /* On video controllers that support mapping of a pixel palette value
  * to an RGB encoding, the following structure may be used to define
  * that mapping.
@@ -314,6 +330,14 @@ struct fb_vtable_s
   int (*getcursor)(FAR struct fb_vtable_s *vtable, FAR struct fb_cursorattrib_s *attrib);
   int (*setcursor)(FAR struct fb_vtable_s *vtable, FAR struct fb_setcursor_s *settings);
 #endif
+
+  /* The following is provided only if the video hardware must be told when
+   * an area of the framebuffer has been modified.  It may be NULL.
+   */
+
+#ifdef CONFIG_FB_UPDATE
+  int (*updatearea)(FAR struct fb_vtable_s *vtable, FAR const struct fb_area_s *area);
+#endif
 };
 
 /****************************************************************************
@@ -55,6 +55,8 @@
 
 #define __FS_FLAG_EOF   (1 << 0) /* EOF detected by a read operation */
 #define __FS_FLAG_ERROR (1 << 1) /* Error detected by any operation */
+#define __FS_FLAG_LBF   (1 << 2) /* Line buffered (see setvbuf()) */
+#define __FS_FLAG_UBF   (1 << 3) /* Buffer is owned by the user (see setvbuf()) */
 
 /****************************************************************************
  * Type Definitions
@@ -268,6 +270,10 @@ struct filelist
  *     |                      |                RD: Pointer to last buffered read char+1
  *     +----------------------+
  *                              <- fs_bufend   Points to end end of the buffer+1
+ *
+ * The buffer is normally allocated when the stream is opened but may be
+ * replaced, resized, or removed with setvbuf().  If the stream is unbuffered,
+ * then all four pointers are NULL.
  */
 
 #if CONFIG_NFILE_STREAMS > 0
@@ -282,6 +288,9 @@ struct file_struct
   FAR unsigned char *fs_bufend;    /* Pointer to 1 past end of buffer */
   FAR unsigned char *fs_bufpos;    /* Current position in buffer */
   FAR unsigned char *fs_bufread;   /* Pointer to 1 past last buffered read char. */
+#ifdef CONFIG_STDIO_READAHEAD
+  size_t             fs_rasize;    /* Current read-ahead window size */
+#endif
 #endif
   uint16_t           fs_oflags;    /* Open mode flags */
   uint8_t            fs_flags;     /* Stream flags */
@@ -528,6 +537,51 @@ int file_dup2(int fd1, int fd2);
 #endif
 #endif
 
+/* fs_read.c ****************************************************************/
+/****************************************************************************
+ * Name: file_read
+ *
+ * Description:
+ *   Equivalent to the standard read() function except that it accepts a
+ *   struct file instance instead of a file descriptor.  Returns a negated
+ *   errno value on failure; errno is not modified.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+ssize_t file_read(FAR struct file *filep, FAR void *buf, size_t nbytes);
+#endif
+
+/* fs_lseek.c ***************************************************************/
+/****************************************************************************
+ * Name: file_seek
+ *
+ * Description:
+ *   Equivalent to the standard lseek() function except that it accepts a
+ *   struct file instance instead of a file descriptor.  Returns a negated
+ *   errno value on failure; errno is not modified.
+ *
+ ****************************************************************************/
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+off_t file_seek(FAR struct file *filep, off_t offset, int whence);
+#endif
+
+/* libc/misc/lib_sendfile.c *************************************************/
+/****************************************************************************
+ * Name: lib_sendfile
+ *
+ * Description:
+ *   The generic read()/write() implementation of sendfile().  When the
+ *   kernel sendfile() is enabled (CONFIG_NET_SENDFILE), this is the
+ *   fallback used for any transfer that is not file-to-TCP socket.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_SENDFILE
+ssize_t lib_sendfile(int outfd, int infd, FAR off_t *offset, size_t count);
+#endif
+
 /* fs_openblockdriver.c *****************************************************/
 /****************************************************************************
  * Name: open_blockdriver
@@ -94,6 +94,42 @@ struct lcd_planeinfo_s
   int (*getrun)(fb_coord_t row, fb_coord_t col, FAR uint8_t *buffer,
                 size_t npixels);
 
+  /* This method can be used to write a rectangular area to the LCD in one
+   * transfer:  The LCD window is set up once and the pixels of all rows are
+   * sent in a single burst (possibly using DMA).  This method is optional
+   * and may be NULL.  In that case, putrun() is used for each row.
+   *
+   *  row     - Starting row to write to (range: 0 <= row <= yres-nrows)
+   *  col     - Starting column to write to (range: 0 <= col <= xres-npixels)
+   *  nrows   - The number of rows to write (range: 0 < nrows <= yres-row)
+   *  npixels - The number of pixels to write in each row
+   *            (range: 0 < npixels <= xres-col)
+   *  buffer  - The buffer containing the first row of the area
+   *  stride  - The distance in bytes from the start of one row in the buffer
+   *            to the start of the next.  If zero, the same run is written
+   *            to every row (as when filling an area with one color).
+   */
+
+  int (*putarea)(fb_coord_t row, fb_coord_t col, fb_coord_t nrows,
+                 size_t npixels, FAR const uint8_t *buffer, size_t stride);
+
+  /* This method can be used to read a rectangular area from the LCD in one
+   * transfer.  This method is optional and may be NULL.  In that case,
+   * getrun() is used for each row.
+   *
+   *  row     - Starting row to read from (range: 0 <= row <= yres-nrows)
+   *  col     - Starting column to read from (range: 0 <= col <= xres-npixels)
+   *  nrows   - The number of rows to read (range: 0 < nrows <= yres-row)
+   *  npixels - The number of pixels to read in each row
+   *            (range: 0 < npixels <= xres-col)
+   *  buffer  - The buffer in which to return the area read from the LCD
+   *  stride  - The distance in bytes from the start of one row in the buffer
+   *            to the start of the next (stride > 0)
+   */
+
+  int (*getarea)(fb_coord_t row, fb_coord_t col, fb_coord_t nrows,
+                 size_t npixels, FAR uint8_t *buffer, size_t stride);
+
   /* Plane color characteristics ********************************************/
 
   /* This is working memory allocated by the LCD driver for each LCD device
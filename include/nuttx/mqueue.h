@@ -63,17 +63,21 @@
 /* This structure defines a message queue */
 
 struct mq_des; /* forward reference */
+struct mqmsg;  /* forward reference */
 
 struct msgq_s
 {
   FAR struct msgq_s *flink;   /* Forward link to next message queue */
-  sq_queue_t   msglist;       /* Prioritized message list */
+  FAR struct mqmsg *msghead;  /* Highest priority message sub-queue */
+  FAR struct mqmsg *msgfree;  /* Free message slots of this queue */
+  dq_queue_t   waitnotempty;  /* Prioritized list of tasks waiting for not empty */
+  dq_queue_t   waitnotfull;   /* Prioritized list of tasks waiting for not full */
   int16_t      maxmsgs;       /* Maximum number of messages in the queue */
   int16_t      nmsgs;         /* Number of message in the queue */
   int16_t      nconnect;      /* Number of connections to message queue */
   int16_t      nwaitnotfull;  /* Number tasks waiting for not full */
   int16_t      nwaitnotempty; /* Number tasks waiting for not empty */
-  uint8_t      maxmsgsize;    /* Max size of message in message queue */
+  uint16_t     maxmsgsize;    /* Max size of message in message queue */
   bool         unlinked;      /* true if the msg queue has been unlinked */
 #ifndef CONFIG_DISABLE_SIGNALS
   FAR struct mq_des *ntmqdes; /* Notification: Owning mqdes (NULL if none) */
@@ -114,6 +118,24 @@ extern "C" {
 #define EXTERN extern
 #endif
 
+/* Non-standard, zero-copy message interfaces.  mq_loan() reserves a free
+ * message slot of the queue and returns a pointer to its payload (of size
+ * mq_msgsize).  The sender fills in the message in place and queues it with
+ * mq_sendloan().  mq_receiveloan() removes the next message from the queue
+ * without copying it and returns a pointer to its payload.  Every loaned
+ * buffer must be handed back with mq_sendloan() or mq_returnloan() before
+ * the message queue is closed.
+ */
+
+#ifdef CONFIG_MQ_LOAN
+EXTERN FAR void *mq_loan(mqd_t mqdes);
+EXTERN int      mq_sendloan(mqd_t mqdes, FAR void *buffer, size_t msglen,
+                            int prio);
+EXTERN ssize_t  mq_receiveloan(mqd_t mqdes, FAR void **buffer,
+                               FAR int *prio);
+EXTERN int      mq_returnloan(mqd_t mqdes, FAR void *buffer);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -188,6 +188,19 @@ int psock_connect(FAR struct socket *psock, FAR const struct sockaddr *addr,
 ssize_t psock_send(FAR struct socket *psock, const void *buf, size_t len,
                    int flags);
 
+/* net_sendfile.c ************************************************************/
+/* Send data from a regular file on a mounted volume on a connected TCP
+ * socket.  The file is read by the caller into a buffer that the network
+ * sends from directly.  'infile' is the file structure backing the input
+ * file descriptor.
+ */
+
+#if defined(CONFIG_NET_SENDFILE) && CONFIG_NFILE_DESCRIPTORS > 0
+struct file;
+ssize_t net_sendfile(int outfd, FAR struct file *infile, FAR off_t *offset,
+                     size_t count);
+#endif
+
 /* sendto.c ******************************************************************/
 /* Sendto using underlying socket structure */
 
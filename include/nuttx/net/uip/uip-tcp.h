@@ -164,11 +164,17 @@ struct uip_conn
    *   backlog - The pending connection backlog.  If this connection is
    *     configured as a listener with backlog, then this refers to the
    *     struct uip_backlog_s tear-off structure that manages that backlog.
+   *   blnode - Links this connection into one of the parent's backlog
+   *     queues.
+   *   blhalfopen - True if this backlogged connection is still waiting for
+   *     the ACK of its SYNACK.
    */
 
 #ifdef CONFIG_NET_TCPBACKLOG
   struct uip_conn      *blparent;
   struct uip_backlog_s *backlog;
+  dq_entry_t            blnode;
+  bool                  blhalfopen;
 #endif
 
   /* Application callbacks:
@@ -225,22 +231,21 @@ struct uip_readahead_s
 
 /* Support for listen backlog:
  *
- *   struct uip_blcontainer_s describes one backlogged connection
  *   struct uip_backlog_s is a "tear-off" describing all backlog for a
- *      listener connection
+ *      listener connection.  Backlogged connections are linked into one of
+ *      two FIFO queues through their blnode field:  Half-open connections
+ *      (SYNACK sent but not yet ACKed) and established connections.  The
+ *      total of both is limited by the listen() backlog argument.
  */
 
 #ifdef CONFIG_NET_TCPBACKLOG
-struct uip_blcontainer_s
-{
-  sq_entry_t           bc_node;    /* Implements a singly linked list */
-  FAR struct uip_conn *bc_conn;    /* Holds reference to the new connection structure */
-};
-
 struct uip_backlog_s
 {
-  sq_queue_t           bl_free;    /* Implements a singly-linked list of free containers */
-  sq_queue_t           bl_pending; /* Implements a singly-linked list of pending connections */
+  dq_queue_t           bl_halfopen;  /* Half-open connections (FIFO) */
+  dq_queue_t           bl_pending;   /* Established connections (FIFO) */
+  uint16_t             bl_max;       /* Maximum number of backlogged connections */
+  uint16_t             bl_nhalfopen; /* Number of connections in bl_halfopen */
+  uint16_t             bl_npending;  /* Number of connections in bl_pending */
 };
 #endif
 
@@ -404,6 +409,7 @@ extern bool uip_backlogavailable(FAR struct uip_conn *conn);
 #endif
 extern FAR struct uip_conn *uip_backlogremove(FAR struct uip_conn *conn);
 extern int uip_backlogdelete(FAR struct uip_conn *conn, FAR struct uip_conn *blconn);
+extern void uip_backlogconnected(FAR struct uip_conn *blconn);
 
 #else
 #  define uip_backlogcreate(conn,nblg) (-ENOSYS)
@@ -411,6 +417,7 @@ extern int uip_backlogdelete(FAR struct uip_conn *conn, FAR struct uip_conn *blc
 #  define uip_backlogadd(conn,blconn)  (-ENOSYS)
 #  define uip_backlogavailable(conn)   (false);
 #  define uip_backlogremove(conn)      (NULL)
+#  define uip_backlogconnected(blconn)
 #endif
 
 /* Tell the sending host to stop sending data.
@@ -500,6 +500,55 @@ EXTERN int nx_closewindow(NXWINDOW hwnd);
 EXTERN int nx_block(NXWINDOW hwnd, FAR void *arg);
 #endif
 
+/****************************************************************************
+ * Name: nx_batch
+ *
+ * Description:
+ *   Enable or disable batching of drawing commands on this connection.
+ *   While batching is enabled, nx_setpixel, nx_fill, nx_filltrapezoid, and
+ *   nx_move (and the drawing functions built on them) are collected into
+ *   messages of up to CONFIG_NX_BATCHSIZE bytes and sent to the server
+ *   together.  The pending commands are sent when the batch is full, before
+ *   any other message to the server, on nx_flush(), and when batching is
+ *   disabled.
+ *
+ *   Multiple user mode only!
+ *
+ * Input Parameters:
+ *   handle - The handle returned by nx_connect
+ *   enable - True: Start batching; false: send any pending commands and
+ *            stop batching.
+ *
+ * Return:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_BATCH
+EXTERN int nx_batch(NXHANDLE handle, bool enable);
+#endif
+
+/****************************************************************************
+ * Name: nx_flush
+ *
+ * Description:
+ *   Send any drawing commands batched on this connection to the server now.
+ *   This is a no-op if batching is not enabled.
+ *
+ *   Multiple user mode only!
+ *
+ * Input Parameters:
+ *   handle - The handle returned by nx_connect
+ *
+ * Return:
+ *   OK on success; ERROR on failure with errno set appropriately
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NX_BATCH
+EXTERN int nx_flush(NXHANDLE handle);
+#endif
+
 /****************************************************************************
  * Name: nx_requestbkgd
  *
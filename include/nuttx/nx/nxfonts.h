@@ -42,6 +42,7 @@
 
 #include <nuttx/config.h>
 
+#include <sys/types.h>
 #include <stdint.h>
 
 #include <nuttx/nx/nx.h>
@@ -120,6 +121,20 @@
 
 #endif
 
+/* Shared glyph cache.  CONFIG_NXFONTS_CACHEBUDGET is the amount of memory
+ * (in bytes) that may be used for cached glyphs;  CONFIG_NXFONTS_CACHEHASH
+ * is the number of hash table buckets.
+ */
+
+#ifdef CONFIG_NXFONTS_CACHE
+#  ifndef CONFIG_NXFONTS_CACHEBUDGET
+#    define CONFIG_NXFONTS_CACHEBUDGET 4096
+#  endif
+#  ifndef CONFIG_NXFONTS_CACHEHASH
+#    define CONFIG_NXFONTS_CACHEHASH 32
+#  endif
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -267,6 +282,47 @@ struct nx_fontpackage_s
 #endif
 };
 
+/* This structure describes one glyph in the shared glyph cache:  The font
+ * bitmap for one character rendered at one pixel depth with one pair of
+ * foreground and background colors.
+ */
+
+#ifdef CONFIG_NXFONTS_CACHE
+struct nxf_glyph_s
+{
+  /* These are used only by the glyph cache */
+
+  FAR struct nxf_glyph_s *hnext; /* Next glyph in the same hash bucket */
+  FAR struct nxf_glyph_s *flink; /* Next, less recently used glyph */
+  FAR struct nxf_glyph_s *blink; /* Previous, more recently used glyph */
+  size_t size;                   /* Allocated size (with the bitmap) */
+  nxgl_mxpixel_t fgcolor;        /* Character color */
+  nxgl_mxpixel_t bgcolor;        /* Background color */
+  uint16_t code;                 /* Character code */
+  uint8_t fontid;                /* Font ID (see enum nx_fontid_e) */
+  uint8_t bpp;                   /* Bits per pixel */
+  uint8_t crefs;                 /* Number of users of the glyph */
+
+  /* These describe the rendered glyph */
+
+  uint8_t width;                 /* Width of the glyph (in pixels) */
+  uint8_t height;                /* Height of the glyph (in rows) */
+  uint16_t stride;               /* Width of a glyph row (in bytes) */
+  FAR uint8_t *bitmap;           /* Rendered glyph bitmap */
+};
+
+/* Glyph cache statistics */
+
+struct nxf_cachestats_s
+{
+  uint32_t hits;                 /* Glyphs found in the cache */
+  uint32_t misses;               /* Glyphs that had to be rendered */
+  uint32_t evictions;            /* Glyphs freed to stay within the budget */
+  uint32_t nglyphs;              /* Number of glyphs in the cache */
+  size_t   nbytes;               /* Memory used by the cached glyphs */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -378,6 +434,68 @@ EXTERN int nxf_convert_32bpp(FAR uint32_t *dest, uint16_t height,
                              FAR const struct nx_fontbitmap_s *bm,
                              nxgl_mxpixel_t color);
 
+/****************************************************************************
+ * Name: nxf_cache_getglyph
+ *
+ * Description:
+ *   Return the pre-rendered glyph for a character, rendering it and adding
+ *   it to the shared glyph cache if it is not already there.  Glyphs are
+ *   identified by font, character code, pixel depth, and colors.  The least
+ *   recently used glyphs are discarded to keep the cache within
+ *   CONFIG_NXFONTS_CACHEBUDGET bytes.
+ *
+ *   The returned glyph remains valid until it is released with
+ *   nxf_cache_release().
+ *
+ * Input Parameters:
+ *   hfont:   A font handle previously returned by nxf_getfonthandle()
+ *   ch:      The character code
+ *   bpp:     The pixel depth of the glyph (1, 2, 4, 8, 16, or 32)
+ *   fgcolor: The color of the character
+ *   bgcolor: The color of the glyph background
+ *
+ * Returned Value:
+ *   The glyph on success; NULL if the font has no glyph for the character
+ *   code or if the glyph could not be allocated.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFONTS_CACHE
+EXTERN FAR const struct nxf_glyph_s *
+  nxf_cache_getglyph(NXHANDLE hfont, uint16_t ch, uint8_t bpp,
+                     nxgl_mxpixel_t fgcolor, nxgl_mxpixel_t bgcolor);
+#endif
+
+/****************************************************************************
+ * Name: nxf_cache_release
+ *
+ * Description:
+ *   Release a glyph returned by nxf_cache_getglyph().
+ *
+ * Input Parameters:
+ *   glyph:   The glyph to release
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFONTS_CACHE
+EXTERN void nxf_cache_release(FAR const struct nxf_glyph_s *glyph);
+#endif
+
+/****************************************************************************
+ * Name: nxf_cache_getstats
+ *
+ * Description:
+ *   Return a snapshot of the glyph cache statistics.
+ *
+ * Input Parameters:
+ *   stats:   The location to return the statistics
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NXFONTS_CACHE
+EXTERN void nxf_cache_getstats(FAR struct nxf_cachestats_s *stats);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
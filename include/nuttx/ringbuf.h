@@ -0,0 +1,299 @@
+/****************************************************************************
+ * include/nuttx/ringbuf.h
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_RINGBUF_H
+#define __INCLUDE_NUTTX_RINGBUF_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <semaphore.h>
+#include <poll.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Ring buffer state queries.  These may be used by either the producer or
+ * the consumer.  The result may be stale by the time it is used, but only
+ * in the safe direction:  The producer may see less space and the
+ * consumer may see less data than is actually available.
+ */
+
+#define ringbuf_isempty(rb) ((rb)->rb_head == (rb)->rb_tail)
+#define ringbuf_isfull(rb)  (ringbuf_used(rb) >= (rb)->rb_size)
+#define ringbuf_space(rb)   ((rb)->rb_size - ringbuf_used(rb))
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This structure describes a byte ring buffer with one producer and one
+ * consumer.  The producer only modifies rb_head and the consumer only
+ * modifies rb_tail, so neither needs to lock out the other:  A task and
+ * an interrupt handler or two tasks may share the ring buffer without
+ * disabling interrupts or taking a semaphore.
+ *
+ * Both indices run from 0 to 2*rb_size-1 so that a full ring buffer can be
+ * distinguished from an empty one without sacrificing one byte of the
+ * buffer and without requiring that rb_size be a power of two.
+ */
+
+struct ringbuf_s
+{
+  FAR uint8_t    *rb_buffer;  /* Storage for the data */
+  size_t          rb_size;    /* Size of rb_buffer in bytes */
+  volatile size_t rb_head;    /* Producer index.  Next byte to write */
+  volatile size_t rb_tail;    /* Consumer index.  Next byte to read */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: ringbuf_init
+ *
+ * Description:
+ *   Initialize an empty ring buffer that uses the caller-provided storage.
+ *
+ * Input parameters:
+ *   rb     - The ring buffer to initialize
+ *   buffer - Storage for the ring buffer data
+ *   size   - Size of 'buffer' in bytes.  Need not be a power of two.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ringbuf_init(FAR struct ringbuf_s *rb, FAR void *buffer, size_t size);
+
+/****************************************************************************
+ * Name: ringbuf_reset
+ *
+ * Description:
+ *   Discard all of the data in the ring buffer.  Neither the producer nor
+ *   the consumer may be using the ring buffer.
+ *
+ ****************************************************************************/
+
+#define ringbuf_reset(rb) do { (rb)->rb_head = (rb)->rb_tail = 0; } while (0)
+
+/****************************************************************************
+ * Name: ringbuf_used
+ *
+ * Description:
+ *   Return the number of bytes of data in the ring buffer.
+ *
+ ****************************************************************************/
+
+size_t ringbuf_used(FAR const struct ringbuf_s *rb);
+
+/****************************************************************************
+ * Name: ringbuf_put
+ *
+ * Description:
+ *   Producer side:  Copy as much of 'data' into the ring buffer as will
+ *   fit.  The data is copied with at most two memcpy() calls and then
+ *   published to the consumer all at once.  Only one producer may call
+ *   ringbuf_put(), ringbuf_putc(), or ringbuf_wrcommit() at a time (see
+ *   ringbuf_mput()).
+ *
+ * Input parameters:
+ *   rb   - The ring buffer
+ *   data - The data to be copied into the ring buffer
+ *   len  - The number of bytes in 'data'
+ *
+ * Returned Value:
+ *   The number of bytes copied (zero if the ring buffer is full).
+ *
+ ****************************************************************************/
+
+size_t ringbuf_put(FAR struct ringbuf_s *rb, FAR const void *data,
+                   size_t len);
+
+/****************************************************************************
+ * Name: ringbuf_mput
+ *
+ * Description:
+ *   Same as ringbuf_put() but may be called by several producers (tasks
+ *   and interrupt handlers) at the same time.  The producers are
+ *   serialized by disabling interrupts during the copy.  The consumer side
+ *   remains lock-free.
+ *
+ ****************************************************************************/
+
+size_t ringbuf_mput(FAR struct ringbuf_s *rb, FAR const void *data,
+                    size_t len);
+
+/****************************************************************************
+ * Name: ringbuf_get
+ *
+ * Description:
+ *   Consumer side:  Copy up to 'len' bytes from the ring buffer into
+ *   'data' and release the space to the producer all at once.  Only one
+ *   consumer may use the ring buffer at a time.
+ *
+ * Input parameters:
+ *   rb   - The ring buffer
+ *   data - The location to copy the data to
+ *   len  - The maximum number of bytes to copy
+ *
+ * Returned Value:
+ *   The number of bytes copied (zero if the ring buffer is empty).
+ *
+ ****************************************************************************/
+
+size_t ringbuf_get(FAR struct ringbuf_s *rb, FAR void *data, size_t len);
+
+/****************************************************************************
+ * Name: ringbuf_putc and ringbuf_getc
+ *
+ * Description:
+ *   Single byte versions of ringbuf_put() and ringbuf_get().
+ *
+ * Returned Value:
+ *   ringbuf_putc() returns true if the byte was added and false if the
+ *   ring buffer is full.  ringbuf_getc() returns the byte or EOF (-1) if
+ *   the ring buffer is empty.
+ *
+ ****************************************************************************/
+
+bool ringbuf_putc(FAR struct ringbuf_s *rb, uint8_t ch);
+int  ringbuf_getc(FAR struct ringbuf_s *rb);
+
+/****************************************************************************
+ * Name: ringbuf_wrspan and ringbuf_wrcommit
+ *
+ * Description:
+ *   Producer side, zero-copy:  ringbuf_wrspan() returns the location and
+ *   size of the contiguous free space that follows the data in the ring
+ *   buffer.  After writing up to that many bytes there (by DMA, for
+ *   example), the producer publishes them with ringbuf_wrcommit().
+ *
+ * Input parameters:
+ *   rb   - The ring buffer
+ *   ptr  - Location to return the address of the free space
+ *   len  - The number of bytes to publish (ringbuf_wrcommit() only)
+ *
+ * Returned Value:
+ *   ringbuf_wrspan() returns the number of contiguous free bytes.
+ *
+ ****************************************************************************/
+
+size_t ringbuf_wrspan(FAR struct ringbuf_s *rb, FAR uint8_t **ptr);
+void   ringbuf_wrcommit(FAR struct ringbuf_s *rb, size_t len);
+
+/****************************************************************************
+ * Name: ringbuf_rdspan and ringbuf_rdcommit
+ *
+ * Description:
+ *   Consumer side, zero-copy:  ringbuf_rdspan() returns the location and
+ *   size of the contiguous data at the head of the ring buffer.  After
+ *   using up to that many bytes in place, the consumer releases them to
+ *   the producer with ringbuf_rdcommit().
+ *
+ * Input parameters:
+ *   rb   - The ring buffer
+ *   ptr  - Location to return the address of the data
+ *   len  - The number of bytes to release (ringbuf_rdcommit() only)
+ *
+ * Returned Value:
+ *   ringbuf_rdspan() returns the number of contiguous bytes of data.
+ *
+ ****************************************************************************/
+
+size_t ringbuf_rdspan(FAR struct ringbuf_s *rb, FAR uint8_t **ptr);
+void   ringbuf_rdcommit(FAR struct ringbuf_s *rb, size_t len);
+
+/****************************************************************************
+ * Name: ringbuf_notify
+ *
+ * Description:
+ *   Wake up every thread that is waiting on 'sem'.  This is used with one
+ *   semaphore (initialized to zero) on which consumers wait for data and
+ *   another on which producers wait for space:  A consumer that finds the
+ *   ring buffer empty waits on the first semaphore and the producer calls
+ *   ringbuf_notify() on it after adding data (and vice versa).  This may
+ *   be called from an interrupt handler.
+ *
+ * Input parameters:
+ *   sem - The semaphore that the threads are waiting on
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void ringbuf_notify(FAR sem_t *sem);
+
+/****************************************************************************
+ * Name: ringbuf_pollevents and ringbuf_pollnotify
+ *
+ * Description:
+ *   ringbuf_pollevents() returns POLLIN if the ring buffer holds data and
+ *   POLLOUT if it has space.  ringbuf_pollnotify() reports the events in
+ *   'eventset' to the threads waiting in poll() on the 'nfds' pollfd
+ *   references in 'fds' (some of which may be NULL).
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_POLL
+pollevent_t ringbuf_pollevents(FAR const struct ringbuf_s *rb);
+void ringbuf_pollnotify(FAR struct pollfd **fds, int nfds,
+                        pollevent_t eventset);
+#endif
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_NUTTX_RINGBUF_H */
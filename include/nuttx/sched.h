@@ -453,6 +453,7 @@ struct tcb_s
   uint8_t  pend_reprios[CONFIG_SEM_NNESTPRIO];
 #  endif
   uint8_t  base_priority;                /* "Normal" priority of the thread     */
+  FAR struct semholder_s *holdsem;       /* Pre-allocated holders of thread     */
 #endif
 
   uint8_t  task_state;                   /* Current state of the thread         */
@@ -461,6 +462,10 @@ struct tcb_s
 
 #if CONFIG_RR_INTERVAL > 0
   int      timeslice;                    /* RR timeslice interval remaining     */
+#endif
+#ifdef CONFIG_SCHED_CPULOAD
+  uint32_t ticks;                        /* Run time in the current load window */
+  uint32_t runtime;                      /* Cumulative run time (wraps)         */
 #endif
   FAR struct wdog_s *waitdog;            /* All timed waits used this wdog      */
 
@@ -474,6 +479,10 @@ struct tcb_s
                                          /* Need to deallocate stack            */
   FAR void *adj_stack_ptr;               /* Adjusted stack_alloc_ptr for HW     */
                                          /* The initial stack pointer value     */
+#ifdef CONFIG_SCHED_TCBPOOL
+  size_t    req_stack_size;              /* Requested stack size.  Zero if the  */
+                                         /* TCB cannot be re-used               */
+#endif
 #endif
 
   /* External Module Support ****************************************************/
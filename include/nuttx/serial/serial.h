@@ -46,6 +46,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <semaphore.h>
+#ifdef CONFIG_SERIAL_TERMIOS
+#  include <wdog.h>
+#endif
 
 #include <nuttx/fs/fs.h>
 
@@ -75,6 +78,17 @@
 #define uart_send(dev,ch)        dev->ops->send(dev,ch)
 #define uart_receive(dev,s)      dev->ops->receive(dev,s)
 
+#ifdef CONFIG_SERIAL_DMA
+#  define uart_dmasend(dev)      \
+   ((dev)->ops->dmasend ? (dev)->ops->dmasend(dev) : (void)0)
+#  define uart_dmareceive(dev)   \
+   ((dev)->ops->dmareceive ? (dev)->ops->dmareceive(dev) : (void)0)
+#  define uart_dmarxfree(dev)    \
+   ((dev)->ops->dmarxfree ? (dev)->ops->dmarxfree(dev) : (void)0)
+#  define uart_dmatxavail(dev)   \
+   ((dev)->ops->dmatxavail ? (dev)->ops->dmatxavail(dev) : (void)0)
+#endif
+
 /************************************************************************************
  * Public Types
  ************************************************************************************/
@@ -93,9 +107,28 @@ struct uart_buffer_s
   FAR char        *buffer; /* Pointer to the allocated buffer memory */
 };
 
+/* This structure describes one DMA transfer to or from a serial I/O buffer.
+ * Because the serial buffers are circular, a transfer may consist of two
+ * contiguous regions:  The first region begins at the current head (RX) or
+ * tail (TX) index; the second (optional) region begins at the start of the
+ * buffer after the index wraps.  The lower half sets 'nbytes' to the number
+ * of bytes actually transferred before reporting completion.
+ */
+
+#ifdef CONFIG_SERIAL_DMA
+struct uart_dmaxfer_s
+{
+  FAR char        *buffer;  /* First DMA buffer region */
+  FAR char        *nbuffer; /* Next DMA buffer region (after wrap) */
+  size_t           length;  /* Length of the first region */
+  size_t           nlength; /* Length of the next region */
+  size_t           nbytes;  /* Bytes actually transferred from both regions */
+};
+#endif
+
 /* This structure defines all of the operations providd by the architecture specific
  * logic.  All fields must be provided with non-NULL function pointers by the
- * caller of uart_register().
+ * caller of uart_register() (except for the optional DMA methods).
  */
 
 struct uart_dev_s;
@@ -177,6 +210,39 @@ struct uart_ops_s
    */
 
   CODE bool (*txempty)(FAR struct uart_dev_s *dev);
+
+#ifdef CONFIG_SERIAL_DMA
+  /* The following methods are optional and may be NULL if the lower half
+   * does not support DMA.  They permit the lower half to move whole regions
+   * of the serial buffers with a single transfer rather than one byte per
+   * send() or receive() call.
+   *
+   * dmasend() starts a DMA transfer of the regions described by dev->dmatx.
+   * When the transfer completes, the lower half sets dev->dmatx.nbytes and
+   * calls uart_xmitchars_done().
+   */
+
+  CODE void (*dmasend)(FAR struct uart_dev_s *dev);
+
+  /* dmareceive() starts a DMA transfer into the regions described by
+   * dev->dmarx.  When the transfer completes (or the line goes idle), the
+   * lower half sets dev->dmarx.nbytes and calls uart_recvchars_done().
+   */
+
+  CODE void (*dmareceive)(FAR struct uart_dev_s *dev);
+
+  /* dmarxfree() is called by the upper half when data has been removed from
+   * the RX buffer so that a stalled receive DMA may be restarted.
+   */
+
+  CODE void (*dmarxfree)(FAR struct uart_dev_s *dev);
+
+  /* dmatxavail() is called by the upper half when new data has been added to
+   * the TX buffer so that an idle transmit DMA may be started.
+   */
+
+  CODE void (*dmatxavail)(FAR struct uart_dev_s *dev);
+#endif
 };
 
 /* This is the device structure used by the driver.  The caller of
@@ -198,6 +264,14 @@ struct uart_dev_s
   volatile bool        disconnected; /* true: Removable device is not connected */
 #endif
   bool                 isconsole;    /* true: This is the serial console */
+#ifdef CONFIG_SERIAL_TERMIOS
+  uint8_t              vmin;         /* termios VMIN: Minimum bytes for read() */
+  uint8_t              vtime;        /* termios VTIME: read() timeout (deciseconds) */
+  volatile bool        rxinterbyte;  /* true: Restart rxtimer as each byte arrives */
+  volatile bool        rxexpired;    /* true: rxtimer expired or the line went idle */
+  volatile int16_t     rxthreshold;  /* Buffered bytes needed to wake the reader */
+  WDOG_ID              rxtimer;      /* Implements the VTIME timeout */
+#endif
   sem_t                closesem;     /* Locks out new open while close is in progress */
   sem_t                xmitsem;      /* Wakeup user waiting for space in xmit.buffer */
   sem_t                recvsem;      /* Wakeup user waiting for data in recv.buffer */
@@ -206,6 +280,10 @@ struct uart_dev_s
 #endif
   struct uart_buffer_s xmit;         /* Describes transmit buffer */
   struct uart_buffer_s recv;         /* Describes receive buffer */
+#ifdef CONFIG_SERIAL_DMA
+  struct uart_dmaxfer_s dmatx;       /* Describes transmit DMA transfer */
+  struct uart_dmaxfer_s dmarx;       /* Describes receive DMA transfer */
+#endif
   FAR const struct uart_ops_s *ops;  /* Arch-specific operations */
   FAR void            *priv;         /* Used by the arch-specific logic */
 
@@ -286,6 +364,23 @@ void uart_recvchars(FAR uart_dev_t *dev);
 
 void uart_datareceived(FAR uart_dev_t *dev);
 
+/************************************************************************************
+ * Name: uart_recvidle
+ *
+ * Description:
+ *   This function may be called by the lower half when it detects that the RX
+ *   line has gone idle after receiving data (for example, from an IDLE line
+ *   interrupt or a receiver timeout).  Any new RX data must already have been
+ *   added to the recv buffer.  A reader that is waiting for more data to satisfy
+ *   its VMIN threshold will be awakened and will return the data received so
+ *   far.  This allows framed protocols to receive one frame per wakeup.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_TERMIOS
+void uart_recvidle(FAR uart_dev_t *dev);
+#endif
+
 /************************************************************************************
  * Name: uart_datasent
  *
@@ -299,6 +394,62 @@ void uart_datareceived(FAR uart_dev_t *dev);
 
 void uart_datasent(FAR uart_dev_t *dev);
 
+/************************************************************************************
+ * Name: uart_xmitchars_dma
+ *
+ * Description:
+ *   Set up to transfer the contents of the xmit buffer using DMA.  This function
+ *   describes the pending TX data in dev->dmatx and calls the lower half dmasend()
+ *   method.  It is normally called by the lower half from its dmatxavail() method
+ *   or from its TX DMA completion logic.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_DMA
+void uart_xmitchars_dma(FAR uart_dev_t *dev);
+#endif
+
+/************************************************************************************
+ * Name: uart_xmitchars_done
+ *
+ * Description:
+ *   Perform xmit-related operations after the completion of a TX DMA transfer.
+ *   The lower half must have set dev->dmatx.nbytes to the number of bytes sent.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_DMA
+void uart_xmitchars_done(FAR uart_dev_t *dev);
+#endif
+
+/************************************************************************************
+ * Name: uart_recvchars_dma
+ *
+ * Description:
+ *   Set up to receive into the free space of the recv buffer using DMA.  This
+ *   function describes the free regions in dev->dmarx and calls the lower half
+ *   dmareceive() method.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_DMA
+void uart_recvchars_dma(FAR uart_dev_t *dev);
+#endif
+
+/************************************************************************************
+ * Name: uart_recvchars_done
+ *
+ * Description:
+ *   Perform recv-related operations after the completion of an RX DMA transfer.
+ *   The lower half must have set dev->dmarx.nbytes to the number of bytes
+ *   received.
+ *
+ ************************************************************************************/
+
+#ifdef CONFIG_SERIAL_DMA
+void uart_recvchars_done(FAR uart_dev_t *dev);
+#endif
+
 /************************************************************************************
  * Name: uart_connected
  *
@@ -58,6 +58,8 @@ struct lib_outstream_s;
 
 typedef int  (*lib_getc_t)(FAR struct lib_instream_s *this);
 typedef void (*lib_putc_t)(FAR struct lib_outstream_s *this, int ch);
+typedef void (*lib_puts_t)(FAR struct lib_outstream_s *this,
+                           FAR const char *buffer, int buflen);
 typedef int  (*lib_flush_t)(FAR struct lib_outstream_s *this);
 
 struct lib_instream_s
@@ -70,6 +72,8 @@ struct lib_instream_s
 struct lib_outstream_s
 {
   lib_putc_t  put;                /* Pointer to function to put one character */
+  lib_puts_t  puts;               /* Pointer to function to put a block of
+                                   * characters (may be NULL) */
 #ifdef CONFIG_STDIO_LINEBUFFER
   lib_flush_t flush;              /* Pointer to function flush buffered characters */
 #endif
@@ -43,6 +43,7 @@
 #include <nuttx/config.h>
 
 #include <sys/types.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <signal.h>
 #include <queue.h>
@@ -67,8 +68,10 @@
  *   in order to build the high priority work queue.
  * CONFIG_SCHED_WORKPRIORITY - The execution priority of the worker
  *   thread.  Default: 192
- * CONFIG_SCHED_WORKPERIOD - How often the worker thread checks for
- *   work in units of microseconds.  Default: 50*1000 (50 MS).
+ * CONFIG_SCHED_WORKPERIOD - The longest time that the worker thread
+ *   sleeps when no work is ready, in units of microseconds.  The worker
+ *   thread is also awakened when new work is queued and when delayed work
+ *   expires.  Default: 50*1000 (50 MS).
  * CONFIG_SCHED_WORKSTACKSIZE - The stack size allocated for the worker
  *   thread.  Default: CONFIG_IDLETHREAD_STACKSIZE.
  * CONFIG_SIG_SIGWORK - The signal number that will be used to wake-up
@@ -81,10 +84,15 @@
  *   (such as file system clean-up operations)
  * CONFIG_SCHED_LPWORKPRIORITY - The execution priority of the lower priority
  *   worker thread.  Default: 50
- * CONFIG_SCHED_LPWORKPERIOD - How often the lower priority worker thread
- *  checks for work in units of microseconds.  Default: 50*1000 (50 MS).
+ * CONFIG_SCHED_LPWORKPERIOD - The longest time that the lower priority
+ *  worker thread sleeps when no work is ready, in units of microseconds.
+ *  Default: 50*1000 (50 MS).
  * CONFIG_SCHED_LPWORKSTACKSIZE - The stack size allocated for the lower
  *   priority worker thread.  Default: CONFIG_IDLETHREAD_STACKSIZE.
+ * CONFIG_SCHED_LPNTHREADS - The number of threads in the pool that serves
+ *   the lower priority work queue.  If CONFIG_PRIORITY_INHERITANCE is also
+ *   defined, then these threads inherit the priority of the tasks that
+ *   queue work for them.  Default: 1
  */
 
 /* Is this a kernel build (CONFIG_NUTTX_KERNEL=y) */
@@ -182,6 +190,14 @@
 #    define CONFIG_SCHED_LPWORKSTACKSIZE CONFIG_IDLETHREAD_STACKSIZE
 #  endif
 
+#  ifndef CONFIG_SCHED_LPNTHREADS
+#    define CONFIG_SCHED_LPNTHREADS 1
+#  endif
+
+#  if CONFIG_SCHED_LPNTHREADS < 1
+#    error "CONFIG_SCHED_LPNTHREADS must be at least one"
+#  endif
+
 /* The high priority worker thread should be higher priority than the low
  * priority worker thread.
  */
@@ -264,6 +280,16 @@
 
 #endif /* CONFIG_NUTTX_KERNEL && !__KERNEL__ */
 
+/* The low priority work queue may be served by a pool of worker threads.
+ * Every other work queue is served by a single thread.
+ */
+
+#ifdef CONFIG_SCHED_LPWORK
+#  define WORK_MAXTHREADS CONFIG_SCHED_LPNTHREADS
+#else
+#  define WORK_MAXTHREADS 1
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -275,10 +301,23 @@
  * accessed by application logic.
  */
 
+/* This structure describes one of the threads that serve a work queue */
+
+struct kworker_s
+{
+  pid_t             pid;     /* The task ID of the worker thread */
+  volatile bool     busy;    /* False: Waiting for work to be queued */
+#if defined(CONFIG_SCHED_LPWORK) && defined(CONFIG_PRIORITY_INHERITANCE)
+  volatile bool     boosted; /* True: Running above its base priority */
+#endif
+};
+
 struct wqueue_s
 {
-  pid_t             pid; /* The task ID of the worker thread */
-  struct dq_queue_s q;   /* The queue of pending work */
+  struct dq_queue_s q;       /* The queue of work with no delay (FIFO) */
+  struct dq_queue_s delayed; /* Delayed work in order of expiration */
+  uint8_t           nthreads; /* Number of threads serving the queue */
+  struct kworker_s  worker[WORK_MAXTHREADS]; /* State of each thread */
 };
 
 /* Defines the work callback */
@@ -455,9 +494,9 @@ int work_cancel(int qid, FAR struct work_s *work);
  * Name: work_signal
  *
  * Description:
- *   Signal the worker thread to process the work queue now.  This function
- *   is used internally by the work logic but could also be used by the
- *   user to force an immediate re-assessment of pending work.
+ *   Signal a waiting worker thread to process the work queue now.  This
+ *   function is used internally by the work logic but could also be used
+ *   by the user to force an immediate re-assessment of pending work.
  *
  * Input parameters:
  *   qid    - The work queue ID
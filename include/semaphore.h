@@ -44,6 +44,7 @@
 
 #include <stdint.h>
 #include <limits.h>
+#include <queue.h>
 
 #ifdef __cplusplus
 #define EXTERN extern "C"
@@ -60,23 +61,31 @@ extern "C" {
  * Public Type Declarations
  ****************************************************************************/
 
-/* This structure contains information about the holder of a semaphore */
+/* This structure contains information about the holder of a semaphore.
+ * Each holder record is linked into the list of holders of the semaphore.
+ * Pre-allocated holder records are also linked into the list of semaphores
+ * held by the holder thread; the holder built into the semaphore is not,
+ * since the semaphore's storage may go away without sem_destroy().
+ */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
 struct tcb_s; /* Forward reference */
+struct sem_s; /* Forward reference */
 struct semholder_s
 {
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  struct semholder_s *flink;     /* Implements singly linked list */
+  struct semholder_s *flink;     /* Next holder of the same semaphore */
 #endif
+  struct semholder_s *tlink;     /* Next pre-allocated holder of the thread */
+  FAR struct sem_s *sem;         /* The semaphore that is held */
   FAR struct tcb_s *htcb;        /* Holder TCB */
   int16_t counts;                /* Number of counts owned by this holder */
 };
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-#  define SEMHOLDER_INITIALIZER {NULL, NULL, 0}
+#  define SEMHOLDER_INITIALIZER {NULL, NULL, NULL, NULL, 0}
 #else
-#  define SEMHOLDER_INITIALIZER {NULL, 0}
+#  define SEMHOLDER_INITIALIZER {NULL, NULL, NULL, 0}
 #endif
 #endif /* CONFIG_PRIORITY_INHERITANCE */
 
@@ -86,6 +95,8 @@ struct sem_s
 {
   int16_t semcount;              /* >0 -> Num counts available */
                                  /* <0 -> Num tasks waiting for semaphore */
+  dq_queue_t waitlist;           /* Prioritized list of waiting tasks */
+
   /* If priority inheritance is enabled, then we have to keep track of which
    * tasks hold references to the semaphore.
    */
@@ -93,9 +104,9 @@ struct sem_s
 #ifdef CONFIG_PRIORITY_INHERITANCE
 # if CONFIG_SEM_PREALLOCHOLDERS > 0
   FAR struct semholder_s *hhead; /* List of holders of semaphore counts */
-# else
-  struct semholder_s holder;     /* Single holder */
 # endif
+  struct semholder_s holder;     /* Built-in holder.  Used first; it is the
+                                  * only holder needed by a mutex */
 #endif
 };
 
@@ -105,12 +116,12 @@ typedef struct sem_s sem_t;
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
 # if CONFIG_SEM_PREALLOCHOLDERS > 0
-#  define SEM_INITIALIZER(c) {(c), NULL}  /* semcount, hhead */
+#  define SEM_INITIALIZER(c) {(c), {NULL, NULL}, NULL, SEMHOLDER_INITIALIZER} /* semcount, waitlist, hhead, holder */
 # else
-#  define SEM_INITIALIZER(c) {(c), SEMHOLDER_INITIALIZER} /* semcount, holder */
+#  define SEM_INITIALIZER(c) {(c), {NULL, NULL}, SEMHOLDER_INITIALIZER} /* semcount, waitlist, holder */
 # endif
 #else
-#  define SEM_INITIALIZER(c) {(c)} /* semcount */
+#  define SEM_INITIALIZER(c) {(c), {NULL, NULL}} /* semcount, waitlist */
 #endif
 
 /****************************************************************************
@@ -42,6 +42,20 @@
 
 #include <sys/types.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The offset in bytes of a member from the beginning of its structure */
+
+#ifndef offsetof
+#  ifdef __GNUC__
+#    define offsetof(type, member) __builtin_offsetof(type, member)
+#  else
+#    define offsetof(type, member) ((size_t)&(((type *)0)->member))
+#  endif
+#endif
+
 /****************************************************************************
  * Type Definitions
  ****************************************************************************/
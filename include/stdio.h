@@ -60,6 +60,12 @@
 
 #define EOF        (-1)
 
+/* Buffering modes for setvbuf() */
+
+#define _IOFBF     0  /* Fully buffered */
+#define _IOLBF     1  /* Line buffered */
+#define _IONBF     2  /* Unbuffered */
+
 /* The first three _iob entries are reserved for standard I/O */
 
 #define stdin  (&sched_getstreams()->sl_streams[0])
@@ -123,6 +129,7 @@ int    fseek(FAR FILE *stream, long int offset, int whence);
 int    fsetpos(FAR FILE *stream, FAR fpos_t *pos);
 long   ftell(FAR FILE *stream);
 size_t fwrite(FAR const void *ptr, size_t size, size_t n_items, FAR FILE *stream);
+int    setvbuf(FAR FILE *stream, FAR char *buffer, int mode, size_t size);
 FAR char *gets(FAR char *s);
 int    ungetc(int c, FAR FILE *stream);
 
@@ -0,0 +1,196 @@
+/****************************************************************************
+ * include/sys/epoll.h
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_SYS_EPOLL_H
+#define __INCLUDE_SYS_EPOLL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <poll.h>
+
+#if defined(CONFIG_FS_EPOLL) && !defined(CONFIG_DISABLE_POLL)
+
+/****************************************************************************
+ * Pre-Processor Definitions
+ ****************************************************************************/
+
+/* epoll_ctl() operations */
+
+#define EPOLL_CTL_ADD  1  /* Add a descriptor to the interest set */
+#define EPOLL_CTL_DEL  2  /* Remove a descriptor from the interest set */
+#define EPOLL_CTL_MOD  3  /* Change the events of a descriptor in the set */
+
+/* Event definitions.  The low order bits are the same as the poll() event
+ * bits.  The high order bits are epoll() options.
+ */
+
+#define EPOLLIN        POLLIN
+#define EPOLLPRI       POLLPRI
+#define EPOLLOUT       POLLOUT
+#define EPOLLERR       POLLERR
+#define EPOLLHUP       POLLHUP
+
+#define EPOLLONESHOT   (0x40)  /* Disarm the descriptor after one event */
+#define EPOLLET        (0x80)  /* Edge triggered (not re-armed on report) */
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+/* User data associated with a descriptor in the interest set and returned
+ * with its events by epoll_wait().
+ */
+
+typedef union epoll_data
+{
+  FAR void *ptr;
+  int       fd;
+  uint32_t  u32;
+} epoll_data_t;
+
+struct epoll_event
+{
+  uint32_t     events;   /* Requested events (in) / ready events (out) */
+  epoll_data_t data;     /* User data */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C" {
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: epoll_create
+ *
+ * Description:
+ *   Create a persistent interest set that can hold up to 'size'
+ *   descriptors.  Descriptors added with epoll_ctl() are registered with
+ *   their drivers once and remain registered until they are removed; they
+ *   are not set up and torn down on each call to epoll_wait().
+ *
+ *   NOTE: The returned value is an epoll handle, not a file descriptor.  It
+ *   must be released with epoll_close(), not close().
+ *
+ * Returned Value:
+ *   A non-negative epoll handle on success; -1 on failure with errno set:
+ *
+ *   EINVAL - 'size' is not positive
+ *   EMFILE - All CONFIG_FS_EPOLL_NINSTANCES handles are in use
+ *   ENOMEM - Insufficient memory to allocate the interest set
+ *
+ ****************************************************************************/
+
+EXTERN int epoll_create(int size);
+
+/****************************************************************************
+ * Name: epoll_close
+ *
+ * Description:
+ *   Unregister all descriptors in the interest set and release the epoll
+ *   handle.
+ *
+ ****************************************************************************/
+
+EXTERN void epoll_close(int epfd);
+
+/****************************************************************************
+ * Name: epoll_ctl
+ *
+ * Description:
+ *   Add (EPOLL_CTL_ADD), modify (EPOLL_CTL_MOD), or remove (EPOLL_CTL_DEL)
+ *   the descriptor 'fd' in the interest set 'epfd'.
+ *
+ * Returned Value:
+ *   Zero on success; -1 on failure with errno set:
+ *
+ *   EBADF  - 'epfd' is not a valid epoll handle or 'fd' is not valid
+ *   EEXIST - EPOLL_CTL_ADD and 'fd' is already in the set
+ *   ENOENT - EPOLL_CTL_MOD or EPOLL_CTL_DEL and 'fd' is not in the set
+ *   ENOSPC - EPOLL_CTL_ADD and the set is full
+ *   EINVAL - 'op' is not valid
+ *   Or any error reported by the driver's poll method
+ *
+ ****************************************************************************/
+
+EXTERN int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev);
+
+/****************************************************************************
+ * Name: epoll_wait
+ *
+ * Description:
+ *   Wait up to 'timeout' milliseconds for events on the interest set
+ *   'epfd' and return at most 'maxevents' ready descriptors in 'evs'.  A
+ *   negative 'timeout' waits forever; a zero 'timeout' does not wait.
+ *
+ *   By default, events are level-triggered:  Each descriptor that is
+ *   reported is re-armed so that it will be reported again if it is still
+ *   ready.  If EPOLLET was specified, the descriptor is reported only when
+ *   its driver posts a new event.  If EPOLLONESHOT was specified, the
+ *   descriptor is disarmed after it is reported until re-enabled with
+ *   EPOLL_CTL_MOD.
+ *
+ * Returned Value:
+ *   The number of ready descriptors returned in 'evs', zero on a timeout,
+ *   or -1 on failure with errno set:
+ *
+ *   EBADF  - 'epfd' is not a valid epoll handle
+ *   EINVAL - 'maxevents' is not positive
+ *   EINTR  - A signal was received before any event
+ *   ENOMEM - No watchdog timer was available for a finite 'timeout'
+ *
+ ****************************************************************************/
+
+EXTERN int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents,
+                      int timeout);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_FS_EPOLL && !CONFIG_DISABLE_POLL */
+#endif /* __INCLUDE_SYS_EPOLL_H */
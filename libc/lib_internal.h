@@ -44,6 +44,7 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <limits.h>
 #include <semaphore.h>
@@ -96,6 +97,20 @@
 
 #define LIB_BUFLEN_UNKNOWN INT_MAX
 
+/* Word-at-a-time support for the speed-optimized versions of memcpy(),
+ * memmove(), memcmp(), strlen() and strcmp().  LIB_HASZERO() is non-zero
+ * if any byte of the 32-bit word w is zero.
+ */
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+#  define LIB_WORDSIZE    4
+#  define LIB_WORDMASK    (LIB_WORDSIZE - 1)
+#  define LIB_ALIGNED(p)  (((uintptr_t)(p) & LIB_WORDMASK) == 0)
+#  define LIB_COALIGNED(p1,p2) \
+     ((((uintptr_t)(p1) ^ (uintptr_t)(p2)) & LIB_WORDMASK) == 0)
+#  define LIB_HASZERO(w)  (((w) - 0x01010101) & ~(w) & 0x80808080)
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -136,6 +151,11 @@ void  stream_semgive(FAR struct streamlist *list);
 int lib_noflush(FAR struct lib_outstream_s *this);
 #endif
 
+/* Defined in lib_libstreamputs.c */
+
+void lib_streamputs(FAR struct lib_outstream_s *this,
+                    FAR const char *buffer, int buflen);
+
 /* Defined in lib_libsprintf.c */
 
 int lib_sprintf(FAR struct lib_outstream_s *obj,
@@ -209,6 +229,13 @@ double lib_expi(size_t n);
 float lib_sqrtapprox(float x);
 #endif
 
+/* Defined in work_signal.c */
+
+#ifdef CONFIG_SCHED_WORKQUEUE
+struct wqueue_s;
+int work_wakeup(FAR struct wqueue_s *wqueue);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
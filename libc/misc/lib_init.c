@@ -140,9 +140,10 @@ void lib_releaselist(FAR struct streamlist *list)
 
       (void)sem_destroy(&list->sl_streams[i].fs_sem);
 
-      /* Release the IO buffer */
+      /* Release the IO buffer (unless it was provided by the user) */
 
-      if (list->sl_streams[i].fs_bufstart)
+      if (list->sl_streams[i].fs_bufstart &&
+          (list->sl_streams[i].fs_flags & __FS_FLAG_UBF) == 0)
         {
           sched_ufree(list->sl_streams[i].fs_bufstart);
         }
@@ -0,0 +1,374 @@
+/****************************************************************************
+ * libc/misc/lib_ringbuf.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+#include <arch/irq.h>
+#include <nuttx/ringbuf.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The producer must finish writing the data before it publishes the new
+ * head index and the consumer must not read the data before it has read
+ * the head index (and vice versa for the tail index and the free space).
+ * NuttX runs on a single CPU, so it is sufficient to keep the compiler
+ * from moving buffer accesses across the accesses to the indices.
+ */
+
+#ifdef __GNUC__
+#  define ringbuf_barrier() __asm__ __volatile__ ("" : : : "memory")
+#else
+#  define ringbuf_barrier()
+#endif
+
+/* Convert an index (0..2*rb_size-1) into an offset into rb_buffer */
+
+#define ringbuf_offset(rb,ndx) \
+  ((ndx) >= (rb)->rb_size ? (ndx) - (rb)->rb_size : (ndx))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ringbuf_advance
+ *
+ * Description:
+ *   Advance an index by 'n' bytes (n <= rb_size), wrapping at 2*rb_size.
+ *
+ ****************************************************************************/
+
+static inline size_t ringbuf_advance(FAR const struct ringbuf_s *rb,
+                                     size_t ndx, size_t n)
+{
+  ndx += n;
+  if (ndx >= 2 * rb->rb_size)
+    {
+      ndx -= 2 * rb->rb_size;
+    }
+
+  return ndx;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ringbuf_init
+ *
+ * Description:
+ *   Initialize an empty ring buffer that uses the caller-provided storage.
+ *
+ ****************************************************************************/
+
+void ringbuf_init(FAR struct ringbuf_s *rb, FAR void *buffer, size_t size)
+{
+  rb->rb_buffer = (FAR uint8_t *)buffer;
+  rb->rb_size   = size;
+  rb->rb_head   = 0;
+  rb->rb_tail   = 0;
+}
+
+/****************************************************************************
+ * Name: ringbuf_used
+ *
+ * Description:
+ *   Return the number of bytes of data in the ring buffer.
+ *
+ ****************************************************************************/
+
+size_t ringbuf_used(FAR const struct ringbuf_s *rb)
+{
+  size_t head = rb->rb_head;
+  size_t tail = rb->rb_tail;
+
+  return head >= tail ? head - tail : head + 2 * rb->rb_size - tail;
+}
+
+/****************************************************************************
+ * Name: ringbuf_put
+ *
+ * Description:
+ *   Producer side:  Copy as much of 'data' into the ring buffer as will
+ *   fit.
+ *
+ ****************************************************************************/
+
+size_t ringbuf_put(FAR struct ringbuf_s *rb, FAR const void *data,
+                   size_t len)
+{
+  FAR const uint8_t *src = (FAR const uint8_t *)data;
+  size_t head = rb->rb_head;
+  size_t space;
+  size_t offset;
+  size_t chunk;
+
+  space = rb->rb_size - ringbuf_used(rb);
+  ringbuf_barrier();
+
+  if (len > space)
+    {
+      len = space;
+    }
+
+  if (len > 0)
+    {
+      /* Copy up to the end of the buffer, then the rest at the beginning */
+
+      offset = ringbuf_offset(rb, head);
+      chunk  = rb->rb_size - offset;
+      if (chunk > len)
+        {
+          chunk = len;
+        }
+
+      memcpy(&rb->rb_buffer[offset], src, chunk);
+      if (chunk < len)
+        {
+          memcpy(rb->rb_buffer, &src[chunk], len - chunk);
+        }
+
+      /* Then publish all of the new data at once */
+
+      ringbuf_barrier();
+      rb->rb_head = ringbuf_advance(rb, head, len);
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: ringbuf_mput
+ *
+ * Description:
+ *   Same as ringbuf_put() but may be called by several producers at the
+ *   same time.
+ *
+ ****************************************************************************/
+
+size_t ringbuf_mput(FAR struct ringbuf_s *rb, FAR const void *data,
+                    size_t len)
+{
+  irqstate_t flags;
+
+  flags = irqsave();
+  len = ringbuf_put(rb, data, len);
+  irqrestore(flags);
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: ringbuf_get
+ *
+ * Description:
+ *   Consumer side:  Copy up to 'len' bytes from the ring buffer into
+ *   'data'.
+ *
+ ****************************************************************************/
+
+size_t ringbuf_get(FAR struct ringbuf_s *rb, FAR void *data, size_t len)
+{
+  FAR uint8_t *dest = (FAR uint8_t *)data;
+  size_t tail = rb->rb_tail;
+  size_t used;
+  size_t offset;
+  size_t chunk;
+
+  used = ringbuf_used(rb);
+  ringbuf_barrier();
+
+  if (len > used)
+    {
+      len = used;
+    }
+
+  if (len > 0)
+    {
+      /* Copy up to the end of the buffer, then the rest at the beginning */
+
+      offset = ringbuf_offset(rb, tail);
+      chunk  = rb->rb_size - offset;
+      if (chunk > len)
+        {
+          chunk = len;
+        }
+
+      memcpy(dest, &rb->rb_buffer[offset], chunk);
+      if (chunk < len)
+        {
+          memcpy(&dest[chunk], rb->rb_buffer, len - chunk);
+        }
+
+      /* Then release all of the space at once */
+
+      ringbuf_barrier();
+      rb->rb_tail = ringbuf_advance(rb, tail, len);
+    }
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: ringbuf_putc
+ *
+ * Description:
+ *   Add one byte to the ring buffer.
+ *
+ ****************************************************************************/
+
+bool ringbuf_putc(FAR struct ringbuf_s *rb, uint8_t ch)
+{
+  size_t head = rb->rb_head;
+
+  if (ringbuf_used(rb) >= rb->rb_size)
+    {
+      return false;
+    }
+
+  ringbuf_barrier();
+  rb->rb_buffer[ringbuf_offset(rb, head)] = ch;
+  ringbuf_barrier();
+  rb->rb_head = ringbuf_advance(rb, head, 1);
+  return true;
+}
+
+/****************************************************************************
+ * Name: ringbuf_getc
+ *
+ * Description:
+ *   Remove one byte from the ring buffer.
+ *
+ ****************************************************************************/
+
+int ringbuf_getc(FAR struct ringbuf_s *rb)
+{
+  size_t tail = rb->rb_tail;
+  int ch;
+
+  if (rb->rb_head == tail)
+    {
+      return EOF;
+    }
+
+  ringbuf_barrier();
+  ch = rb->rb_buffer[ringbuf_offset(rb, tail)];
+  ringbuf_barrier();
+  rb->rb_tail = ringbuf_advance(rb, tail, 1);
+  return ch;
+}
+
+/****************************************************************************
+ * Name: ringbuf_wrspan
+ *
+ * Description:
+ *   Return the location and size of the contiguous free space that
+ *   follows the data in the ring buffer.
+ *
+ ****************************************************************************/
+
+size_t ringbuf_wrspan(FAR struct ringbuf_s *rb, FAR uint8_t **ptr)
+{
+  size_t offset = ringbuf_offset(rb, rb->rb_head);
+  size_t space  = rb->rb_size - ringbuf_used(rb);
+  size_t chunk  = rb->rb_size - offset;
+
+  ringbuf_barrier();
+  *ptr = &rb->rb_buffer[offset];
+  return chunk < space ? chunk : space;
+}
+
+/****************************************************************************
+ * Name: ringbuf_wrcommit
+ *
+ * Description:
+ *   Publish 'len' bytes written at the location returned by
+ *   ringbuf_wrspan().
+ *
+ ****************************************************************************/
+
+void ringbuf_wrcommit(FAR struct ringbuf_s *rb, size_t len)
+{
+  ringbuf_barrier();
+  rb->rb_head = ringbuf_advance(rb, rb->rb_head, len);
+}
+
+/****************************************************************************
+ * Name: ringbuf_rdspan
+ *
+ * Description:
+ *   Return the location and size of the contiguous data at the head of the
+ *   ring buffer.
+ *
+ ****************************************************************************/
+
+size_t ringbuf_rdspan(FAR struct ringbuf_s *rb, FAR uint8_t **ptr)
+{
+  size_t offset = ringbuf_offset(rb, rb->rb_tail);
+  size_t used   = ringbuf_used(rb);
+  size_t chunk  = rb->rb_size - offset;
+
+  ringbuf_barrier();
+  *ptr = &rb->rb_buffer[offset];
+  return chunk < used ? chunk : used;
+}
+
+/****************************************************************************
+ * Name: ringbuf_rdcommit
+ *
+ * Description:
+ *   Release 'len' bytes at the location returned by ringbuf_rdspan() to the
+ *   producer.
+ *
+ ****************************************************************************/
+
+void ringbuf_rdcommit(FAR struct ringbuf_s *rb, size_t len)
+{
+  ringbuf_barrier();
+  rb->rb_tail = ringbuf_advance(rb, rb->rb_tail, len);
+}
@@ -0,0 +1,125 @@
+/****************************************************************************
+ * libc/misc/lib_ringbufnotify.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <semaphore.h>
+#include <poll.h>
+#include <debug.h>
+
+#include <nuttx/ringbuf.h>
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ringbuf_notify
+ *
+ * Description:
+ *   Wake up every thread that is waiting on 'sem'.
+ *
+ ****************************************************************************/
+
+void ringbuf_notify(FAR sem_t *sem)
+{
+  int sval;
+
+  while (sem_getvalue(sem, &sval) == 0 && sval < 0)
+    {
+      sem_post(sem);
+    }
+}
+
+/****************************************************************************
+ * Name: ringbuf_pollevents
+ *
+ * Description:
+ *   Return the poll events that the state of the ring buffer satisfies.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_DISABLE_POLL
+pollevent_t ringbuf_pollevents(FAR const struct ringbuf_s *rb)
+{
+  size_t used = ringbuf_used(rb);
+  pollevent_t eventset = 0;
+
+  if (used > 0)
+    {
+      eventset |= POLLIN;
+    }
+
+  if (used < rb->rb_size)
+    {
+      eventset |= POLLOUT;
+    }
+
+  return eventset;
+}
+
+/****************************************************************************
+ * Name: ringbuf_pollnotify
+ *
+ * Description:
+ *   Report the events in 'eventset' to the threads waiting in poll().
+ *
+ ****************************************************************************/
+
+void ringbuf_pollnotify(FAR struct pollfd **fds, int nfds,
+                        pollevent_t eventset)
+{
+  FAR struct pollfd *fd;
+  int i;
+
+  for (i = 0; i < nfds; i++)
+    {
+      fd = fds[i];
+      if (fd)
+        {
+          fd->revents |= (fd->events & eventset);
+          if (fd->revents != 0)
+            {
+              fvdbg("Report events: %02x\n", fd->revents);
+              sem_post(fd->sem);
+            }
+        }
+    }
+}
+#endif /* CONFIG_DISABLE_POLL */
@@ -45,6 +45,8 @@
 #include <unistd.h>
 #include <errno.h>
 
+#include <nuttx/fs/fs.h>
+
 #include "lib_internal.h"
 
 #if CONFIG_NSOCKET_DESCRIPTORS > 0 || CONFIG_NFILE_DESCRIPTORS > 0
@@ -70,7 +72,7 @@
  ************************************************************************/
 
 /************************************************************************
- * Name: sendfile
+ * Name: sendfile (or lib_sendfile)
  *
  * Description:
  *   sendfile() copies data between one file descriptor and another.
@@ -111,9 +113,18 @@
  *   EINVAL - Bad input parameters.
  *   ENOMEM - Could not allocated an I/O buffer
  *
+ *   If CONFIG_NET_SENDFILE is selected, then sendfile() is provided by
+ *   the OS (see fs/fs_sendfile.c) and this function is renamed to
+ *   lib_sendfile().  The OS sendfile() falls back to lib_sendfile() for
+ *   any transfer that it cannot perform within the network layer.
+ *
  ************************************************************************/
 
+#ifdef CONFIG_NET_SENDFILE
+ssize_t lib_sendfile(int outfd, int infd, off_t *offset, size_t count)
+#else
 ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
+#endif
 {
   FAR uint8_t *iobuffer;
   FAR uint8_t *wrbuffer;
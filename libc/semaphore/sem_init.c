@@ -105,15 +105,18 @@ int sem_init(FAR sem_t *sem, int pshared, unsigned int value)
 
       sem->semcount      = (int16_t)value;
 
+      /* Initialize the list of tasks waiting for the semaphore */
+
+      dq_init(&sem->waitlist);
+
       /* Initialize to support priority inheritance */
 
 #ifdef CONFIG_PRIORITY_INHERITANCE
 #  if CONFIG_SEM_PREALLOCHOLDERS > 0
       sem->hhead         = NULL;
-#  else
+#  endif
       sem->holder.htcb   = NULL;
       sem->holder.counts = 0;
-#  endif
 #endif
       return OK;
     }
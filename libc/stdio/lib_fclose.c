@@ -112,9 +112,9 @@ int fclose(FAR FILE *stream)
 
       sem_destroy(&stream->fs_sem);
 
-      /* Release the buffer */
+      /* Release the buffer (unless it was provided by the user) */
 
-      if (stream->fs_bufstart)
+      if (stream->fs_bufstart && (stream->fs_flags & __FS_FLAG_UBF) == 0)
         {
           lib_free(stream->fs_bufstart);
         }
@@ -130,6 +130,12 @@ int fseek(FAR FILE *stream, long int offset, int whence)
   stream->fs_nungotten = 0;
 #endif
 
+  /* The access is no longer sequential.  Restart the read-ahead window. */
+
+#ifdef CONFIG_STDIO_READAHEAD
+  stream->fs_rasize = 0;
+#endif
+
   /* Perform the fseek on the underlying file descriptor */
 
   return lseek(stream->fs_filedes, offset, whence) == (off_t)-1 ? ERROR : OK;
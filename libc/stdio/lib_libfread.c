@@ -127,129 +127,158 @@ ssize_t lib_fread(FAR void *ptr, size_t count, FAR FILE *stream)
 #if CONFIG_STDIO_BUFFER_SIZE > 0
       /* If the buffer is currently being used for write access, then
        * flush all of the buffered write data.  We do not support concurrent
-       * buffered read/write access.
+       * buffered read/write access.  There is nothing to flush if the
+       * buffer is empty or holds read-ahead data.
        */
 
-      ret = lib_wrflush(stream);
-      if (ret < 0)
+      if (stream->fs_bufread == stream->fs_bufstart &&
+          stream->fs_bufpos  != stream->fs_bufstart)
         {
-          lib_give_semaphore(stream);
-          return ret;
+          ret = lib_wrflush(stream);
+          if (ret < 0)
+            {
+              lib_give_semaphore(stream);
+              return ret;
+            }
         }
 
       /* Now get any other needed chars from the buffer or the file. */
 
       while (count > 0)
         {
+          size_t buffer_size;
+          size_t gulp_size;
+
           /* Is there readable data in the buffer? */
 
-          while ((count > 0) && (stream->fs_bufpos < stream->fs_bufread))
+          gulp_size = stream->fs_bufread - stream->fs_bufpos;
+          if (gulp_size > 0)
             {
-              /* Yes, copy a byte into the user buffer */
+              /* Yes, copy as much as is needed into the user buffer */
+
+              if (gulp_size > count)
+                {
+                  gulp_size = count;
+                }
 
-              *dest++ = *stream->fs_bufpos++;
-              count--;
+              memcpy(dest, stream->fs_bufpos, gulp_size);
+              stream->fs_bufpos += gulp_size;
+              dest              += gulp_size;
+              count             -= gulp_size;
+              continue;
             }
 
-          /* The buffer is empty OR we have already supplied the number of
-           * bytes requested in the read.  Check if we need to read
-           * more from the file.
+          /* The buffer is empty.  We need to read more data from the file.
+           * Mark the buffer empty.
            */
 
-          if (count > 0)
+          stream->fs_bufpos = stream->fs_bufread = stream->fs_bufstart;
+          buffer_size = stream->fs_bufend - stream->fs_bufstart;
+
+          /* If at least a buffer-full of data is still needed, then read
+           * the largest multiple of the buffer size directly into the user's
+           * buffer.  Only the remainder (if any) will pass through the
+           * buffer.  If the stream is unbuffered, then everything is read
+           * directly.
+           */
+
+          if (count >= buffer_size)
             {
-              size_t buffer_available;
+              gulp_size = count;
+              if (buffer_size > 0)
+                {
+                  gulp_size -= count % buffer_size;
+                }
 
-              /* We need to read more data into the buffer from the file */
+              bytes_read = read(stream->fs_filedes, dest, gulp_size);
+              if (bytes_read < 0)
+                {
+                  /* An error occurred on the read.  The error code is
+                   * in the 'errno' variable.
+                   */
 
-              /* Mark the buffer empty */
+                  goto errout_with_errno;
+                }
+              else if (bytes_read == 0)
+                {
+                  /* We are at the end of the file.  But we may already
+                   * have buffered data.  In that case, we will report
+                   * the EOF indication later.
+                   */
 
-              stream->fs_bufpos = stream->fs_bufread = stream->fs_bufstart;
+                  goto shortread;
+                }
 
-              /* How much space is available in the buffer? */
+              /* Some bytes were read. Adjust the dest pointer */
 
-              buffer_available = stream->fs_bufend - stream->fs_bufread;
+              dest  += bytes_read;
+              count -= bytes_read;
+
+              /* Were all of the requested bytes read? */
+
+              if ((size_t)bytes_read < gulp_size)
+                {
+                  /* No.  We must be at the end of file (or this is a
+                   * device that returns what is available).
+                   */
 
-              /* Will the number of bytes that we need to read fit into
-               * the buffer space that is available? If the read size is
-               * larger than the buffer, then read some of the data
-               * directly into the user's buffer.
+                  goto shortread;
+                }
+            }
+          else
+            {
+              /* The number of bytes required to satisfy the read is less
+               * than the size of the buffer.  Read ahead into the buffer.
+               */
+
+#ifdef CONFIG_STDIO_READAHEAD
+              /* Read only what is needed plus the current read-ahead
+               * window.  The window starts at zero when the stream is
+               * opened or repositioned and doubles each time that a
+               * sequential reader empties the buffer.
                */
 
-              if (count > buffer_available)
+              gulp_size = count + stream->fs_rasize;
+              if (gulp_size > buffer_size)
                 {
-                  bytes_read = read(stream->fs_filedes, dest, count);
-                  if (bytes_read < 0)
-                    {
-                      /* An error occurred on the read.  The error code is
-                       * in the 'errno' variable.
-                       */
-
-                      goto errout_with_errno;
-                    }
-                  else if (bytes_read == 0)
-                    {
-                      /* We are at the end of the file.  But we may already
-                       * have buffered data.  In that case, we will report
-                       * the EOF indication later.
-                       */
-
-                      goto shortread;
-                    }
-                  else
-                    {
-                      /* Some bytes were read. Adjust the dest pointer */
-
-                      dest  += bytes_read;
-
-                      /* Were all of the requested bytes read? */
-
-                      if (bytes_read < count)
-                        {
-                          /* No.  We must be at the end of file. */
-
-                          goto shortread;
-                        }
-                      else
-                        {
-                          /* Yes.  We are done. */
-
-                          count = 0;
-                        }
-                    }
+                  gulp_size = buffer_size;
                 }
-              else
+
+              if (stream->fs_rasize < buffer_size)
+                {
+                  stream->fs_rasize = stream->fs_rasize > 0 ?
+                                      2 * stream->fs_rasize : count;
+                }
+#else
+              /* Read as much as we can into the buffer */
+
+              gulp_size = buffer_size;
+#endif
+
+              bytes_read = read(stream->fs_filedes, stream->fs_bufread,
+                                gulp_size);
+              if (bytes_read < 0)
                 {
-                  /* The number of bytes required to satisfy the read
-                   * is less than or equal to the size of the buffer
-                   * space that we have left. Read as much as we can
-                   * into the buffer.
+                  /* An error occurred on the read.  The error code is
+                   * in the 'errno' variable.
                    */
 
-                  bytes_read = read(stream->fs_filedes, stream->fs_bufread, buffer_available);
-                  if (bytes_read < 0)
-                    {
-                      /* An error occurred on the read.  The error code is
-                       * in the 'errno' variable.
-                       */
-
-                      goto errout_with_errno;
-                    }
-                  else if (bytes_read == 0)
-                    {
-                      /* We are at the end of the file.  But we may already
-                       * have buffered data.  In that case, we will report
-                       * the EOF indication later.
-                       */
-
-                      goto shortread;
-                    }
-                  else
-                    {
-                      /* Some bytes were read */
-
-                      stream->fs_bufread += bytes_read;
-                    }
+                  goto errout_with_errno;
+                }
+              else if (bytes_read == 0)
+                {
+                  /* We are at the end of the file.  But we may already
+                   * have buffered data.  In that case, we will report
+                   * the EOF indication later.
+                   */
+
+                  goto shortread;
+                }
+              else
+                {
+                  /* Some bytes were read */
+
+                  stream->fs_bufread += bytes_read;
                 }
             }
         }
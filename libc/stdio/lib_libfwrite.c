@@ -42,6 +42,7 @@
 #include <sys/types.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
@@ -114,13 +115,48 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
       goto errout_with_semaphore;
     }
 
-  /* Loop until all of the bytes have been buffered */
+  /* Loop until all of the bytes have been buffered or written */
 
   while (count > 0)
     {
+      size_t buffer_size = stream->fs_bufend - stream->fs_bufstart;
+      size_t gulp_size;
+
+      /* If the buffer is empty and at least a buffer-full of data remains,
+       * then there is nothing to be gained by copying the data through the
+       * buffer.  Write the largest multiple of the buffer size directly
+       * from the user's buffer and only buffer the remainder.  If the
+       * stream is unbuffered, then everything is written directly.
+       */
+
+      if (stream->fs_bufpos == stream->fs_bufstart && count >= buffer_size)
+        {
+          ssize_t nwritten;
+
+          gulp_size = count;
+          if (buffer_size > 0)
+            {
+              gulp_size -= count % buffer_size;
+            }
+
+          nwritten = write(stream->fs_filedes, src, gulp_size);
+          if (nwritten <= 0)
+            {
+              goto errout_with_semaphore;
+            }
+
+          /* The write may have been partial.  Anything left over will be
+           * handled on the next pass.
+           */
+
+          src   += nwritten;
+          count -= nwritten;
+          continue;
+        }
+
       /* Determine the number of bytes left in the buffer */
 
-      size_t gulp_size = stream->fs_bufend - stream->fs_bufpos;
+      gulp_size = stream->fs_bufend - stream->fs_bufpos;
 
       /* Will the user data fit into the amount of buffer space
        * that we have left?
@@ -141,10 +177,10 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
 
       /* Transfer the data into the buffer */
 
-      for (dest = stream->fs_bufpos; gulp_size > 0; gulp_size--)
-        {
-          *dest++ = *src++;
-        }
+      dest = stream->fs_bufpos;
+      memcpy(dest, src, gulp_size);
+      src  += gulp_size;
+      dest += gulp_size;
       stream->fs_bufpos = dest;
 
       /* Is the buffer full? */
@@ -161,6 +197,19 @@ ssize_t lib_fwrite(FAR const void *ptr, size_t count, FAR FILE *stream)
         }
     }
 
+  /* If the stream is line buffered, then flush the buffer if a newline
+   * was written.
+   */
+
+  if ((stream->fs_flags & __FS_FLAG_LBF) != 0 &&
+      memchr(start, '\n', src - start) != NULL)
+    {
+      if (lib_fflush(stream, true) < 0)
+        {
+          goto errout_with_semaphore;
+        }
+    }
+
   /* Return the number of bytes written */
 
   ret = src - start;
@@ -0,0 +1,90 @@
+/****************************************************************************
+ * libc/stdio/lib_libstreamputs.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <assert.h>
+
+#include "lib_internal.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: lib_streamputs
+ *
+ * Description:
+ *  Write a block of characters to an output stream.  The stream's block
+ *  put method is used if it provides one; otherwise the characters are
+ *  passed one at a time to the stream's put method.
+ *
+ * Input parameters:
+ *   this   - The output stream
+ *   buffer - The characters to be written
+ *   buflen - The number of characters in buffer
+ *
+ * Returned Value:
+ *   None.  As with the put method, the number of characters actually
+ *   accepted by the stream is reflected in this->nput.
+ *
+ ****************************************************************************/
+
+void lib_streamputs(FAR struct lib_outstream_s *this,
+                    FAR const char *buffer, int buflen)
+{
+  DEBUGASSERT(this && buffer);
+
+  if (buflen <= 0)
+    {
+      return;
+    }
+
+  if (this->puts)
+    {
+      this->puts(this, buffer, buflen);
+    }
+  else
+    {
+      for (; buflen > 0; buflen--)
+        {
+          this->put(this, *buffer++);
+        }
+    }
+}
@@ -61,6 +61,18 @@
 #  define CONFIG_LIBC_FIXEDPRECISION 3
 #endif
 
+/* Integer conversions are formatted into a local buffer so that they can be
+ * measured and then written to the output stream as a single block.  The
+ * worst case is a binary conversion of the widest integer type plus a sign
+ * or "0x" prefix.
+ */
+
+#ifdef CONFIG_HAVE_LONG_LONG
+#  define NUMBUF_SIZE (8 * sizeof(unsigned long long) + 4)
+#else
+#  define NUMBUF_SIZE (8 * sizeof(unsigned long) + 4)
+#endif
+
 #define FLAG_SHOWPLUS            0x01
 #define FLAG_ALTFORM             0x02
 #define FLAG_HASDOT              0x04
@@ -162,7 +174,6 @@ static void utoascii(FAR struct lib_outstream_s *obj, uint8_t fmt,
 
 #ifndef CONFIG_NOPRINTF_FIELDWIDTH
 static void fixup(uint8_t fmt, FAR uint8_t *flags, int *n);
-static int  getusize(uint8_t fmt, uint8_t flags, unsigned int lln);
 #endif
 
 /* Unsigned long int to ASCII conversion */
@@ -176,7 +187,6 @@ static void lutoascii(FAR struct lib_outstream_s *obj, uint8_t fmt,
                       uint8_t flags, unsigned long ln);
 #ifndef CONFIG_NOPRINTF_FIELDWIDTH
 static void lfixup(uint8_t fmt, FAR uint8_t *flags, long *ln);
-static int  getlusize(uint8_t fmt, FAR uint8_t flags, unsigned long ln);
 #endif
 #endif
 
@@ -191,7 +201,6 @@ static void llutoascii(FAR struct lib_outstream_s *obj, uint8_t fmt,
                        uint8_t flags, unsigned long long lln);
 #ifndef CONFIG_NOPRINTF_FIELDWIDTH
 static void llfixup(uint8_t fmt, FAR uint8_t *flags, FAR long long *lln);
-static int  getllusize(uint8_t fmt, FAR uint8_t flags, FAR unsigned long long lln);
 #endif
 #endif
 
@@ -526,19 +535,6 @@ static void fixup(uint8_t fmt, FAR uint8_t *flags, FAR int *n)
     }
 }
 
-/****************************************************************************
- * Name: getusize
- ****************************************************************************/
-
-static int getusize(uint8_t fmt, uint8_t flags, unsigned int n)
-{
-  struct lib_outstream_s nulloutstream;
-  lib_nulloutstream(&nulloutstream);
-
-  utoascii(&nulloutstream, fmt, flags, n);
-  return nulloutstream.nput;
-}
-
 /****************************************************************************
  * Name: getdblsize
  ****************************************************************************/
@@ -789,19 +785,6 @@ static void lfixup(uint8_t fmt, FAR uint8_t *flags, FAR long *ln)
     }
 }
 
-/****************************************************************************
- * Name: getlusize
- ****************************************************************************/
-
-static int getlusize(uint8_t fmt, uint8_t flags, unsigned long ln)
-{
-  struct lib_outstream_s nulloutstream;
-  lib_nulloutstream(&nulloutstream);
-
-  lutoascii(&nulloutstream, fmt, flags, ln);
-  return nulloutstream.nput;
-}
-
 #endif /* CONFIG_NOPRINTF_FIELDWIDTH */
 #endif /* CONFIG_LONG_IS_NOT_INT */
 
@@ -1039,20 +1022,6 @@ static void llfixup(uint8_t fmt, FAR uint8_t *flags, FAR long long *lln)
     }
 }
 
-/****************************************************************************
- * Name: getllusize
- ****************************************************************************/
-
-static int getllusize(uint8_t fmt, uint8_t flags, unsigned long long lln)
-{
-  struct lib_outstream_s nulloutstream;
-  lib_nulloutstream(&nulloutstream);
-
-
-  llutoascii(&nulloutstream, fmt, flags, lln);
-  return nulloutstream.nput;
-}
-
 #endif /* CONFIG_NOPRINTF_FIELDWIDTH */
 #endif /* CONFIG_HAVE_LONG_LONG */
 
@@ -1166,6 +1135,8 @@ static void postjustify(FAR struct lib_outstream_s *obj, uint8_t fmt,
 
 int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list ap)
 {
+  struct lib_memoutstream_s numstream;
+  char            numbuf[NUMBUF_SIZE + 1];
   FAR char        *ptmp;
 #ifndef CONFIG_NOPRINTF_FIELDWIDTH
   int             width;
@@ -1185,9 +1156,29 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list a
 
       if (FMT_CHAR != '%')
         {
+#ifdef CONFIG_ARCH_ROMGETC
            /* Output the character */
 
            obj->put(obj, FMT_CHAR);
+#else
+           /* Find the end of this run of regular characters and output the
+            * whole run at once.  A newline also ends the run so that line
+            * buffered streams are flushed at the same point.
+            */
+
+           FAR const char *run = src;
+
+           while (src[1] != '\0' && src[1] != '%'
+#ifdef CONFIG_STDIO_LINEBUFFER
+                  && src[0] != '\n'
+#endif
+                 )
+             {
+               src++;
+             }
+
+           lib_streamputs(obj, run, src - run + 1);
+#endif
 
            /* Flush the buffer if a newline is encountered */
 
@@ -1358,9 +1349,8 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list a
 
       if (FMT_CHAR == 's')
         {
-#ifndef CONFIG_NOPRINTF_FIELDWIDTH
           int swidth;
-#endif
+
           /* Get the string to output */
 
           ptmp = va_arg(ap, char *);
@@ -1373,17 +1363,13 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list a
            * operations.
            */
 
-#ifndef CONFIG_NOPRINTF_FIELDWIDTH
           swidth = strlen(ptmp);
+#ifndef CONFIG_NOPRINTF_FIELDWIDTH
           prejustify(obj, fmt, 0, width, swidth);
 #endif
           /* Concatenate the string into the output */
 
-          while (*ptmp)
-            {
-              obj->put(obj, *ptmp);
-              ptmp++;
-            }
+          lib_streamputs(obj, ptmp, swidth);
 
           /* Perform left-justification operations. */
 
@@ -1438,17 +1424,24 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list a
               lln = va_arg(ap, long long);
 
 #ifdef CONFIG_NOPRINTF_FIELDWIDTH
+              /* Convert the number */
+
+              lib_memoutstream(&numstream, numbuf, NUMBUF_SIZE + 1);
+              llutoascii(&numstream.public, FMT_CHAR, flags, (unsigned long long)lln);
+
               /* Output the number */
 
-              llutoascii(obj, FMT_CHAR, flags, (unsigned long long)lln);
+              lib_streamputs(obj, numbuf, numstream.public.nput);
 #else
               /* Resolve sign-ness and format issues */
 
               llfixup(FMT_CHAR, &flags, &lln);
 
-              /* Get the width of the output */
+              /* Convert the number and get the width of the output */
 
-              lluwidth = getllusize(FMT_CHAR, flags, lln);
+              lib_memoutstream(&numstream, numbuf, NUMBUF_SIZE + 1);
+              llutoascii(&numstream.public, FMT_CHAR, flags, (unsigned long long)lln);
+              lluwidth = numstream.public.nput;
 
               /* Perform left field justification actions */
 
@@ -1456,7 +1449,7 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list a
 
               /* Output the number */
 
-              llutoascii(obj, FMT_CHAR, flags, (unsigned long long)lln);
+              lib_streamputs(obj, numbuf, lluwidth);
 
               /* Perform right field justification actions */
 
@@ -1477,17 +1470,24 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list a
               ln = va_arg(ap, long);
 
 #ifdef CONFIG_NOPRINTF_FIELDWIDTH
+              /* Convert the number */
+
+              lib_memoutstream(&numstream, numbuf, NUMBUF_SIZE + 1);
+              lutoascii(&numstream.public, FMT_CHAR, flags, (unsigned long)ln);
+
               /* Output the number */
 
-              lutoascii(obj, FMT_CHAR, flags, (unsigned long)ln);
+              lib_streamputs(obj, numbuf, numstream.public.nput);
 #else
               /* Resolve sign-ness and format issues */
 
               lfixup(FMT_CHAR, &flags, &ln);
 
-              /* Get the width of the output */
+              /* Convert the number and get the width of the output */
 
-              luwidth = getlusize(FMT_CHAR, flags, ln);
+              lib_memoutstream(&numstream, numbuf, NUMBUF_SIZE + 1);
+              lutoascii(&numstream.public, FMT_CHAR, flags, (unsigned long)ln);
+              luwidth = numstream.public.nput;
 
               /* Perform left field justification actions */
 
@@ -1495,7 +1495,7 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list a
 
               /* Output the number */
 
-              lutoascii(obj, FMT_CHAR, flags, (unsigned long)ln);
+              lib_streamputs(obj, numbuf, luwidth);
 
               /* Perform right field justification actions */
 
@@ -1553,17 +1553,24 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list a
               n = va_arg(ap, int);
 
 #ifdef CONFIG_NOPRINTF_FIELDWIDTH
+              /* Convert the number */
+
+              lib_memoutstream(&numstream, numbuf, NUMBUF_SIZE + 1);
+              utoascii(&numstream.public, FMT_CHAR, flags, (unsigned int)n);
+
               /* Output the number */
 
-              utoascii(obj, FMT_CHAR, flags, (unsigned int)n);
+              lib_streamputs(obj, numbuf, numstream.public.nput);
 #else
               /* Resolve sign-ness and format issues */
 
               fixup(FMT_CHAR, &flags, &n);
 
-              /* Get the width of the output */
+              /* Convert the number and get the width of the output */
 
-              uwidth = getusize(FMT_CHAR, flags, n);
+              lib_memoutstream(&numstream, numbuf, NUMBUF_SIZE + 1);
+              utoascii(&numstream.public, FMT_CHAR, flags, (unsigned int)n);
+              uwidth = numstream.public.nput;
 
               /* Perform left field justification actions */
 
@@ -1571,7 +1578,7 @@ int lib_vsprintf(FAR struct lib_outstream_s *obj, FAR const char *src, va_list a
 
               /* Output the number */
 
-              utoascii(obj, FMT_CHAR, flags, (unsigned int)n);
+              lib_streamputs(obj, numbuf, uwidth);
 
               /* Perform right field justification actions */
 
@@ -37,6 +37,7 @@
  * Included Files
  ****************************************************************************/
 
+#include <string.h>
 #include <assert.h>
 
 #include "lib_internal.h"
@@ -68,6 +69,36 @@ static void memoutstream_putc(FAR struct lib_outstream_s *this, int ch)
     }
 }
 
+/****************************************************************************
+ * Name: memoutstream_puts
+ ****************************************************************************/
+
+static void memoutstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const char *buffer, int buflen)
+{
+  FAR struct lib_memoutstream_s *mthis = (FAR struct lib_memoutstream_s *)this;
+  int nfree;
+
+  DEBUGASSERT(this);
+
+  /* Copy as much of the block as will fit, discarding the rest just as
+   * memoutstream_putc() would.
+   */
+
+  nfree = mthis->buflen - this->nput;
+  if (buflen > nfree)
+    {
+      buflen = nfree;
+    }
+
+  if (buflen > 0)
+    {
+      memcpy(&mthis->buffer[this->nput], buffer, buflen);
+      this->nput += buflen;
+      mthis->buffer[this->nput] = '\0';
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -93,6 +124,7 @@ void lib_memoutstream(FAR struct lib_memoutstream_s *memoutstream,
                       FAR char *bufstart, int buflen)
 {
   memoutstream->public.put   = memoutstream_putc;
+  memoutstream->public.puts  = memoutstream_puts;
 #ifdef CONFIG_STDIO_LINEBUFFER
   memoutstream->public.flush = lib_noflush;
 #endif
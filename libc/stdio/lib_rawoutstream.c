@@ -82,6 +82,43 @@ static void rawoutstream_putc(FAR struct lib_outstream_s *this, int ch)
   while (get_errno() == EINTR);
 }
 
+/****************************************************************************
+ * Name: rawoutstream_puts
+ ****************************************************************************/
+
+static void rawoutstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const char *buffer, int buflen)
+{
+  FAR struct lib_rawoutstream_s *rthis = (FAR struct lib_rawoutstream_s *)this;
+  int nwritten;
+
+  DEBUGASSERT(this && rthis->fd >= 0);
+
+  /* Loop until the entire block has been transferred or until an
+   * irrecoverable error occurs.  The write may be partial.
+   */
+
+  while (buflen > 0)
+    {
+      nwritten = write(rthis->fd, buffer, buflen);
+      if (nwritten > 0)
+        {
+          this->nput += nwritten;
+          buffer     += nwritten;
+          buflen     -= nwritten;
+        }
+
+      /* The only expected error is EINTR, meaning that the write operation
+       * was awakened by a signal.
+       */
+
+      else if (nwritten == 0 || get_errno() != EINTR)
+        {
+          break;
+        }
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -106,6 +143,7 @@ static void rawoutstream_putc(FAR struct lib_outstream_s *this, int ch)
 void lib_rawoutstream(FAR struct lib_rawoutstream_s *rawoutstream, int fd)
 {
   rawoutstream->public.put   = rawoutstream_putc;
+  rawoutstream->public.puts  = rawoutstream_puts;
 #ifdef CONFIG_STDIO_LINEBUFFER
   rawoutstream->public.flush = lib_noflush;
 #endif
@@ -0,0 +1,221 @@
+/****************************************************************************
+ * libc/stdio/lib_setvbuf.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdio.h>
+#include <errno.h>
+
+#include "lib_internal.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: setvbuf
+ *
+ * Description:
+ *   The setvbuf() function may be used after the stream pointed to by
+ *   stream is associated with an open file but before any other operation
+ *   is performed on the stream.  The argument mode determines how stream
+ *   will be buffered:
+ *
+ *     _IOFBF causes input/output to be fully buffered.
+ *     _IOLBF causes output to be line buffered:  The buffer is flushed
+ *            whenever a newline is written.
+ *     _IONBF causes input/output to be unbuffered.
+ *
+ *   If buffer is not a null pointer, the array it points to (of size bytes)
+ *   may be used instead of a buffer allocated by setvbuf().  Otherwise, a
+ *   buffer of size bytes is allocated.  If size is zero, then the current
+ *   buffer size is kept.
+ *
+ *   Large reads and writes bypass the buffer in any event so the buffer
+ *   need only be large enough to hold the typical small transfer.
+ *
+ * Input Parameters:
+ *   stream - The stream whose buffering is to be changed
+ *   buffer - A user supplied buffer (may be NULL)
+ *   mode   - One of _IOFBF, _IOLBF, or _IONBF
+ *   size   - The size of the buffer in bytes
+ *
+ * Returned Value:
+ *   Zero on success; otherwise, -1 (ERROR) is returned and the errno value
+ *   is set to indicate the error:
+ *
+ *     EBADF  - The stream is not valid
+ *     EINVAL - The mode is not valid
+ *     EBUSY  - The stream buffer holds data
+ *     ENOMEM - The buffer could not be allocated
+ *
+ ****************************************************************************/
+
+int setvbuf(FAR FILE *stream, FAR char *buffer, int mode, size_t size)
+{
+#if CONFIG_STDIO_BUFFER_SIZE > 0
+  FAR unsigned char *newbuf;
+  uint8_t flags;
+  int errcode;
+
+  /* Verify the stream and the mode */
+
+  if (!stream || stream->fs_filedes < 0)
+    {
+      errcode = EBADF;
+      goto errout;
+    }
+
+  if (mode != _IOFBF && mode != _IOLBF && mode != _IONBF)
+    {
+      errcode = EINVAL;
+      goto errout;
+    }
+
+  lib_take_semaphore(stream);
+
+  /* The buffer cannot be changed while it holds read-ahead or write data */
+
+  if (stream->fs_bufpos != stream->fs_bufstart ||
+      stream->fs_bufread != stream->fs_bufstart)
+    {
+      errcode = EBUSY;
+      goto errout_with_semaphore;
+    }
+
+  /* Determine the new buffer */
+
+  flags = stream->fs_flags & ~(__FS_FLAG_LBF | __FS_FLAG_UBF);
+  if (mode == _IONBF)
+    {
+      newbuf = NULL;
+      size   = 0;
+    }
+  else
+    {
+      if (size == 0)
+        {
+          size = stream->fs_bufend - stream->fs_bufstart;
+          if (size == 0)
+            {
+              size = CONFIG_STDIO_BUFFER_SIZE;
+            }
+        }
+
+      if (buffer)
+        {
+          /* Use the caller's buffer */
+
+          newbuf = (FAR unsigned char *)buffer;
+          flags |= __FS_FLAG_UBF;
+        }
+      else if (stream->fs_bufstart &&
+               (stream->fs_flags & __FS_FLAG_UBF) == 0 &&
+               (size_t)(stream->fs_bufend - stream->fs_bufstart) == size)
+        {
+          /* Keep the current, allocated buffer */
+
+          newbuf = stream->fs_bufstart;
+        }
+      else
+        {
+          /* Allocate a new buffer */
+
+          newbuf = (FAR unsigned char *)lib_malloc(size);
+          if (!newbuf)
+            {
+              errcode = ENOMEM;
+              goto errout_with_semaphore;
+            }
+        }
+
+      if (mode == _IOLBF)
+        {
+          flags |= __FS_FLAG_LBF;
+        }
+    }
+
+  /* Release the old buffer if we allocated it and it is not being kept */
+
+  if (stream->fs_bufstart && stream->fs_bufstart != newbuf &&
+      (stream->fs_flags & __FS_FLAG_UBF) == 0)
+    {
+      lib_free(stream->fs_bufstart);
+    }
+
+  /* Install the new buffer */
+
+  stream->fs_bufstart = newbuf;
+  stream->fs_bufend   = newbuf ? newbuf + size : NULL;
+  stream->fs_bufpos   = newbuf;
+  stream->fs_bufread  = newbuf;
+  stream->fs_flags    = flags;
+#ifdef CONFIG_STDIO_READAHEAD
+  stream->fs_rasize   = 0;
+#endif
+
+  lib_give_semaphore(stream);
+  return OK;
+
+errout_with_semaphore:
+  lib_give_semaphore(stream);
+
+errout:
+  set_errno(errcode);
+  return ERROR;
+#else
+  /* Without CONFIG_STDIO_BUFFER_SIZE, all streams are unbuffered.  Only the
+   * validity of the arguments can be checked.
+   */
+
+  if (!stream || stream->fs_filedes < 0)
+    {
+      set_errno(EBADF);
+      return ERROR;
+    }
+
+  if (mode != _IOFBF && mode != _IOLBF && mode != _IONBF)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  return OK;
+#endif
+}
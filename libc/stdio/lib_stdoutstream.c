@@ -78,6 +78,38 @@ static void stdoutstream_putc(FAR struct lib_outstream_s *this, int ch)
   while (get_errno() == EINTR);
 }
 
+/****************************************************************************
+ * Name: stdoutstream_puts
+ ****************************************************************************/
+
+static void stdoutstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const char *buffer, int buflen)
+{
+  FAR struct lib_stdoutstream_s *sthis = (FAR struct lib_stdoutstream_s *)this;
+  ssize_t nwritten;
+
+  DEBUGASSERT(this && sthis->stream);
+
+  /* Pass the whole block to the FILE in one call so that the stream
+   * semaphore is taken once rather than once per character.
+   */
+
+  do
+    {
+      nwritten = lib_fwrite(buffer, buflen, sthis->stream);
+      if (nwritten >= 0)
+        {
+          this->nput += nwritten;
+          return;
+        }
+
+      /* EINTR (meaning that lib_fwrite was interrupted by a signal) is the
+       * only recoverable error.
+       */
+    }
+  while (get_errno() == EINTR);
+}
+
 /****************************************************************************
  * Name: stdoutstream_flush
  ****************************************************************************/
@@ -114,9 +146,10 @@ int stdoutstream_flush(FAR struct lib_outstream_s *this)
 void lib_stdoutstream(FAR struct lib_stdoutstream_s *stdoutstream,
                    FAR FILE *stream)
 {
-  /* Select the put operation */
+  /* Select the put operations */
 
   stdoutstream->public.put   = stdoutstream_putc;
+  stdoutstream->public.puts  = stdoutstream_puts;
 
   /* Select the correct flush operation.  This flush is only called when
    * a newline is encountered in the output stream.  However, we do not
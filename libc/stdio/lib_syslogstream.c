@@ -90,6 +90,40 @@ static void syslogstream_putc(FAR struct lib_outstream_s *this, int ch)
   while (errno == -EINTR);
 }
 
+/****************************************************************************
+ * Name: syslogstream_puts
+ ****************************************************************************/
+
+static void syslogstream_puts(FAR struct lib_outstream_s *this,
+                              FAR const char *buffer, int buflen)
+{
+  int ret;
+
+  /* The logging device only accepts one character at a time, but handling
+   * the whole block here avoids an indirect call per character.
+   */
+
+  while (buflen > 0)
+    {
+      ret = syslog_putc(*buffer);
+      if (ret != EOF)
+        {
+          this->nput++;
+          buffer++;
+          buflen--;
+        }
+
+      /* The special errno value -EINTR means that syslog_putc() was
+       * awakened by a signal.  Any other error is irrecoverable.
+       */
+
+      else if (errno != -EINTR)
+        {
+          break;
+        }
+    }
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -112,6 +146,7 @@ static void syslogstream_putc(FAR struct lib_outstream_s *this, int ch)
 void lib_syslogstream(FAR struct lib_outstream_s *stream)
 {
   stream->put   = syslogstream_putc;
+  stream->puts  = syslogstream_puts;
 #ifdef CONFIG_STDIO_LINEBUFFER
   stream->flush = lib_noflush;
 #endif
@@ -43,8 +43,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_internal.h"
+
 /************************************************************
  * Global Functions
  ************************************************************/
@@ -55,6 +58,44 @@ int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
   unsigned char *p1 = (unsigned char *)s1;
   unsigned char *p2 = (unsigned char *)s2;
 
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* Skip over equal words if both buffers can be aligned to a word
+   * boundary.  The byte comparison below then finds the first difference
+   * (if any) within the remaining bytes.
+   */
+
+  if (n >= 2 * LIB_WORDSIZE && LIB_COALIGNED(p1, p2))
+    {
+      FAR const uint32_t *w1;
+      FAR const uint32_t *w2;
+
+      while (!LIB_ALIGNED(p1))
+        {
+          if (*p1 != *p2)
+            {
+              return *p1 < *p2 ? -1 : 1;
+            }
+
+          p1++;
+          p2++;
+          n--;
+        }
+
+      w1 = (FAR const uint32_t *)p1;
+      w2 = (FAR const uint32_t *)p2;
+
+      while (n >= LIB_WORDSIZE && *w1 == *w2)
+        {
+          w1++;
+          w2++;
+          n -= LIB_WORDSIZE;
+        }
+
+      p1 = (unsigned char *)w1;
+      p2 = (unsigned char *)w2;
+    }
+#endif
+
   while (n-- > 0)
     {
       if (*p1 < *p2)
@@ -43,8 +43,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_internal.h"
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -56,9 +59,98 @@
 #ifndef CONFIG_ARCH_MEMCPY
 FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
 {
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* This version is optimized for speed */
+
+  FAR uint8_t       *pout = (FAR uint8_t *)dest;
+  FAR const uint8_t *pin  = (FAR const uint8_t *)src;
+
+  /* Copy a word at a time if the source and destination can both be
+   * aligned to a word boundary.
+   */
+
+  if (n >= 2 * LIB_WORDSIZE && LIB_COALIGNED(pout, pin))
+    {
+      FAR uint32_t       *wout;
+      FAR const uint32_t *win;
+
+      /* Copy the unaligned head */
+
+      while (!LIB_ALIGNED(pout))
+        {
+          *pout++ = *pin++;
+          n--;
+        }
+
+      /* Copy four words per pass, then any remaining whole words */
+
+      wout = (FAR uint32_t *)pout;
+      win  = (FAR const uint32_t *)pin;
+
+      while (n >= 4 * LIB_WORDSIZE)
+        {
+          wout[0] = win[0];
+          wout[1] = win[1];
+          wout[2] = win[2];
+          wout[3] = win[3];
+          wout   += 4;
+          win    += 4;
+          n      -= 4 * LIB_WORDSIZE;
+        }
+
+      while (n >= LIB_WORDSIZE)
+        {
+          *wout++ = *win++;
+          n      -= LIB_WORDSIZE;
+        }
+
+      pout = (FAR uint8_t *)wout;
+      pin  = (FAR const uint8_t *)win;
+    }
+
+  /* Otherwise, copy a half-word at a time if both can be aligned to a
+   * half-word boundary.
+   */
+
+  else if (n >= 4 && (((uintptr_t)pout ^ (uintptr_t)pin) & 1) == 0)
+    {
+      FAR uint16_t       *hout;
+      FAR const uint16_t *hin;
+
+      if (((uintptr_t)pout & 1) != 0)
+        {
+          *pout++ = *pin++;
+          n--;
+        }
+
+      hout = (FAR uint16_t *)pout;
+      hin  = (FAR const uint16_t *)pin;
+
+      while (n >= 2)
+        {
+          *hout++ = *hin++;
+          n      -= 2;
+        }
+
+      pout = (FAR uint8_t *)hout;
+      pin  = (FAR const uint8_t *)hin;
+    }
+
+  /* Copy the tail (or everything if the buffers cannot be aligned) */
+
+  while (n-- > 0)
+    {
+      *pout++ = *pin++;
+    }
+
+  return dest;
+#else
+  /* This version is optimized for size */
+
   FAR unsigned char *pout = (FAR unsigned char*)dest;
   FAR unsigned char *pin  = (FAR unsigned char*)src;
   while (n-- > 0) *pout++ = *pin++;
   return dest;
+#endif
 }
 #endif
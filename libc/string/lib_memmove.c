@@ -43,8 +43,12 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_internal.h"
+
 /************************************************************
  * Global Functions
  ************************************************************/
@@ -52,6 +56,115 @@
 #ifndef CONFIG_ARCH_MEMMOVE
 FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
 {
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  /* This version is optimized for speed */
+
+  FAR uint8_t       *pout = (FAR uint8_t *)dest;
+  FAR const uint8_t *pin  = (FAR const uint8_t *)src;
+  bool               words;
+
+  words = (count >= 2 * LIB_WORDSIZE && LIB_COALIGNED(pout, pin));
+
+  if (pout <= pin || pout >= pin + count)
+    {
+      /* Copy forward.  This is safe even if the regions overlap because
+       * each byte is read before the destination reaches it.
+       */
+
+      if (words)
+        {
+          FAR uint32_t       *wout;
+          FAR const uint32_t *win;
+
+          while (!LIB_ALIGNED(pout))
+            {
+              *pout++ = *pin++;
+              count--;
+            }
+
+          wout = (FAR uint32_t *)pout;
+          win  = (FAR const uint32_t *)pin;
+
+          while (count >= 4 * LIB_WORDSIZE)
+            {
+              wout[0] = win[0];
+              wout[1] = win[1];
+              wout[2] = win[2];
+              wout[3] = win[3];
+              wout   += 4;
+              win    += 4;
+              count  -= 4 * LIB_WORDSIZE;
+            }
+
+          while (count >= LIB_WORDSIZE)
+            {
+              *wout++ = *win++;
+              count  -= LIB_WORDSIZE;
+            }
+
+          pout = (FAR uint8_t *)wout;
+          pin  = (FAR const uint8_t *)win;
+        }
+
+      while (count-- > 0)
+        {
+          *pout++ = *pin++;
+        }
+    }
+  else
+    {
+      /* The destination overlaps the end of the source.  Copy backward
+       * from the end.
+       */
+
+      pout += count;
+      pin  += count;
+
+      if (words)
+        {
+          FAR uint32_t       *wout;
+          FAR const uint32_t *win;
+
+          while (!LIB_ALIGNED(pout))
+            {
+              *--pout = *--pin;
+              count--;
+            }
+
+          wout = (FAR uint32_t *)pout;
+          win  = (FAR const uint32_t *)pin;
+
+          while (count >= 4 * LIB_WORDSIZE)
+            {
+              wout   -= 4;
+              win    -= 4;
+              wout[3] = win[3];
+              wout[2] = win[2];
+              wout[1] = win[1];
+              wout[0] = win[0];
+              count  -= 4 * LIB_WORDSIZE;
+            }
+
+          while (count >= LIB_WORDSIZE)
+            {
+              *--wout = *--win;
+              count  -= LIB_WORDSIZE;
+            }
+
+          pout = (FAR uint8_t *)wout;
+          pin  = (FAR const uint8_t *)win;
+        }
+
+      while (count-- > 0)
+        {
+          *--pout = *--pin;
+        }
+    }
+
+  return dest;
+#else
+  /* This version is optimized for size */
+
   char *tmp, *s;
   if (dest <= src)
     {
@@ -73,5 +186,6 @@ FAR void *memmove(FAR void *dest, FAR const void *src, size_t count)
     }
 
   return dest;
+#endif
 }
 #endif
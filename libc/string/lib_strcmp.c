@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_internal.h"
+
 /****************************************************************************
  * Public Functions
  *****************************************************************************/
@@ -48,6 +51,47 @@
 #ifndef CONFIG_ARCH_STRCMP
 int strcmp(const char *cs, const char *ct)
 {
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  FAR const unsigned char *s1 = (FAR const unsigned char *)cs;
+  FAR const unsigned char *s2 = (FAR const unsigned char *)ct;
+
+  /* Skip over equal words if both strings can be aligned to a word
+   * boundary.  The comparison stops at the first word that differs or
+   * that contains the terminator of the first string; if the second string
+   * ends earlier, then the words differ.
+   */
+
+  if (LIB_COALIGNED(s1, s2))
+    {
+      FAR const uint32_t *w1;
+      FAR const uint32_t *w2;
+
+      for (; !LIB_ALIGNED(s1); s1++, s2++)
+        {
+          if (*s1 != *s2 || *s1 == '\0')
+            {
+              return (int)*s1 - (int)*s2;
+            }
+        }
+
+      w1 = (FAR const uint32_t *)s1;
+      w2 = (FAR const uint32_t *)s2;
+
+      while (*w1 == *w2 && !LIB_HASZERO(*w1))
+        {
+          w1++;
+          w2++;
+        }
+
+      s1 = (FAR const unsigned char *)w1;
+      s2 = (FAR const unsigned char *)w2;
+    }
+
+  /* Find the difference (or the terminator) a byte at a time */
+
+  for (; *s1 == *s2 && *s1 != '\0'; s1++, s2++);
+  return (int)*s1 - (int)*s2;
+#else
   register signed char result;
   for (;;)
     {
@@ -55,5 +99,6 @@ int strcmp(const char *cs, const char *ct)
 	break;
     }
   return result;
+#endif
 }
 #endif
@@ -39,8 +39,11 @@
 
 #include <nuttx/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+#include "lib_internal.h"
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -49,7 +52,32 @@
 size_t strlen(const char *s)
 {
   const char *sc;
-  for (sc = s; *sc != '\0'; ++sc);
+
+#ifdef CONFIG_LIBC_STRING_OPTSPEED
+  FAR const uint32_t *ws;
+
+  /* Check the bytes up to the first word boundary */
+
+  for (sc = s; !LIB_ALIGNED(sc); ++sc)
+    {
+      if (*sc == '\0')
+        {
+          return sc - s;
+        }
+    }
+
+  /* Then skip over whole words that contain no NUL.  An aligned word never
+   * crosses a page or memory region boundary, so reading the bytes after
+   * the terminator in the last word is safe.
+   */
+
+  for (ws = (FAR const uint32_t *)sc; !LIB_HASZERO(*ws); ws++);
+  sc = (const char *)ws;
+#else
+  sc = s;
+#endif
+
+  for (; *sc != '\0'; ++sc);
   return sc - s;
 }
 #endif
@@ -93,6 +93,7 @@
 int work_cancel(int qid, FAR struct work_s *work)
 {
   FAR struct wqueue_s *wqueue = &g_work[qid];
+  FAR dq_queue_t *queue;
   irqstate_t flags;
 
   DEBUGASSERT(work != NULL && (unsigned)qid < NWORKERS);
@@ -105,16 +106,20 @@ int work_cancel(int qid, FAR struct work_s *work)
   flags = irqsave();
   if (work->worker != NULL)
     {
+      /* Work with no delay and delayed work are kept in different lists */
+
+      queue = work->delay ? &wqueue->delayed : &wqueue->q;
+
       /* A little test of the integrity of the work queue */
 
-      DEBUGASSERT(work->dq.flink ||(FAR dq_entry_t *)work == wqueue->q.tail);
-      DEBUGASSERT(work->dq.blink ||(FAR dq_entry_t *)work == wqueue->q.head);
+      DEBUGASSERT(work->dq.flink ||(FAR dq_entry_t *)work == queue->tail);
+      DEBUGASSERT(work->dq.blink ||(FAR dq_entry_t *)work == queue->head);
 
       /* Remove the entry from the work queue and make sure that it is
        * mark as availalbe (i.e., the worker field is nullified).
        */
 
-      dq_rem((FAR dq_entry_t *)work, &wqueue->q);
+      dq_rem((FAR dq_entry_t *)work, queue);
       work->worker = NULL;
     }
 
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <stdint.h>
+#include <sched.h>
 #include <queue.h>
 #include <assert.h>
 #include <errno.h>
@@ -49,6 +50,8 @@
 #include <nuttx/clock.h>
 #include <nuttx/wqueue.h>
 
+#include "lib_internal.h"
+
 #ifdef CONFIG_SCHED_WORKQUEUE
 
 /****************************************************************************
@@ -71,6 +74,62 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: work_boostpriority
+ *
+ * Description:
+ *   The calling task is waiting for the work that it just queued on the
+ *   low priority work queue.  Raise the priority of the worker thread(s)
+ *   that may perform that work to the priority of the caller so that the
+ *   work is not held off by tasks of intermediate priority.  A worker
+ *   thread returns to its base priority when it finds no more work to do.
+ *
+ * Input parameters:
+ *   wqueue - The low priority work queue
+ *   wndx   - The index of the thread that was awakened to perform the
+ *            work or a negative value if all of the threads were busy.
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_LPWORK) && defined(CONFIG_PRIORITY_INHERITANCE)
+static void work_boostpriority(FAR struct wqueue_s *wqueue, int wndx)
+{
+  FAR struct kworker_s *kworker;
+  struct sched_param param;
+  int reqprio;
+  int i;
+
+  if (sched_getparam(0, &param) < 0 ||
+      param.sched_priority <= CONFIG_SCHED_LPWORKPRIORITY)
+    {
+      return;
+    }
+
+  reqprio = param.sched_priority;
+
+  /* If a waiting thread was awakened, then it will perform the work.
+   * Otherwise, the work will be performed by whichever busy thread
+   * finishes first.
+   */
+
+  for (i = 0; i < wqueue->nthreads; i++)
+    {
+      kworker = &wqueue->worker[i];
+      if ((wndx < 0 || i == wndx) &&
+          sched_getparam(kworker->pid, &param) == OK &&
+          param.sched_priority < reqprio)
+        {
+          kworker->boosted     = true;
+          param.sched_priority = reqprio;
+          (void)sched_setparam(kworker->pid, &param);
+        }
+    }
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -82,6 +141,15 @@
  *   Queue work to be performed at a later time.  All queued work will be
  *   performed on the worker thread of of execution (not the caller's).
  *
+ *   Work with no delay is simply added to the end of the queue.  Delayed
+ *   work is kept in a separate list in order of expiration time (and in
+ *   FIFO order for work that expires at the same time).  New delayed work
+ *   usually expires after the work already queued, so the search for its
+ *   place starts at the end of the list.  A waiting worker thread is
+ *   signaled when work with no delay is queued or when new delayed work
+ *   will be the first to expire; busy worker threads will find the work
+ *   when they finish the work that they are performing.
+ *
  *   The work structure is allocated by caller, but completely managed by
  *   the work queue logic.  The caller should never modify the contents of
  *   the work queue structure; the caller should not call work_queue()
@@ -108,7 +176,12 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
                FAR void *arg, uint32_t delay)
 {
   FAR struct wqueue_s *wqueue = &g_work[qid];
+  FAR struct work_s *prev;
   irqstate_t flags;
+  uint32_t expiry;
+#if defined(CONFIG_SCHED_LPWORK) && defined(CONFIG_PRIORITY_INHERITANCE)
+  int wndx = -EBUSY;
+#endif
 
   DEBUGASSERT(work != NULL && (unsigned)qid < NWORKERS);
 
@@ -126,10 +199,58 @@ int work_queue(int qid, FAR struct work_s *work, worker_t worker,
   flags        = irqsave();
   work->qtime  = clock_systimer(); /* Time work queued */
 
-  dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
-  kill(wqueue->pid, SIGWORK);      /* Wake up the worker thread */
+  if (delay == 0)
+    {
+      /* Work with no delay is performed in the order that it is queued */
+
+      dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+
+      /* Wake up a waiting worker thread */
+
+#if defined(CONFIG_SCHED_LPWORK) && defined(CONFIG_PRIORITY_INHERITANCE)
+      wndx = work_wakeup(wqueue);
+#else
+      (void)work_wakeup(wqueue);
+#endif
+    }
+  else
+    {
+      /* Find the last delayed work that expires no later than this work.
+       * The signed difference handles wrap-around of the system timer.
+       */
+
+      expiry = work->qtime + delay;
+      for (prev = (FAR struct work_s *)wqueue->delayed.tail;
+           prev && (int32_t)(expiry - (prev->qtime + prev->delay)) < 0;
+           prev = (FAR struct work_s *)prev->dq.blink);
+
+      if (prev)
+        {
+          dq_addafter((FAR dq_entry_t *)prev, (FAR dq_entry_t *)work,
+                      &wqueue->delayed);
+        }
+      else
+        {
+          /* This is now the first delayed work to expire */
+
+          dq_addfirst((FAR dq_entry_t *)work, &wqueue->delayed);
+          (void)work_wakeup(wqueue); /* Wake up a waiting worker thread */
+        }
+    }
 
   irqrestore(flags);
+
+#if defined(CONFIG_SCHED_LPWORK) && defined(CONFIG_PRIORITY_INHERITANCE)
+  /* If a task queued work with no delay on the low priority work queue,
+   * then the worker thread inherits the priority of that task.
+   */
+
+  if (qid == LPWORK && delay == 0 && !up_interrupt_context())
+    {
+      work_boostpriority(wqueue, wndx);
+    }
+#endif
+
   return OK;
 }
 
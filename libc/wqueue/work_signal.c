@@ -41,9 +41,13 @@
 
 #include <signal.h>
 #include <assert.h>
+#include <errno.h>
 
+#include <arch/irq.h>
 #include <nuttx/wqueue.h>
 
+#include "lib_internal.h"
+
 #ifdef CONFIG_SCHED_WORKQUEUE
 
 /****************************************************************************
@@ -69,13 +73,55 @@
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
+/****************************************************************************
+ * Name: work_wakeup
+ *
+ * Description:
+ *   Wake up one of the threads that is waiting for work on the work queue.
+ *   The thread is marked busy when it is signaled so that work queued
+ *   before it runs will wake up a different thread.  This function is used
+ *   internally by the work logic.
+ *
+ * Input parameters:
+ *   wqueue - The work queue to be processed
+ *
+ * Returned Value:
+ *   The index of the thread that was signaled.  -EBUSY is returned if
+ *   all of the threads are busy; they will find the work when they finish
+ *   their current work.  Any other negated errno value indicates a failure.
+ *
+ ****************************************************************************/
+
+int work_wakeup(FAR struct wqueue_s *wqueue)
+{
+  FAR struct kworker_s *kworker;
+  irqstate_t flags;
+  int ret = -EBUSY;
+  int wndx;
+
+  flags = irqsave();
+  for (wndx = 0; wndx < wqueue->nthreads; wndx++)
+    {
+      kworker = &wqueue->worker[wndx];
+      if (!kworker->busy)
+        {
+          kworker->busy = true;
+          ret = kill(kworker->pid, SIGWORK) < 0 ? -errno : wndx;
+          break;
+        }
+    }
+
+  irqrestore(flags);
+  return ret;
+}
+
 /****************************************************************************
  * Name: work_signal
  *
  * Description:
- *   Signal the worker thread to process the work queue now.  This function
- *   is used internally by the work logic but could also be used by the
- *   user to force an immediate re-assessment of pending work.
+ *   Signal a waiting worker thread to process the work queue now.  This
+ *   function is used internally by the work logic but could also be used
+ *   by the user to force an immediate re-assessment of pending work.
  *
  * Input parameters:
  *   qid    - The work queue ID
@@ -87,8 +133,12 @@
 
 int work_signal(int qid)
 {
+  int ret;
+
   DEBUGASSERT((unsigned)qid < NWORKERS);
-  return kill(g_work[qid].pid, SIGWORK);
+
+  ret = work_wakeup(&g_work[qid]);
+  return ret < 0 && ret != -EBUSY ? ret : OK;
 }
 
 #endif /* CONFIG_SCHED_WORKQUEUE */
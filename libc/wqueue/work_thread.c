@@ -41,6 +41,7 @@
 
 #include <stdint.h>
 #include <unistd.h>
+#include <sched.h>
 #include <queue.h>
 #include <assert.h>
 #include <errno.h>
@@ -103,97 +104,148 @@ struct wqueue_s g_work[NWORKERS];
  * Description:
  *   This is the logic that performs actions placed on any work list.
  *
+ *   Work with no delay is kept in FIFO order and delayed work is kept in
+ *   order of expiration time (see work_queue()), so only the head of each
+ *   list needs to be examined.  When no work is ready, the worker thread
+ *   sleeps until the first delayed work expires (but no longer than
+ *   'period').  work_queue() and work_signal() wake it up early.
+ *
+ *   Several worker threads may process the same work queue.  Each work is
+ *   removed from the list (with interrupts disabled) before it is
+ *   performed, so each work is performed by only one thread and
+ *   work_cancel() has no effect on work that is already being performed.
+ *
  * Input parameters:
- *   wqueue - Describes the work queue to be processed
+ *   wqueue  - Describes the work queue to be processed
+ *   kworker - Describes the worker thread that is processing the queue
+ *   period  - Maximum time to sleep in microseconds
  *
  * Returned Value:
  *   None
  *
  ****************************************************************************/
 
-static void work_process(FAR struct wqueue_s *wqueue)
+static void work_process(FAR struct wqueue_s *wqueue,
+                         FAR struct kworker_s *kworker, uint32_t period)
 {
   volatile FAR struct work_s *work;
+  volatile FAR struct work_s *delayed;
+  FAR dq_queue_t *queue;
   worker_t  worker;
   irqstate_t flags;
   FAR void *arg;
   uint32_t elapsed;
-  uint32_t remaining;
   uint32_t next;
+#if defined(CONFIG_SCHED_LPWORK) && defined(CONFIG_PRIORITY_INHERITANCE)
+  struct sched_param param;
+#endif
 
   /* Then process queued work.  We need to keep interrupts disabled while
    * we process items in the work list.
    */
 
-  next  = CONFIG_SCHED_WORKPERIOD / USEC_PER_TICK;
+  next  = period / USEC_PER_TICK;
   flags = irqsave();
-  work  = (FAR struct work_s *)wqueue->q.head;
-  while (work)
+  for (;;)
     {
-      /* Is this work ready?  It is ready if there is no delay or if
-       * the delay has elapsed. qtime is the time that the work was added
-       * to the work queue.  It will always be greater than or equal to
-       * zero.  Therefore a delay of zero will always execute immediately.
+      /* Is the first delayed work ready?  It is ready if the delay has
+       * elapsed.  qtime is the time that the work was added to the work
+       * queue.
        */
 
-      elapsed = clock_systimer() - work->qtime;
-      if (elapsed >= work->delay)
+      work    = (FAR struct work_s *)wqueue->q.head;
+      delayed = (FAR struct work_s *)wqueue->delayed.head;
+      queue   = &wqueue->q;
+
+      if (delayed)
         {
-          /* Remove the ready-to-execute work from the list */
+          elapsed = clock_systimer() - delayed->qtime;
+          if (elapsed >= delayed->delay)
+            {
+              /* Yes.. perform it first if it expired before the first
+               * work with no delay was queued.
+               */
+
+              if (!work ||
+                  (int32_t)(delayed->qtime + delayed->delay - work->qtime) <= 0)
+                {
+                  work  = delayed;
+                  queue = &wqueue->delayed;
+                }
+            }
+          else if (delayed->delay - elapsed < next)
+            {
+              /* No.. but it will be ready before the next scheduled wakeup
+               * interval.  Then schedule to wake up when the work is ready.
+               */
 
-          (void)dq_rem((struct dq_entry_s *)work, &wqueue->q);
+              next = delayed->delay - elapsed;
+            }
+        }
 
-          /* Extract the work description from the entry (in case the work
-           * instance by the re-used after it has been de-queued).
+      /* Is there any work ready to be performed? */
+
+      if (!work)
+        {
+#if defined(CONFIG_SCHED_LPWORK) && defined(CONFIG_PRIORITY_INHERITANCE)
+          /* No.. If this thread inherited the priority of a task that
+           * queued work, then return to the base priority before waiting.
+           * Pre-emption is disabled so that the priority cannot be boosted
+           * again before the flag is cleared.  Then check the work lists
+           * again since other tasks may have run when pre-emption was
+           * re-enabled.
            */
 
-          worker = work->worker;
-          arg    = work->arg;
+          if (kworker->boosted)
+            {
+              sched_lock();
+              kworker->boosted     = false;
+              param.sched_priority = CONFIG_SCHED_LPWORKPRIORITY;
+              (void)sched_setparam(0, &param);
+              sched_unlock();
+              continue;
+            }
+#endif
+          break;
+        }
 
-          /* Mark the work as no longer being queued */
+      /* Remove the ready-to-execute work from the list */
 
-          work->worker = NULL;
+      (void)dq_rem((struct dq_entry_s *)work, queue);
 
-          /* Do the work.  Re-enable interrupts while the work is being
-           * performed... we don't have any idea how long that will take!
-           */
+      /* Extract the work description from the entry (in case the work
+       * instance by the re-used after it has been de-queued).
+       */
 
-          irqrestore(flags);
-          worker(arg);
+      worker = work->worker;
+      arg    = work->arg;
 
-          /* Now, unfortunately, since we re-enabled interrupts we don't
-           * know the state of the work list and we will have to start
-           * back at the head of the list.
-           */
+      /* Mark the work as no longer being queued */
 
-          flags = irqsave();
-          work  = (FAR struct work_s *)wqueue->q.head;
-        }
-      else
-        {
-          /* This one is not ready.. will it be ready before the next
-           * scheduled wakeup interval?
-           */
+      work->worker = NULL;
 
-          remaining = elapsed - work->delay;
-          if (remaining < next)
-            {
-              /* Yes.. Then schedule to wake up when the work is ready */
+      /* Do the work.  Re-enable interrupts while the work is being
+       * performed... we don't have any idea how long that will take!
+       */
 
-              next = remaining;
-            }
-              
-          /* Then try the next in the list. */
+      irqrestore(flags);
+      worker(arg);
 
-          work = (FAR struct work_s *)work->dq.flink;
-        }
+      /* Now, since we re-enabled interrupts we don't know the state of the
+       * work lists.  Start over with the heads of the lists.
+       */
+
+      flags = irqsave();
+      next  = period / USEC_PER_TICK;
     }
 
   /* Wait awhile to check the work list.  We will wait here until either
    * the time elapses or until we are awakened by a signal.
    */
 
+  kworker->busy = false;
   usleep(next * USEC_PER_TICK);
+  kworker->busy = true;
   irqrestore(flags);
 }
 
@@ -254,7 +306,8 @@ int work_hpthread(int argc, char *argv[])
        * we process items in the work list.
        */
 
-      work_process(&g_work[HPWORK]);
+      work_process(&g_work[HPWORK], &g_work[HPWORK].worker[0],
+                   CONFIG_SCHED_WORKPERIOD);
     }
 
   return OK; /* To keep some compilers happy */
@@ -264,6 +317,26 @@ int work_hpthread(int argc, char *argv[])
 
 int work_lpthread(int argc, char *argv[])
 {
+  FAR struct kworker_s *kworker;
+  pid_t me = getpid();
+  int wndx;
+
+  /* Find the entry for this thread in the pool.  The pool is started with
+   * pre-emption disabled, so the task IDs of all of the threads are known
+   * by the time that any of them runs.
+   */
+
+  for (wndx = 0; wndx < CONFIG_SCHED_LPNTHREADS - 1; wndx++)
+    {
+      if (g_work[LPWORK].worker[wndx].pid == me)
+        {
+          break;
+        }
+    }
+
+  kworker = &g_work[LPWORK].worker[wndx];
+  DEBUGASSERT(kworker->pid == me);
+
   /* Loop forever */
 
   for (;;)
@@ -281,7 +354,7 @@ int work_lpthread(int argc, char *argv[])
        * we process items in the work list.
        */
 
-      work_process(&g_work[LPWORK]);
+      work_process(&g_work[LPWORK], kworker, CONFIG_SCHED_LPWORKPERIOD);
     }
 
   return OK; /* To keep some compilers happy */
@@ -302,7 +375,8 @@ int work_usrthread(int argc, char *argv[])
        * we process items in the work list.
        */
 
-      work_process(&g_work[USRWORK]);
+      work_process(&g_work[USRWORK], &g_work[USRWORK].worker[0],
+                   CONFIG_SCHED_USRWORKPERIOD);
     }
 
   return OK; /* To keep some compilers happy */
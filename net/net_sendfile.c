@@ -0,0 +1,621 @@
+/****************************************************************************
+ * net/net_sendfile.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+#if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && \
+    defined(CONFIG_NET_SENDFILE) && CONFIG_NFILE_DESCRIPTORS > 0
+
+#include <sys/types.h>
+#include <sys/socket.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <arch/irq.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/uip/uip-arch.h>
+
+#ifdef CONFIG_NET_ARP_IPIN
+#  include <nuttx/net/uip/uip-arp.h>
+#endif
+
+#include "net_internal.h"
+#include "uip/uip_internal.h"
+
+/****************************************************************************
+ * Definitions
+ ****************************************************************************/
+
+#define TCPBUF ((struct uip_tcpip_hdr *)&dev->d_buf[UIP_LLH_LEN])
+
+#ifndef CONFIG_NET_SENDFILE_BUFSIZE
+#  define CONFIG_NET_SENDFILE_BUFSIZE 1024
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure holds the state of the sendfile operation until it can be
+ * operated upon from the interrupt level.  The file is read by the calling
+ * thread, one buffer at a time, into snd_buffer.  The interrupt level logic
+ * only sends (and re-sends) data from that buffer.  All positions are byte
+ * offsets from the beginning of the transfer.
+ */
+
+struct sendfile_s
+{
+  FAR struct socket         *snd_sock;    /* Points to the parent socket structure */
+  FAR struct uip_callback_s *snd_cb;      /* Reference to callback instance */
+  FAR uint8_t               *snd_buffer;  /* File data to be sent */
+  sem_t                      snd_sem;     /* Used to wake up the waiting thread */
+  size_t                     snd_flen;    /* Number of bytes to send from the file */
+  uint32_t                   snd_bufpos;  /* Position of the first byte in snd_buffer */
+  size_t                     snd_buflen;  /* Number of valid bytes in snd_buffer */
+  bool                       snd_refill;  /* true: snd_buffer has been ACKed */
+  ssize_t                    snd_sent;    /* The number of bytes sent */
+  uint32_t                   snd_isn;     /* Initial sequence number */
+  uint32_t                   snd_acked;   /* The number of bytes acked */
+#if defined(CONFIG_NET_SOCKOPTS) && !defined(CONFIG_DISABLE_CLOCK)
+  uint32_t                   snd_time;    /* Last send time for determining timeout */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Function: sendfile_timeout
+ *
+ * Description:
+ *   Check for send timeout.
+ *
+ * Parameters:
+ *   pstate   sendfile state structure
+ *
+ * Returned Value:
+ *   TRUE:timeout FALSE:no timeout
+ *
+ * Assumptions:
+ *   Running at the interrupt level
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_NET_SOCKOPTS) && !defined(CONFIG_DISABLE_CLOCK)
+static inline int sendfile_timeout(FAR struct sendfile_s *pstate)
+{
+  FAR struct socket *psock = pstate->snd_sock;
+
+  /* Check for a timeout configured via setsockopts(SO_SNDTIMEO).
+   * If none... we well let the send wait forever.
+   */
+
+  if (psock && psock->s_sndtimeo != 0)
+    {
+      /* Check if the configured timeout has elapsed */
+
+      return net_timeo(pstate->snd_time, psock->s_sndtimeo);
+    }
+
+  /* No timeout */
+
+  return FALSE;
+}
+#endif /* CONFIG_NET_SOCKOPTS && !CONFIG_DISABLE_CLOCK */
+
+/****************************************************************************
+ * Function: sendfile_interrupt
+ *
+ * Description:
+ *   This function is called from the interrupt level to perform the actual
+ *   send operation when polled by the uIP layer.  The file data was read
+ *   into snd_buffer by the waiting thread; each segment is copied from
+ *   there into the device's outgoing packet buffer (d_snddata).  The file
+ *   is never accessed here:  File system reads may wait on semaphores and
+ *   perform block device I/O and so must not be done at the interrupt
+ *   level.  When the whole buffer has been ACKed, the waiting thread is
+ *   awakened to read the next part of the file.
+ *
+ * Parameters:
+ *   dev      The sructure of the network driver that caused the interrupt
+ *   conn     The connection structure associated with the socket
+ *   flags    Set of events describing why the callback was invoked
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   Running at the interrupt level
+ *
+ ****************************************************************************/
+
+static uint16_t sendfile_interrupt(FAR struct uip_driver_s *dev,
+                                   FAR void *pvconn, FAR void *pvpriv,
+                                   uint16_t flags)
+{
+  FAR struct uip_conn *conn = (FAR struct uip_conn*)pvconn;
+  FAR struct sendfile_s *pstate = (FAR struct sendfile_s *)pvpriv;
+
+  nllvdbg("flags: %04x acked: %d sent: %d\n",
+          flags, pstate->snd_acked, pstate->snd_sent);
+
+  /* If this packet contains an acknowledgement, then update the count of
+   * acknowldged bytes.
+   */
+
+  if ((flags & UIP_ACKDATA) != 0)
+    {
+      pstate->snd_acked = uip_tcpgetsequence(TCPBUF->ackno) - pstate->snd_isn;
+      nllvdbg("ACK: acked=%d sent=%d flen=%d\n",
+              pstate->snd_acked, pstate->snd_sent, pstate->snd_flen);
+
+      /* Has all of the data in the buffer been sent and acknowledged? */
+
+      if (!pstate->snd_refill &&
+          pstate->snd_acked >= pstate->snd_bufpos + pstate->snd_buflen)
+        {
+          /* Yes.. wake up the thread to read more of the file (or to
+           * finish the transfer).  Nothing more can be sent until then.
+           */
+
+          pstate->snd_refill = true;
+          sem_post(&pstate->snd_sem);
+          return flags;
+        }
+
+      /* No.. fall through to send more data if necessary */
+    }
+
+  /* Check if we are being asked to retransmit data */
+
+  else if ((flags & UIP_REXMIT) != 0)
+    {
+      /* Yes.. in this case, reset the number of bytes that have been sent
+       * to the number of bytes that have been ACKed.  The unacknowledged
+       * data is still in snd_buffer.
+       */
+
+      pstate->snd_sent = pstate->snd_acked;
+    }
+
+ /* Check for a loss of connection */
+
+  else if ((flags & (UIP_CLOSE|UIP_ABORT|UIP_TIMEDOUT)) != 0)
+    {
+      /* Report not connected */
+
+      nllvdbg("Lost connection\n");
+
+      net_lostconnection(pstate->snd_sock, flags);
+      pstate->snd_sent = -ENOTCONN;
+      goto end_wait;
+    }
+
+  /* We get here if (1) not all of the data has been ACKed, (2) we have been
+   * asked to retransmit data, (3) the connection is still healthy, and (4)
+   * the outgoing packet is available for our use.  In this case, we are
+   * now free to send more data to receiver -- UNLESS the buffer contains
+   * unprocessing incoming data.  In that event, we will have to wait for the
+   * next polling cycle.
+   */
+
+  if ((flags & UIP_NEWDATA) == 0 &&
+      pstate->snd_sent < pstate->snd_bufpos + pstate->snd_buflen)
+    {
+      uint32_t seqno;
+
+      /* Get the amount of data that we can send in the next packet */
+
+      uint32_t sndlen = pstate->snd_bufpos + pstate->snd_buflen -
+                        pstate->snd_sent;
+      if (sndlen > uip_mss(conn))
+        {
+          sndlen = uip_mss(conn);
+        }
+
+      /* Copy the file data from the buffer into the outgoing packet */
+
+      memcpy(dev->d_snddata,
+             &pstate->snd_buffer[pstate->snd_sent - pstate->snd_bufpos],
+             sndlen);
+
+      /* Set the sequence number for this packet.  NOTE:  uIP updates
+       * sndseq on recept of ACK *before* this function is called.  In that
+       * case sndseq will point to the next unacknowledge byte (which might
+       * have already been sent).  We will overwrite the value of sndseq
+       * here before the packet is sent.
+       */
+
+      seqno = pstate->snd_sent + pstate->snd_isn;
+      nllvdbg("SEND: sndseq %08x->%08x\n", conn->sndseq, seqno);
+      uip_tcpsetsequence(conn->sndseq, seqno);
+
+      /* Then set-up to send the data now in d_snddata (this won't actually
+       * happen until the polling cycle completes).
+       */
+
+      dev->d_sndlen = sndlen;
+
+      /* Check if the destination IP address is in the ARP table.  If not,
+       * then the send won't actually make it out... it will be replaced with
+       * an ARP request.  See the notes in send_interrupt().
+       */
+
+#if defined(CONFIG_NET_ETHERNET) && defined (CONFIG_NET_ARP_IPIN)
+      if (pstate->snd_sent != 0 || uip_arp_find(conn->ripaddr) != NULL)
+#endif
+        {
+          /* Update the amount of data sent (but not necessarily ACKed) */
+
+          pstate->snd_sent += sndlen;
+          nllvdbg("SEND: acked=%d sent=%d flen=%d\n",
+                  pstate->snd_acked, pstate->snd_sent, pstate->snd_flen);
+
+          /* Update the send time */
+
+#if defined(CONFIG_NET_SOCKOPTS) && !defined(CONFIG_DISABLE_CLOCK)
+          pstate->snd_time = clock_systimer();
+#endif
+        }
+    }
+
+  /* All data in the buffer has been sent and we are just waiting for ACK
+   * or re-transmit indications.  Check for a timeout (but not while the
+   * thread is reading the next part of the file).
+   */
+
+#if defined(CONFIG_NET_SOCKOPTS) && !defined(CONFIG_DISABLE_CLOCK)
+  else if (!pstate->snd_refill && sendfile_timeout(pstate))
+    {
+      /* Yes.. report the timeout */
+
+      nlldbg("SEND timeout\n");
+      pstate->snd_sent = -ETIMEDOUT;
+      goto end_wait;
+    }
+#endif /* CONFIG_NET_SOCKOPTS && !CONFIG_DISABLE_CLOCK */
+
+  /* Continue waiting */
+
+  return flags;
+
+end_wait:
+  /* Do not allow any further callbacks */
+
+  pstate->snd_cb->flags   = 0;
+  pstate->snd_cb->priv    = NULL;
+  pstate->snd_cb->event   = NULL;
+
+  /* There are no outstanding, unacknowledged bytes */
+
+  conn->unacked           = 0;
+
+  /* Wake up the waiting thread */
+
+  sem_post(&pstate->snd_sem);
+  return flags;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Function: net_sendfile
+ *
+ * Description:
+ *   Send 'count' bytes from the file 'infile' on the connected TCP socket
+ *   'outfd'.  This is the network portion of the OS sendfile():  The file
+ *   is read by the calling thread into a buffer that stays with the
+ *   connection until its data has been ACKed.  The network callback sends
+ *   (and, if necessary, re-sends) each segment from that buffer, so the
+ *   file is never accessed from the interrupt level and no user buffer or
+ *   separate send() call is needed.
+ *
+ *   The input file must be a seekable file:  A regular file on a mounted
+ *   volume.
+ *
+ * Parameters:
+ *   outfd    Socket descriptor of a connected TCP socket
+ *   infile   The file structure of the input file
+ *   offset   If non-NULL, the file offset at which to start reading.  On
+ *            return, it is updated to the offset after the last byte sent
+ *            and the file position of 'infile' is not modified.  If NULL,
+ *            the transfer starts at the current file position and the file
+ *            position is updated.
+ *   count    The number of bytes to send
+ *
+ * Returned Value:
+ *   On success, returns the number of bytes sent.  On error, -1 is
+ *   returned, and errno is set appropriately (see send()).
+ *
+ ****************************************************************************/
+
+ssize_t net_sendfile(int outfd, FAR struct file *infile, FAR off_t *offset,
+                     size_t count)
+{
+  FAR struct socket *psock = sockfd_socket(outfd);
+  struct sendfile_s state;
+  uip_lock_t save;
+  off_t startpos;
+  off_t foffset;
+  ssize_t nread;
+  size_t nbytes;
+  int err;
+  int ret = OK;
+
+  /* Verify that the sockfd corresponds to valid, allocated socket */
+
+  if (!psock || psock->s_crefs <= 0)
+    {
+      err = EBADF;
+      goto errout;
+    }
+
+  /* If this is an un-connected socket, then return ENOTCONN */
+
+  if (psock->s_type != SOCK_STREAM || !_SS_ISCONNECTED(psock->s_flags))
+    {
+      err = ENOTCONN;
+      goto errout;
+    }
+
+  /* Verify that the input file is open and readable */
+
+  if (!infile->f_inode || (infile->f_oflags & O_RDOK) == 0)
+    {
+      err = EBADF;
+      goto errout;
+    }
+
+  /* Get the current file position.  This is where the transfer begins if
+   * no offset was provided; otherwise it is restored when we are finished.
+   */
+
+  startpos = file_seek(infile, 0, SEEK_CUR);
+  if (startpos < 0)
+    {
+      err = (int)-startpos;
+      goto errout;
+    }
+
+  foffset = startpos;
+  if (offset && *offset != startpos)
+    {
+      foffset = file_seek(infile, *offset, SEEK_SET);
+      if (foffset < 0)
+        {
+          err = (int)-foffset;
+          goto errout;
+        }
+    }
+
+  /* Allocate the buffer that will hold the file data until it is ACKed */
+
+  memset(&state, 0, sizeof(struct sendfile_s));
+  state.snd_buffer = (FAR uint8_t *)kmalloc(CONFIG_NET_SENDFILE_BUFSIZE);
+  if (!state.snd_buffer)
+    {
+      (void)file_seek(infile, startpos, SEEK_SET);
+      err = ENOMEM;
+      goto errout;
+    }
+
+  /* Set the socket state to sending */
+
+  psock->s_flags = _SS_SETSTATE(psock->s_flags, _SF_SEND);
+
+  /* Initialize the state structure.  This is done with interrupts
+   * disabled because we don't want anything to happen until we
+   * are ready.
+   */
+
+  save                = uip_lock();
+  (void)sem_init(&state.snd_sem, 0, 0); /* Doesn't really fail */
+  state.snd_sock      = psock;            /* Socket descriptor to use */
+  state.snd_flen      = count;            /* Number of bytes to send */
+  state.snd_refill    = true;             /* Nothing read from the file yet */
+
+  if (count > 0)
+    {
+      struct uip_conn *conn = (struct uip_conn*)psock->s_conn;
+
+      /* Allocate resources to receive a callback */
+
+      state.snd_cb = uip_tcpcallbackalloc(conn);
+      if (state.snd_cb)
+        {
+          /* Get the initial sequence number that will be used */
+
+          state.snd_isn         = uip_tcpgetsequence(conn->sndseq);
+
+          /* There is no outstanding, unacknowledged data after this
+           * initial sequence number.
+           */
+
+          conn->unacked         = 0;
+
+          /* Set the initial time for calculating timeouts */
+
+#if defined(CONFIG_NET_SOCKOPTS) && !defined(CONFIG_DISABLE_CLOCK)
+          state.snd_time        = clock_systimer();
+#endif
+          /* Set up the callback in the connection */
+
+          state.snd_cb->flags   = UIP_ACKDATA|UIP_REXMIT|UIP_POLL|UIP_CLOSE|UIP_ABORT|UIP_TIMEDOUT;
+          state.snd_cb->priv    = (void*)&state;
+          state.snd_cb->event   = sendfile_interrupt;
+
+          /* Read the file one buffer at a time.  Each time that the
+           * previous buffer has been sent and ACKed, the network callback
+           * wakes us to read the next one.
+           */
+
+          while (state.snd_sent >= 0 && state.snd_acked < state.snd_flen)
+            {
+              nbytes = state.snd_flen - state.snd_acked;
+              if (nbytes > CONFIG_NET_SENDFILE_BUFSIZE)
+                {
+                  nbytes = CONFIG_NET_SENDFILE_BUFSIZE;
+                }
+
+              /* Read the file with the network unlocked.  The callback
+               * does not use the buffer while snd_refill is set.
+               */
+
+              uip_unlock(save);
+              nread = file_read(infile, state.snd_buffer, nbytes);
+              save  = uip_lock();
+
+              if (nread < 0)
+                {
+                  if (state.snd_sent >= 0)
+                    {
+                      state.snd_sent = nread;
+                    }
+
+                  break;
+                }
+              else if (nread == 0 || state.snd_sent < 0)
+                {
+                  /* End of file (or the connection was lost while we were
+                   * reading).  Nothing more will be sent.
+                   */
+
+                  state.snd_flen = state.snd_acked;
+                  break;
+                }
+
+              /* Hand the new data to the network callback */
+
+              state.snd_bufpos = state.snd_acked;
+              state.snd_buflen = nread;
+              state.snd_refill = false;
+
+              /* Notify the device driver of the availaibilty of TX data */
+
+              netdev_txnotify(&conn->ripaddr);
+
+              /* Wait for the buffer to be ACKed or an error to occur:
+               * NOTES: (1) uip_lockedwait will also terminate if a signal
+               * is received, (2) interrupts may be disabled!  They will be
+               * re-enabled while the task sleeps and automatically
+               * re-enabled when the task restarts.
+               */
+
+              ret = uip_lockedwait(&state.snd_sem);
+              if (ret < 0)
+                {
+                  break;
+                }
+            }
+
+          /* Make sure that no further interrupts are processed */
+
+          uip_tcpcallbackfree(conn, state.snd_cb);
+        }
+    }
+
+  sem_destroy(&state.snd_sem);
+  uip_unlock(save);
+  kfree(state.snd_buffer);
+
+  /* Set the socket state to idle */
+
+  psock->s_flags = _SS_SETSTATE(psock->s_flags, _SF_IDLE);
+
+  /* Update the file position:  If an offset was provided, return the new
+   * offset and restore the original file position; otherwise, leave the
+   * file positioned after the last byte that was ACKed.
+   */
+
+  if (state.snd_sent >= 0)
+    {
+      off_t endpos = foffset + state.snd_acked;
+
+      if (offset)
+        {
+          *offset = endpos;
+          (void)file_seek(infile, startpos, SEEK_SET);
+        }
+      else
+        {
+          (void)file_seek(infile, endpos, SEEK_SET);
+        }
+    }
+
+  /* Check for a errors.  Errors are signaled by negative errno values
+   * for the send length
+   */
+
+  if (state.snd_sent < 0)
+    {
+      err = (int)-state.snd_sent;
+      goto errout;
+    }
+
+  /* If uip_lockedwait failed, then we were probably reawakened by a signal.
+   * In this case, uip_lockedwait will have set errno appropriately.
+   */
+
+  if (ret < 0)
+    {
+      err = -ret;
+      goto errout;
+    }
+
+  /* Return the number of bytes actually sent and acknowledged */
+
+  return state.snd_acked;
+
+errout:
+  set_errno(err);
+  return ERROR;
+}
+
+#endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_SENDFILE */
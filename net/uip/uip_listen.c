@@ -46,12 +46,43 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <errno.h>
 #include <debug.h>
 
 #include <nuttx/net/uip/uipopt.h>
 
 #include "uip_internal.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Listeners are found through a small hash table indexed by the local port
+ * number.  The number of buckets is a power of two that is at least as
+ * large as the number of listener slots so that chains are short.
+ */
+
+#if CONFIG_NET_MAX_LISTENPORTS > 254
+#  error "CONFIG_NET_MAX_LISTENPORTS is too large"
+#elif CONFIG_NET_MAX_LISTENPORTS > 64
+#  define UIP_LISTEN_NBUCKETS 128
+#elif CONFIG_NET_MAX_LISTENPORTS > 32
+#  define UIP_LISTEN_NBUCKETS 64
+#elif CONFIG_NET_MAX_LISTENPORTS > 16
+#  define UIP_LISTEN_NBUCKETS 32
+#elif CONFIG_NET_MAX_LISTENPORTS > 8
+#  define UIP_LISTEN_NBUCKETS 16
+#else
+#  define UIP_LISTEN_NBUCKETS 8
+#endif
+
+#define UIP_LISTEN_NOSLOT 0xff
+
+/* The port number is in network byte order; fold both bytes in */
+
+#define UIP_LISTEN_HASH(p) \
+  ((((p) >> 8) ^ (p)) & (UIP_LISTEN_NBUCKETS - 1))
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -60,6 +91,13 @@
 
 static struct uip_conn *uip_listenports[CONFIG_NET_MAX_LISTENPORTS];
 
+/* Hash buckets (the index of the first slot in each chain) and the chain
+ * links (the index of the next slot in the same chain).
+ */
+
+static uint8_t g_listenhash[UIP_LISTEN_NBUCKETS];
+static uint8_t g_listennext[CONFIG_NET_MAX_LISTENPORTS];
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -77,18 +115,19 @@ static struct uip_conn *uip_listenports[CONFIG_NET_MAX_LISTENPORTS];
 
 struct uip_conn *uip_findlistener(uint16_t portno)
 {
+  FAR struct uip_conn *conn;
   int ndx;
 
-  /* Examine each connection structure in each slot of the listener list */
+  /* Examine only the listener slots in this port's hash chain */
 
-  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+  for (ndx = g_listenhash[UIP_LISTEN_HASH(portno)];
+       ndx != UIP_LISTEN_NOSLOT;
+       ndx = g_listennext[ndx])
     {
-      /* Is this slot assigned?  If so, does the connection have the same
-       * local port number?
-       */
+      /* Does the connection have the same local port number? */
 
-      struct uip_conn *conn = uip_listenports[ndx];
-      if (conn && conn->lport == portno)
+      conn = uip_listenports[ndx];
+      if (conn->lport == portno)
         {
           /* Yes.. we found a listener on this port */
 
@@ -123,6 +162,12 @@ void uip_listeninit(void)
   for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
     {
       uip_listenports[ndx] = NULL;
+      g_listennext[ndx]    = UIP_LISTEN_NOSLOT;
+    }
+
+  for (ndx = 0; ndx < UIP_LISTEN_NBUCKETS; ndx++)
+    {
+      g_listenhash[ndx] = UIP_LISTEN_NOSLOT;
     }
 }
 
@@ -139,15 +184,24 @@ void uip_listeninit(void)
 
 int uip_unlisten(struct uip_conn *conn)
 {
+  FAR uint8_t *pndx;
   uip_lock_t flags;
-  int ndx;
   int ret = -EINVAL;
 
   flags = uip_lock();
-  for (ndx = 0; ndx < CONFIG_NET_MAX_LISTENPORTS; ndx++)
+
+  /* Find the slot in the hash chain for this port and unlink it */
+
+  for (pndx = &g_listenhash[UIP_LISTEN_HASH(conn->lport)];
+       *pndx != UIP_LISTEN_NOSLOT;
+       pndx = &g_listennext[*pndx])
     {
-      if (uip_listenports[ndx] == conn)
+      if (uip_listenports[*pndx] == conn)
         {
+          int ndx = *pndx;
+
+          *pndx                = g_listennext[ndx];
+          g_listennext[ndx]    = UIP_LISTEN_NOSLOT;
           uip_listenports[ndx] = NULL;
           ret = OK;
           break;
@@ -172,6 +226,7 @@ int uip_unlisten(struct uip_conn *conn)
 int uip_listen(struct uip_conn *conn)
 {
   uip_lock_t flags;
+  int hash;
   int ndx;
   int ret;
 
@@ -205,9 +260,12 @@ int uip_listen(struct uip_conn *conn)
 
           if (!uip_listenports[ndx])
             {
-              /* Yes.. we found it */
+              /* Yes.. we found it.  Add it to the head of the hash chain */
 
+              hash                 = UIP_LISTEN_HASH(conn->lport);
               uip_listenports[ndx] = conn;
+              g_listennext[ndx]    = g_listenhash[hash];
+              g_listenhash[hash]   = ndx;
               ret = OK;
               break;
             }
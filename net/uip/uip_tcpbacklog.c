@@ -40,10 +40,12 @@
 #include <nuttx/net/uip/uipopt.h>
 #if defined(CONFIG_NET) && defined(CONFIG_NET_TCP) && defined(CONFIG_NET_TCPBACKLOG)
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <queue.h>
+#include <errno.h>
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
@@ -52,6 +54,16 @@
 
 #include "uip_internal.h"
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Backlogged connections are linked through their blnode field */
+
+#define BLNODE_OFFSET  offsetof(struct uip_conn, blnode)
+#define BLNODE2CONN(n) \
+  ((FAR struct uip_conn *)((FAR uint8_t *)(n) - BLNODE_OFFSET))
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
@@ -60,6 +72,36 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Function: uip_backlogunlink
+ *
+ * Description:
+ *   Remove a connection from whichever backlog queue it is in and update
+ *   the counts.  This is an O(1) operation.
+ *
+ * Assumptions:
+ *   Called with interrupts disabled
+ *
+ ****************************************************************************/
+
+static void uip_backlogunlink(FAR struct uip_backlog_s *bls,
+                              FAR struct uip_conn *blconn)
+{
+  if (blconn->blhalfopen)
+    {
+      dq_rem(&blconn->blnode, &bls->bl_halfopen);
+      bls->bl_nhalfopen--;
+    }
+  else
+    {
+      dq_rem(&blconn->blnode, &bls->bl_pending);
+      bls->bl_npending--;
+    }
+
+  blconn->blparent   = NULL;
+  blconn->blhalfopen = false;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -69,7 +111,9 @@
  *
  * Description:
  *   Called from the listen() logic to setup the backlog as specified in the
- *   the listen arguments.
+ *   the listen arguments.  The backlog holds at most 'nblg' connections,
+ *   counting both those that are still waiting for the peer to ACK our
+ *   SYNACK (half-open) and those that are fully established.
  *
  * Assumptions:
  *   Called from normal user code. Interrupts may be disabled.
@@ -78,12 +122,8 @@
 
 int uip_backlogcreate(FAR struct uip_conn *conn, int nblg)
 {
-  FAR struct uip_backlog_s     *bls = NULL;
-  FAR struct uip_blcontainer_s *blc;
+  FAR struct uip_backlog_s *bls = NULL;
   uip_lock_t flags;
-  int size;
-  int offset;
-  int i;
 
   nllvdbg("conn=%p nblg=%d\n", conn, nblg);
 
@@ -94,40 +134,21 @@ int uip_backlogcreate(FAR struct uip_conn *conn, int nblg)
     }
 #endif
 
-  /* Then allocate the backlog as requested */
+  /* Then allocate the backlog as requested.  The pending connections are
+   * linked through the connection structures themselves so only the
+   * backlog header is needed.
+   */
 
   if (nblg > 0)
     {
-      /* Align the list of backlog structures to 32-bit boundaries.  This
-       * may be excessive on 24-16-bit address machines; and insufficient
-       * on 64-bit address machines -- REVISIT
-       */
-
-      offset = (sizeof(struct uip_backlog_s) + 3) & ~3;
-
-      /* Then determine the full size of the allocation include the
-       * uip_backlog_s, a pre-allocated array of struct uip_blcontainer_s
-       * and alignement padding
-       */
-
-      size = offset + nblg * sizeof(struct uip_blcontainer_s);
-
-      /* Then allocate that much */
-
-      bls = (FAR struct uip_backlog_s *)kzalloc(size);
+      bls = (FAR struct uip_backlog_s *)kzalloc(sizeof(struct uip_backlog_s));
       if (!bls)
         {
           nlldbg("Failed to allocate backlog\n");
           return -ENOMEM;
         }
 
-      /* Then add all of the pre-allocated containers to the free list */
-
-      blc = (FAR struct uip_blcontainer_s*)(((FAR uint8_t*)bls) + offset);
-      for (i = 0; i < nblg; i++)
-        {
-          sq_addfirst(&blc->bc_node, &bls->bl_free);
-        }
+      bls->bl_max = nblg > UINT16_MAX ? UINT16_MAX : nblg;
     }
 
   /* Destroy any existing backlog (shouldn't be any) */
@@ -164,9 +185,9 @@ int uip_backlogcreate(FAR struct uip_conn *conn, int nblg)
 
 int uip_backlogdestroy(FAR struct uip_conn *conn)
 {
-  FAR struct uip_backlog_s     *blg;
-  FAR struct uip_blcontainer_s *blc;
-  FAR struct uip_conn          *blconn;
+  FAR struct uip_backlog_s *blg;
+  FAR struct uip_conn      *blconn;
+  FAR dq_entry_t           *node;
 
   nllvdbg("conn=%p\n", conn);
 
@@ -188,18 +209,17 @@ int uip_backlogdestroy(FAR struct uip_conn *conn)
 
        /* Handle any pending connections in the backlog */
 
-       while ((blc = (FAR struct uip_blcontainer_s*)sq_remfirst(&blg->bl_pending)) != NULL)
+       while ((node = dq_peek(&blg->bl_pending)) != NULL ||
+              (node = dq_peek(&blg->bl_halfopen)) != NULL)
          {
-           blconn = blc->bc_conn;
-           if (blconn)
-             {
-               /* REVISIT -- such connections really need to be gracefully closed */
-
-               blconn->blparent = NULL;
-               blconn->backlog  = NULL;
-               blconn->crefs    = 0;
-               uip_tcpfree(blconn);
-             }
+           blconn = BLNODE2CONN(node);
+           uip_backlogunlink(blg, blconn);
+
+           /* REVISIT -- such connections really need to be gracefully closed */
+
+           blconn->backlog  = NULL;
+           blconn->crefs    = 0;
+           uip_tcpfree(blconn);
          }
 
        /* Then free the entire backlog structure */
@@ -216,7 +236,9 @@ int uip_backlogdestroy(FAR struct uip_conn *conn)
  * Description:
  *  Called uip_listen when a new connection is made with a listener socket
  *  but when there is no accept() in place to receive the connection.  This
- *  function adds the new connection to the backlog.
+ *  function adds the new connection to the tail of the half-open queue.  It
+ *  will be moved to the established queue by uip_backlogconnected() when
+ *  the peer ACKs our SYNACK.
  *
  * Assumptions:
  *   Called from the interrupt level with interrupts disabled
@@ -225,8 +247,7 @@ int uip_backlogdestroy(FAR struct uip_conn *conn)
 
 int uip_backlogadd(FAR struct uip_conn *conn, FAR struct uip_conn *blconn)
 {
-  FAR struct uip_backlog_s     *bls;
-  FAR struct uip_blcontainer_s *blc;
+  FAR struct uip_backlog_s *bls;
   int ret = -EINVAL;
 
   nllvdbg("conn=%p blconn=%p\n", conn, blconn);
@@ -241,30 +262,63 @@ int uip_backlogadd(FAR struct uip_conn *conn, FAR struct uip_conn *blconn)
   bls = conn->backlog;
   if (bls && blconn)
     {
-       /* Allocate a container for the connection from the free list */
+       /* Is there space in the backlog? */
 
-       blc = (FAR struct uip_blcontainer_s *)sq_remfirst(&bls->bl_free);
-       if (!blc)
+       if (bls->bl_nhalfopen + bls->bl_npending >= bls->bl_max)
          {
-           nlldbg("Failed to allocate container\n");
+           nlldbg("Backlog full: halfopen=%d pending=%d\n",
+                  bls->bl_nhalfopen, bls->bl_npending);
            ret = -ENOMEM;
          }
        else
          {
-           /* Save the connection reference in the container and put the
-            * container at the end of the pending connection list (FIFO).
-            */
+           /* Put the connection at the end of the half-open list (FIFO) */
 
-           blc->bc_conn = blconn;
-           sq_addlast(&blc->bc_node, &bls->bl_pending);
+           blconn->blparent   = conn;
+           blconn->blhalfopen = true;
+           dq_addlast(&blconn->blnode, &bls->bl_halfopen);
+           bls->bl_nhalfopen++;
            ret = OK;
          }
     }
+
   return ret;
 }
 
 /****************************************************************************
- * Function: uip_backlogremove
+ * Function: uip_backlogconnected
+ *
+ * Description:
+ *  Called from the TCP input logic when a backlogged connection receives
+ *  an ACK.  If the connection is still half-open, it is moved to the tail
+ *  of the established queue where accept() will find it.
+ *
+ * Assumptions:
+ *   Called from the interrupt level with interrupts disabled
+ *
+ ****************************************************************************/
+
+void uip_backlogconnected(FAR struct uip_conn *blconn)
+{
+  FAR struct uip_backlog_s *bls;
+
+  if (blconn->blhalfopen && blconn->blparent)
+    {
+      bls = blconn->blparent->backlog;
+      if (bls)
+        {
+          dq_rem(&blconn->blnode, &bls->bl_halfopen);
+          bls->bl_nhalfopen--;
+
+          blconn->blhalfopen = false;
+          dq_addlast(&blconn->blnode, &bls->bl_pending);
+          bls->bl_npending++;
+        }
+    }
+}
+
+/****************************************************************************
+ * Function: uip_backlogavailable
  *
  * Description:
  *  Called from poll().  Before waiting for a new connection, poll will
@@ -278,7 +332,9 @@ int uip_backlogadd(FAR struct uip_conn *conn, FAR struct uip_conn *blconn)
 #ifndef CONFIG_DISABLE_POLL
 bool uip_backlogavailable(FAR struct uip_conn *conn)
 {
-  return (conn && conn->backlog && !sq_empty(&conn->backlog->bl_pending));
+  return (conn && conn->backlog &&
+          (!dq_empty(&conn->backlog->bl_pending) ||
+           !dq_empty(&conn->backlog->bl_halfopen)));
 }
 #endif
 
@@ -289,6 +345,11 @@ bool uip_backlogavailable(FAR struct uip_conn *conn)
  *  Called from accept().  Before waiting for a new connection, accept will
  *  call this API to see if there are pending connections in the backlog.
  *
+ *  The oldest established connection is returned first.  If there are no
+ *  established connections, the oldest half-open connection is returned:
+ *  uIP already treats a backlogged connection as ESTABLISHED once it has
+ *  sent the SYNACK, so it is usable even before the peer's ACK arrives.
+ *
  * Assumptions:
  *   Called from normal user code, but with interrupts disabled,
  *
@@ -296,9 +357,9 @@ bool uip_backlogavailable(FAR struct uip_conn *conn)
 
 struct uip_conn *uip_backlogremove(FAR struct uip_conn *conn)
 {
-  FAR struct uip_backlog_s     *bls;
-  FAR struct uip_blcontainer_s *blc;
-  FAR struct uip_conn          *blconn = NULL;
+  FAR struct uip_backlog_s *bls;
+  FAR dq_entry_t           *node;
+  FAR struct uip_conn      *blconn = NULL;
 
 #ifdef CONFIG_DEBUG
   if (!conn)
@@ -310,20 +371,20 @@ struct uip_conn *uip_backlogremove(FAR struct uip_conn *conn)
   bls = conn->backlog;
   if (bls)
     {
-       /* Remove the a container at the head of the pending connection list
-        * (FIFO)
+       /* Remove the connection at the head of the established connection
+        * list (FIFO), or of the half-open list if there is none.
         */
 
-       blc = (FAR struct uip_blcontainer_s *)sq_remfirst(&bls->bl_pending);
-       if (blc)
+       node = dq_peek(&bls->bl_pending);
+       if (!node)
          {
-           /* Extract the connection reference from the container and put
-            * container in the free list
-            */
+           node = dq_peek(&bls->bl_halfopen);
+         }
 
-           blconn       = blc->bc_conn;
-           blc->bc_conn = NULL;
-           sq_addlast(&blc->bc_node, &bls->bl_free);
+       if (node)
+         {
+           blconn = BLNODE2CONN(node);
+           uip_backlogunlink(bls, blconn);
          }
     }
 
@@ -337,7 +398,8 @@ struct uip_conn *uip_backlogremove(FAR struct uip_conn *conn)
  * Description:
  *  Called from uip_tcpfree() when a connection is freed that this also
  *  retained in the pending connectino list of a listener.  We simply need
- *  to remove the defunct connecton from the list.
+ *  to remove the defunct connecton from the list.  Because the lists are
+ *  doubly linked through the connection structure, this is O(1).
  *
  * Assumptions:
  *   Called from the interrupt level with interrupts disabled
@@ -346,9 +408,7 @@ struct uip_conn *uip_backlogremove(FAR struct uip_conn *conn)
 
 int uip_backlogdelete(FAR struct uip_conn *conn, FAR struct uip_conn *blconn)
 {
-  FAR struct uip_backlog_s     *bls;
-  FAR struct uip_blcontainer_s *blc;
-  FAR struct uip_blcontainer_s *prev;
+  FAR struct uip_backlog_s *bls;
 
   nllvdbg("conn=%p blconn=%p\n", conn, blconn);
 
@@ -360,45 +420,14 @@ int uip_backlogdelete(FAR struct uip_conn *conn, FAR struct uip_conn *blconn)
 #endif
 
   bls = conn->backlog;
-  if (bls)
+  if (bls && blconn->blparent == conn)
     {
-       /* Find the container hold the connection */
-
-       for (blc = (FAR struct uip_blcontainer_s *)sq_peek(&bls->bl_pending), prev = NULL;
-            blc;
-            prev = blc, blc = (FAR struct uip_blcontainer_s *)sq_next(&blc->bc_node))
-         {
-            if (blc->bc_conn == blconn)
-              {
-                if (prev)
-                  {
-                    /* Remove the a container from the middle of the list of
-                     * pending connections
-                      */
-
-                    (void)sq_remafter(&prev->bc_node, &bls->bl_pending);
-                  }
-                else
-                  {
-                    /* Remove the a container from the head of the list of
-                     * pending connections
-                     */
-
-                    (void)sq_remfirst(&bls->bl_pending);
-                  }
-
-                /* Put container in the free list */
-
-                blc->bc_conn = NULL;
-                sq_addlast(&blc->bc_node, &bls->bl_free);
-                return OK;
-              }
-          }
-
-        nlldbg("Failed to find pending connection\n");
-        return -EINVAL;
+      uip_backlogunlink(bls, blconn);
+      return OK;
     }
-  return OK;
+
+  nlldbg("Failed to find pending connection\n");
+  return -EINVAL;
 }
 
 #endif /* CONFIG_NET && CONFIG_NET_TCP && CONFIG_NET_TCPBACKLOG */
@@ -431,6 +431,17 @@ found:
 
        flags |= UIP_ACKDATA;
 
+#ifdef CONFIG_NET_TCPBACKLOG
+       /* If this is a backlogged connection that was waiting for the ACK of
+        * its SYNACK, then it is now fully established.
+        */
+
+       if (conn->blparent)
+         {
+           uip_backlogconnected(conn);
+         }
+#endif
+
        /* Reset the retransmission timer. */
 
        conn->timer = conn->rto;
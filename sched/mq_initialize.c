@@ -69,13 +69,6 @@ struct mq_des_block_s
 
 sq_queue_t  g_msgqueues;
 
-/* The g_msgfree is a list of messages that are available for general
- * use.  The number of messages in this list is a system configuration
- * item.
- */
-
-sq_queue_t  g_msgfree;
-
 /* The g_msgfreeInt is a list of messages that are reserved for use by
  * interrupt handlers.
  */
@@ -93,12 +86,6 @@ sq_queue_t  g_desfree;
  * Private Variables
  ************************************************************************/
 
-/* g_msgalloc is a pointer to the start of the allocated block of
- * messages.
- */
-
-static mqmsg_t    *g_msgalloc;
-
 /* g_msgfreeirqalloc is a pointer to the start of the allocated block of
  * messages.
  */
@@ -127,26 +114,27 @@ static sq_queue_t  g_desalloc;
 static mqmsg_t *mq_msgblockalloc(sq_queue_t *queue, uint16_t nmsgs,
                                  uint8_t alloc_type)
 {
-  mqmsg_t *mqmsgblock;
+  FAR uint8_t *mqmsgblock;
 
-  /* The g_msgfree must be loaded at initialization time to hold the
+  /* The g_msgfreeirq must be loaded at initialization time to hold the
    * configured number of messages.
    */
 
-  mqmsgblock = (mqmsg_t*)kmalloc(sizeof(mqmsg_t) * nmsgs);
+  mqmsgblock = (FAR uint8_t*)kmalloc(MQ_MSG_SIZE(MQ_MAX_BYTES) * nmsgs);
   if (mqmsgblock)
     {
-      mqmsg_t *mqmsg = mqmsgblock;
-      int      i;
+      FAR mqmsg_t *mqmsg;
+      int          i;
 
       for (i = 0; i < nmsgs; i++)
         {
+          mqmsg = (FAR mqmsg_t*)&mqmsgblock[i * MQ_MSG_SIZE(MQ_MAX_BYTES)];
           mqmsg->type = alloc_type;
-          sq_addlast((FAR sq_entry_t*)mqmsg++, queue);
+          sq_addlast((FAR sq_entry_t*)mqmsg, queue);
         }
     }
 
-  return mqmsgblock;
+  return (FAR mqmsg_t*)mqmsgblock;
 }
 
 /************************************************************************
@@ -175,18 +163,14 @@ void mq_initialize(void)
 
   sq_init(&g_msgqueues);
 
-  /* Initialize the message free lists */
+  /* Initialize the message free lists.  Each message queue holds the
+   * storage for its own messages; only the messages reserved for
+   * interrupt handlers are allocated here.
+   */
 
-  sq_init(&g_msgfree);
   sq_init(&g_msgfreeirq);
   sq_init(&g_desalloc);
 
-  /* Allocate a block of messages for general use */
-
-  g_msgalloc =
-    mq_msgblockalloc(&g_msgfree, CONFIG_PREALLOC_MQ_MSGS,
-                     MQ_ALLOC_FIXED);
-
   /* Allocate a block of messages for use exclusively by
    * interrupt handlers
    */
@@ -44,6 +44,7 @@
 #include <nuttx/compiler.h>
 
 #include <sys/types.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <limits.h>
@@ -70,37 +71,52 @@
 #define NUM_MSG_DESCRIPTORS 24
 
 /* This defines the number of messages to set aside for exclusive use by
- * interrupt handlers
+ * interrupt handlers.  These are used only if the message queue has no free
+ * message slot and can hold messages of up to MQ_MAX_BYTES.
  */
 
 #define NUM_INTERRUPT_MSGS   8
 
+/* Size of the message header and of a message slot holding up to 'n' bytes
+ * of payload.  Slots are aligned so that they can follow one another in
+ * the storage of the message queue.
+ */
+
+#define MQ_MSG_HDRSIZE  offsetof(mqmsg_t, mail)
+#define MQ_ALIGN(n)     (((n) + sizeof(uintptr_t) - 1) & ~(sizeof(uintptr_t) - 1))
+#define MQ_MSG_SIZE(n)  MQ_ALIGN(MQ_MSG_HDRSIZE + (n))
+
+/* Get the message from a pointer to its payload (loaned messages) */
+
+#define MQ_MAIL2MSG(p)  ((FAR mqmsg_t*)((FAR uint8_t*)(p) - MQ_MSG_HDRSIZE))
+
 /****************************************************************************
  * Global Type Declarations
  ****************************************************************************/
 
 enum mqalloc_e
 {
-  MQ_ALLOC_FIXED = 0,  /* pre-allocated; never freed */
-  MQ_ALLOC_DYN,        /* dynamically allocated; free when unused */
+  MQ_ALLOC_QUEUE = 0,  /* Slot in the storage of the message queue */
   MQ_ALLOC_IRQ         /* Preallocated, reserved for interrupt handling */
 };
 
 typedef enum mqalloc_e mqalloc_t;
 
-/* This structure describes one buffered POSIX message. */
+/* This structure describes one buffered POSIX message.  Queued messages are
+ * kept in one FIFO sub-queue per priority.  The first message of each
+ * sub-queue also holds the sub-queue tail and the link to the first
+ * message of the next lower priority sub-queue.
+ */
 
 struct mqmsg
 {
-  FAR struct mqmsg  *next;    /* Forward link to next message */
+  FAR struct mqmsg  *next;    /* Next message (same priority or free list) */
+  FAR struct mqmsg  *nextprio; /* Sub-queue head: next lower priority */
+  FAR struct mqmsg  *tail;    /* Sub-queue head: last message */
   uint8_t      type;          /* (Used to manage allocations) */
   uint8_t      priority;      /* priority of message          */
-#if MQ_MAX_BYTES < 256
-  uint8_t      msglen;        /* Message data length          */
-#else
   uint16_t     msglen;        /* Message data length          */
-#endif
-  uint8_t      mail[MQ_MAX_BYTES]; /* Message data            */
+  uint8_t      mail[1];       /* Message data (variable size) */
 };
 
 typedef struct mqmsg mqmsg_t;
@@ -121,12 +137,6 @@ extern "C"
 
 EXTERN sq_queue_t  g_msgqueues;
 
-/* The g_msgfree is a list of messages that are available for general use.
- * The number of messages in this list is a system configuration item.
- */
-
-EXTERN sq_queue_t  g_msgfree;
-
 /* The g_msgfreeInt is a list of messages that are reserved for use by
  * interrupt handlers.
  */
@@ -151,7 +161,7 @@ void mq_desblockalloc(void);
 
 mqd_t mq_descreate(FAR struct tcb_s* mtcb, FAR msgq_t* msgq, int oflags);
 FAR msgq_t  *mq_findnamed(const char *mq_name);
-void mq_msgfree(FAR mqmsg_t *mqmsg);
+void mq_msgfree(FAR msgq_t *msgq, FAR mqmsg_t *mqmsg);
 void mq_msgqfree(FAR msgq_t *msgq);
 
 /* mq_waitirq.c ************************************************************/
@@ -167,7 +177,7 @@ ssize_t mq_doreceive(mqd_t mqdes, mqmsg_t *mqmsg, void *ubuffer, int *prio);
 /* mq_sndinternal.c ********************************************************/
 
 int mq_verifysend(mqd_t mqdes, const void *msg, size_t msglen, int prio);
-FAR mqmsg_t *mq_msgalloc(void);
+FAR mqmsg_t *mq_msgalloc(FAR msgq_t *msgq, size_t msglen);
 int mq_waitsend(mqd_t mqdes);
 int mq_dosend(mqd_t mqdes, FAR mqmsg_t *mqmsg, const void *msg,
               size_t msglen, int prio);
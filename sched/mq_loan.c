@@ -0,0 +1,272 @@
+/****************************************************************************
+ * sched/mq_loan.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/************************************************************************
+ * Included Files
+ ************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <mqueue.h>
+#include <debug.h>
+#include <nuttx/arch.h>
+#include <nuttx/mqueue.h>
+
+#include "os_internal.h"
+#include "mq_internal.h"
+
+#ifdef CONFIG_MQ_LOAN
+
+/************************************************************************
+ * Pre-processor Definitions
+ ************************************************************************/
+
+/************************************************************************
+ * Private Type Declarations
+ ************************************************************************/
+
+/************************************************************************
+ * Global Variables
+ ************************************************************************/
+
+/************************************************************************
+ * Private Variables
+ ************************************************************************/
+
+/************************************************************************
+ * Private Functions
+ ************************************************************************/
+
+/************************************************************************
+ * Public Functions
+ ************************************************************************/
+
+/************************************************************************
+ * Name: mq_loan
+ *
+ * Description:
+ *   Reserve a free message slot of the message queue for the caller.
+ *   The caller builds the message in place and then sends it with
+ *   mq_sendloan() (or gives it back unsent with mq_returnloan()).  If
+ *   the message queue is full, this waits for a free slot unless
+ *   O_NONBLOCK was set for the message queue description.
+ *
+ * Parameters:
+ *   mqdes - Message queue descriptor
+ *
+ * Return Value:
+ *   A pointer to a buffer of mq_msgsize bytes.  On failure, NULL is
+ *   returned and errno is set appropriately:
+ *
+ *   EINVAL   mqdes is NULL.
+ *   EPERM    Message queue opened not opened for writing.
+ *   EAGAIN   The queue was full, and the O_NONBLOCK flag was set for the
+ *            message queue description referred to by mqdes.
+ *   EINTR    The call was interrupted by a signal handler.
+ *
+ ************************************************************************/
+
+FAR void *mq_loan(mqd_t mqdes)
+{
+  FAR mqmsg_t *mqmsg = NULL;
+  irqstate_t saved_state;
+
+  DEBUGASSERT(up_interrupt_context() == false);
+
+  if (!mqdes)
+    {
+      set_errno(EINVAL);
+      return NULL;
+    }
+
+  if ((mqdes->oflags & O_WROK) == 0)
+    {
+      set_errno(EPERM);
+      return NULL;
+    }
+
+  /* Wait for a free message slot with interrupts disabled because messages
+   * can be sent from interrupt level.
+   */
+
+  sched_lock();
+  saved_state = irqsave();
+  if (mqdes->msgq->msgfree != NULL || mq_waitsend(mqdes) == OK)
+    {
+      mqmsg = mq_msgalloc(mqdes->msgq, mqdes->msgq->maxmsgsize);
+    }
+
+  irqrestore(saved_state);
+  sched_unlock();
+
+  return mqmsg ? mqmsg->mail : NULL;
+}
+
+/************************************************************************
+ * Name: mq_sendloan
+ *
+ * Description:
+ *   Send a message that was built in place in a buffer obtained from
+ *   mq_loan().  No data is copied.  The buffer may not be used by the
+ *   caller afterward.
+ *
+ * Parameters:
+ *   mqdes - Message queue descriptor
+ *   buffer - The buffer returned by mq_loan()
+ *   msglen - The length of the message in bytes
+ *   prio - The priority of the message
+ *
+ * Return Value:
+ *   On success, 0 (OK) is returned.  On failure, -1 (ERROR) is returned
+ *   and errno is set as for mq_send().  On failure, the buffer remains
+ *   loaned to the caller.
+ *
+ ************************************************************************/
+
+int mq_sendloan(mqd_t mqdes, FAR void *buffer, size_t msglen, int prio)
+{
+  int ret;
+
+  if (mq_verifysend(mqdes, buffer, msglen, prio) != OK)
+    {
+      return ERROR;
+    }
+
+  sched_lock();
+  ret = mq_dosend(mqdes, MQ_MAIL2MSG(buffer), buffer, msglen, prio);
+  sched_unlock();
+  return ret;
+}
+
+/************************************************************************
+ * Name: mq_receiveloan
+ *
+ * Description:
+ *   Receive the oldest of the highest priority messages from the message
+ *   queue without copying it.  The message is returned in place; the
+ *   caller must give it back with mq_returnloan() when done with it.  The
+ *   message slot remains in use (and may keep senders waiting) until then.
+ *
+ * Parameters:
+ *   mqdes - Message queue descriptor
+ *   buffer - Location to return the address of the message
+ *   prio - If not NULL, the location to store message priority.
+ *
+ * Return Value:
+ *   The length of the received message.  On failure, -1 (ERROR) is
+ *   returned and errno is set as for mq_receive().
+ *
+ ************************************************************************/
+
+ssize_t mq_receiveloan(mqd_t mqdes, FAR void **buffer, FAR int *prio)
+{
+  FAR mqmsg_t *mqmsg;
+  irqstate_t saved_state;
+  ssize_t ret = ERROR;
+
+  DEBUGASSERT(up_interrupt_context() == false);
+
+  if (!mqdes || !buffer)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  if (mq_verifyreceive(mqdes, buffer, mqdes->msgq->maxmsgsize) != OK)
+    {
+      return ERROR;
+    }
+
+  /* Get the next mesage from the message queue.  As for mq_receive(),
+   * pre-emption and interrupts are disabled while waiting.
+   */
+
+  sched_lock();
+  saved_state = irqsave();
+  mqmsg = mq_waitreceive(mqdes);
+  irqrestore(saved_state);
+
+  if (mqmsg)
+    {
+      *buffer = mqmsg->mail;
+      if (prio)
+        {
+          *prio = mqmsg->priority;
+        }
+
+      ret = mqmsg->msglen;
+    }
+
+  sched_unlock();
+  return ret;
+}
+
+/************************************************************************
+ * Name: mq_returnloan
+ *
+ * Description:
+ *   Give back a buffer obtained from mq_receiveloan() or an unsent buffer
+ *   obtained from mq_loan().  The message slot becomes free and a task
+ *   waiting for the message queue to become not full is awakened.
+ *
+ * Parameters:
+ *   mqdes - Message queue descriptor
+ *   buffer - The loaned buffer
+ *
+ * Return Value:
+ *   0 (OK) or -1 (ERROR) with errno set to EINVAL if mqdes or buffer is
+ *   NULL.
+ *
+ ************************************************************************/
+
+int mq_returnloan(mqd_t mqdes, FAR void *buffer)
+{
+  if (!mqdes || !buffer)
+    {
+      set_errno(EINVAL);
+      return ERROR;
+    }
+
+  sched_lock();
+  mq_msgfree(mqdes->msgq, MQ_MAIL2MSG(buffer));
+  sched_unlock();
+  return OK;
+}
+
+#endif /* CONFIG_MQ_LOAN */
@@ -40,6 +40,7 @@
 #include <nuttx/config.h>
 
 #include <queue.h>
+#include <assert.h>
 #include <nuttx/arch.h>
 #include "os_internal.h"
 #include "mq_internal.h"
@@ -72,35 +73,42 @@
  * Name: mq_msgfree
  *
  * Description:
- *   The mq_msgfree function will return a message to the free pool of
- *   messages if it was a pre-allocated message. If the message was
- *   allocated dynamically it will be deallocated.
+ *   The mq_msgfree function will return a message to the free slots of
+ *   its message queue or, if the message was reserved for interrupt
+ *   handlers, to the g_msgfreeirq list.  Then it wakes up the highest
+ *   priority task waiting for the message queue to become not full.
  *
  * Inputs:
+ *   msgq  - The message queue that the message was allocated for
  *   mqmsg - message to free
  *
  * Return Value:
  *   None
  *
+ * Assumptions:
+ *   Pre-emption is disabled.
+ *
  ************************************************************************/
 
-void mq_msgfree(FAR mqmsg_t *mqmsg)
+void mq_msgfree(FAR msgq_t *msgq, FAR mqmsg_t *mqmsg)
 {
+  FAR struct tcb_s *btcb;
   irqstate_t saved_state;
 
-  /* If this is a generally available pre-allocated message,
-   * then just put it back in the free list.
+  /* Make sure we avoid concurrent access to the free lists from
+   * interrupt handlers.
    */
 
-  if (mqmsg->type == MQ_ALLOC_FIXED)
-    {
-      /* Make sure we avoid concurrent access to the free
-       * list from interrupt handlers.
-       */
+  saved_state = irqsave();
 
-      saved_state = irqsave();
-      sq_addlast((FAR sq_entry_t*)mqmsg, &g_msgfree);
-      irqrestore(saved_state);
+  /* If this is a slot of the message queue, then just put it back in
+   * the free list of the message queue.
+   */
+
+  if (mqmsg->type == MQ_ALLOC_QUEUE)
+    {
+      mqmsg->next   = msgq->msgfree;
+      msgq->msgfree = mqmsg;
     }
 
   /* If this is a message pre-allocated for interrupts,
@@ -109,26 +117,34 @@ void mq_msgfree(FAR mqmsg_t *mqmsg)
 
   else if (mqmsg->type == MQ_ALLOC_IRQ)
     {
-      /* Make sure we avoid concurrent access to the free
-       * list from interrupt handlers.
-       */
-
-      saved_state = irqsave();
       sq_addlast((FAR sq_entry_t*)mqmsg, &g_msgfreeirq);
-      irqrestore(saved_state);
-    }
-
-  /* Otherwise, deallocate it.  Note:  interrupt handlers
-   * will never deallocate messages because they will not
-   * received them.
-   */
-
-  else if (mqmsg->type == MQ_ALLOC_DYN)
-    {
-      sched_kfree(mqmsg);
     }
   else
     {
       PANIC();
     }
+
+  /* Check if any tasks are waiting for the MQ not full event. */
+
+  if (msgq->nwaitnotfull > 0)
+    {
+      /* The highest priority task that is waiting for this queue to be
+       * not-full is at the head of the queue's prioritized waitnotfull
+       * list.
+       */
+
+      btcb = (FAR struct tcb_s*)msgq->waitnotfull.head;
+
+      /* If one was found, unblock it.  NOTE:  There is a race
+       * condition here:  the queue might be full again by the
+       * time the task is unblocked
+       */
+
+      ASSERT(btcb);
+
+      msgq->nwaitnotfull--;
+      up_unblock_task(btcb);
+    }
+
+  irqrestore(saved_state);
 }
@@ -87,22 +87,29 @@
 
 void mq_msgqfree(FAR msgq_t *msgq)
 {
+  FAR mqmsg_t *band;
+  FAR mqmsg_t *nextprio;
   FAR mqmsg_t *curr;
   FAR mqmsg_t *next;
 
-  /* Deallocate any stranded messages in the message queue. */
+  /* Deallocate any stranded messages in the message queue.  Slots of the
+   * queue are part of the message queue allocation, but messages reserved
+   * for interrupt handlers must be returned.
+   */
 
-  curr = (FAR mqmsg_t*)msgq->msglist.head;
-  while (curr)
+  for (band = msgq->msghead; band; band = nextprio)
     {
-      /* Deallocate the message structure. */
-
-      next = curr->next;
-      mq_msgfree(curr);
-      curr = next;
+      nextprio = band->nextprio;
+      for (curr = band; curr; curr = next)
+        {
+          /* Deallocate the message structure. */
+
+          next = curr->next;
+          mq_msgfree(msgq, curr);
+        }
     }
 
-  /* Then deallocate the message queue itself */
+  /* Then deallocate the message queue itself (and its message slots) */
 
   sched_kfree(msgq);
 }
@@ -95,13 +95,16 @@
  *   parameters are expected:
  *
  *     1. mode_t mode (ignored), and
- *     2. struct mq_attr *attr.  The mq_maxmsg attribute
- *        is used at the time that the message queue is
- *        created to determine the maximum number of
- *        messages that may be placed in the message queue.
+ *     2. struct mq_attr *attr.  The mq_maxmsg and mq_msgsize
+ *        attributes are used at the time that the message queue
+ *        is created to determine the maximum number and size of
+ *        messages that may be placed in the message queue.  The
+ *        storage for all of these messages is allocated together
+ *        with the message queue.
  *
  * Return Value:
- *   A message queue descriptor or -1 (ERROR)
+ *   A message queue descriptor or -1 (ERROR).  errno is set to EINVAL if
+ *   the attributes of a new message queue are not valid.
  *
  * Assumptions:
  *
@@ -111,10 +114,16 @@ mqd_t mq_open(const char *mq_name, int oflags, ...)
 {
   FAR struct tcb_s *rtcb = (FAR struct tcb_s*)g_readytorun.head;
   FAR msgq_t *msgq;
+  FAR mqmsg_t *mqmsg;
   mqd_t mqdes = NULL;
   va_list arg;                  /* Points to each un-named argument */
   struct mq_attr *attr;         /* MQ creation attributes */
+  size_t hdrsize;               /* Size of the msgq_t header and name */
+  size_t slotsize;              /* Size of one message slot */
+  int maxmsgs;                  /* Number of message slots */
+  int msgsize;                  /* Maximum message size */
   int namelen;                  /* Length of MQ name */
+  int i;
 
   /* Make sure that a non-NULL name is supplied */
 
@@ -151,12 +160,46 @@ mqd_t mq_open(const char *mq_name, int oflags, ...)
 
           else if ((oflags & O_CREAT) != 0)
             {
+              /* Set up to get the optional arguments needed to create
+               * a message queue.
+               */
+
+              va_start(arg, oflags);
+              (void)va_arg(arg, mode_t); /* MQ creation mode parameter (ignored) */
+              attr = va_arg(arg, struct mq_attr*);
+              va_end(arg);
+
+              /* Get the size of the new message queue */
+
+              if (attr)
+                {
+                  maxmsgs = (int)attr->mq_maxmsg;
+                  msgsize = (int)attr->mq_msgsize;
+                }
+              else
+                {
+                  maxmsgs = MQ_MAX_MSGS;
+                  msgsize = MQ_MAX_BYTES;
+                }
+
+              if (maxmsgs <= 0 || maxmsgs > INT16_MAX ||
+                  msgsize <= 0 || msgsize > UINT16_MAX)
+                {
+                  set_errno(EINVAL);
+                  sched_unlock();
+                  return (mqd_t)ERROR;
+                }
+
               /* Allocate memory for the new message queue.  The size to
                * allocate is the size of the msgq_t header plus the size
-               * of the message queue name+1.
+               * of the message queue name+1 plus the storage for all of
+               * the messages that the queue can hold.
                */
 
-              msgq = (FAR msgq_t*)kzalloc(SIZEOF_MQ_HEADER + namelen + 1);
+              hdrsize  = MQ_ALIGN(SIZEOF_MQ_HEADER + namelen + 1);
+              slotsize = MQ_MSG_SIZE(msgsize);
+
+              msgq = (FAR msgq_t*)kzalloc(hdrsize + maxmsgs * slotsize);
               if (msgq)
                 {
                   /* Create a message queue descriptor for the TCB */
@@ -164,33 +207,20 @@ mqd_t mq_open(const char *mq_name, int oflags, ...)
                   mqdes = mq_descreate(rtcb, msgq, oflags);
                   if (mqdes)
                     {
-                      /* Set up to get the optional arguments needed to create
-                       * a message queue.
-                       */
+                      /* Initialize the new named message queue */
 
-                      va_start(arg, oflags);
-                      (void)va_arg(arg, mode_t); /* MQ creation mode parameter (ignored) */
-                      attr = va_arg(arg, struct mq_attr*);
+                      msgq->maxmsgs    = (int16_t)maxmsgs;
+                      msgq->maxmsgsize = (uint16_t)msgsize;
 
-                      /* Initialize the new named message queue */
+                      /* Put all of the message slots in the free list */
 
-                      sq_init(&msgq->msglist);
-                      if (attr)
-                        {
-                          msgq->maxmsgs = (int16_t)attr->mq_maxmsg;
-                          if (attr->mq_msgsize <= MQ_MAX_BYTES)
-                            {
-                              msgq->maxmsgsize = (int16_t)attr->mq_msgsize;
-                            }
-                          else
-                            {
-                              msgq->maxmsgsize = MQ_MAX_BYTES;
-                            }
-                        }
-                      else
+                      for (i = maxmsgs - 1; i >= 0; i--)
                         {
-                          msgq->maxmsgs = MQ_MAX_MSGS;
-                          msgq->maxmsgsize = MQ_MAX_BYTES;
+                          mqmsg = (FAR mqmsg_t*)
+                            ((FAR uint8_t*)msgq + hdrsize + i * slotsize);
+                          mqmsg->type   = MQ_ALLOC_QUEUE;
+                          mqmsg->next   = msgq->msgfree;
+                          msgq->msgfree = mqmsg;
                         }
 
                       msgq->nconnect = 1;
@@ -204,10 +234,6 @@ mqd_t mq_open(const char *mq_name, int oflags, ...)
                        */
 
                       sq_addlast((FAR sq_entry_t*)msgq, &g_msgqueues);
-
-                      /* Clean-up variable argument stuff */
-
-                      va_end(arg);
                     }
                   else
                     {
@@ -164,9 +164,9 @@ FAR mqmsg_t *mq_waitreceive(mqd_t mqdes)
 
   msgq = mqdes->msgq;
 
-  /* Get the message from the head of the queue */
+  /* Get the message from the head of the highest priority sub-queue */
 
-  while ((rcvmsg = (FAR mqmsg_t*)sq_remfirst(&msgq->msglist)) == NULL)
+  while ((rcvmsg = msgq->msghead) == NULL)
     {
       /* The queue is empty!  Should we block until there the above condition
        * has been satisfied?
@@ -182,6 +182,7 @@ FAR mqmsg_t *mq_waitreceive(mqd_t mqdes)
 
           set_errno(OK);
           up_block_task(rtcb, TSTATE_WAIT_MQNOTEMPTY);
+          rtcb->msgwaitq = NULL;
 
           /* When we resume at this point, either (1) the message queue
            * is no longer empty, or (2) the wait has been interrupted by
@@ -205,12 +206,27 @@ FAR mqmsg_t *mq_waitreceive(mqd_t mqdes)
         }
     }
 
-  /* If we got message, then decrement the number of messages in
-   * the queue while we are still in the critical section
+  /* If we got message, then remove it from its sub-queue and decrement
+   * the number of messages in the queue while we are still in the
+   * critical section.  If more messages of the same priority remain, the
+   * next one takes over as the head of the sub-queue.
    */
 
   if (rcvmsg)
     {
+      FAR mqmsg_t *next = rcvmsg->next;
+
+      if (next)
+        {
+          next->tail     = rcvmsg->tail;
+          next->nextprio = rcvmsg->nextprio;
+          msgq->msghead  = next;
+        }
+      else
+        {
+          msgq->msghead  = rcvmsg->nextprio;
+        }
+
       msgq->nmsgs--;
     }
 
@@ -247,9 +263,6 @@ FAR mqmsg_t *mq_waitreceive(mqd_t mqdes)
 
 ssize_t mq_doreceive(mqd_t mqdes, mqmsg_t *mqmsg, void *ubuffer, int *prio)
 {
-  FAR struct tcb_s *btcb;
-  irqstate_t saved_state;
-  FAR msgq_t *msgq;
   ssize_t rcvmsglen;
 
   /* Get the length of the message (also the return value) */
@@ -267,39 +280,11 @@ ssize_t mq_doreceive(mqd_t mqdes, mqmsg_t *mqmsg, void *ubuffer, int *prio)
       *prio = mqmsg->priority;
     }
 
-  /* We are done with the message.  Deallocate it now. */
-
-  mq_msgfree(mqmsg);
-
-  /* Check if any tasks are waiting for the MQ not full event. */
-
-  msgq = mqdes->msgq;
-  if (msgq->nwaitnotfull > 0)
-    {
-      /* Find the highest priority task that is waiting for
-       * this queue to be not-full in g_waitingformqnotfull list.
-       * This must be performed in a critical section because
-       * messages can be sent from interrupt handlers.
-       */
-
-      saved_state = irqsave();
-      for (btcb = (FAR struct tcb_s*)g_waitingformqnotfull.head;
-           btcb && btcb->msgwaitq != msgq;
-           btcb = btcb->flink);
-
-      /* If one was found, unblock it.  NOTE:  There is a race
-       * condition here:  the queue might be full again by the
-       * time the task is unblocked
-       */
-
-      ASSERT(btcb);
-
-       btcb->msgwaitq = NULL;
-       msgq->nwaitnotfull--;
-       up_unblock_task(btcb);
+  /* We are done with the message.  Deallocate it now.  This also wakes up
+   * any task waiting for the MQ not full event.
+   */
 
-      irqrestore(saved_state);
-    }
+  mq_msgfree(mqdes->msgq, mqmsg);
 
   /* Return the length of the message transferred to the user buffer */
 
@@ -146,13 +146,13 @@ int mq_send(mqd_t mqdes, const void *msg, size_t msglen, int prio)
 
   saved_state = irqsave();
   if (up_interrupt_context()      || /* In an interrupt handler */
-      msgq->nmsgs < msgq->maxmsgs || /* OR Message queue not full */
+      msgq->msgfree != NULL       || /* OR Message queue not full */
       mq_waitsend(mqdes) == OK)      /* OR Successfully waited for mq not full */
     {
       /* Allocate the message */
 
+      mqmsg = mq_msgalloc(msgq, msglen);
       irqrestore(saved_state);
-      mqmsg = mq_msgalloc();
     }
   else
     {
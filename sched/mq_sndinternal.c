@@ -137,77 +137,53 @@ int mq_verifysend(mqd_t mqdes, const void *msg, size_t msglen, int prio)
  * Name: mq_msgalloc
  *
  * Description:
- *   The mq_msgalloc function will get a free message for use by the
- *   operating system.  The message will be allocated from the g_msgfree
- *   list.
+ *   The mq_msgalloc function will get a free message slot of the message
+ *   queue.  Each message queue holds storage for mq_maxmsg messages of
+ *   mq_msgsize bytes which is allocated when the queue is created, so this
+ *   never allocates memory.
  *
- *   If the list is empty AND the message is NOT being allocated from the
- *   interrupt level, then the message will be allocated.  If a message
- *   cannot be obtained, the operating system is dead and therefore cannot
- *   continue.
- *
- *   If the list is empty AND the message IS being allocated from the
- *   interrupt level.  This function will attempt to get a message from 
- *   the g_msgfreeirq list.  If this is unsuccessful, the calling interrupt
- *   handler will be notified.
+ *   If the message queue has no free slot AND the message IS being
+ *   allocated from the interrupt level, this function will attempt to get
+ *   a message from the g_msgfreeirq list.  These messages can hold up to
+ *   CONFIG_MQ_MAXMSGSIZE bytes.  If this is unsuccessful, the calling
+ *   interrupt handler will be notified.
  *
  * Inputs:
- *   None
+ *   msgq   - The message queue that the message will be sent on
+ *   msglen - The length of the message in bytes
  *
  * Return Value:
- *   A reference to the allocated msg structure.  On a failure to allocate,
- *   this function PANICs.
+ *   A reference to the allocated msg structure or NULL if no message is
+ *   available.
  *
  ****************************************************************************/
 
-FAR mqmsg_t *mq_msgalloc(void)
+FAR mqmsg_t *mq_msgalloc(FAR msgq_t *msgq, size_t msglen)
 {
   FAR mqmsg_t *mqmsg;
   irqstate_t   saved_state;
 
-  /* If we were called from an interrupt handler, then try to get the message
-   * from generally available list of messages. If this fails, then try the
-   * list of messages reserved for interrupt handlers
-   */
+  /* Disable interrupts -- we might be called from an interrupt handler. */
 
-  if (up_interrupt_context())
+  saved_state = irqsave();
+  mqmsg = msgq->msgfree;
+  if (mqmsg)
     {
-      /* Try the general free list */
+      /* Remove the slot from the free list of the queue */
 
-      mqmsg = (FAR mqmsg_t*)sq_remfirst(&g_msgfree);
-      if (!mqmsg)
-        {
-          /* Try the free list reserved for interrupt handlers */
-
-          mqmsg = (FAR mqmsg_t*)sq_remfirst(&g_msgfreeirq);
-        }
+      msgq->msgfree = mqmsg->next;
     }
 
-  /* We were not called from an interrupt handler. */
+  /* If we were called from an interrupt handler, then try the list of
+   * messages reserved for interrupt handlers.
+   */
 
-  else
+  else if (up_interrupt_context() && msglen <= MQ_MAX_BYTES)
     {
-      /* Try to get the message from the generally available free list.
-       * Disable interrupts -- we might be called from an interrupt handler.
-       */
-
-      saved_state = irqsave();
-      mqmsg = (FAR mqmsg_t*)sq_remfirst(&g_msgfree);
-      irqrestore(saved_state);
-
-      /* If we cannot a message from the free list, then we will have to allocate one. */
-
-      if (!mqmsg)
-        {
-          mqmsg = (FAR mqmsg_t *)kmalloc((sizeof (mqmsg_t)));
-
-          /* Check if we got an allocated message */
-
-          ASSERT(mqmsg);
-          mqmsg->type = MQ_ALLOC_DYN;
-        }
+      mqmsg = (FAR mqmsg_t*)sq_remfirst(&g_msgfreeirq);
     }
 
+  irqrestore(saved_state);
   return mqmsg;
 }
 
@@ -246,9 +222,11 @@ int mq_waitsend(mqd_t mqdes)
 
   msgq = mqdes->msgq;
 
-  /* Verify that the queue is indeed full as the caller thinks */
+  /* Verify that the queue is indeed full as the caller thinks.  A message
+   * slot may also be unavailable because it is loaned out.
+   */
 
-  if (msgq->nmsgs >= msgq->maxmsgs)
+  if (msgq->msgfree == NULL)
     {
       /* Should we block until there is sufficient space in the
        * message queue?
@@ -272,7 +250,7 @@ int mq_waitsend(mqd_t mqdes)
            * receiving message queue
            */
 
-          while (msgq->nmsgs >= msgq->maxmsgs)
+          while (msgq->msgfree == NULL)
             {
               /* Block until the message queue is no longer full.
                * When we are unblocked, we will try again
@@ -284,6 +262,7 @@ int mq_waitsend(mqd_t mqdes)
 
               set_errno(OK);
               up_block_task(rtcb, TSTATE_WAIT_MQNOTFULL);
+              rtcb->msgwaitq = NULL;
 
               /* When we resume at this point, either (1) the message queue
                * is no longer empty, or (2) the wait has been interrupted by
@@ -342,32 +321,51 @@ int mq_dosend(mqd_t mqdes, FAR mqmsg_t *mqmsg, const void *msg, size_t msglen, i
   mqmsg->priority = prio;
   mqmsg->msglen   = msglen;
 
-  /* Copy the message data into the message */
+  /* Copy the message data into the message (unless the message was
+   * built in place in a loaned message slot).
+   */
 
-  memcpy((void*)mqmsg->mail, (const void*)msg, msglen);
+  if (msg != (FAR const void*)mqmsg->mail)
+    {
+      memcpy((void*)mqmsg->mail, (const void*)msg, msglen);
+    }
 
   /* Insert the new message in the message queue */
 
   saved_state = irqsave();
 
-  /* Search the message list to find the location to insert the new
-   * message. Each is list is maintained in ascending priority order.
+  /* Find the sub-queue for this priority.  The sub-queues are kept in
+   * descending priority order and there is only one for each priority
+   * with queued messages, so this is usually found immediately.
    */
 
-  for (prev = NULL, next = (FAR mqmsg_t*)msgq->msglist.head;
-       next && prio <= next->priority;
-       prev = next, next = next->next);
+  for (prev = NULL, next = msgq->msghead;
+       next && prio < next->priority;
+       prev = next, next = next->nextprio);
 
-  /* Add the message at the right place */
-
-  if (prev)
+  mqmsg->next = NULL;
+  if (next && prio == next->priority)
     {
-      sq_addafter((FAR sq_entry_t*)prev, (FAR sq_entry_t*)mqmsg,
-                  &msgq->msglist);
+      /* Append the message to the end of the existing sub-queue */
+
+      next->tail->next = mqmsg;
+      next->tail       = mqmsg;
     }
   else
     {
-      sq_addfirst((FAR sq_entry_t*)mqmsg, &msgq->msglist);
+      /* Start a new sub-queue at the right place */
+
+      mqmsg->tail     = mqmsg;
+      mqmsg->nextprio = next;
+
+      if (prev)
+        {
+          prev->nextprio = mqmsg;
+        }
+      else
+        {
+          msgq->msghead  = mqmsg;
+        }
     }
 
   /* Increment the count of messages in the queue */
@@ -414,21 +412,17 @@ int mq_dosend(mqd_t mqdes, FAR mqmsg_t *mqmsg, const void *msg, size_t msglen, i
   saved_state = irqsave();
   if (msgq->nwaitnotempty > 0)
     {
-      /* Find the highest priority task that is waiting for
-       * this queue to be non-empty in g_waitingformqnotempty
-       * list. sched_lock() should give us sufficent protection since
-       * interrupts should never cause a change in this list
+      /* The highest priority task that is waiting for this queue to be
+       * non-empty is at the head of the queue's prioritized waitnotempty
+       * list.
        */
 
-      for (btcb = (FAR struct tcb_s*)g_waitingformqnotempty.head;
-           btcb && btcb->msgwaitq != msgq;
-           btcb = btcb->flink);
+      btcb = (FAR struct tcb_s*)msgq->waitnotempty.head;
 
       /* If one was found, unblock it */
 
       ASSERT(btcb);
 
-      btcb->msgwaitq = NULL;
       msgq->nwaitnotempty--;
       up_unblock_task(btcb);
     }
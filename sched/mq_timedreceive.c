@@ -235,7 +235,7 @@ ssize_t mq_timedreceive(mqd_t mqdes, void *msg, size_t msglen,
    * will not need to start timer.
    */
 
-  if (mqdes->msgq->msglist.head == NULL)
+  if (mqdes->msgq->msghead == NULL)
     {
       int ticks;
 
@@ -229,12 +229,12 @@ int mq_timedsend(mqd_t mqdes, const char *msg, size_t msglen, int prio,
   sched_lock();
   saved_state = irqsave();
   if (up_interrupt_context()      || /* In an interrupt handler */
-      msgq->nmsgs < msgq->maxmsgs)   /* OR Message queue not full */
+      msgq->msgfree != NULL)         /* OR Message queue not full */
     {
       /* Allocate the message */
 
+      mqmsg = mq_msgalloc(msgq, msglen);
       irqrestore(saved_state);
-      mqmsg = mq_msgalloc();
     }
   else
     {
@@ -285,10 +285,6 @@ int mq_timedsend(mqd_t mqdes, const char *msg, size_t msglen, int prio,
           wd_cancel(rtcb->waitdog);
         }
 
-      /* That is the end of the atomic operations */
-
-      irqrestore(saved_state);
-
       /* If any of the above failed, set the errno.  Otherwise, there should
        * be space for another message in the message queue.  NOW we can allocate
        * the message structure.
@@ -296,8 +292,12 @@ int mq_timedsend(mqd_t mqdes, const char *msg, size_t msglen, int prio,
 
       if (ret == OK)
         {
-          mqmsg = mq_msgalloc();
+          mqmsg = mq_msgalloc(msgq, msglen);
         }
+
+      /* That is the end of the atomic operations */
+
+      irqrestore(saved_state);
     }
 
   /* Check if we were able to get a message structure -- this can fail
@@ -115,8 +115,6 @@ void mq_waitirq(FAR struct tcb_s *wtcb, int errcode)
       msgq = wtcb->msgwaitq;
       DEBUGASSERT(msgq);
 
-      wtcb->msgwaitq = NULL;
-
       /* Decrement the count of waiters and cancel the wait */
 
       if (wtcb->task_state == TSTATE_WAIT_MQNOTEMPTY)
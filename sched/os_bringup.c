@@ -130,6 +130,9 @@
 int os_bringup(void)
 {
   int taskid;
+#if defined(CONFIG_SCHED_WORKQUEUE) && defined(CONFIG_SCHED_LPWORK)
+  int i;
+#endif
 
   /* Setup up the initial environment for the idle task.  At present, this
    * may consist of only the initial PATH variable.  The PATH variable is
@@ -169,10 +172,12 @@ int os_bringup(void)
   svdbg("Starting kernel worker thread\n");
 #endif
 
-  g_work[HPWORK].pid = KERNEL_THREAD(HPWORKNAME, CONFIG_SCHED_WORKPRIORITY,
-                                     CONFIG_SCHED_WORKSTACKSIZE,
-                                     (main_t)work_hpthread, (FAR char * const *)NULL);
-  DEBUGASSERT(g_work[HPWORK].pid > 0);
+  g_work[HPWORK].nthreads = 1;
+  g_work[HPWORK].worker[0].pid =
+    KERNEL_THREAD(HPWORKNAME, CONFIG_SCHED_WORKPRIORITY,
+                  CONFIG_SCHED_WORKSTACKSIZE,
+                  (main_t)work_hpthread, (FAR char * const *)NULL);
+  DEBUGASSERT(g_work[HPWORK].worker[0].pid > 0);
 
   /* Start a lower priority worker thread for other, non-critical continuation
    * tasks
@@ -180,12 +185,26 @@ int os_bringup(void)
 
 #ifdef CONFIG_SCHED_LPWORK
 
-  svdbg("Starting low-priority kernel worker thread\n");
+  svdbg("Starting %d low-priority kernel worker thread(s)\n",
+        CONFIG_SCHED_LPNTHREADS);
+
+  /* The lower priority work queue may be served by a pool of threads.
+   * Pre-emption is disabled so that each thread can find its own task ID
+   * in the pool when it first runs.
+   */
 
-  g_work[LPWORK].pid = KERNEL_THREAD(LPWORKNAME, CONFIG_SCHED_LPWORKPRIORITY,
-                                     CONFIG_SCHED_LPWORKSTACKSIZE,
-                                     (main_t)work_lpthread, (FAR char * const *)NULL);
-  DEBUGASSERT(g_work[LPWORK].pid > 0);
+  sched_lock();
+  g_work[LPWORK].nthreads = CONFIG_SCHED_LPNTHREADS;
+  for (i = 0; i < CONFIG_SCHED_LPNTHREADS; i++)
+    {
+      g_work[LPWORK].worker[i].pid =
+        KERNEL_THREAD(LPWORKNAME, CONFIG_SCHED_LPWORKPRIORITY,
+                      CONFIG_SCHED_LPWORKSTACKSIZE,
+                      (main_t)work_lpthread, (FAR char * const *)NULL);
+      DEBUGASSERT(g_work[LPWORK].worker[i].pid > 0);
+    }
+
+  sched_unlock();
 
 #endif /* CONFIG_SCHED_LPWORK */
 #endif /* CONFIG_SCHED_HPWORK */
@@ -108,7 +108,9 @@ typedef struct pidhash_s  pidhash_t;
 
 /* This structure defines an element of the g_tasklisttable[].
  * This table is used to map a task_state enumeration to the
- * corresponding task list.
+ * corresponding task list.  The list is NULL if the list is not a
+ * global list but is held in the object that the task waits for.
+ * Use sched_tasklist() to get the list of a particular task.
  */
 
 struct tasklist_s
@@ -129,8 +131,10 @@ typedef struct tasklist_s tasklist_t;
  * and by a series of task lists.  All of these tasks lists are declared
  * below. Although it is not always necessary, most of these lists are
  * prioritized so that common list handling logic can be used (only the
- * g_readytorun, the g_pendingtasks, and the g_waitingforsemaphore lists need
- * to be prioritized).
+ * g_readytorun and the g_pendingtasks lists need to be prioritized).
+ *
+ * Tasks waiting for a semaphore or for a message queue are held in
+ * prioritized lists in the semaphore or message queue itself.
  */
 
 /* This is the list of all tasks that are ready to run.  The head of this
@@ -148,32 +152,12 @@ extern volatile dq_queue_t g_readytorun;
 
 extern volatile dq_queue_t g_pendingtasks;
 
-/* This is the list of all tasks that are blocked waiting for a semaphore */
-
-extern volatile dq_queue_t g_waitingforsemaphore;
-
 /* This is the list of all tasks that are blocked waiting for a signal */
 
 #ifndef CONFIG_DISABLE_SIGNALS
 extern volatile dq_queue_t g_waitingforsignal;
 #endif
 
-/* This is the list of all tasks that are blocked waiting for a message
- * queue to become non-empty.
- */
-
-#ifndef CONFIG_DISABLE_MQUEUE
-extern volatile dq_queue_t g_waitingformqnotempty;
-#endif
-
-/* This is the list of all tasks that are blocked waiting for a message
- * queue to become non-full.
- */
-
-#ifndef CONFIG_DISABLE_MQUEUE
-extern volatile dq_queue_t g_waitingformqnotfull;
-#endif
-
 /* This is the list of all tasks that are blocking waiting for a page fill */
 
 #ifdef CONFIG_PAGING
@@ -222,6 +206,14 @@ extern pidhash_t g_pidhash[CONFIG_MAX_TASKS];
 
 extern const tasklist_t g_tasklisttable[NUM_TASK_STATES];
 
+/* This is the total number of clocks counted in the current CPU load window
+ * for all tasks.
+ */
+
+#ifdef CONFIG_SCHED_CPULOAD
+extern volatile uint32_t g_cpuload_total;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -252,6 +244,7 @@ bool sched_addprioritized(FAR struct tcb_s *newTcb, DSEG dq_queue_t *list);
 bool sched_mergepending(void);
 void sched_addblocked(FAR struct tcb_s *btcb, tstate_t task_state);
 void sched_removeblocked(FAR struct tcb_s *btcb);
+FAR dq_queue_t *sched_tasklist(FAR struct tcb_s *tcb, tstate_t task_state);
 int  sched_setpriority(FAR struct tcb_s *tcb, int sched_priority);
 #ifdef CONFIG_PRIORITY_INHERITANCE
 int  sched_reprioritize(FAR struct tcb_s *tcb, int sched_priority);
@@ -263,4 +256,19 @@ bool sched_verifytcb(FAR struct tcb_s *tcb);
 
 int  sched_releasetcb(FAR struct tcb_s *tcb, uint8_t ttype);
 
+#ifdef CONFIG_SCHED_TCBPOOL
+void sched_tcbpoolinit(void);
+FAR struct tcb_s *sched_alloctcb(uint8_t ttype, size_t stack_size);
+bool sched_recycletcb(FAR struct tcb_s *tcb, uint8_t ttype);
+#endif
+
+#ifdef CONFIG_SCHED_CPULOAD
+void sched_process_cpuload(void);
+#endif
+#ifdef CONFIG_SCHED_CPULOAD_EXTCLK
+void sched_cpuload_switch(FAR struct tcb_s *rtcb);
+#else
+#  define sched_cpuload_switch(rtcb)
+#endif
+
 #endif /* __SCHED_OS_INTERNAL_H */
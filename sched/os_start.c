@@ -85,8 +85,11 @@
  * and by a series of task lists.  All of these tasks lists are declared
  * below. Although it is not always necessary, most of these lists are
  * prioritized so that common list handling logic can be used (only the
- * g_readytorun, the g_pendingtasks, and the g_waitingforsemaphore lists need
- * to be prioritized).
+ * g_readytorun and the g_pendingtasks lists need to be prioritized).
+ *
+ * Tasks waiting for a semaphore or for a message queue are not held in a
+ * global list.  Instead, each semaphore and message queue holds its own
+ * prioritized list of waiting tasks (see sched_tasklist()).
  */
 
 /* This is the list of all tasks that are ready to run.  The head of this
@@ -104,32 +107,12 @@ volatile dq_queue_t g_readytorun;
 
 volatile dq_queue_t g_pendingtasks;
 
-/* This is the list of all tasks that are blocked waiting for a semaphore */
-
-volatile dq_queue_t g_waitingforsemaphore;
-
 /* This is the list of all tasks that are blocked waiting for a signal */
 
 #ifndef CONFIG_DISABLE_SIGNALS
 volatile dq_queue_t g_waitingforsignal;
 #endif
 
-/* This is the list of all tasks that are blocked waiting for a message
- * queue to become non-empty.
- */
-
-#ifndef CONFIG_DISABLE_MQUEUE
-volatile dq_queue_t g_waitingformqnotempty;
-#endif
-
-/* This is the list of all tasks that are blocked waiting for a message
- * queue to become non-full.
- */
-
-#ifndef CONFIG_DISABLE_MQUEUE
-volatile dq_queue_t g_waitingformqnotfull;
-#endif
-
 /* This is the list of all tasks that are blocking waiting for a page fill */
 
 #ifdef CONFIG_PAGING
@@ -174,7 +157,9 @@ pidhash_t g_pidhash[CONFIG_MAX_TASKS];
  * the task state enumeration type (tstate_t) and provides
  * a pointer to the associated static task list (if there
  * is one) as well as a boolean indication as to if the list
- * is an ordered list or not.
+ * is an ordered list or not.  The list pointer is NULL for
+ * the states whose list belongs to the object being waited
+ * for.
  */
 
 const tasklist_t g_tasklisttable[NUM_TASK_STATES] =
@@ -184,15 +169,15 @@ const tasklist_t g_tasklisttable[NUM_TASK_STATES] =
   { &g_readytorun,           true  },  /* TSTATE_TASK_READYTORUN */
   { &g_readytorun,           true  },  /* TSTATE_TASK_RUNNING */
   { &g_inactivetasks,        false },  /* TSTATE_TASK_INACTIVE */
-  { &g_waitingforsemaphore,  true  }   /* TSTATE_WAIT_SEM */
+  { NULL,                    true  }   /* TSTATE_WAIT_SEM */
 #ifndef CONFIG_DISABLE_SIGNALS
   ,
   { &g_waitingforsignal,     false }  /* TSTATE_WAIT_SIG */
 #endif
 #ifndef CONFIG_DISABLE_MQUEUE
   ,
-  { &g_waitingformqnotempty, true  },  /* TSTATE_WAIT_MQNOTEMPTY */
-  { &g_waitingformqnotfull,  true  }   /* TSTATE_WAIT_MQNOTFULL */
+  { NULL,                    true  },  /* TSTATE_WAIT_MQNOTEMPTY */
+  { NULL,                    true  }   /* TSTATE_WAIT_MQNOTFULL */
 #endif
 #ifdef CONFIG_PAGING
   ,
@@ -243,14 +228,9 @@ void os_start(void)
 
   dq_init(&g_readytorun);
   dq_init(&g_pendingtasks);
-  dq_init(&g_waitingforsemaphore);
 #ifndef CONFIG_DISABLE_SIGNALS
   dq_init(&g_waitingforsignal);
 #endif
-#ifndef CONFIG_DISABLE_MQUEUE
-  dq_init(&g_waitingformqnotfull);
-  dq_init(&g_waitingformqnotempty);
-#endif
 #ifdef CONFIG_PAGING
   dq_init(&g_waitingforfill);
 #endif
@@ -434,6 +414,12 @@ void os_start(void)
     }
 #endif
 
+  /* Pre-allocate TCBs and stacks for re-use */
+
+#ifdef CONFIG_SCHED_TCBPOOL
+  sched_tcbpoolinit();
+#endif
+
   /* Initialize the file system (needed to support device drivers) */
 
 #if CONFIG_NFILE_DESCRIPTORS > 0
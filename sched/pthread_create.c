@@ -247,7 +247,12 @@ int pthread_create(FAR pthread_t *thread, FAR pthread_attr_t *attr,
 
   /* Allocate a TCB for the new task. */
 
+#ifdef CONFIG_SCHED_TCBPOOL
+  ptcb = (FAR struct pthread_tcb_s *)
+    sched_alloctcb(TCB_FLAG_TTYPE_PTHREAD, attr->stacksize);
+#else
   ptcb = (FAR struct pthread_tcb_s *)kzalloc(sizeof(struct pthread_tcb_s));
+#endif
   if (!ptcb)
     {
       sdbg("ERROR: Failed to allocate TCB\n");
@@ -292,14 +297,17 @@ int pthread_create(FAR pthread_t *thread, FAR pthread_attr_t *attr,
       goto errout_with_tcb;
     }
 
-  /* Allocate the stack for the TCB */
+  /* Allocate the stack for the TCB (unless a re-used TCB already has one) */
 
-  ret = up_create_stack((FAR struct tcb_s *)ptcb, attr->stacksize,
-                        TCB_FLAG_TTYPE_PTHREAD);
-  if (ret != OK)
+  if (!ptcb->cmn.stack_alloc_ptr)
     {
-      errcode = ENOMEM;
-      goto errout_with_join;
+      ret = up_create_stack((FAR struct tcb_s *)ptcb, attr->stacksize,
+                            TCB_FLAG_TTYPE_PTHREAD);
+      if (ret != OK)
+        {
+          errcode = ENOMEM;
+          goto errout_with_join;
+        }
     }
 
   /* Should we use the priority and scheduler specified in the
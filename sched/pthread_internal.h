@@ -108,6 +108,14 @@ FAR struct join_s *pthread_findjoininfo(FAR struct task_group_s *group,
 void pthread_release(FAR struct task_group_s *group);
 int pthread_givesemaphore(sem_t *sem);
 int pthread_takesemaphore(sem_t *sem);
+bool pthread_mutexfastlock(FAR pthread_mutex_t *mutex);
+bool pthread_mutexfastunlock(FAR pthread_mutex_t *mutex);
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+void pthread_mutexholder(FAR pthread_mutex_t *mutex);
+#else
+#  define pthread_mutexholder(mutex)
+#endif
 
 #ifdef CONFIG_MUTEX_TYPES
 int pthread_mutexattr_verifytype(int type);
@@ -0,0 +1,156 @@
+/****************************************************************************
+ * sched/pthread_mutexfast.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <arch/irq.h>
+
+#include "os_internal.h"
+#include "sem_internal.h"
+#include "pthread_internal.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutexfastlock
+ *
+ * Description:
+ *   Try to take an unlocked mutex without locking the scheduler or
+ *   disabling interrupts (if the architecture provides up_cmpxchg16()).
+ *   The holder is not recorded for priority inheritance; if another thread
+ *   later has to wait for the mutex, it records the holder (see
+ *   pthread_mutexholder()).
+ *
+ * Parameters:
+ *   mutex - The mutex to lock
+ *
+ * Return Value:
+ *   true if the mutex was locked.  The caller must then set mutex->pid.
+ *
+ ****************************************************************************/
+
+bool pthread_mutexfastlock(FAR pthread_mutex_t *mutex)
+{
+  return sem_cmpxchg((FAR sem_t*)&mutex->sem, 1, 0);
+}
+
+/****************************************************************************
+ * Name: pthread_mutexfastunlock
+ *
+ * Description:
+ *   Try to unlock a mutex without locking the scheduler.  This succeeds
+ *   only if no thread is waiting for the mutex and, with priority
+ *   inheritance, if no holder has been recorded (otherwise the holder's
+ *   priority may need to be restored).
+ *
+ * Parameters:
+ *   mutex - The mutex to unlock.  mutex->pid has already been cleared.
+ *
+ * Return Value:
+ *   true if the mutex was unlocked.  Otherwise, the caller must unlock the
+ *   mutex with pthread_givesemaphore().
+ *
+ ****************************************************************************/
+
+bool pthread_mutexfastunlock(FAR pthread_mutex_t *mutex)
+{
+#ifdef CONFIG_PRIORITY_INHERITANCE
+  FAR sem_t *sem = (FAR sem_t*)&mutex->sem;
+  irqstate_t flags;
+  bool ret = false;
+
+  /* The holder test and the count update must be atomic */
+
+  flags = irqsave();
+  if (sem->semcount == 0 && !sem_hasholders(sem))
+    {
+      sem->semcount = 1;
+      ret = true;
+    }
+
+  irqrestore(flags);
+  return ret;
+#else
+  return sem_cmpxchg((FAR sem_t*)&mutex->sem, 0, 1);
+#endif
+}
+
+/****************************************************************************
+ * Name: pthread_mutexholder
+ *
+ * Description:
+ *   Called before waiting for a locked mutex.  If the mutex was taken via
+ *   the fast path, record its holder so that sem_wait() can boost the
+ *   holder's priority.
+ *
+ *   If the holder has taken the mutex but has not yet set mutex->pid, it
+ *   cannot be found.  Its priority is not boosted for this wait.
+ *
+ * Parameters:
+ *   mutex - The locked mutex
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   The scheduler is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_PRIORITY_INHERITANCE
+void pthread_mutexholder(FAR pthread_mutex_t *mutex)
+{
+  FAR struct tcb_s *htcb;
+
+  if (mutex->pid > 0)
+    {
+      htcb = sched_gettcb((pid_t)mutex->pid);
+      if (htcb)
+        {
+          sem_registerholder((FAR sem_t*)&mutex->sem, htcb);
+        }
+    }
+}
+#endif
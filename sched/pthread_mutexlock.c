@@ -127,6 +127,18 @@ int pthread_mutex_lock(FAR pthread_mutex_t *mutex)
     {
       ret = EINVAL;
     }
+
+  /* If the mutex is not locked, just take it.  This cannot succeed if
+   * this thread already holds the mutex.
+   */
+
+  else if (pthread_mutexfastlock(mutex))
+    {
+      mutex->pid    = mypid;
+#ifdef CONFIG_MUTEX_TYPES
+      mutex->nlocks = 1;
+#endif
+    }
   else
     {
       /* Make sure the semaphore is stable while we make the following
@@ -161,6 +173,12 @@ int pthread_mutex_lock(FAR pthread_mutex_t *mutex)
         }
       else
         {
+          /* We will have to wait.  Make sure that the holder is known so
+           * that its priority can be boosted.
+           */
+
+          pthread_mutexholder(mutex);
+
           /* Take the semaphore */
 
           ret = pthread_takesemaphore((sem_t*)&mutex->sem);
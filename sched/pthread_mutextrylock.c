@@ -106,6 +106,16 @@ int pthread_mutex_trylock(FAR pthread_mutex_t *mutex)
     {
       ret = EINVAL;
     }
+
+  /* If the mutex is not locked, just take it */
+
+  else if (pthread_mutexfastlock(mutex))
+    {
+      mutex->pid    = (int)getpid();
+#ifdef CONFIG_MUTEX_TYPES
+      mutex->nlocks = 1;
+#endif
+    }
   else
     {
       /* Make sure the semaphore is stable while we make the following
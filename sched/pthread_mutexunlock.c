@@ -108,6 +108,30 @@ int pthread_mutex_unlock(FAR pthread_mutex_t *mutex)
     {
       ret = EINVAL;
     }
+
+  /* Only the holder can have set mutex->pid to its own pid, so the holder
+   * can test ownership without locking the scheduler.  If this thread is
+   * the holder of a non-recursive mutex (or of the outermost lock of a
+   * recursive mutex) and no thread is waiting, just unlock it.
+   */
+
+  else if (mutex->pid == (int)getpid()
+#ifdef CONFIG_MUTEX_TYPES
+           && (mutex->type != PTHREAD_MUTEX_RECURSIVE || mutex->nlocks <= 1)
+#endif
+          )
+    {
+      mutex->pid    = 0;
+#ifdef CONFIG_MUTEX_TYPES
+      mutex->nlocks = 0;
+#endif
+      if (!pthread_mutexfastunlock(mutex))
+        {
+          sched_lock();
+          ret = pthread_givesemaphore((sem_t*)&mutex->sem);
+          sched_unlock();
+        }
+    }
   else
     {
       /* Make sure the semaphore is stable while we make the following
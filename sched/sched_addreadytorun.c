@@ -127,6 +127,10 @@ bool sched_addreadytorun(FAR struct tcb_s *btcb)
 
       sched_note_switch(rtcb, btcb);
 
+      /* Charge the outgoing task for the time that it has run */
+
+      sched_cpuload_switch(rtcb);
+
       /* The new btcb was added at the head of the g_readytorun list.  It
        * is now to new active task!
        */
@@ -0,0 +1,235 @@
+/****************************************************************************
+ * sched/sched_cpuload.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sched.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <arch/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/clock.h>
+
+#include "os_internal.h"
+
+#ifdef CONFIG_SCHED_CPULOAD
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The number of system timer ticks in one CPU load window */
+
+#define CPULOAD_WINDOW_TICKS SEC2TICK(CONFIG_SCHED_CPULOAD_TIMECONSTANT)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* This is the total number of clocks counted in the current CPU load window
+ * for all tasks.
+ */
+
+volatile uint32_t g_cpuload_total;
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The number of ticks remaining in the current load window */
+
+static uint32_t g_cpuload_window = CPULOAD_WINDOW_TICKS;
+
+/* The value of the run-time counter at the last context switch */
+
+#ifdef CONFIG_SCHED_CPULOAD_EXTCLK
+static uint32_t g_cpuload_lastswitch;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_cpuload_charge
+ *
+ * Description:
+ *   Add run time to a task and to the system total.
+ *
+ * Assumptions:
+ *   Called with interrupts disabled.
+ *
+ ****************************************************************************/
+
+static inline void sched_cpuload_charge(FAR struct tcb_s *tcb,
+                                        uint32_t clocks)
+{
+  tcb->ticks      += clocks;
+  tcb->runtime    += clocks;
+  g_cpuload_total += clocks;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_cpuload_switch
+ *
+ * Description:
+ *   Charge the task that is being switched out for the time that it has
+ *   run since the last context switch.
+ *
+ * Inputs:
+ *   rtcb - The TCB of the task that was running
+ *
+ * Assumptions:
+ *   Called with interrupts disabled.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPULOAD_EXTCLK
+void sched_cpuload_switch(FAR struct tcb_s *rtcb)
+{
+  uint32_t now = up_cpuload_clock();
+
+  sched_cpuload_charge(rtcb, now - g_cpuload_lastswitch);
+  g_cpuload_lastswitch = now;
+}
+#endif
+
+/****************************************************************************
+ * Name: sched_process_cpuload
+ *
+ * Description:
+ *   Called from the timer interrupt on each system timer tick.  Without an
+ *   architecture run-time counter, the running task is charged for the
+ *   whole tick.  At the end of each load window, all counts are halved so
+ *   that the load reflects recent activity.
+ *
+ * Assumptions:
+ *   Called from the timer interrupt handler with interrupts disabled.
+ *
+ ****************************************************************************/
+
+void sched_process_cpuload(void)
+{
+  FAR struct tcb_s *rtcb = (FAR struct tcb_s *)g_readytorun.head;
+  int i;
+
+#ifdef CONFIG_SCHED_CPULOAD_EXTCLK
+  /* Bring the running task up to date */
+
+  sched_cpuload_switch(rtcb);
+#else
+  /* Charge the running task for the whole tick */
+
+  sched_cpuload_charge(rtcb, 1);
+#endif
+
+  /* Is this the end of the load window? */
+
+  if (--g_cpuload_window == 0)
+    {
+      /* Yes.. halve the count of every task and of the total.  Halving the
+       * total separately leaves a small rounding error that is discarded
+       * with the next window.
+       */
+
+      for (i = 0; i < CONFIG_MAX_TASKS; i++)
+        {
+          if (g_pidhash[i].tcb)
+            {
+              g_pidhash[i].tcb->ticks >>= 1;
+            }
+        }
+
+      g_cpuload_total  >>= 1;
+      g_cpuload_window   = CPULOAD_WINDOW_TICKS;
+    }
+}
+
+/****************************************************************************
+ * Name: clock_cpuload
+ *
+ * Description:
+ *   Return the CPU load of one task.  The load of the whole system is
+ *   100% less the load of the IDLE task (PID 0).
+ *
+ * Parameters:
+ *   pid     - The task ID of the task of interest
+ *   cpuload - The location to return the CPU load
+ *
+ * Return Value:
+ *   OK (0) on success; a negated errno value on failure.  The only
+ *   expected failure is -ESRCH if there is no task with that ID.
+ *
+ * Assumptions:
+ *
+ ****************************************************************************/
+
+int clock_cpuload(pid_t pid, FAR struct cpuload_s *cpuload)
+{
+  FAR struct tcb_s *tcb;
+  irqstate_t flags;
+  int ret = -ESRCH;
+
+  DEBUGASSERT(cpuload);
+
+  /* Interrupts are disabled so that the task and the total are sampled at
+   * the same time.
+   */
+
+  flags = irqsave();
+  tcb   = sched_gettcb(pid);
+  if (tcb)
+    {
+      cpuload->total   = g_cpuload_total;
+      cpuload->active  = tcb->ticks;
+      cpuload->runtime = tcb->runtime;
+      ret              = OK;
+    }
+
+  irqrestore(flags);
+  return ret;
+}
+
+#endif /* CONFIG_SCHED_CPULOAD */
@@ -137,6 +137,10 @@ bool sched_mergepending(void)
 
           sched_note_switch(rtrtcb, pndtcb);
 
+          /* Charge the outgoing task for the time that it has run */
+
+          sched_cpuload_switch(rtrtcb);
+
           /* Then insert at the head of the list */
 
           pndtcb->flink      = rtrtcb;
@@ -187,4 +187,10 @@ void sched_process_timer(void)
    */
 
   sched_process_timeslice();
+
+#ifdef CONFIG_SCHED_CPULOAD
+  /* Update the CPU load counts */
+
+  sched_process_cpuload();
+#endif
 }
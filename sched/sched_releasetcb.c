@@ -133,15 +133,6 @@ int sched_releasetcb(FAR struct tcb_s *tcb, uint8_t ttype)
           sched_releasepid(tcb->pid);
         }
 
-      /* Delete the thread's stack if one has been allocated */
-
-#ifndef CONFIG_CUSTOM_STACK
-      if (tcb->stack_alloc_ptr)
-        {
-          up_release_stack(tcb, ttype);
-        }
-#endif
-
       /* Delete the tasks's allocated DSpace region (external modules only) */
 
 #ifdef CONFIG_PIC
@@ -191,6 +182,25 @@ int sched_releasetcb(FAR struct tcb_s *tcb, uint8_t ttype)
 #ifdef HAVE_TASK_GROUP
       group_leave(tcb);
 #endif
+
+      /* Keep the TCB and its stack for re-use if there is room in the pool */
+
+#ifdef CONFIG_SCHED_TCBPOOL
+      if (sched_recycletcb(tcb, ttype))
+        {
+          return ret;
+        }
+#endif
+
+      /* Delete the thread's stack if one has been allocated */
+
+#ifndef CONFIG_CUSTOM_STACK
+      if (tcb->stack_alloc_ptr)
+        {
+          up_release_stack(tcb, ttype);
+        }
+#endif
+
       /* And, finally, release the TCB itself */
 
       sched_kfree(tcb);
@@ -108,6 +108,10 @@ bool sched_removereadytorun(FAR struct tcb_s *rtcb)
 
       sched_note_switch(rtcb, rtcb->flink);
 
+      /* Charge the outgoing task for the time that it has run */
+
+      sched_cpuload_switch(rtcb);
+
       rtcb->flink->task_state = TSTATE_TASK_RUNNING;
       ret = true;
     }
@@ -204,7 +204,7 @@ int sched_setpriority(FAR struct tcb_s *tcb, int sched_priority)
           {
             /* Remove the TCB from the prioritized task list */
 
-            dq_rem((FAR dq_entry_t*)tcb, (FAR dq_queue_t*)g_tasklisttable[task_state].list);
+            dq_rem((FAR dq_entry_t*)tcb, sched_tasklist(tcb, task_state));
 
             /* Change the task priority */
 
@@ -214,7 +214,7 @@ int sched_setpriority(FAR struct tcb_s *tcb, int sched_priority)
              * position
              */
 
-            sched_addprioritized(tcb, (FAR dq_queue_t*)g_tasklisttable[task_state].list);
+            sched_addprioritized(tcb, sched_tasklist(tcb, task_state));
           }
 
         /* CASE 3b. The task resides in a non-prioritized list. */
@@ -0,0 +1,100 @@
+/****************************************************************************
+ * sched/sched_tasklist.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <semaphore.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <nuttx/mqueue.h>
+
+#include "os_internal.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_tasklist
+ *
+ * Description:
+ *   Return the task list that holds (or will hold) a TCB in the given
+ *   state.  Most states map to one of the global lists in
+ *   g_tasklisttable[].  Tasks waiting for a semaphore or a message queue
+ *   are instead held in a prioritized list within the semaphore or
+ *   message queue so that the waiter to wake can be found without
+ *   searching through the tasks waiting on other objects.
+ *
+ * Inputs:
+ *   tcb - The TCB of interest.  For the semaphore and message queue
+ *     states, tcb->waitsem or tcb->msgwaitq must be valid.
+ *   task_state - The state of the task.
+ *
+ * Return Value:
+ *   The task list.
+ *
+ * Assumptions:
+ * - The caller has established a critical section before calling this
+ *   function.
+ *
+ ****************************************************************************/
+
+FAR dq_queue_t *sched_tasklist(FAR struct tcb_s *tcb, tstate_t task_state)
+{
+  switch (task_state)
+    {
+      case TSTATE_WAIT_SEM:
+        DEBUGASSERT(tcb->waitsem != NULL);
+        return &tcb->waitsem->waitlist;
+
+#ifndef CONFIG_DISABLE_MQUEUE
+      case TSTATE_WAIT_MQNOTEMPTY:
+        DEBUGASSERT(tcb->msgwaitq != NULL);
+        return &tcb->msgwaitq->waitnotempty;
+
+      case TSTATE_WAIT_MQNOTFULL:
+        DEBUGASSERT(tcb->msgwaitq != NULL);
+        return &tcb->msgwaitq->waitnotfull;
+#endif
+
+      default:
+        return (FAR dq_queue_t*)g_tasklisttable[task_state].list;
+    }
+}
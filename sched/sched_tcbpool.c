@@ -0,0 +1,282 @@
+/****************************************************************************
+ * sched/sched_tcbpool.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include <queue.h>
+#include <sched.h>
+#include <debug.h>
+
+#include <arch/irq.h>
+#include <nuttx/arch.h>
+#include <nuttx/kmalloc.h>
+
+#include "os_internal.h"
+
+#ifdef CONFIG_SCHED_TCBPOOL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Configuration ************************************************************/
+
+#ifndef CONFIG_SCHED_TCBPOOL_NFREE
+#  define CONFIG_SCHED_TCBPOOL_NFREE 8
+#endif
+
+#ifndef CONFIG_SCHED_TCBPOOL_NPREALLOC
+#  define CONFIG_SCHED_TCBPOOL_NPREALLOC 0
+#endif
+
+/* Free TCBs are kept in a separate list for each thread type.  The TCB
+ * structures differ in size and, in the kernel build, the stacks of kernel
+ * threads come from a different heap.
+ */
+
+#define TCBPOOL_NTYPES     3
+#define TCBPOOL_NDX(ttype) (((ttype) & TCB_FLAG_TTYPE_MASK) >> TCB_FLAG_TTYPE_SHIFT)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The lists of free TCBs (each with its stack) and the number of TCBs in
+ * all of the lists.
+ */
+
+static dq_queue_t g_tcbpool[TCBPOOL_NTYPES];
+static uint16_t   g_tcbnfree;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_tcbsize
+ *
+ * Description:
+ *   Return the size of the TCB structure used for this thread type.
+ *
+ ****************************************************************************/
+
+static inline size_t sched_tcbsize(uint8_t ttype)
+{
+#ifndef CONFIG_DISABLE_PTHREAD
+  if ((ttype & TCB_FLAG_TTYPE_MASK) == TCB_FLAG_TTYPE_PTHREAD)
+    {
+      return sizeof(struct pthread_tcb_s);
+    }
+#endif
+
+  return sizeof(struct task_tcb_s);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_tcbpoolinit
+ *
+ * Description:
+ *   Pre-allocate CONFIG_SCHED_TCBPOOL_NPREALLOC pthread TCBs, each with a
+ *   stack of the default size, so that the first threads created do not
+ *   have to allocate them either.
+ *
+ * Parameters:
+ *   None
+ *
+ * Return Value:
+ *   None
+ *
+ ****************************************************************************/
+
+void sched_tcbpoolinit(void)
+{
+#if CONFIG_SCHED_TCBPOOL_NPREALLOC > 0 && !defined(CONFIG_DISABLE_PTHREAD)
+  FAR struct tcb_s *tcb;
+  int i;
+
+  for (i = 0; i < CONFIG_SCHED_TCBPOOL_NPREALLOC; i++)
+    {
+      tcb = sched_alloctcb(TCB_FLAG_TTYPE_PTHREAD, PTHREAD_STACK_DEFAULT);
+      if (!tcb)
+        {
+          break;
+        }
+
+      if (up_create_stack(tcb, PTHREAD_STACK_DEFAULT,
+                          TCB_FLAG_TTYPE_PTHREAD) < 0)
+        {
+          sched_kfree(tcb);
+          break;
+        }
+
+      if (!sched_recycletcb(tcb, TCB_FLAG_TTYPE_PTHREAD))
+        {
+          up_release_stack(tcb, TCB_FLAG_TTYPE_PTHREAD);
+          sched_kfree(tcb);
+          break;
+        }
+    }
+
+  svdbg("%d pthread TCBs pre-allocated\n", i);
+#endif
+}
+
+/****************************************************************************
+ * Name: sched_alloctcb
+ *
+ * Description:
+ *   Allocate a zeroed TCB for a new task or thread.  If a free TCB of the
+ *   same type with a stack of the same requested size is available, then
+ *   that TCB is re-initialized and returned with its stack already set up
+ *   (i.e., stack_alloc_ptr is non-NULL and up_create_stack() must not be
+ *   called).  Otherwise, a new TCB is allocated and the caller must
+ *   allocate its stack.
+ *
+ * Parameters:
+ *   ttype      - The type of the new task or thread
+ *   stack_size - The requested stack size
+ *
+ * Return Value:
+ *   The new TCB or NULL if the TCB could not be allocated.
+ *
+ ****************************************************************************/
+
+FAR struct tcb_s *sched_alloctcb(uint8_t ttype, size_t stack_size)
+{
+  FAR dq_queue_t *pool = &g_tcbpool[TCBPOOL_NDX(ttype)];
+  FAR struct tcb_s *tcb;
+  FAR void *stack;
+  irqstate_t flags;
+
+  /* Look for a free TCB with a stack of the requested size.  The most
+   * recently freed TCB is at the head of the list.
+   */
+
+  flags = irqsave();
+  for (tcb = (FAR struct tcb_s *)pool->head;
+       tcb && tcb->req_stack_size != stack_size;
+       tcb = tcb->flink);
+
+  if (tcb)
+    {
+      dq_rem((FAR dq_entry_t *)tcb, pool);
+      g_tcbnfree--;
+    }
+
+  irqrestore(flags);
+
+  if (tcb)
+    {
+      /* Re-initialize the TCB but keep its stack */
+
+      stack = tcb->stack_alloc_ptr;
+      memset(tcb, 0, sched_tcbsize(ttype));
+      (void)up_use_stack(tcb, stack, stack_size);
+    }
+  else
+    {
+      /* Allocate a new TCB.  The caller will allocate the stack. */
+
+      tcb = (FAR struct tcb_s *)kzalloc(sched_tcbsize(ttype));
+      if (!tcb)
+        {
+          return NULL;
+        }
+    }
+
+  /* Remember the requested stack size.  This also marks the TCB as one that
+   * can be returned to the pool.
+   */
+
+  tcb->req_stack_size = stack_size;
+  return tcb;
+}
+
+/****************************************************************************
+ * Name: sched_recycletcb
+ *
+ * Description:
+ *   Called by sched_releasetcb() after all other resources held by the TCB
+ *   have been released.  Keep the TCB and its stack in the pool if the TCB
+ *   was allocated by sched_alloctcb() and the pool is not full.
+ *
+ * Parameters:
+ *   tcb   - The TCB to be released
+ *   ttype - The type of the TCB to be released
+ *
+ * Return Value:
+ *   true if the TCB was kept in the pool; false if the caller must free the
+ *   TCB and its stack.
+ *
+ * Assumptions:
+ *   This may be called by a task that is exiting, while it is still using
+ *   the stack.  That is safe because interrupts are disabled until the
+ *   context switch and no other task can allocate the TCB in the meantime.
+ *
+ ****************************************************************************/
+
+bool sched_recycletcb(FAR struct tcb_s *tcb, uint8_t ttype)
+{
+  irqstate_t flags;
+  bool ret = false;
+
+  if (tcb->req_stack_size > 0 && tcb->stack_alloc_ptr)
+    {
+      flags = irqsave();
+      if (g_tcbnfree < CONFIG_SCHED_TCBPOOL_NFREE)
+        {
+          dq_addfirst((FAR dq_entry_t *)tcb, &g_tcbpool[TCBPOOL_NDX(ttype)]);
+          g_tcbnfree++;
+          ret = true;
+        }
+
+      irqrestore(flags);
+    }
+
+  return ret;
+}
+
+#endif /* CONFIG_SCHED_TCBPOOL */
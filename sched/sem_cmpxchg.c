@@ -0,0 +1,155 @@
+/****************************************************************************
+ * sched/sem_cmpxchg.c
+ *
+ *   Copyright (C) 2013 Gregory Nutt. All rights reserved.
+ *   Author: Gregory Nutt <gnutt@nuttx.org>
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ * 3. Neither the name NuttX nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software
+ *    without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ * LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ * ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <semaphore.h>
+
+#include <nuttx/arch.h>
+#include <arch/irq.h>
+
+#include "sem_internal.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sem_cmpxchg
+ *
+ * Description:
+ *   Atomically replace the semaphore count with newval if it is equal to
+ *   oldval.  This is the fallback for architectures that do not provide
+ *   up_cmpxchg16():  Atomicity is assured by disabling interrupts.
+ *
+ * Parameters:
+ *   sem - The semaphore
+ *   oldval - The expected semaphore count
+ *   newval - The new semaphore count
+ *
+ * Return Value:
+ *   true if the count was replaced.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_ARCH_HAVE_CMPXCHG
+bool sem_cmpxchg(FAR sem_t *sem, int16_t oldval, int16_t newval)
+{
+  irqstate_t flags;
+  bool ret = false;
+
+  flags = irqsave();
+  if (sem->semcount == oldval)
+    {
+      sem->semcount = newval;
+      ret = true;
+    }
+
+  irqrestore(flags);
+  return ret;
+}
+#endif
+
+/****************************************************************************
+ * Name: sem_fastwait
+ *
+ * Description:
+ *   Try to take a count on the semaphore without disabling interrupts.
+ *   This succeeds only if a count is available.  Otherwise, the caller
+ *   must fall back to the normal logic (which may block).
+ *
+ * Parameters:
+ *   sem - The semaphore
+ *
+ * Return Value:
+ *   true if a count was taken.
+ *
+ ****************************************************************************/
+
+#ifdef SEM_HAVE_FASTPATH
+bool sem_fastwait(FAR sem_t *sem)
+{
+  int16_t semcount;
+
+  for (semcount = sem->semcount; semcount > 0; semcount = sem->semcount)
+    {
+      if (sem_cmpxchg(sem, semcount, semcount - 1))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: sem_fastpost
+ *
+ * Description:
+ *   Try to give a count to the semaphore without disabling interrupts.
+ *   This succeeds only if no task is waiting for the semaphore.  Otherwise,
+ *   the caller must fall back to the normal logic that wakes the waiter.
+ *
+ * Parameters:
+ *   sem - The semaphore
+ *
+ * Return Value:
+ *   true if the count was given.
+ *
+ ****************************************************************************/
+
+bool sem_fastpost(FAR sem_t *sem)
+{
+  int16_t semcount;
+
+  for (semcount = sem->semcount;
+       semcount >= 0 && semcount < SEM_VALUE_MAX;
+       semcount = sem->semcount)
+    {
+      if (sem_cmpxchg(sem, semcount, semcount + 1))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+#endif /* SEM_HAVE_FASTPATH */
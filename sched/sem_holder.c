@@ -88,49 +88,73 @@ static FAR struct semholder_s *g_freeholders;
 
 /****************************************************************************
  * Name: sem_allocholder
+ *
+ * Description:
+ *   Allocate a holder record for htcb and link it into the list of holders
+ *   of the semaphore.  The semaphore's built-in holder is used first so
+ *   that a mutex never needs a pre-allocated holder.  Only pre-allocated
+ *   holders are also linked into the list of semaphores held by htcb:  The
+ *   built-in holder lives in the semaphore itself and the semaphore's
+ *   storage may be released (a semaphore on the stack, for example) without
+ *   sem_destroy() ever being called.
+ *
  ****************************************************************************/
 
-static inline FAR struct semholder_s *sem_allocholder(sem_t *sem)
+static inline FAR struct semholder_s *sem_allocholder(sem_t *sem,
+                                                      FAR struct tcb_s *htcb)
 {
   FAR struct semholder_s *pholder;
 
-  /* Check if the "built-in" holder is being used.  We have this built-in
-   * holder to optimize for the simplest case where semaphores are only
-   * used to implement mutexes.
-   */
-
-#if CONFIG_SEM_PREALLOCHOLDERS > 0
-  pholder = g_freeholders;
-  if (pholder)
+  if (!sem->holder.htcb)
     {
-      /* Remove the holder from the free list an put it into the semaphore's holder list */
-
-      g_freeholders    = pholder->flink;
-      pholder->flink   = sem->hhead;
-      sem->hhead       = pholder;
-
-      /* Make sure the initial count is zero */
-
-      pholder->counts  = 0;
+      pholder = &sem->holder;
     }
-#else
-  if (!sem->holder.htcb)
+#if CONFIG_SEM_PREALLOCHOLDERS > 0
+  else if (g_freeholders)
     {
-      pholder          = &sem->holder;
-      pholder->counts  = 0;
+      /* Remove the holder from the free list */
+
+      pholder       = g_freeholders;
+      g_freeholders = pholder->flink;
     }
 #endif
   else
     {
       sdbg("Insufficient pre-allocated holders\n");
-      pholder = NULL;
+      return NULL;
     }
 
+#if CONFIG_SEM_PREALLOCHOLDERS > 0
+  /* Put the holder into the semaphore's holder list */
+
+  pholder->flink  = sem->hhead;
+  sem->hhead      = pholder;
+#endif
+
+  /* Pre-allocated holders also go into the holder thread's list of held
+   * semaphores.
+   */
+
+  if (pholder != &sem->holder)
+    {
+      pholder->tlink = htcb->holdsem;
+      htcb->holdsem  = pholder;
+    }
+
+  pholder->sem    = sem;
+  pholder->htcb   = htcb;
+  pholder->counts = 0;
   return pholder;
 }
 
 /****************************************************************************
  * Name: sem_findholder
+ *
+ * Description:
+ *   Find the holder record of htcb on the semaphore.  The semaphore's
+ *   built-in holder is checked first, then only the pre-allocated holders
+ *   owned by htcb are searched.
+ *
  ****************************************************************************/
 
 static FAR struct semholder_s *sem_findholder(sem_t *sem,
@@ -138,15 +162,14 @@ static FAR struct semholder_s *sem_findholder(sem_t *sem,
 {
   FAR struct semholder_s *pholder;
 
-  /* Try to find the holder in the list of holders associated with this semaphore */
+  if (sem->holder.htcb == htcb)
+    {
+      return &sem->holder;
+    }
 
-#if CONFIG_SEM_PREALLOCHOLDERS > 0
-  for (pholder = sem->hhead; pholder; pholder = pholder->flink)
-#else
-  pholder = &sem->holder;
-#endif
+  for (pholder = htcb->holdsem; pholder; pholder = pholder->tlink)
     {
-      if (pholder->htcb == htcb)
+      if (pholder->sem == sem)
         {
           /* Got it! */
 
@@ -169,7 +192,7 @@ sem_findorallocateholder(sem_t *sem, FAR struct tcb_s *htcb)
   FAR struct semholder_s *pholder = sem_findholder(sem, htcb);
   if (!pholder)
     {
-      pholder = sem_allocholder(sem);
+      pholder = sem_allocholder(sem, htcb);
     }
 
   return pholder;
@@ -177,46 +200,76 @@ sem_findorallocateholder(sem_t *sem, FAR struct tcb_s *htcb)
 
 /****************************************************************************
  * Name: sem_freeholder
+ *
+ * Description:
+ *   Unlink the holder record from the semaphore and from the holder thread
+ *   and release it.  If pholder->htcb is NULL (a stale holder), the record
+ *   is not unlinked from the thread.  The thread's list is singly linked,
+ *   so unlinking searches the pre-allocated holders owned by the thread.
+ *
  ****************************************************************************/
 
 static inline void sem_freeholder(sem_t *sem, FAR struct semholder_s *pholder)
 {
-#if CONFIG_SEM_PREALLOCHOLDERS > 0
-  FAR struct semholder_s *curr;
-  FAR struct semholder_s *prev;
-#endif
+  FAR struct semholder_s **link;
 
-  /* Release the holder and counts */
+  /* Remove a pre-allocated holder from the holder thread's list */
 
-  pholder->htcb   = NULL;
-  pholder->counts = 0;
+  if (pholder->htcb && pholder != &sem->holder)
+    {
+      for (link = &pholder->htcb->holdsem;
+           *link && *link != pholder;
+           link = &(*link)->tlink);
+
+      if (*link)
+        {
+          *link = pholder->tlink;
+        }
+    }
 
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-  /* Search the list for the matching holder */
+  /* Remove the holder from the semaphore's list */
 
-  for (prev = NULL, curr = sem->hhead;
-       curr && curr != pholder;
-       prev = curr, curr = curr->flink);
+  for (link = &sem->hhead;
+       *link && *link != pholder;
+       link = &(*link)->flink);
 
-  if (curr)
+  if (*link)
     {
-      /* Remove the holder from the list */
-
-      if (prev)
-        {
-          prev->flink = pholder->flink;
-        }
-      else
-        {
-          sem->hhead = pholder->flink;
-        }
+      *link = pholder->flink;
+    }
 
-      /* And put it in the free list */
+  /* Put pre-allocated holders back in the free list */
 
+  if (pholder != &sem->holder)
+    {
       pholder->flink = g_freeholders;
       g_freeholders  = pholder;
     }
 #endif
+
+  /* Release the holder and counts */
+
+  pholder->tlink  = NULL;
+  pholder->sem    = NULL;
+  pholder->htcb   = NULL;
+  pholder->counts = 0;
+}
+
+/****************************************************************************
+ * Name: sem_freestaleholder
+ *
+ * Description:
+ *   Release a holder whose thread has exited.  The TCB may already have
+ *   been freed so it must not be touched.
+ *
+ ****************************************************************************/
+
+static void sem_freestaleholder(sem_t *sem, FAR struct semholder_s *pholder)
+{
+  sdbg("TCB 0x%08x is a stale handle, counts lost\n", pholder->htcb);
+  pholder->htcb = NULL;
+  sem_freeholder(sem, pholder);
 }
 
 /****************************************************************************
@@ -250,6 +303,17 @@ static int sem_foreachholder(FAR sem_t *sem, holderhandler_t handler, FAR void *
 
           ret = handler(pholder, sem, arg);
         }
+#if CONFIG_SEM_PREALLOCHOLDERS > 0
+
+      /* A pre-allocated holder with no thread was orphaned by sem_recover()
+       * when its thread exited.  Release it now.
+       */
+
+      else if (pholder != &sem->holder)
+        {
+          sem_freeholder(sem, pholder);
+        }
+#endif
     }
 
   return ret;
@@ -259,13 +323,11 @@ static int sem_foreachholder(FAR sem_t *sem, holderhandler_t handler, FAR void *
  * Name: sem_recoverholders
  ****************************************************************************/
 
-#if CONFIG_SEM_PREALLOCHOLDERS > 0
 static int sem_recoverholders(FAR struct semholder_s *pholder, FAR sem_t *sem, FAR void *arg)
 {
   sem_freeholder(sem, pholder);
   return 0;
 }
-#endif
 
 /****************************************************************************
  * Name: sem_boostholderprio
@@ -284,10 +346,9 @@ static int sem_boostholderprio(FAR struct semholder_s *pholder,
    */
 
   if (!sched_verifytcb(htcb))
-   {
-      sdbg("TCB 0x%08x is a stale handle, counts lost\n", htcb);
-      sem_freeholder(sem, pholder);
-   }
+    {
+      sem_freestaleholder(sem, pholder);
+    }
 
 #if CONFIG_SEM_NNESTPRIO > 0
 
@@ -432,10 +493,9 @@ static int sem_restoreholderprio(FAR struct semholder_s *pholder, FAR sem_t *sem
    */
 
   if (!sched_verifytcb(htcb))
-   {
-      sdbg("TCB 0x%08x is a stale handle, counts lost\n", htcb);
-      sem_freeholder(sem, pholder);
-   }
+    {
+      sem_freestaleholder(sem, pholder);
+    }
 
   /* Was the priority of the holder thread boosted? If so, then drop its
    * priority back to the correct level.  What is the correct level?
@@ -809,20 +869,11 @@ void sem_destroyholder(FAR sem_t *sem)
    * doing.
    */
 
-#if CONFIG_SEM_PREALLOCHOLDERS > 0
-  if (sem->hhead)
+  if (sem_hasholders(sem))
     {
       sdbg("Semaphore destroyed with holders\n");
       (void)sem_foreachholder(sem, sem_recoverholders, NULL);
     }
-#else
-  if (sem->holder.htcb)
-    {
-      sdbg("Semaphore destroyed with holder\n");
-    }
-
-  sem->holder.htcb = NULL;
-#endif
 }
 
 /****************************************************************************
@@ -851,13 +902,113 @@ void sem_addholder(FAR sem_t *sem)
   pholder = sem_findorallocateholder(sem, rtcb);
   if (pholder)
     {
-      /* Then set the holder and increment the number of counts held by this holder */
+      /* Then increment the number of counts held by this holder */
 
-      pholder->htcb = rtcb;
       pholder->counts++;
     }
 }
 
+/****************************************************************************
+ * Name: sem_registerholder
+ *
+ * Description:
+ *   Called when a thread must wait for a pthread mutex that was taken via
+ *   the fast path.  The fast path does not record the holder.  Record it
+ *   now (holding the one count) so that the holder's priority can be
+ *   boosted.  Nothing is done if the holder is already recorded.
+ *
+ * Parameters:
+ *   sem - A reference to the mutex semaphore
+ *   htcb - The TCB of the thread that holds the mutex
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   The scheduler is locked.
+ *
+ ****************************************************************************/
+
+void sem_registerholder(FAR sem_t *sem, FAR struct tcb_s *htcb)
+{
+  FAR struct semholder_s *pholder;
+
+  if (!sem_findholder(sem, htcb))
+    {
+      pholder = sem_allocholder(sem, htcb);
+      if (pholder)
+        {
+          pholder->counts = 1;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: sem_hasholders
+ *
+ * Description:
+ *   Return true if any holder of the semaphore is recorded.
+ *
+ * Parameters:
+ *   sem - A reference to the semaphore
+ *
+ * Return Value:
+ *   true if there are recorded holders
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+bool sem_hasholders(FAR sem_t *sem)
+{
+#if CONFIG_SEM_PREALLOCHOLDERS > 0
+  return sem->hhead != NULL;
+#else
+  return sem->holder.htcb != NULL;
+#endif
+}
+
+/****************************************************************************
+ * Name: sem_recover
+ *
+ * Description:
+ *   Called from task_recover() when a task exits or is restarted.  Any
+ *   semaphore counts still held by the task are lost.  The pre-allocated
+ *   holder records owned by the task are detached from the task and are
+ *   released the next time the holders of their semaphore are visited.
+ *   The semaphores themselves are not touched here:  Their storage may
+ *   already have been released without sem_destroy().  A built-in holder
+ *   left by the task is released as a stale holder when it is next found
+ *   (see sem_freestaleholder()).
+ *
+ * Parameters:
+ *   tcb - The TCB of the exiting task
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *
+ ****************************************************************************/
+
+void sem_recover(FAR struct tcb_s *tcb)
+{
+  FAR struct semholder_s *pholder;
+  irqstate_t flags;
+
+  flags = irqsave();
+  while ((pholder = tcb->holdsem) != NULL)
+    {
+      tcb->holdsem    = pholder->tlink;
+      pholder->tlink  = NULL;
+      pholder->htcb   = NULL;
+      pholder->counts = 0;
+    }
+
+  irqrestore(flags);
+}
+
 /****************************************************************************
  * Name: void sem_boostpriority(sem_t *sem)
  *
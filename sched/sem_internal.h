@@ -42,6 +42,7 @@
 
 #include <nuttx/config.h>
 #include <nuttx/compiler.h>
+#include <nuttx/arch.h>
 
 #include <stdint.h>
 #include <stdbool.h>
@@ -53,6 +54,26 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Atomic compare-and-swap of the semaphore count.  Use the architecture's
+ * interrupt-safe primitive if there is one.  Otherwise, sem_cmpxchg() is a
+ * function that disables interrupts.
+ */
+
+#ifdef CONFIG_ARCH_HAVE_CMPXCHG
+#  define sem_cmpxchg(s,o,n) up_cmpxchg16(&(s)->semcount,(o),(n))
+#endif
+
+/* sem_wait(), sem_trywait(), and sem_post() can take or give a count
+ * without disabling interrupts if there is no waiter to wake and no
+ * holder to track.  This requires a real atomic primitive:  With the
+ * fallback, the fast path would just disable interrupts twice when the
+ * semaphore is contended.
+ */
+
+#if defined(CONFIG_ARCH_HAVE_CMPXCHG) && !defined(CONFIG_PRIORITY_INHERITANCE)
+#  define SEM_HAVE_FASTPATH 1
+#endif
+
 /****************************************************************************
  * Public Type Declarations
  ****************************************************************************/
@@ -97,6 +118,17 @@ void weak_function sem_initialize(void);
 void sem_waitirq(FAR struct tcb_s *wtcb, int errcode);
 FAR nsem_t *sem_findnamed(const char *name);
 
+/* Atomic operations on the semaphore count */
+
+#ifndef CONFIG_ARCH_HAVE_CMPXCHG
+bool sem_cmpxchg(FAR sem_t *sem, int16_t oldval, int16_t newval);
+#endif
+
+#ifdef SEM_HAVE_FASTPATH
+bool sem_fastwait(FAR sem_t *sem);
+bool sem_fastpost(FAR sem_t *sem);
+#endif
+
 /* Special logic needed only by priority inheritance to manage collections of
  * holders of semaphores.
  */
@@ -108,6 +140,9 @@ void sem_addholder(FAR sem_t *sem);
 void sem_boostpriority(FAR sem_t *sem);
 void sem_releaseholder(FAR sem_t *sem);
 void sem_restorebaseprio(FAR struct tcb_s *stcb, FAR sem_t *sem);
+void sem_registerholder(FAR sem_t *sem, FAR struct tcb_s *htcb);
+bool sem_hasholders(FAR sem_t *sem);
+void sem_recover(FAR struct tcb_s *tcb);
 #  ifndef CONFIG_DISABLE_SIGNALS
 void sem_canceled(FAR struct tcb_s *stcb, FAR sem_t *sem);
 #  else
@@ -120,6 +155,9 @@ void sem_canceled(FAR struct tcb_s *stcb, FAR sem_t *sem);
 #  define sem_boostpriority(sem)
 #  define sem_releaseholder(sem)
 #  define sem_restorebaseprio(stcb,sem)
+#  define sem_registerholder(sem,htcb)
+#  define sem_hasholders(sem) (false)
+#  define sem_recover(tcb)
 #  define sem_canceled(stcb, sem)
 #endif
 
@@ -110,6 +110,15 @@ int sem_post(FAR sem_t *sem)
 
   if (sem)
     {
+#ifdef SEM_HAVE_FASTPATH
+      /* If no task is waiting for the semaphore, just add the count */
+
+      if (sem_fastpost(sem))
+        {
+          return OK;
+        }
+#endif
+
       /* The following operations must be performed with interrupts
        * disabled because sem_post() may be called from an interrupt
        * handler.
@@ -140,23 +149,19 @@ int sem_post(FAR sem_t *sem)
 
       if (sem->semcount <= 0)
         {
-          /* Check if there are any tasks in the waiting for semaphore
-           * task list that are waiting for this semaphore. This is a
-           * prioritized list so the first one we encounter is the one
-           * that we want.
+          /* Check if there are any tasks waiting for this semaphore.
+           * The semaphore's wait list is prioritized so the task at the
+           * head of the list is the one that we want.
            */
 
-          for (stcb = (FAR struct tcb_s*)g_waitingforsemaphore.head;
-               (stcb && stcb->waitsem != sem);
-               stcb = stcb->flink);
-
+          stcb = (FAR struct tcb_s*)sem->waitlist.head;
           if (stcb)
             {
-              /* It is, let the task take the semaphore */
-
-              stcb->waitsem = NULL;
-
-              /* Restart the waiting task. */
+              /* Restart the waiting task.  It will take the semaphore and
+               * clear its waitsem reference when it runs.  waitsem must
+               * remain valid until the task has been removed from the
+               * semaphore's wait list.
+               */
 
               up_unblock_task(stcb);
             }
@@ -110,6 +110,15 @@ int sem_trywait(FAR sem_t *sem)
 
   if (sem)
     {
+#ifdef SEM_HAVE_FASTPATH
+      /* If a count is available, just take it */
+
+      if (sem_fastwait(sem))
+        {
+          return OK;
+        }
+#endif
+
       /* The following operations must be performed with interrupts disabled
        * because sem_post() may be called from an interrupt handler.
        */
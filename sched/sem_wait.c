@@ -110,6 +110,15 @@ int sem_wait(FAR sem_t *sem)
 
   if (sem)
     {
+#ifdef SEM_HAVE_FASTPATH
+      /* If a count is available, just take it */
+
+      if (sem_fastwait(sem))
+        {
+          return OK;
+        }
+#endif
+
       /* The following operations must be performed with interrupts
        * disabled because sem_post() may be called from an interrupt
        * handler.
@@ -171,6 +180,12 @@ int sem_wait(FAR sem_t *sem)
           errno = 0;
           up_block_task(rtcb, TSTATE_WAIT_SEM);
 
+          /* We have been removed from the semaphore's wait list.  Indicate
+           * that the semaphore wait is over.
+           */
+
+          rtcb->waitsem = NULL;
+
           /* When we resume at this point, either (1) the semaphore has been
            * assigned to this thread of execution, or (2) the semaphore wait
            * has been interrupted by a signal or a timeout.  We can detect these
@@ -183,7 +198,7 @@ int sem_wait(FAR sem_t *sem)
            * - sem_canceled() was called to restore the priority of all threads
            *   that hold a reference to the semaphore,
            * - The semaphore count was decremented, and
-           * - tcb->waitsem was nullifed.
+           * - The task was removed from the semaphore's wait list.
            *
            * It is necesaary to do these things in sem_waitirq.c because a long
            * time may elapse between the time that the signal was issued and
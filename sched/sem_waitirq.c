@@ -125,10 +125,6 @@ void sem_waitirq(FAR struct tcb_s *wtcb, int errcode)
 
       sem->semcount++;
 
-      /* Indicate that the semaphore wait is over. */
-
-      wtcb->waitsem = NULL;
-
       /* Mark the errno value for the thread. */
 
       wtcb->pterrno = errcode;
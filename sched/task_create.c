@@ -113,7 +113,11 @@ static int thread_create(FAR const char *name, uint8_t ttype, int priority,
 
   /* Allocate a TCB for the new task. */
 
+#ifdef CONFIG_SCHED_TCBPOOL
+  tcb = (FAR struct task_tcb_s *)sched_alloctcb(ttype, stack_size);
+#else
   tcb = (FAR struct task_tcb_s *)kzalloc(sizeof(struct task_tcb_s));
+#endif
   if (!tcb)
     {
       sdbg("ERROR: Failed to allocate TCB\n");
@@ -143,14 +147,17 @@ static int thread_create(FAR const char *name, uint8_t ttype, int priority,
     }
 #endif
 
-  /* Allocate the stack for the TCB */
+  /* Allocate the stack for the TCB (unless a re-used TCB already has one) */
 
 #ifndef CONFIG_CUSTOM_STACK
-  ret = up_create_stack((FAR struct tcb_s *)tcb, stack_size, ttype);
-  if (ret < OK)
+  if (!tcb->cmn.stack_alloc_ptr)
     {
-      errcode = -ret;
-      goto errout_with_tcb;
+      ret = up_create_stack((FAR struct tcb_s *)tcb, stack_size, ttype);
+      if (ret < OK)
+        {
+          errcode = -ret;
+          goto errout_with_tcb;
+        }
     }
 #endif
 
@@ -46,6 +46,7 @@
 
 #include "os_internal.h"
 #include "mq_internal.h"
+#include "sem_internal.h"
 
 /****************************************************************************
  * Definitions
@@ -81,7 +82,8 @@
  * Description:
  *   This function is called when a task is deleted via task_deleted or
  *   via pthread_cancel. I checks if the task was waiting for a message
- *   queue event and adjusts counts appropriately.
+ *   queue event and adjusts counts appropriately and releases any
+ *   semaphore holder records that belong to the task.
  *
  * Inputs:
  *   tcb - The TCB of the terminated task or thread
@@ -120,4 +122,8 @@ void task_recover(FAR struct tcb_s *tcb)
 #ifndef CONFIG_DISABLE_MQUEUE
   mq_recover(tcb);
 #endif
+
+  /* Release any semaphore holder records still owned by the thread */
+
+  sem_recover(tcb);
 }
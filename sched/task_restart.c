@@ -160,7 +160,7 @@ int task_restart(pid_t pid)
 
       state = irqsave();
       dq_rem((FAR dq_entry_t*)tcb,
-             (dq_queue_t*)g_tasklisttable[tcb->cmn.task_state].list);
+             sched_tasklist((FAR struct tcb_s *)tcb, tcb->cmn.task_state));
       tcb->cmn.task_state = TSTATE_TASK_INVALID;
       irqrestore(state);
 